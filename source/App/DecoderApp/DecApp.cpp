@@ -47,6 +47,9 @@
 #include "CommonLib/CodingStatistics.h"
 #endif
 #include "CommonLib/dtrace_codingstruct.h"
+#if DECODER_STAGE_TIMING
+#include <chrono>
+#endif
 
 
 //! \ingroup DecoderApp
@@ -77,15 +80,16 @@ uint32_t DecApp::decode()
 {
   int                 poc;
   PicList* pcListPic = NULL;
+#if DECODER_STAGE_TIMING
+  const auto startTime = std::chrono::steady_clock::now();
+#endif
 
-  ifstream bitstreamFile(m_bitstreamFileName.c_str(), ifstream::in | ifstream::binary);
-  if (!bitstreamFile)
+  MappedInputByteStream bytestream;
+  if (!bytestream.open(m_bitstreamFileName))
   {
     EXIT( "Failed to open bitstream file " << m_bitstreamFileName.c_str() << " for reading" ) ;
   }
 
-  InputByteStream bytestream(bitstreamFile);
-
   if (!m_outputDecodedSEIMessagesFilename.empty() && m_outputDecodedSEIMessagesFilename!="-")
   {
     m_seiMessageFileStream.open(m_outputDecodedSEIMessagesFilename.c_str(), std::ios::out);
@@ -114,7 +118,7 @@ uint32_t DecApp::decode()
   bool openedReconFile = false; // reconstruction file not yet opened. (must be performed after SPS is seen)
   bool loopFiltered = false;
 
-  while (!!bitstreamFile)
+  while (!bytestream.eof())
   {
     /* location serves to work around a design fault in the decoder, whereby
      * the process of reading a new slice that is the first slice of a new frame
@@ -128,15 +132,14 @@ uint32_t DecApp::decode()
     CodingStatistics::CodingStatisticsData* backupStats = new CodingStatistics::CodingStatisticsData(CodingStatistics::GetStatistics());
 #endif
 
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    streampos location = bitstreamFile.tellg() - streampos(bytestream.GetNumBufferedBytes());
-#else
-    streampos location = bitstreamFile.tellg();
-#endif
+    size_t location = bytestream.getPosition();
     AnnexBStats stats = AnnexBStats();
 
     InputNALUnit nalu;
-    byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
+    {
+      DEC_STAGE_TIMER( m_stageTimes, DEC_STAGE_NAL_READ );
+      byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
+    }
 
     // call actual decoding function
     bool bNewPicture = false;
@@ -151,7 +154,10 @@ uint32_t DecApp::decode()
     }
     else
     {
-      read(nalu);
+      {
+        DEC_STAGE_TIMER( m_stageTimes, DEC_STAGE_NAL_READ );
+        read(nalu);
+      }
 
 #if JVET_N0278_HLS
       if ((m_iMaxTemporalLayer >= 0 && nalu.m_temporalId > m_iMaxTemporalLayer) || !isNaluWithinTargetDecLayerIdSet(&nalu) || !isNaluTheTargetLayer(&nalu))
@@ -166,18 +172,11 @@ uint32_t DecApp::decode()
         bNewPicture = m_cDecLib.decode(nalu, m_iSkipFrame, m_iPOCLastDisplay);
         if (bNewPicture)
         {
-          bitstreamFile.clear();
-          /* location points to the current nalunit payload[1] due to the
-           * need for the annexB parser to read three extra bytes.
-           * [1] except for the first NAL unit in the file
-           *     (but bNewPicture doesn't happen then) */
+          /* location points to the leading bytes of the current nal unit,
+           * which is read again for the next picture */
+          bytestream.setPosition(location);
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-          bitstreamFile.seekg(location);
-          bytestream.reset();
           CodingStatistics::SetStatistics(*backupStats);
-#else
-          bitstreamFile.seekg(location-streamoff(3));
-          bytestream.reset();
 #endif
         }
       }
@@ -185,9 +184,9 @@ uint32_t DecApp::decode()
 
 
 
-    if( ( bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS ) && !m_cDecLib.getFirstSliceInSequence() )
+    if( ( bNewPicture || bytestream.eof() || nalu.m_nalUnitType == NAL_UNIT_EOS ) && !m_cDecLib.getFirstSliceInSequence() )
     {
-      if (!loopFiltered || bitstreamFile)
+      if (!loopFiltered || !bytestream.eof())
       {
         m_cDecLib.executeLoopFilters();
         m_cDecLib.finishPicture( poc, pcListPic );
@@ -199,7 +198,7 @@ uint32_t DecApp::decode()
       }
 
     }
-    else if ( (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS ) &&
+    else if ( (bNewPicture || bytestream.eof() || nalu.m_nalUnitType == NAL_UNIT_EOS ) &&
               m_cDecLib.getFirstSliceInSequence () )
     {
       m_cDecLib.setFirstSliceInPicture (true);
@@ -224,6 +223,7 @@ uint32_t DecApp::decode()
         }
 
         m_cVideoIOYuvReconFile.open( m_reconFileName, true, m_outputBitDepth, m_outputBitDepth, bitDepths.recon ); // write mode
+        m_cReconFileWriter.create( &m_cVideoIOYuvReconFile, m_outputQueueDepth );
         openedReconFile = true;
       }
       // write reconstruction to file
@@ -248,10 +248,12 @@ uint32_t DecApp::decode()
             || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_N_LP) )
 #endif
       {
+        m_cDecLib.finishPendingPictures( poc, pcListPic );
         xFlushOutput( pcListPic );
       }
       if (nalu.m_nalUnitType == NAL_UNIT_EOS)
       {
+        m_cDecLib.finishPendingPictures( poc, pcListPic );
         xWriteOutput( pcListPic, nalu.m_temporalId );
         m_cDecLib.setFirstSliceInPicture (false);
       }
@@ -275,8 +277,13 @@ uint32_t DecApp::decode()
 #endif
   }
 
+  m_cDecLib.finishPendingPictures( poc, pcListPic );
   xFlushOutput( pcListPic );
 
+#if DECODER_STAGE_TIMING
+  xReportStageTiming( std::chrono::duration<double>( std::chrono::steady_clock::now() - startTime ).count() );
+#endif
+
   // get the number of checksum errors
   uint32_t nRet = m_cDecLib.getNumberOfChecksumErrorsDetected();
 
@@ -303,6 +310,8 @@ void DecApp::xCreateDecLib()
   initROM();
 
   // create decoder class
+  m_cDecLib.setNumDecThreads( m_numDecThreads );
+  m_cDecLib.setLoopFilterPipelineDepth( m_loopFilterPipelineDepth );
   m_cDecLib.create();
 
   // initialize decoder class
@@ -328,6 +337,7 @@ void DecApp::xDestroyDecLib()
 {
   if ( !m_reconFileName.empty() )
   {
+    m_cReconFileWriter.destroy();
     m_cVideoIOYuvReconFile.close();
   }
 
@@ -345,6 +355,7 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
   {
     return;
   }
+  DEC_STAGE_TIMER( m_stageTimes, DEC_STAGE_OUTPUT );
 
   PicList::iterator iterPic   = pcListPic->begin();
   int numPicsNotYetDisplayed = 0;
@@ -399,6 +410,10 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
       iterPic++;
       Picture* pcPicBottom = *(iterPic);
 
+      if( m_cDecLib.isLoopFilterPending( pcPicTop ) || m_cDecLib.isLoopFilterPending( pcPicBottom ) )
+      {
+        break; // the following pictures in output order have to wait for it
+      }
       if ( pcPicTop->neededForOutput && pcPicBottom->neededForOutput &&
           (numPicsNotYetDisplayed >  numReorderPicsHighestTid || dpbFullness > maxDecPicBufferingHighestTid) &&
           (!(pcPicTop->getPOC()%2) && pcPicBottom->getPOC() == pcPicTop->getPOC()+1) &&
@@ -427,21 +442,21 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
 
           if (display)
           {
-            m_cVideoIOYuvReconFile.write( pcPicTop->getRecoBuf(), pcPicBottom->getRecoBuf(),
-                                          m_outputColourSpaceConvert,
-                                          false, // TODO: m_packedYUVMode,
+            m_cReconFileWriter.write( pcPicTop->getRecoBuf(), pcPicBottom->getRecoBuf(),
+                                      m_outputColourSpaceConvert,
+                                      false, // TODO: m_packedYUVMode,
 #if JVET_N0063_VUI
-                                          conf.getWindowLeftOffset(),
-                                          conf.getWindowRightOffset(),
-                                          conf.getWindowTopOffset(),
-                                          conf.getWindowBottomOffset(),
+                                      conf.getWindowLeftOffset(),
+                                      conf.getWindowRightOffset(),
+                                      conf.getWindowTopOffset(),
+                                      conf.getWindowBottomOffset(),
 #else
-                                          conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset(),
-                                          conf.getWindowRightOffset()  + defDisp.getWindowRightOffset(),
-                                          conf.getWindowTopOffset()    + defDisp.getWindowTopOffset(),
-                                          conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
+                                      conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset(),
+                                      conf.getWindowRightOffset()  + defDisp.getWindowRightOffset(),
+                                      conf.getWindowTopOffset()    + defDisp.getWindowTopOffset(),
+                                      conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
 #endif
-                                          NUM_CHROMA_FORMAT, isTff );
+                                      NUM_CHROMA_FORMAT, isTff );
           }
         }
 
@@ -470,6 +485,10 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
     {
       pcPic = *(iterPic);
 
+      if( m_cDecLib.isLoopFilterPending( pcPic ) )
+      {
+        break; // the following pictures in output order have to wait for it
+      }
       if(pcPic->neededForOutput && pcPic->getPOC() > m_iPOCLastDisplay &&
         (numPicsNotYetDisplayed >  numReorderPicsHighestTid || dpbFullness > maxDecPicBufferingHighestTid))
       {
@@ -488,21 +507,21 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
           const Window  defDisp = (m_respectDefDispWindow && pcPic->cs->sps->getVuiParametersPresentFlag()) ? pcPic->cs->sps->getVuiParameters()->getDefaultDisplayWindow() : Window();
 #endif
 
-          m_cVideoIOYuvReconFile.write( pcPic->getRecoBuf(),
-                                        m_outputColourSpaceConvert,
-                                        m_packedYUVMode,
+          m_cReconFileWriter.write( pcPic->getRecoBuf(),
+                                    m_outputColourSpaceConvert,
+                                    m_packedYUVMode,
 #if JVET_N0063_VUI
-                                        conf.getWindowLeftOffset(),
-                                        conf.getWindowRightOffset(),
-                                        conf.getWindowTopOffset(),
-                                        conf.getWindowBottomOffset(),
+                                    conf.getWindowLeftOffset(),
+                                    conf.getWindowRightOffset(),
+                                    conf.getWindowTopOffset(),
+                                    conf.getWindowBottomOffset(),
 #else
-                                        conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset(),
-                                        conf.getWindowRightOffset()  + defDisp.getWindowRightOffset(),
-                                        conf.getWindowTopOffset()    + defDisp.getWindowTopOffset(),
-                                        conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
+                                    conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset(),
+                                    conf.getWindowRightOffset()  + defDisp.getWindowRightOffset(),
+                                    conf.getWindowTopOffset()    + defDisp.getWindowTopOffset(),
+                                    conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
 #endif
-                                        NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+                                    NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
         }
 
         if (m_seiMessageFileStream.is_open())
@@ -534,6 +553,7 @@ void DecApp::xFlushOutput( PicList* pcListPic )
   {
     return;
   }
+  DEC_STAGE_TIMER( m_stageTimes, DEC_STAGE_OUTPUT );
   PicList::iterator iterPic   = pcListPic->begin();
 
   iterPic   = pcListPic->begin();
@@ -561,21 +581,21 @@ void DecApp::xFlushOutput( PicList* pcListPic )
 #endif
           const bool    isTff   = pcPicTop->topField;
 
-          m_cVideoIOYuvReconFile.write( pcPicTop->getRecoBuf(), pcPicBottom->getRecoBuf(),
-                                        m_outputColourSpaceConvert,
-                                        false, // TODO: m_packedYUVMode,
+          m_cReconFileWriter.write( pcPicTop->getRecoBuf(), pcPicBottom->getRecoBuf(),
+                                    m_outputColourSpaceConvert,
+                                    false, // TODO: m_packedYUVMode,
 #if JVET_N0063_VUI
-                                        conf.getWindowLeftOffset(),
-                                        conf.getWindowRightOffset(),
-                                        conf.getWindowTopOffset(),
-                                        conf.getWindowBottomOffset(),
+                                    conf.getWindowLeftOffset(),
+                                    conf.getWindowRightOffset(),
+                                    conf.getWindowTopOffset(),
+                                    conf.getWindowBottomOffset(),
 #else
-                                        conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset(),
-                                        conf.getWindowRightOffset()  + defDisp.getWindowRightOffset(),
-                                        conf.getWindowTopOffset()    + defDisp.getWindowTopOffset(),
-                                        conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
+                                    conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset(),
+                                    conf.getWindowRightOffset()  + defDisp.getWindowRightOffset(),
+                                    conf.getWindowTopOffset()    + defDisp.getWindowTopOffset(),
+                                    conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
 #endif
-                                        NUM_CHROMA_FORMAT, isTff );
+                                    NUM_CHROMA_FORMAT, isTff );
         }
 
         // update POC of display order
@@ -625,21 +645,21 @@ void DecApp::xFlushOutput( PicList* pcListPic )
           const Window  defDisp = (m_respectDefDispWindow && pcPic->cs->sps->getVuiParametersPresentFlag()) ? pcPic->cs->sps->getVuiParameters()->getDefaultDisplayWindow() : Window();
 #endif
 
-          m_cVideoIOYuvReconFile.write( pcPic->getRecoBuf(),
-                                        m_outputColourSpaceConvert,
-                                        m_packedYUVMode,
+          m_cReconFileWriter.write( pcPic->getRecoBuf(),
+                                    m_outputColourSpaceConvert,
+                                    m_packedYUVMode,
 #if JVET_N0063_VUI
-                                        conf.getWindowLeftOffset(),
-                                        conf.getWindowRightOffset(),
-                                        conf.getWindowTopOffset(),
-                                        conf.getWindowBottomOffset(),
+                                    conf.getWindowLeftOffset(),
+                                    conf.getWindowRightOffset(),
+                                    conf.getWindowTopOffset(),
+                                    conf.getWindowBottomOffset(),
 #else
-                                        conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset(),
-                                        conf.getWindowRightOffset()  + defDisp.getWindowRightOffset(),
-                                        conf.getWindowTopOffset()    + defDisp.getWindowTopOffset(),
-                                        conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
+                                    conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset(),
+                                    conf.getWindowRightOffset()  + defDisp.getWindowRightOffset(),
+                                    conf.getWindowTopOffset()    + defDisp.getWindowTopOffset(),
+                                    conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
 #endif
-                                        NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+                                    NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
         }
 
         if (m_seiMessageFileStream.is_open())
@@ -670,6 +690,36 @@ void DecApp::xFlushOutput( PicList* pcListPic )
   m_iPOCLastDisplay = -MAX_INT;
 }
 
+#if DECODER_STAGE_TIMING
+/** \param decodingTime wall clock time of the decoding in seconds
+ */
+void DecApp::xReportStageTiming( const double decodingTime )
+{
+  DecStageStatistics& stageStatistics = m_cDecLib.getStageStatistics();
+  stageStatistics.addSequenceTimes( m_stageTimes );
+  stageStatistics.printSummary( INFO, decodingTime );
+
+  if( !m_stageTimingFileName.empty() )
+  {
+    std::ofstream file( m_stageTimingFileName.c_str(), std::ios::out );
+    if( !file.is_open() )
+    {
+      EXIT( "Unable to open file " << m_stageTimingFileName.c_str() << " for writing decoding stage times" );
+    }
+    const std::string ext = ".json";
+    const bool isJSON = m_stageTimingFileName.size() >= ext.size() && m_stageTimingFileName.compare( m_stageTimingFileName.size() - ext.size(), ext.size(), ext ) == 0;
+    if( isJSON )
+    {
+      stageStatistics.writeJSON( file );
+    }
+    else
+    {
+      stageStatistics.writeCSV( file );
+    }
+  }
+}
+#endif
+
 /** \param nalu Input nalu to check whether its LayerId is within targetDecLayerIdSet
  */
 bool DecApp::isNaluWithinTargetDecLayerIdSet( InputNALUnit* nalu )
@@ -43,6 +43,7 @@
 #endif // _MSC_VER > 1000
 
 #include "Utilities/VideoIOYuv.h"
+#include "Utilities/VideoIOYuvAsyncWriter.h"
 #include "Utilities/ColourRemapping.h"
 #include "CommonLib/Picture.h"
 #include "DecoderLib/DecLib.h"
@@ -62,11 +63,15 @@ private:
   // class interface
   DecLib          m_cDecLib;                     ///< decoder class
   VideoIOYuv      m_cVideoIOYuvReconFile;        ///< reconstruction YUV class
+  VideoIOYuvAsyncWriter m_cReconFileWriter;     ///< writes the reconstruction YUV file on a background thread
 
   // for output control
   int             m_iPOCLastDisplay;              ///< last POC in display order
   std::ofstream   m_seiMessageFileStream;         ///< Used for outputing SEI messages.
   ColourRemapping m_cColourRemapping;             ///< colour remapping handler
+#if DECODER_STAGE_TIMING
+  DecStageTimes   m_stageTimes;                   ///< byte stream parsing and output times, not assigned to a picture
+#endif
 
 
 public:
@@ -80,6 +85,9 @@ private:
   void  xDestroyDecLib    (); ///< destroy internal classes
   void  xWriteOutput      ( PicList* pcListPic , uint32_t tId); ///< write YUV to file
   void  xFlushOutput      ( PicList* pcListPic ); ///< flush all remaining decoded pictures to file
+#if DECODER_STAGE_TIMING
+  void  xReportStageTiming( const double decodingTime ); ///< print and write the decoding stage times
+#endif
   bool  isNaluWithinTargetDecLayerIdSet ( InputNALUnit* nalu ); ///< check whether given Nalu is within targetDecLayerIdSet
 #if JVET_N0278_HLS
   bool  isNaluTheTargetLayer(InputNALUnit* nalu); ///< check whether given Nalu is within targetDecLayerIdSet
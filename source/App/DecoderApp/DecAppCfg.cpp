@@ -114,8 +114,14 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
                                                                                    "\t1: enable bit statistic\n"
                                                                                    "\t2: enable tool statistic\n"
                                                                                    "\t3: enable bit and tool statistic\n")
+#endif
+#if DECODER_STAGE_TIMING
+  ("StageTimingFile",           m_stageTimingFileName,                string( "" ), "File name for the time of each decoding stage per picture, written as JSON for a .json extension and as CSV otherwise")
 #endif
   ("MCTSCheck",                m_mctsCheck,                           false,       "If enabled, the decoder checks for violations of mc_exact_sample_value_match_flag in Temporal MCTS ")
+  ("Threads",                   m_numDecThreads,                       1,           "Number of threads used for decoding, bitstreams with entropy coding sync are decoded CTU row parallel")
+  ("LoopFilterPipeline",        m_loopFilterPipelineDepth,             0,           "Number of pictures whose in-loop filtering runs on a separate thread while the following pictures are decoded (0: sequential)")
+  ("OutputQueueDepth",          m_outputQueueDepth,                    2,           "Number of output pictures buffered for writing the reconstruction file on a separate thread (0: synchronous writing)")
   ;
 
   po::setDefaults(opts);
@@ -153,6 +159,23 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
 #endif
 
   g_mctsDecCheckEnabled = m_mctsCheck;
+
+  if( m_numDecThreads < 1 )
+  {
+    msg( ERROR, "Number of decoding threads must be at least 1\n" );
+    return false;
+  }
+  if( m_loopFilterPipelineDepth < 0 )
+  {
+    msg( ERROR, "Loop filter pipeline depth must not be negative\n" );
+    return false;
+  }
+  if( m_outputQueueDepth < 0 )
+  {
+    msg( ERROR, "Output queue depth must not be negative\n" );
+    return false;
+  }
+
   // Chroma output bit-depth
   if( m_outputBitDepth[CHANNEL_TYPE_LUMA] != 0 && m_outputBitDepth[CHANNEL_TYPE_CHROMA] == 0 )
   {
@@ -239,6 +262,9 @@ DecAppCfg::DecAppCfg()
 , m_packedYUVMode(false)
 , m_statMode(0)
 , m_mctsCheck(false)
+, m_numDecThreads(1)
+, m_loopFilterPipelineDepth(0)
+, m_outputQueueDepth(2)
 {
   for (uint32_t channelTypeIndex = 0; channelTypeIndex < MAX_NUM_CHANNEL_TYPE; channelTypeIndex++)
   {
@@ -76,7 +76,11 @@ protected:
   bool          m_packedYUVMode;                      ///< If true, output 10-bit and 12-bit YUV data as 5-byte and 3-byte (respectively) packed YUV data
   std::string   m_cacheCfgFile;                       ///< Config file of cache model
   int           m_statMode;                           ///< Config statistic mode (0 - bit stat, 1 - tool stat, 3 - both)
+  std::string   m_stageTimingFileName;                ///< output file for the decoding stage times
   bool          m_mctsCheck;
+  int           m_numDecThreads;                      ///< number of threads used for decoding (wavefront parallel CTU rows)
+  int           m_loopFilterPipelineDepth;            ///< number of pictures filtered concurrently to the decoding of the following ones
+  int           m_outputQueueDepth;                   ///< number of output pictures buffered for the background YUV writer (0: synchronous writing)
 
 public:
   DecAppCfg();
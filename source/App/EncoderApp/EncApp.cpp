@@ -44,6 +44,8 @@
 
 #include "EncApp.h"
 #include "EncoderLib/AnnexBwrite.h"
+#include "DecoderLib/NALread.h"
+#include "DecoderLib/Parcat.h"
 #if EXTENSION_360_VIDEO
 #include "AppEncHelper360/TExt360AppEncTop.h"
 #endif
@@ -686,6 +688,7 @@ void EncApp::xInitLibCfg()
   m_cEncLib.setNumWppThreads                                     ( m_numWppThreads );
   m_cEncLib.setNumWppExtraLines                                  ( m_numWppExtraLines );
   m_cEncLib.setEnsureWppBitEqual                                 ( m_ensureWppBitEqual );
+  m_cEncLib.setNumFrameThreads                                   ( m_numFrameThreads );
 
 #endif
   m_cEncLib.setUseALF                                            ( m_alf );
@@ -769,6 +772,20 @@ void EncApp::encode()
   std::list<PelUnitBuf*> recBufList;
   // initialize internal class & member variables
   xInitLibCfg();
+
+  if( m_numSegments > 1 )
+  {
+    printChromaFormat();
+
+    xEncodeSegments();
+
+    m_bitstream.close();
+
+    printRateSummary();
+
+    return;
+  }
+
   xCreateLib( recBufList
              );
   xInitLib(m_isField);
@@ -878,6 +895,160 @@ void EncApp::encode()
 // Protected member functions
 // ====================================================================================================================
 
+/**
+ - split the input into segments of whole intra periods, neighbouring segments share the intra picture at their border
+ - encode the segments concurrently, each by an encoder instance configured like the one of the application
+ - concatenate the segment bitstreams like parcat, i.e. drop the leading IDR picture and the parameter sets of all
+   segments but the first one and continue the POCs
+ .
+ */
+void EncApp::xEncodeSegments()
+{
+  const int numIntraPeriods = std::max( 1, ( m_framesToBeEncoded - 1 + m_iIntraPeriod - 1 ) / m_iIntraPeriod );
+  const int segmentLength   = ( ( numIntraPeriods + m_numSegments - 1 ) / m_numSegments ) * m_iIntraPeriod;
+  const int numSegments     = std::max( 1, ( m_framesToBeEncoded - 1 + segmentLength - 1 ) / segmentLength );
+
+  if( !m_reconFileName.empty() )
+  {
+    msg( WARNING, "The reconstruction file is not written with segment-parallel encoding\n" );
+  }
+
+  std::vector<SegmentEncoder*> segments( numSegments );
+
+  for( int s = 0; s < numSegments; s++ )
+  {
+    SegmentEncoder& seg        = *( segments[s] = new SegmentEncoder );
+    const int       firstFrame = s * segmentLength;
+
+    seg.numFrames     = std::min( segmentLength, m_framesToBeEncoded - 1 - firstFrame ) + 1;
+    seg.numFramesRcvd = 0;
+
+    // same configuration as the encoder of the application, apart from the input frames
+    static_cast<EncCfg&>( seg.encLib ) = m_cEncLib;
+    seg.encLib.setFrameSkip         ( m_FrameSkip + firstFrame * m_temporalSubsampleRatio );
+    seg.encLib.setFramesToBeEncoded ( seg.numFrames );
+    seg.encLib.setdQPs              ( m_aidQP + firstFrame );
+
+    seg.inputFile.open( m_inputFileName, false, m_inputBitDepth, m_MSBExtendedBitDepth, m_internalBitDepth );  // read  mode
+    seg.inputFile.skipFrames( m_FrameSkip + firstFrame * m_temporalSubsampleRatio, m_iSourceWidth - m_aiPad[0], m_iSourceHeight - m_aiPad[1], m_InputChromaFormatIDC );
+
+    seg.encLib.create();
+
+    for( int i = 0; i < m_iGOPSize + 1; i++ )
+    {
+      seg.recBufList.push_back( new PelUnitBuf );
+    }
+
+    seg.encLib.init( false, &seg );
+  }
+
+  // the calling thread encodes a segment as well
+  ThreadPool threadPool;
+  threadPool.create( numSegments - 1 );
+  threadPool.runJobs( numSegments, [&]( int, int s ) { xEncodeSegment( *segments[s] ); } );
+  threadPool.destroy();
+
+  int pocBase    = 0;
+  int lastIdrPoc = 0;
+
+  for( int s = 0; s < numSegments; s++ )
+  {
+    const std::string bytes = segments[s]->bitstream.str();
+
+    if( bytes.empty() )
+    {
+      // the segment starts behind the end of the input file, so do all following ones
+      break;
+    }
+
+    const std::vector<uint8_t> annexB = filter_segment( std::vector<uint8_t>( bytes.begin(), bytes.end() ), s + 1, &pocBase, &lastIdrPoc );
+
+    m_bitstream.write( (const char*) annexB.data(), annexB.size() );
+    rateStatsAccum( annexB );
+
+    m_iFrameRcvd += segments[s]->numFramesRcvd - ( s > 0 ? 1 : 0 );
+  }
+
+  for( int s = 0; s < numSegments; s++ )
+  {
+    SegmentEncoder& seg = *segments[s];
+
+    if( seg.numFramesRcvd > 0 )
+    {
+      msg( DETAILS, "\nSegment %d (%d frames)\n", s, seg.numFramesRcvd );
+      seg.encLib.printSummary( false );
+    }
+
+    // delete used buffers in encoder class
+    seg.encLib.deletePicBuffer();
+
+    for( auto &p : seg.recBufList )
+    {
+      delete p;
+    }
+    seg.recBufList.clear();
+
+    seg.inputFile.close();
+    seg.encLib.destroy();
+
+    delete segments[s];
+  }
+}
+
+void EncApp::xEncodeSegment( SegmentEncoder& seg )
+{
+  const InputColourSpaceConversion ipCSC  =  m_inputColourSpaceConvert;
+  const InputColourSpaceConversion snrCSC = (!m_snrInternalColourSpace) ? m_inputColourSpaceConvert : IPCOLOURSPACE_UNCHANGED;
+
+  PelStorage trueOrgPic;
+  PelStorage orgPic;
+  UnitArea unitArea( m_chromaFormatIDC, Area( 0, 0, m_iSourceWidth, m_iSourceHeight ) );
+
+  orgPic.create( unitArea );
+  trueOrgPic.create( unitArea );
+
+  int   iNumEncoded = 0;
+  bool  bEos = false;
+
+  while( !bEos )
+  {
+    seg.inputFile.read( orgPic, trueOrgPic, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
+
+    seg.numFramesRcvd++;
+
+    bEos = seg.numFramesRcvd == seg.numFrames;
+
+    bool flush = false;
+    // if end of file (which is only detected on a read failure) flush the encoder of any queued pictures
+    if( seg.inputFile.isEof() )
+    {
+      flush = true;
+      bEos  = true;
+      seg.numFramesRcvd--;
+
+      if( seg.numFramesRcvd == 0 )
+      {
+        break;
+      }
+      seg.encLib.setFramesToBeEncoded( seg.numFramesRcvd );
+    }
+
+    // the reconstruction is not written, only the bitstream
+    seg.encLib.encode( bEos, flush ? 0 : &orgPic, flush ? 0 : &trueOrgPic, snrCSC, seg.recBufList, iNumEncoded );
+
+    // temporally skip frames
+    if( m_temporalSubsampleRatio > 1 )
+    {
+      seg.inputFile.skipFrames( m_temporalSubsampleRatio - 1, m_iSourceWidth - m_aiPad[0], m_iSourceHeight - m_aiPad[1], m_InputChromaFormatIDC );
+    }
+  }
+}
+
+void EncApp::SegmentEncoder::outputAU( const AccessUnit& au )
+{
+  writeAnnexB( bitstream, au );
+}
+
 /**
   Write access units to output file.
   \param bitstreamFile  target bitstream file
@@ -938,6 +1109,51 @@ void EncApp::outputAU( const AccessUnit& au )
 }
 
 
+static bool isEssentialNalUnit( const NalUnitType nalUnitType )
+{
+  switch (nalUnitType)
+  {
+#if !JVET_M0101_HLS
+  case NAL_UNIT_CODED_SLICE_TRAIL_R:
+  case NAL_UNIT_CODED_SLICE_TRAIL_N:
+  case NAL_UNIT_CODED_SLICE_TSA_R:
+  case NAL_UNIT_CODED_SLICE_TSA_N:
+  case NAL_UNIT_CODED_SLICE_STSA_R:
+  case NAL_UNIT_CODED_SLICE_STSA_N:
+  case NAL_UNIT_CODED_SLICE_BLA_W_LP:
+  case NAL_UNIT_CODED_SLICE_BLA_W_RADL:
+  case NAL_UNIT_CODED_SLICE_BLA_N_LP:
+  case NAL_UNIT_CODED_SLICE_IDR_W_RADL:
+  case NAL_UNIT_CODED_SLICE_IDR_N_LP:
+  case NAL_UNIT_CODED_SLICE_CRA:
+  case NAL_UNIT_CODED_SLICE_RADL_N:
+  case NAL_UNIT_CODED_SLICE_RADL_R:
+  case NAL_UNIT_CODED_SLICE_RASL_N:
+  case NAL_UNIT_CODED_SLICE_RASL_R:
+#else
+  case NAL_UNIT_CODED_SLICE_TRAIL:
+  case NAL_UNIT_CODED_SLICE_STSA:
+  case NAL_UNIT_CODED_SLICE_IDR_W_RADL:
+  case NAL_UNIT_CODED_SLICE_IDR_N_LP:
+  case NAL_UNIT_CODED_SLICE_CRA:
+  case NAL_UNIT_CODED_SLICE_RADL:
+  case NAL_UNIT_CODED_SLICE_RASL:
+#endif
+#if JVET_N0349_DPS
+  case NAL_UNIT_DPS:
+#endif
+#if HEVC_VPS || JVET_N0278_HLS
+  case NAL_UNIT_VPS:
+#endif
+  case NAL_UNIT_SPS:
+  case NAL_UNIT_PPS:
+  case NAL_UNIT_APS:
+    return true;
+  default:
+    return false;
+  }
+}
+
 /**
  *
  */
@@ -948,53 +1164,42 @@ void EncApp::rateStatsAccum(const AccessUnit& au, const std::vector<uint32_t>& a
 
   for (; it_au != au.end(); it_au++, it_stats++)
   {
-    switch ((*it_au)->m_nalUnitType)
+    if (isEssentialNalUnit((*it_au)->m_nalUnitType))
     {
-#if !JVET_M0101_HLS
-    case NAL_UNIT_CODED_SLICE_TRAIL_R:
-    case NAL_UNIT_CODED_SLICE_TRAIL_N:
-    case NAL_UNIT_CODED_SLICE_TSA_R:
-    case NAL_UNIT_CODED_SLICE_TSA_N:
-    case NAL_UNIT_CODED_SLICE_STSA_R:
-    case NAL_UNIT_CODED_SLICE_STSA_N:
-    case NAL_UNIT_CODED_SLICE_BLA_W_LP:
-    case NAL_UNIT_CODED_SLICE_BLA_W_RADL:
-    case NAL_UNIT_CODED_SLICE_BLA_N_LP:
-    case NAL_UNIT_CODED_SLICE_IDR_W_RADL:
-    case NAL_UNIT_CODED_SLICE_IDR_N_LP:
-    case NAL_UNIT_CODED_SLICE_CRA:
-    case NAL_UNIT_CODED_SLICE_RADL_N:
-    case NAL_UNIT_CODED_SLICE_RADL_R:
-    case NAL_UNIT_CODED_SLICE_RASL_N:
-    case NAL_UNIT_CODED_SLICE_RASL_R:
-#else
-    case NAL_UNIT_CODED_SLICE_TRAIL:
-    case NAL_UNIT_CODED_SLICE_STSA:
-    case NAL_UNIT_CODED_SLICE_IDR_W_RADL:
-    case NAL_UNIT_CODED_SLICE_IDR_N_LP:
-    case NAL_UNIT_CODED_SLICE_CRA:
-    case NAL_UNIT_CODED_SLICE_RADL:
-    case NAL_UNIT_CODED_SLICE_RASL:
-#endif
-#if JVET_N0349_DPS
-    case NAL_UNIT_DPS:
-#endif
-#if HEVC_VPS || JVET_N0278_HLS
-    case NAL_UNIT_VPS:
-#endif
-    case NAL_UNIT_SPS:
-    case NAL_UNIT_PPS:
-    case NAL_UNIT_APS:
       m_essentialBytes += *it_stats;
-      break;
-    default:
-      break;
     }
 
     m_totalBytes += *it_stats;
   }
 }
 
+/**
+ - accumulate the statistics of the NAL units of an Annex-B byte stream, counted including their start code prefix
+ */
+void EncApp::rateStatsAccum( const std::vector<uint8_t>& annexB )
+{
+  const uint8_t* p  = annexB.data();
+  int            sz = (int) annexB.size();
+  int            nalStart, nalEnd;
+
+  while( sz > 0 && find_nal_unit( p, sz, &nalStart, &nalEnd ) > 0 )
+  {
+    InputNALUnit nalu;
+    nalu.getBitstream().getFifo().assign( p + nalStart, p + nalEnd );
+    read( nalu );
+
+    if( isEssentialNalUnit( nalu.m_nalUnitType ) )
+    {
+      m_essentialBytes += nalEnd;
+    }
+
+    m_totalBytes += nalEnd;
+
+    p  += nalEnd;
+    sz -= nalEnd;
+  }
+}
+
 void EncApp::printRateSummary()
 {
   double time = (double) m_iFrameRcvd / m_iFrameRate * m_temporalSubsampleRatio;
@@ -40,6 +40,7 @@
 
 #include <list>
 #include <ostream>
+#include <sstream>
 
 #include "EncoderLib/EncLib.h"
 #include "Utilities/VideoIOYuv.h"
@@ -66,6 +67,22 @@ private:
   uint32_t              m_totalBytes;
   fstream           m_bitstream;
 
+  /// encoder instance of one segment of the input, see xEncodeSegments()
+  class SegmentEncoder : public AUWriterIf
+  {
+  public:
+    EncLib                 encLib;
+    VideoIOYuv             inputFile;
+    std::list<PelUnitBuf*> recBufList;
+    std::ostringstream     bitstream;             ///< Annex-B bitstream of the segment, filtered when concatenated
+    int                    numFrames;             ///< number of input frames covered by the segment
+    int                    numFramesRcvd;         ///< number of frames read from the input file
+
+    virtual ~SegmentEncoder() {}
+
+    void outputAU( const AccessUnit& au );
+  };
+
 private:
   // initialization
   void xCreateLib  ( std::list<PelUnitBuf*>& recBufList
@@ -74,10 +91,15 @@ private:
   void xInitLib    (bool isFieldCoding);         ///< initialize encoder class
   void xDestroyLib ();                           ///< destroy encoder class
 
+  // segment-parallel encoding
+  void xEncodeSegments ();                       ///< encode the segments concurrently and concatenate them
+  void xEncodeSegment  ( SegmentEncoder& seg );  ///< encode the frames of one segment
+
   // file I/O
   void xWriteOutput     ( int iNumEncoded, std::list<PelUnitBuf*>& recBufList
                          );                      ///< write bitstream to file
   void rateStatsAccum   ( const AccessUnit& au, const std::vector<uint32_t>& stats);
+  void rateStatsAccum   ( const std::vector<uint8_t>& annexB );
   void printRateSummary ();
   void printChromaFormat();
 
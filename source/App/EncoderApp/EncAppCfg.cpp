@@ -1436,13 +1436,12 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("NumSplitThreads",                                 m_numSplitThreads,                            1, "Number of threads used to parallelize splitting")
   ("ForceSingleSplitThread",                          m_forceSplitSequential,                   false, "Force single thread execution even if taking the parallelized path")
   ("NumWppThreads",                                   m_numWppThreads,                              1, "Number of threads used to run WPP-style parallelization")
+  ("WppThreads",                                      m_numWppThreads,                              1, "Number of threads encoding the CTU rows concurrently (same as NumWppThreads)")
   ("NumWppExtraLines",                                m_numWppExtraLines,                           0, "Number of additional wpp lines to switch when threads are blocked")
   ("DebugCTU",                                        m_debugCTU,                                  -1, "If DebugBitstream is present, load frames up to this POC from this bitstream. Starting with DebugPOC-frame at CTUline containin debug CTU.")
-#if ENABLE_WPP_PARALLELISM
-  ("EnsureWppBitEqual",                               m_ensureWppBitEqual,                       true, "Ensure the results are equal to results with WPP-style parallelism, even if WPP is off")
-#else
   ("EnsureWppBitEqual",                               m_ensureWppBitEqual,                      false, "Ensure the results are equal to results with WPP-style parallelism, even if WPP is off")
-#endif
+  ("FrameThreads",                                    m_numFrameThreads,                            1, "Number of mutually independent pictures of a temporal layer encoded concurrently")
+  ("Segments",                                        m_numSegments,                                1, "Number of intra period aligned segments of the input encoded concurrently and concatenated into one bitstream")
   ( "ALF",                                             m_alf,                                    true, "Adpative Loop Filter\n" )
     ;
 
@@ -2319,6 +2318,14 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   m_uiMaxCUWidth = m_uiMaxCUHeight = m_uiCTUSize;
   m_uiMaxCUDepth = m_uiMaxCodingDepth;
 
+#if ENABLE_WPP_PARALLELISM
+  if( m_numWppThreads > 1 )
+  {
+    // the CTU rows are encoded independently of the thread encoding them
+    m_ensureWppBitEqual = true;
+  }
+
+#endif
   // check validity of input parameters
   if( xCheckParameter() )
   {
@@ -2422,9 +2429,6 @@ bool EncAppCfg::xCheckParameter()
 #if ENABLE_SPLIT_PARALLELISM
   xConfirmPara( m_numSplitThreads < 1, "Number of used threads cannot be smaller than 1" );
   xConfirmPara( m_numSplitThreads > PARL_SPLIT_MAX_NUM_THREADS, "Number of used threads cannot be higher than the number of actual jobs" );
-#if _MSC_VER && ENABLE_WPP_PARALLELISM
-  xConfirmPara( m_numSplitThreads > 1 && m_numSplitThreads != NUM_SPLIT_THREADS_IF_MSVC, "Due to poor implementation by Microsoft, NumSplitThreads cannot be set dynamically on runtime!" );
-#endif
 #else
   xConfirmPara( m_numSplitThreads != 1, "ENABLE_SPLIT_PARALLELISM is disabled, numSplitThreads has to be 1" );
 #endif
@@ -2432,16 +2436,43 @@ bool EncAppCfg::xCheckParameter()
 #if ENABLE_WPP_PARALLELISM
   xConfirmPara( m_numWppThreads < 1, "Number of threads used for WPP-style parallelization cannot be smaller than 1" );
   xConfirmPara( m_numWppThreads > PARL_WPP_MAX_NUM_THREADS, "Number of threads used for WPP-style parallelization cannot be bigger than PARL_WPP_MAX_NUM_THREADS" );
-  xConfirmPara( !m_ensureWppBitEqual && m_numWppThreads > 1, "WPP bit equality is implied when using WPP-style parallelism" );
-#if ENABLE_WPP_STATIC_LINK
-  xConfirmPara( m_numWppExtraLines != 0, "WPP-style extra lines out of range" );
-#else
   xConfirmPara( m_numWppExtraLines < 0, "WPP-style extra lines out of range" );
-#endif
+  xConfirmPara( m_numWppThreads + m_numWppExtraLines > PARL_WPP_MAX_NUM_THREADS, "Number of threads and extra lines used for WPP-style parallelization cannot be bigger than PARL_WPP_MAX_NUM_THREADS" );
+  xConfirmPara( m_numWppThreads > 1 && m_RCEnableRateControl, "Rate control is not supported with WPP-style parallelization" );
+  xConfirmPara( m_numFrameThreads < 1, "Number of frame threads cannot be smaller than 1" );
+  xConfirmPara( m_numFrameThreads >= PARL_WPP_MAX_NUM_THREADS, "Number of frame threads has to be smaller than PARL_WPP_MAX_NUM_THREADS" );
+  if( m_numFrameThreads > 1 )
+  {
+    // each frame thread encodes a picture with a single encoder stack
+    xConfirmPara( m_numWppThreads > 1 || m_numWppExtraLines > 0, "Frame-parallel encoding cannot be combined with WPP-style parallelization" );
+    xConfirmPara( m_numSplitThreads > 1, "Frame-parallel encoding cannot be combined with split parallelization" );
+    xConfirmPara( m_RCEnableRateControl, "Rate control is not supported with frame-parallel encoding" );
+    xConfirmPara( m_isField, "Field coding is not supported with frame-parallel encoding" );
+    xConfirmPara( m_compositeRefEnabled, "Composite reference is not supported with frame-parallel encoding" );
+    xConfirmPara( m_encDbOpt, "Encoder deblocking optimization is not supported with frame-parallel encoding" );
+  }
 #else
   xConfirmPara( m_numWppThreads != 1, "ENABLE_WPP_PARALLELISM is disabled, numWppThreads has to be 1" );
   xConfirmPara( m_ensureWppBitEqual, "ENABLE_WPP_PARALLELISM is disabled, cannot ensure being WPP bit-equal" );
+  xConfirmPara( m_numFrameThreads != 1, "ENABLE_WPP_PARALLELISM is disabled, numFrameThreads has to be 1" );
+#endif
+  xConfirmPara( m_numSegments < 1, "Number of segments cannot be smaller than 1" );
+  if( m_numSegments > 1 )
+  {
+    // each segment is encoded by a separate encoder instance starting with an intra picture
+    xConfirmPara( m_iIntraPeriod <= 0, "Segment-parallel encoding requires a positive intra period" );
+    xConfirmPara( m_isField, "Field coding is not supported with segment-parallel encoding" );
+    xConfirmPara( m_compositeRefEnabled, "Composite reference is not supported with segment-parallel encoding" );
+    xConfirmPara( !m_decodeBitstreams[0].empty() || !m_decodeBitstreams[1].empty(), "Decoding bitstreams is not supported with segment-parallel encoding" );
+    xConfirmPara( m_switchPOC != -1, "Switching at a POC is not supported with segment-parallel encoding" );
+    xConfirmPara( m_fastForwardToPOC != -1, "Fast forwarding to a POC is not supported with segment-parallel encoding" );
+#if ENABLE_TRACING
+    xConfirmPara( true, "Segment-parallel encoding is not supported with tracing" );
+#endif
+#if EXTENSION_360_VIDEO
+    xConfirmPara( true, "Segment-parallel encoding is not supported with the 360 video extension" );
 #endif
+  }
 
 
 #if SHARP_LUMA_DELTA_QP && ENABLE_QPA
@@ -3956,6 +3987,8 @@ void EncAppCfg::xPrintParameter()
   }
   msg( VERBOSE, "NumWppThreads:%d+%d ", m_numWppThreads, m_numWppExtraLines );
   msg( VERBOSE, "EnsureWppBitEqual:%d ", m_ensureWppBitEqual );
+  msg( VERBOSE, "FrameThreads:%d ", m_numFrameThreads );
+  msg( VERBOSE, "Segments:%d ", m_numSegments );
 
 #if EXTENSION_360_VIDEO
   m_ext360.outputConfigurationSummary();
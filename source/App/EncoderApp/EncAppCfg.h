@@ -369,6 +369,8 @@ protected:
   int       m_numWppThreads;
   int       m_numWppExtraLines;
   bool      m_ensureWppBitEqual;
+  int       m_numFrameThreads;
+  int       m_numSegments;
 
 #if MAX_TB_SIZE_SIGNALLING
   int       m_log2MaxTbSize;
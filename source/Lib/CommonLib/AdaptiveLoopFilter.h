@@ -88,9 +88,14 @@ public:
   void reconstructCoeffAPSs(CodingStructure& cs, bool luma, bool chroma, bool isRdo);
   void reconstructCoeff(AlfSliceParam& alfSliceParam, ChannelType channel, const bool isRdo, const bool isRedo = false);
   void ALFProcess(CodingStructure& cs);
+  // CTU-row based processing: ALFCopyCtuRow has to store the SAO output of the rows above, below and of the row itself before ALFProcessCtuRow
+  bool ALFPrepare( CodingStructure& cs );   ///< returns false if ALF is disabled for the picture
+  void ALFCopyCtuRow( CodingStructure& cs, const int ctuRow );
+  void ALFProcessCtuRow( CodingStructure& cs, const int ctuRow );
 #else
   void reconstructCoeff(AlfSliceParam& alfSliceParam, ChannelType channel, const bool isRedo = false);
   void ALFProcess( CodingStructure& cs, AlfSliceParam& alfSliceParam );
+  void ALFProcessCtuRow( CodingStructure& cs, const int ctuRow, AlfSliceParam& alfSliceParam );
 #endif
   void create( const int picWidth, const int picHeight, const ChromaFormat format, const int maxCUWidth, const int maxCUHeight, const int maxCUDepth, const int inputBitDepth[MAX_NUM_CHANNEL_TYPE] );
   void destroy();
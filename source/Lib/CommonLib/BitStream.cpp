@@ -60,6 +60,34 @@ OutputBitstream::~OutputBitstream()
 }
 
 
+size_t findEmulationPreventionCore( const uint8_t* buf, size_t pos, size_t size )
+{
+  while( pos + 3 <= size )
+  {
+    if( buf[pos + 2] > 0x03 )
+    {
+      // none of the sequences starting at pos, pos + 1 or pos + 2 can match
+      pos += 3;
+    }
+    else if( buf[pos + 1] == 0x00 && buf[pos] == 0x00 )
+    {
+      return pos;
+    }
+    else
+    {
+      pos++;
+    }
+  }
+  return size < 2 || pos > size - 2 ? pos : size - 2;
+}
+
+BitstreamOps::BitstreamOps()
+{
+  findEmulationPrevention = findEmulationPreventionCore;
+}
+
+BitstreamOps g_bitstreamOps = BitstreamOps();
+
 InputBitstream::InputBitstream()
 : m_fifo()
 , m_emulationPreventionByteLocation()
@@ -238,7 +266,7 @@ int OutputBitstream::countStartCodeEmulations()
 void InputBitstream::pseudoRead ( uint32_t uiNumberOfBits, uint32_t& ruiBits )
 {
   uint32_t saved_num_held_bits = m_num_held_bits;
-  uint8_t saved_held_bits = m_held_bits;
+  uint64_t saved_held_bits = m_held_bits;
   uint32_t saved_fifo_idx = m_fifo_idx;
 
   uint32_t num_bits_to_read = min(uiNumberOfBits, getNumBitsLeft());
@@ -251,66 +279,80 @@ void InputBitstream::pseudoRead ( uint32_t uiNumberOfBits, uint32_t& ruiBits )
 }
 
 
+/**
+ * returns the 64 bits starting at byte byteIdx of the FIFO, the first
+ * byte in the MSBs. The bytes beyond the end of the FIFO are read as zero.
+ */
+uint64_t InputBitstream::xLoadWindow( uint32_t byteIdx ) const
+{
+  if( byteIdx + 8 <= m_fifo.size() )
+  {
+    const uint8_t* p = &m_fifo[byteIdx];
+    return ( uint64_t( p[0] ) << 56 ) | ( uint64_t( p[1] ) << 48 ) | ( uint64_t( p[2] ) << 40 ) | ( uint64_t( p[3] ) << 32 )
+         | ( uint64_t( p[4] ) << 24 ) | ( uint64_t( p[5] ) << 16 ) | ( uint64_t( p[6] ) <<  8 ) |   uint64_t( p[7] );
+  }
+  uint64_t window = 0;
+  for( uint32_t i = byteIdx; i < byteIdx + 8; i++ )
+  {
+    window = ( window << 8 ) | ( i < m_fifo.size() ? m_fifo[i] : 0 );
+  }
+  return window;
+}
+
+/**
+ * appends as many whole bytes of the FIFO to the held bits as fit.
+ * The bits of the next byte that are loaded below them are the same bits
+ * the next refill loads, so the refill does not need to mask them.
+ */
+void InputBitstream::xRefill()
+{
+  const uint32_t numBytes = std::min<uint32_t>( ( 64 - m_num_held_bits ) >> 3, uint32_t( m_fifo.size() ) - m_fifo_idx );
+  m_held_bits     |= xLoadWindow( m_fifo_idx ) >> m_num_held_bits;
+  m_fifo_idx      += numBytes;
+  m_num_held_bits += numBytes << 3;
+}
+
 void InputBitstream::read (uint32_t uiNumberOfBits, uint32_t& ruiBits)
 {
   CHECK( uiNumberOfBits > 32, "Too many bits read" );
 
   m_numBitsRead += uiNumberOfBits;
 
-  /* NB, bits are extracted from the MSB of each byte. */
-  uint32_t retval = 0;
-  if (uiNumberOfBits <= m_num_held_bits)
+  if( uiNumberOfBits == 0 )
   {
-    /* n=1, len(H)=7:   -VHH HHHH, shift_down=6, mask=0xfe
-     * n=3, len(H)=7:   -VVV HHHH, shift_down=4, mask=0xf8
-     */
-    retval = m_held_bits >> (m_num_held_bits - uiNumberOfBits);
-    retval &= ~(0xff << uiNumberOfBits);
-    m_num_held_bits -= uiNumberOfBits;
-    ruiBits = retval;
+    ruiBits = 0;
     return;
   }
 
-  /* all num_held_bits will go into retval
-   *   => need to mask leftover bits from previous extractions
-   *   => align retval with top of extracted word */
-  /* n=5, len(H)=3: ---- -VVV, mask=0x07, shift_up=5-3=2,
-   * n=9, len(H)=3: ---- -VVV, mask=0x07, shift_up=9-3=6 */
-  uiNumberOfBits -= m_num_held_bits;
-  retval = m_held_bits & ~(0xff << m_num_held_bits);
-  retval <<= uiNumberOfBits;
-
-  /* number of whole bytes that need to be loaded to form retval */
-  /* n=32, len(H)=0, load 4bytes, shift_down=0
-   * n=32, len(H)=1, load 4bytes, shift_down=1
-   * n=31, len(H)=1, load 4bytes, shift_down=1+1
-   * n=8,  len(H)=0, load 1byte,  shift_down=0
-   * n=8,  len(H)=3, load 1byte,  shift_down=3
-   * n=5,  len(H)=1, load 1byte,  shift_down=1+3
-   */
-  uint32_t aligned_word = 0;
-  uint32_t num_bytes_to_load = (uiNumberOfBits - 1) >> 3;
-  CHECK(m_fifo_idx + num_bytes_to_load >= m_fifo.size(), "Exceeded FIFO size");
-
-  switch (num_bytes_to_load)
+  /* NB, bits are extracted from the MSB of each byte.
+   * The held bits are refilled with up to 8 bytes at once. */
+  if( m_num_held_bits < uiNumberOfBits )
   {
-  case 3: aligned_word  = m_fifo[m_fifo_idx++] << 24;
-  case 2: aligned_word |= m_fifo[m_fifo_idx++] << 16;
-  case 1: aligned_word |= m_fifo[m_fifo_idx++] <<  8;
-  case 0: aligned_word |= m_fifo[m_fifo_idx++];
+    xRefill();
+    CHECK( m_num_held_bits < uiNumberOfBits, "Exceeded FIFO size" );
   }
 
-  /* resolve remainder bits */
-  uint32_t next_num_held_bits = (32 - uiNumberOfBits) % 8;
-
-  /* copy required part of aligned_word into retval */
-  retval |= aligned_word >> next_num_held_bits;
-
-  /* store held bits */
-  m_num_held_bits = next_num_held_bits;
-  m_held_bits = aligned_word;
+  ruiBits          = uint32_t( m_held_bits >> ( 64 - uiNumberOfBits ) );
+  m_held_bits    <<= uiNumberOfBits;
+  m_num_held_bits -= uiNumberOfBits;
+}
 
-  ruiBits = retval;
+uint32_t InputBitstream::readExpGolombPrefix()
+{
+  if( m_num_held_bits < 32 )
+  {
+    xRefill();
+  }
+  // the bits beyond the end of the FIFO are zero
+  const uint32_t prefix = uint32_t( m_held_bits >> 32 );
+  CHECK( prefix == 0, "Exp-Golomb code with more than 31 leading zero bits" );
+
+  const uint32_t numBits = 32 - floorLog2( prefix );
+  CHECK( m_num_held_bits < numBits, "Exceeded FIFO size" );
+  m_held_bits    <<= numBits;
+  m_num_held_bits -= numBits;
+  m_numBitsRead   += numBits;
+  return numBits - 1;
 }
 
 /**
@@ -362,6 +404,8 @@ InputBitstream *InputBitstream::extractSubstream( uint32_t uiNumBits )
   std::vector<uint8_t> &buf = pResult->getFifo();
   buf.reserve((uiNumBits+7)>>3);
 
+  xReturnHeldBytes();
+
   if (m_num_held_bits == 0)
   {
     std::size_t currentOutputBufferSize=buf.size();
@@ -140,6 +140,29 @@ public:
   int countStartCodeEmulations();
 };
 
+/**
+ * Returns the position of the first two zero bytes followed by a byte
+ * not larger than 0x03 at or after pos, i.e. the next emulation prevention
+ * byte or invalid byte sequence. If there is none, the position of the
+ * last two bytes (but at least pos) is returned.
+ */
+size_t findEmulationPreventionCore( const uint8_t* buf, size_t pos, size_t size );
+
+struct BitstreamOps
+{
+  BitstreamOps();
+
+#if ENABLE_SIMD_OPT_BITSTREAM && defined(TARGET_SIMD_X86)
+  void initBitstreamOpsX86();
+  template<X86_VEXT vext>
+  void _initBitstreamOpsX86();
+#endif
+
+  size_t ( *findEmulationPrevention ) ( const uint8_t* buf, size_t pos, size_t size );
+};
+
+extern BitstreamOps g_bitstreamOps;
+
 /**
  * Model of an input bitstream that extracts bits from a predefined
  * bytestream.
@@ -150,12 +173,22 @@ protected:
   std::vector<uint8_t> m_fifo; /// FIFO for storage of complete bytes
   std::vector<uint32_t>    m_emulationPreventionByteLocation;
 
-  uint32_t m_fifo_idx; /// Read index into m_fifo
+  uint32_t m_fifo_idx; /// Read index into m_fifo, the bytes before it are read or held
 
-  uint32_t m_num_held_bits;
-  uint8_t m_held_bits;
+  uint32_t m_num_held_bits; /// number of bits in m_held_bits, up to 64
+  uint64_t m_held_bits;     /// bits read ahead from m_fifo, the next bit is the MSB
   uint32_t  m_numBitsRead;
 
+  uint64_t    xLoadWindow     ( uint32_t byteIdx ) const;
+  void        xRefill         ();
+  /// returns the whole bytes held to the FIFO, used before byte-wise access
+  void        xReturnHeldBytes()
+  {
+    m_fifo_idx      -= m_num_held_bits >> 3;
+    m_num_held_bits &= 7;
+    m_held_bits     &= ~( ~uint64_t( 0 ) >> m_num_held_bits );
+  }
+
 public:
   /**
    * Create a new bitstream reader object that reads from buf.
@@ -169,8 +202,11 @@ public:
   // interface for decoding
   void        pseudoRead      ( uint32_t uiNumberOfBits, uint32_t& ruiBits );
   void        read            ( uint32_t uiNumberOfBits, uint32_t& ruiBits );
+  /// reads the leading zero bits and the following one bit of an Exp-Golomb code, returns the number of zero bits
+  uint32_t    readExpGolombPrefix();
   void        readByte        ( uint32_t &ruiBits )
   {
+    xReturnHeldBytes();
     CHECK( m_fifo_idx >= m_fifo.size(), "FIFO exceeded" );
     ruiBits = m_fifo[m_fifo_idx++];
 #if ENABLE_TRACING
@@ -180,14 +216,56 @@ public:
 
   void        peekPreviousByte( uint32_t &byte )
   {
+    xReturnHeldBytes();
     CHECK( m_fifo_idx == 0, "FIFO empty" );
     byte = m_fifo[m_fifo_idx - 1];
   }
 
+  /// reads four bytes MSB first, the bytes beyond the end of the FIFO are read as zero, returns the number of these padding bytes
+  uint32_t    readWordPadded  ( uint32_t &ruiBits )
+  {
+    xReturnHeldBytes();
+    if( m_fifo_idx + 4 <= m_fifo.size() )
+    {
+      const uint8_t* p = &m_fifo[m_fifo_idx];
+      ruiBits     = ( uint32_t( p[0] ) << 24 ) | ( uint32_t( p[1] ) << 16 ) | ( uint32_t( p[2] ) << 8 ) | uint32_t( p[3] );
+      m_fifo_idx += 4;
+#if ENABLE_TRACING
+      m_numBitsRead += 32;
+#endif
+      return 0;
+    }
+    uint32_t numPadBytes = 0;
+    ruiBits = 0;
+    for( int i = 0; i < 4; i++ )
+    {
+      ruiBits <<= 8;
+      if( m_fifo_idx < m_fifo.size() )
+      {
+        ruiBits |= readByte();
+      }
+      else
+      {
+        numPadBytes++;
+      }
+    }
+    return numPadBytes;
+  }
+
+  /// moves the read position back by whole bytes, used to return bytes read ahead
+  void        unreadBytes     ( uint32_t numBytes )
+  {
+    xReturnHeldBytes();
+    CHECK( numBytes > m_fifo_idx, "FIFO empty" );
+    m_fifo_idx -= numBytes;
+#if ENABLE_TRACING
+    m_numBitsRead -= 8 * numBytes;
+#endif
+  }
+
   uint32_t        readOutTrailingBits ();
-  uint8_t getHeldBits  ()          { return m_held_bits;          }
   OutputBitstream& operator= (const OutputBitstream& src);
-  uint32_t  getByteLocation              ( )                     { return m_fifo_idx                    ; }
+  uint32_t  getByteLocation              ( )                     { return m_fifo_idx - ( m_num_held_bits >> 3 ); }
 
   // Peek at bits in word-storage. Used in determining if we have completed reading of current bitstream and therefore slice in LCEC.
   uint32_t        peekBits (uint32_t uiBits) { uint32_t tmp; pseudoRead(uiBits, tmp); return tmp; }
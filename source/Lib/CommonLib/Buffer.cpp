@@ -264,6 +264,59 @@ void linTfCore( const T* src, int srcStride, Pel *dst, int dstStride, int width,
 #undef LINTF_CORE_INC
 }
 
+void applyLutCore( Pel* ptr, int ptrStride, int width, int height, const Pel* lut, int lutSize )
+{
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      ptr[x] = lut[ptr[x]];
+    }
+    ptr += ptrStride;
+  }
+}
+
+void scaleSignalCore( Pel* ptr, int ptrStride, int width, int height, int scale, bool dir, const ClpRng& clpRng )
+{
+  int sign, absval;
+  int maxAbsclipBD = (1<<clpRng.bd) - 1;
+
+  if (dir) // forward
+  {
+    for (unsigned y = 0; y < height; y++)
+    {
+      for (unsigned x = 0; x < width; x++)
+      {
+        sign = ptr[x] >= 0 ? 1 : -1;
+        absval = sign * ptr[x];
+        ptr[x] = (Pel)Clip3(-maxAbsclipBD, maxAbsclipBD, sign * (((absval << CSCALE_FP_PREC) + (scale >> 1)) / scale));
+      }
+      ptr += ptrStride;
+    }
+  }
+  else // inverse
+  {
+    for (unsigned y = 0; y < height; y++)
+    {
+      for (unsigned x = 0; x < width; x++)
+      {
+#if JVET_N0220_LMCS_SIMPLIFICATION
+        ptr[x] = (Pel)Clip3((Pel)(-maxAbsclipBD - 1), (Pel)maxAbsclipBD, ptr[x]);
+#endif
+        sign = ptr[x] >= 0 ? 1 : -1;
+        absval = sign * ptr[x];
+        int val = sign * ((absval * scale + (1 << (CSCALE_FP_PREC - 1))) >> CSCALE_FP_PREC);
+        if (sizeof(Pel) == 2) // avoid overflow when storing data
+        {
+           val = Clip3<int>(-32768, 32767, val);
+        }
+        ptr[x] = (Pel)val;
+      }
+      ptr += ptrStride;
+    }
+  }
+}
+
 PelBufferOps::PelBufferOps()
 {
   addAvg4 = addAvgCore<Pel>;
@@ -282,6 +335,9 @@ PelBufferOps::PelBufferOps()
 
   copyBuffer = copyBufferCore;
   padding = paddingCore;
+
+  applyLut    = applyLutCore;
+  scaleSignal = scaleSignalCore;
 #if ENABLE_SIMD_OPT_GBI
   removeWeightHighFreq8 = removeWeightHighFreq;
   removeWeightHighFreq4 = removeWeightHighFreq;
@@ -360,70 +416,18 @@ void AreaBuf<Pel>::addWeightedAvg(const AreaBuf<const Pel> &other1, const AreaBu
 template<>
 void AreaBuf<Pel>::rspSignal(std::vector<Pel>& pLUT)
 {
-  Pel* dst = buf;
-  Pel* src = buf;
-    for (unsigned y = 0; y < height; y++)
-    {
-      for (unsigned x = 0; x < width; x++)
-      {
-        dst[x] = pLUT[src[x]];
-      }
-      dst += stride;
-      src += stride;
-    }
+  g_pelBufOP.applyLut( buf, stride, width, height, pLUT.data(), ( int ) pLUT.size() );
 }
 
 template<>
 void AreaBuf<Pel>::scaleSignal(const int scale, const bool dir, const ClpRng& clpRng)
 {
-  Pel* dst = buf;
-  Pel* src = buf;
-  int sign, absval;
-  int maxAbsclipBD = (1<<clpRng.bd) - 1;
-
-  if (dir) // forward
+  if (dir && width == 1)
   {
-    if (width == 1)
-    {
-      THROW("Blocks of width = 1 not supported");
-    }
-    else
-    {
-      for (unsigned y = 0; y < height; y++)
-      {
-        for (unsigned x = 0; x < width; x++)
-        {
-          sign = src[x] >= 0 ? 1 : -1;
-          absval = sign * src[x];
-          dst[x] = (Pel)Clip3(-maxAbsclipBD, maxAbsclipBD, sign * (((absval << CSCALE_FP_PREC) + (scale >> 1)) / scale));
-        }
-        dst += stride;
-        src += stride;
-      }
-    }
-  }
-  else // inverse
-  {
-    for (unsigned y = 0; y < height; y++)
-    {
-      for (unsigned x = 0; x < width; x++)
-      {
-#if JVET_N0220_LMCS_SIMPLIFICATION
-        src[x] = (Pel)Clip3((Pel)(-maxAbsclipBD - 1), (Pel)maxAbsclipBD, src[x]);
-#endif
-        sign = src[x] >= 0 ? 1 : -1;
-        absval = sign * src[x];
-        int val = sign * ((absval * scale + (1 << (CSCALE_FP_PREC - 1))) >> CSCALE_FP_PREC);
-        if (sizeof(Pel) == 2) // avoid overflow when storing data
-        {
-           val = Clip3<int>(-32768, 32767, val);
-        }
-        dst[x] = (Pel)val;
-      }
-      dst += stride;
-      src += stride;
-    }
+    THROW("Blocks of width = 1 not supported");
   }
+
+  g_pelBufOP.scaleSignal( buf, stride, width, height, scale, dir, clpRng );
 }
 
 template<>
@@ -576,7 +580,15 @@ void AreaBuf<Pel>::reconstruct( const AreaBuf<const Pel> &pred, const AreaBuf<co
 template<>
 void AreaBuf<Pel>::linearTransform( const int scale, const int shift, const int offset, bool bClip, const ClpRng& clpRng )
 {
-  const Pel* src = buf;
+  linearTransform( AreaBuf<const Pel>( buf, stride, *this ), scale, shift, offset, bClip, clpRng );
+}
+
+template<>
+void AreaBuf<Pel>::linearTransform( const AreaBuf<const Pel> &other, const int scale, const int shift, const int offset, bool bClip, const ClpRng& clpRng )
+{
+  CHECK( width != other.width || height != other.height, "Incompatible size" );
+
+  const Pel* src = other.buf;
         Pel* dst = buf;
 
   if( width == 1 )
@@ -586,18 +598,18 @@ void AreaBuf<Pel>::linearTransform( const int scale, const int shift, const int
 #if ENABLE_SIMD_OPT_BUFFER && defined(TARGET_SIMD_X86)
   else if( ( width & 7 ) == 0 )
   {
-    g_pelBufOP.linTf8( src, stride, dst, stride, width, height, scale, shift, offset, clpRng, bClip );
+    g_pelBufOP.linTf8( src, other.stride, dst, stride, width, height, scale, shift, offset, clpRng, bClip );
   }
   else if( ( width & 3 ) == 0 )
   {
-    g_pelBufOP.linTf4( src, stride, dst, stride, width, height, scale, shift, offset, clpRng, bClip );
+    g_pelBufOP.linTf4( src, other.stride, dst, stride, width, height, scale, shift, offset, clpRng, bClip );
   }
 #endif
   else
   {
 #define LINTF_OP( ADDR ) dst[ADDR] = ( Pel ) bClip ? ClipPel( rightShift( scale * src[ADDR], shift ) + offset, clpRng ) : ( rightShift( scale * src[ADDR], shift ) + offset )
 #define LINTF_INC        \
-    src += stride;       \
+    src += other.stride; \
     dst += stride;       \
 
     SIZE_AWARE_PER_EL_OP( LINTF_OP, LINTF_INC );
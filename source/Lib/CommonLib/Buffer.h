@@ -73,6 +73,8 @@ struct PelBufferOps
   void(*calcBlkGradient)(int sx, int sy, int    *arraysGx2, int     *arraysGxGy, int     *arraysGxdI, int     *arraysGy2, int     *arraysGydI, int     &sGx2, int     &sGy2, int     &sGxGy, int     &sGxdI, int     &sGydI, int width, int height, int unitSize);
   void(*copyBuffer)(Pel *src, int srcStride, Pel *dst, int dstStride, int width, int height);
   void(*padding)(Pel *dst, int stride, int width, int height, int padSize);
+  void ( *applyLut )      ( Pel* ptr, int ptrStride, int width, int height, const Pel* lut, int lutSize );
+  void ( *scaleSignal )   ( Pel* ptr, int ptrStride, int width, int height, int scale, bool dir, const ClpRng& clpRng );
 #if ENABLE_SIMD_OPT_GBI
   void ( *removeWeightHighFreq8)  ( Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height, int shift, int gbiWeight);
   void ( *removeWeightHighFreq4)  ( Pel* src0, int src0Stride, const Pel* src1, int src1Stride, int width, int height, int shift, int gbiWeight);
@@ -85,6 +87,8 @@ extern PelBufferOps g_pelBufOP;
 
 void paddingCore(Pel *ptr, int stride, int width, int height, int padSize);
 void copyBufferCore(Pel *src, int srcStride, Pel *Dst, int dstStride, int width, int height);
+void applyLutCore(Pel *ptr, int ptrStride, int width, int height, const Pel *lut, int lutSize);
+void scaleSignalCore(Pel *ptr, int ptrStride, int width, int height, int scale, bool dir, const ClpRng& clpRng);
 
 template<typename T>
 struct AreaBuf : public Size
@@ -117,6 +121,7 @@ struct AreaBuf : public Size
 #endif
   void extendSingleBorderPel();
   void extendBorderPel      (  unsigned margin );
+  void extendBorderPel      (  unsigned margin, bool top, bool bottom );
   void addWeightedAvg       ( const AreaBuf<const T> &other1, const AreaBuf<const T> &other2, const ClpRng& clpRng, const int8_t gbiIdx);
   void removeWeightHighFreq ( const AreaBuf<T>& other, const bool bClip, const ClpRng& clpRng, const int8_t iGbiWeight);
   void addAvg               ( const AreaBuf<const T> &other1, const AreaBuf<const T> &other2, const ClpRng& clpRng );
@@ -127,6 +132,7 @@ struct AreaBuf : public Size
   void subtract             ( const T val );
 
   void linearTransform      ( const int scale, const int shift, const int offset, bool bClip, const ClpRng& clpRng );
+  void linearTransform      ( const AreaBuf<const T> &src, const int scale, const int shift, const int offset, bool bClip, const ClpRng& clpRng );
 
   void transposedFrom       ( const AreaBuf<const T> &other );
 
@@ -440,6 +446,15 @@ void AreaBuf<T>::linearTransform( const int scale, const int shift, const int of
 template<>
 void AreaBuf<Pel>::linearTransform( const int scale, const int shift, const int offset, bool bClip, const ClpRng& clpRng );
 
+template<typename T>
+void AreaBuf<T>::linearTransform( const AreaBuf<const T> &src, const int scale, const int shift, const int offset, bool bClip, const ClpRng& clpRng )
+{
+  THROW( "Type not supported" );
+}
+
+template<>
+void AreaBuf<Pel>::linearTransform( const AreaBuf<const Pel> &src, const int scale, const int shift, const int offset, bool bClip, const ClpRng& clpRng );
+
 template<typename T>
 void AreaBuf<T>::toLast( const ClpRng& clpRng )
 {
@@ -565,6 +580,12 @@ void AreaBuf<T>::updateHistogram( std::vector<int32_t>& hist ) const
 
 template<typename T>
 void AreaBuf<T>::extendBorderPel( unsigned margin )
+{
+  extendBorderPel( margin, true, true );
+}
+
+template<typename T>
+void AreaBuf<T>::extendBorderPel( unsigned margin, bool top, bool bottom )
 {
   T*  p = buf;
   int h = height;
@@ -586,17 +607,23 @@ void AreaBuf<T>::extendBorderPel( unsigned margin )
   // p is now the (0,height) (bottom left of image within bigger picture
   p -= ( s + margin );
   // p is now the (-margin, height-1)
-  for( int y = 0; y < margin; y++ )
+  if( bottom )
   {
-    ::memcpy( p + ( y + 1 ) * s, p, sizeof( T ) * ( w + ( margin << 1 ) ) );
+    for( int y = 0; y < margin; y++ )
+    {
+      ::memcpy( p + ( y + 1 ) * s, p, sizeof( T ) * ( w + ( margin << 1 ) ) );
+    }
   }
 
   // pi is still (-marginX, height-1)
   p -= ( ( h - 1 ) * s );
   // pi is now (-marginX, 0)
-  for( int y = 0; y < margin; y++ )
+  if( top )
   {
-    ::memcpy( p - ( y + 1 ) * s, p, sizeof( T ) * ( w + ( margin << 1 ) ) );
+    for( int y = 0; y < margin; y++ )
+    {
+      ::memcpy( p - ( y + 1 ) * s, p, sizeof( T ) * ( w + ( margin << 1 ) ) );
+    }
   }
 }
 
@@ -731,6 +758,7 @@ struct UnitBuf
   void addAvg               ( const UnitBuf<const T> &other1, const UnitBuf<const T> &other2, const ClpRngs& clpRngs, const bool chromaOnly = false, const bool lumaOnly = false);
   void extendSingleBorderPel();
   void extendBorderPel      ( unsigned margin );
+  void extendBorderPel      ( unsigned margin, bool top, bool bottom );
   void removeHighFreq       ( const UnitBuf<T>& other, const bool bClip, const ClpRngs& clpRngs
                             , const int8_t gbiWeight = g_GbiWeights[GBI_DEFAULT]
                             );
@@ -848,6 +876,15 @@ void UnitBuf<T>::extendBorderPel( unsigned margin )
   }
 }
 
+template<typename T>
+void UnitBuf<T>::extendBorderPel( unsigned margin, bool top, bool bottom )
+{
+  for( unsigned i = 0; i < bufs.size(); i++ )
+  {
+    bufs[i].extendBorderPel( margin, top, bottom );
+  }
+}
+
 template<typename T>
 void UnitBuf<T>::removeHighFreq( const UnitBuf<T>& other, const bool bClip, const ClpRngs& clpRngs
                                , const int8_t gbiWeight
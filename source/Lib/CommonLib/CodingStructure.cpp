@@ -67,6 +67,8 @@ CodingStructure::CodingStructure(CUCache& cuCache, PUCache& puCache, TUCache& tu
   , m_cuCache ( cuCache )
   , m_puCache ( puCache )
   , m_tuCache ( tuCache )
+  , m_ctuParallel        ( false )
+  , m_ctuLanesIndependent( false )
 {
   for( uint32_t i = 0; i < MAX_NUM_COMPONENT; i++ )
   {
@@ -272,32 +274,33 @@ TransformUnit* CodingStructure::getTU( const Position &pos, const ChannelType ef
 
     if( idx != 0 )
     {
-      unsigned extraIdx = 0;
+      TransformUnit* tu = tus[idx - 1];
       if( isLuma( effChType ) )
       {
-        const TransformUnit& tu = *tus[idx - 1];
-
-        if( tu.cu->ispMode ) // Intra SubPartitions mode
+        if( tu->cu->ispMode ) // Intra SubPartitions mode
         {
-          //we obtain the offset to index the corresponding sub-partition
+          //we obtain the corresponding sub-partition, the sub-partitions of a CU are linked in coding order
           if( subTuIdx != -1 )
           {
-            extraIdx = subTuIdx;
+            for( int i = 0; i < subTuIdx; i++ )
+            {
+              tu = tu->next;
+            }
           }
           else
           {
 #if JVET_N0473_DEBLOCK_INTERNAL_TRANSFORM_BOUNDARIES
-            while( !tus[idx - 1 + extraIdx]->blocks[getFirstComponentOfChannel( effChType )].contains( pos ) )
+            while( !tu->blocks[getFirstComponentOfChannel( effChType )].contains( pos ) )
 #else
-            while( pos != tus[idx - 1 + extraIdx]->blocks[getFirstComponentOfChannel( effChType )].pos() )
+            while( pos != tu->blocks[getFirstComponentOfChannel( effChType )].pos() )
 #endif
             {
-              extraIdx++;
+              tu = tu->next;
             }
           }
         }
       }
-      return tus[idx - 1 + extraIdx];
+      return tu;
     }
     else if( m_isTuEnc ) return parent->getTU( pos, effChType );
     else                 return nullptr;
@@ -318,27 +321,29 @@ const TransformUnit * CodingStructure::getTU( const Position &pos, const Channel
     const unsigned idx = m_tuIdx[effChType][rsAddr( pos, _blk.pos(), _blk.width, unitScale[effChType] )];
     if( idx != 0 )
     {
-      unsigned extraIdx = 0;
+      const TransformUnit* tu = tus[idx - 1];
       if( isLuma( effChType ) )
       {
-        const TransformUnit& tu = *tus[idx - 1];
-        if( tu.cu->ispMode ) // Intra SubPartitions mode
+        if( tu->cu->ispMode ) // Intra SubPartitions mode
         {
-          //we obtain the offset to index the corresponding sub-partition
+          //we obtain the corresponding sub-partition, the sub-partitions of a CU are linked in coding order
           if( subTuIdx != -1 )
           {
-            extraIdx = subTuIdx;
+            for( int i = 0; i < subTuIdx; i++ )
+            {
+              tu = tu->next;
+            }
           }
           else
           {
-            while( pos != tus[idx - 1 + extraIdx]->blocks[effChType].pos() )
+            while( pos != tu->blocks[effChType].pos() )
             {
-              extraIdx++;
+              tu = tu->next;
             }
           }
         }
       }
-      return tus[idx - 1 + extraIdx];
+      return tu;
     }
     else if( m_isTuEnc ) return parent->getTU( pos, effChType );
     else                 return nullptr;
@@ -347,6 +352,13 @@ const TransformUnit * CodingStructure::getTU( const Position &pos, const Channel
 
 CodingUnit& CodingStructure::addCU( const UnitArea &unit, const ChannelType chType )
 {
+  std::unique_lock<std::mutex> lock( m_unitMutex, std::defer_lock );
+  if( m_ctuParallel )
+  {
+    lock.lock();
+    CHECK( cus.size() == cus.capacity(), "Unit vectors must not be reallocated while CTUs are processed concurrently" );
+  }
+
   CodingUnit *cu = m_cuCache.get();
 
   cu->UnitArea::operator=( unit );
@@ -362,6 +374,20 @@ CodingUnit& CodingStructure::addCU( const UnitArea &unit, const ChannelType chTy
 
   CodingUnit *prevCU = m_numCUs > 0 ? cus.back() : nullptr;
 
+  if( m_ctuParallel )
+  {
+    // link the CUs in decoding order of the lane, the lanes are chained in finishCtuParallelism()
+    const int lane = getCtuLane( unit.blocks[chType].lumaPos() );
+    CHECK( lane < 0, "CU outside of the concurrently processed CTUs" );
+
+    prevCU = m_laneLastCU[lane];
+    m_laneLastCU[lane] = cu;
+    if( !m_laneFirstCU[lane] )
+    {
+      m_laneFirstCU[lane] = cu;
+    }
+  }
+
   if( prevCU )
   {
     prevCU->next = cu;
@@ -401,6 +427,13 @@ CodingUnit& CodingStructure::addCU( const UnitArea &unit, const ChannelType chTy
 
 PredictionUnit& CodingStructure::addPU( const UnitArea &unit, const ChannelType chType )
 {
+  std::unique_lock<std::mutex> lock( m_unitMutex, std::defer_lock );
+  if( m_ctuParallel )
+  {
+    lock.lock();
+    CHECK( pus.size() == pus.capacity(), "Unit vectors must not be reallocated while CTUs are processed concurrently" );
+  }
+
   PredictionUnit *pu = m_puCache.get();
 
   pu->UnitArea::operator=( unit );
@@ -415,7 +448,7 @@ PredictionUnit& CodingStructure::addPU( const UnitArea &unit, const ChannelType
   CHECK( pu->cu->firstPU != nullptr, "Without an RQT the firstPU should be null" );
 #endif
 
-  PredictionUnit *prevPU = m_numPUs > 0 ? pus.back() : nullptr;
+  PredictionUnit *prevPU = m_ctuParallel ? pu->cu->lastPU : ( m_numPUs > 0 ? pus.back() : nullptr );
 
   if( prevPU && prevPU->cu == pu->cu )
   {
@@ -461,6 +494,13 @@ PredictionUnit& CodingStructure::addPU( const UnitArea &unit, const ChannelType
 
 TransformUnit& CodingStructure::addTU( const UnitArea &unit, const ChannelType chType )
 {
+  std::unique_lock<std::mutex> lock( m_unitMutex, std::defer_lock );
+  if( m_ctuParallel )
+  {
+    lock.lock();
+    CHECK( tus.size() == tus.capacity(), "Unit vectors must not be reallocated while CTUs are processed concurrently" );
+  }
+
   TransformUnit *tu = m_tuCache.get();
 
   tu->UnitArea::operator=( unit );
@@ -477,7 +517,7 @@ TransformUnit& CodingStructure::addTU( const UnitArea &unit, const ChannelType c
 #endif
 
 
-  TransformUnit *prevTU = m_numTUs > 0 ? tus.back() : nullptr;
+  TransformUnit *prevTU = m_ctuParallel ? tu->cu->lastTU : ( m_numTUs > 0 ? tus.back() : nullptr );
 
   if( prevTU && prevTU->cu == tu->cu )
   {
@@ -623,6 +663,93 @@ void CodingStructure::allocateVectorsAtPicLevel()
   tus.reserve( allocSize );
 }
 
+void CodingStructure::startCtuRowParallelism( const int firstCtuRow, const int numCtuRows )
+{
+  m_ctuLanes.assign( pcv->sizeInCtus, -1 );
+  for( int ctuRow = 0; ctuRow < numCtuRows; ctuRow++ )
+  {
+    std::fill_n( m_ctuLanes.begin() + ( firstCtuRow + ctuRow ) * pcv->widthInCtus, pcv->widthInCtus, ctuRow );
+  }
+
+  // the CTU rows access the units of the rows above
+  xStartCtuParallelism( numCtuRows, false );
+}
+
+void CodingStructure::startBrickParallelism( const std::vector<int>& ctuBrickLanes, const int numBricks )
+{
+  CHECK( ctuBrickLanes.size() != pcv->sizeInCtus, "Brick lanes have to be given for all CTUs" );
+
+  m_ctuLanes = ctuBrickLanes;
+
+  // the bricks are independent, except for the dependencies resolved by the caller
+  xStartCtuParallelism( numBricks, true );
+}
+
+void CodingStructure::xStartCtuParallelism( const int numLanes, const bool lanesIndependent )
+{
+  CHECK( m_ctuParallel, "CTUs are already processed concurrently" );
+
+  // the unit vectors are accessed without locking, so they must not be reallocated
+  const int  twice = pcv->chrFormat != CHROMA_400 ? 2 : 1;
+  size_t allocSize = cus.size() + twice * unitScale[0].scale( area.blocks[0].size() ).area();
+
+  cus.reserve( allocSize );
+  pus.reserve( allocSize );
+  tus.reserve( allocSize );
+
+  m_laneFirstCU  .assign( numLanes, nullptr );
+  m_laneLastCU   .assign( numLanes, nullptr );
+  m_laneMotionLut.assign( numLanes, motionLut );
+
+  m_laneLastCU[0] = m_numCUs > 0 ? cus.back() : nullptr;
+
+  m_ctuLanesIndependent = lanesIndependent;
+  m_ctuParallel         = true;
+}
+
+void CodingStructure::finishCtuParallelism()
+{
+  CHECK( !m_ctuParallel, "CTUs are not processed concurrently" );
+
+  m_ctuParallel         = false;
+  m_ctuLanesIndependent = false;
+
+  // chain the lanes, so the CUs are linked in coding order
+  for( int lane = 1; lane < (int) m_laneFirstCU.size(); lane++ )
+  {
+    if( m_laneFirstCU[lane] )
+    {
+      CHECK( !m_laneLastCU[lane - 1], "Missing CUs in concurrently processed lane" );
+      m_laneLastCU[lane - 1]->next = m_laneFirstCU[lane];
+    }
+  }
+
+  motionLut = m_laneMotionLut.back();
+
+  m_ctuLanes     .clear();
+  m_laneFirstCU  .clear();
+  m_laneLastCU   .clear();
+  m_laneMotionLut.clear();
+}
+
+LutMotionCand& CodingStructure::getMotionLut( const Position& lumaPos )
+{
+  if( !m_ctuParallel ) return motionLut;
+
+  const int lane = getCtuLane( lumaPos );
+  CHECKD( lane < 0, "Position outside of the concurrently processed CTUs" );
+  return m_laneMotionLut[lane];
+}
+
+const LutMotionCand& CodingStructure::getMotionLut( const Position& lumaPos ) const
+{
+  if( !m_ctuParallel ) return motionLut;
+
+  const int lane = getCtuLane( lumaPos );
+  CHECKD( lane < 0, "Position outside of the concurrently processed CTUs" );
+  return m_laneMotionLut[lane];
+}
+
 
 
 void CodingStructure::create(const ChromaFormat &_chromaFormat, const Area& _area, const bool isTopLayer)
@@ -800,7 +927,7 @@ void CodingStructure::initSubStructure( CodingStructure& subStruct, const Channe
 
   subStruct.m_isTuEnc = isTuEnc;
 
-  subStruct.motionLut = motionLut;
+  subStruct.motionLut = getMotionLut( subArea.blocks[_chType].lumaPos() );
 
   subStruct.initStructData( currQP[_chType], isLossless );
 
@@ -861,82 +988,22 @@ void CodingStructure::useSubStructure( const CodingStructure& subStruct, const C
 
     ownMB.copyFrom( subMB );
 
-    motionLut = subStruct.motionLut;
+    getMotionLut( clippedArea.lumaPos() ) = subStruct.motionLut;
   }
-#if ENABLE_WPP_PARALLELISM
 
-  if( nullptr == parent )
   {
-#pragma omp critical
+    // the CTUs of concurrently encoded CTU rows are accumulated into the picture
+    std::unique_lock<std::mutex> lock( m_unitMutex, std::defer_lock );
+    if( m_ctuParallel )
     {
-      fracBits += subStruct.fracBits;
-      dist     += subStruct.dist;
-      cost     += subStruct.cost;
-      costDbOffset += subStruct.costDbOffset;
-      if( parent )
-      {
-        // allow this to be false at the top level
-        CHECKD( !area.contains( subArea ), "Trying to use a sub-structure not contained in self" );
-      }
-
-      // copy the CUs over
-      if( subStruct.m_isTuEnc )
-      {
-        // don't copy if the substruct was created for encoding of the TUs
-      }
-      else
-      {
-        for( const auto &pcu : subStruct.cus )
-        {
-          // add an analogue CU into own CU store
-          const UnitArea &cuPatch = *pcu;
-
-          CodingUnit &cu = addCU( cuPatch, chType );
-
-          // copy the CU info from subPatch
-          cu = *pcu;
-        }
-      }
-
-      // copy the PUs over
-      if( subStruct.m_isTuEnc )
-      {
-        // don't copy if the substruct was created for encoding of the TUs
-      }
-      else
-      {
-        for( const auto &ppu : subStruct.pus )
-        {
-          // add an analogue PU into own PU store
-          const UnitArea &puPatch = *ppu;
-
-          PredictionUnit &pu = addPU( puPatch, chType );
-
-          // copy the PU info from subPatch
-          pu = *ppu;
-        }
-      }
-      // copy the TUs over
-      for( const auto &ptu : subStruct.tus )
-      {
-        // add an analogue TU into own TU store
-        const UnitArea &tuPatch = *ptu;
-
-        TransformUnit &tu = addTU( tuPatch, chType );
-
-        // copy the TU info from subPatch
-        tu = *ptu;
-      }
+      lock.lock();
     }
 
-    return;
+    fracBits += subStruct.fracBits;
+    dist     += subStruct.dist;
+    cost     += subStruct.cost;
+    costDbOffset += subStruct.costDbOffset;
   }
-#endif
-
-  fracBits += subStruct.fracBits;
-  dist     += subStruct.dist;
-  cost     += subStruct.cost;
-  costDbOffset += subStruct.costDbOffset;
   if( parent )
   {
     // allow this to be false at the top level
@@ -1284,7 +1351,7 @@ PelBuf CodingStructure::getBuf( const CompArea &blk, const PictureType &type )
   cFinal.relativeTo( area.blocks[compID] );
 
 #if !KEEP_PRED_AND_RESI_SIGNALS
-  if( !parent && ( type == PIC_RESIDUAL || type == PIC_PREDICTION ) )
+  if( !parent && picture->hasCtuSizedTempBuffers() && ( type == PIC_RESIDUAL || type == PIC_PREDICTION ) )
   {
     cFinal.x &= ( pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
     cFinal.y &= ( pcv->maxCUHeightMask >> getComponentScaleY( blk.compID, blk.chromaFormat ) );
@@ -1318,7 +1385,7 @@ const CPelBuf CodingStructure::getBuf( const CompArea &blk, const PictureType &t
   cFinal.relativeTo( area.blocks[compID] );
 
 #if !KEEP_PRED_AND_RESI_SIGNALS
-  if( !parent && ( type == PIC_RESIDUAL || type == PIC_PREDICTION ) )
+  if( !parent && picture->hasCtuSizedTempBuffers() && ( type == PIC_RESIDUAL || type == PIC_PREDICTION ) )
   {
     cFinal.x &= ( pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
     cFinal.y &= ( pcv->maxCUHeightMask >> getComponentScaleY( blk.compID, blk.chromaFormat ) );
@@ -1356,7 +1423,6 @@ const CPelUnitBuf CodingStructure::getBuf( const UnitArea &unit, const PictureTy
 
 const CodingUnit* CodingStructure::getCURestricted( const Position &pos, const CodingUnit& curCu, const ChannelType _chType ) const
 {
-  const CodingUnit* cu = getCU( pos, _chType );
   // exists       same slice and tile                  cu precedes curCu in encoding order
   //                                                  (thus, is either from parent CS in RD-search or its index is lower)
 #if JVET_N0150_ONE_CTU_DELAY_WPP
@@ -1365,9 +1431,11 @@ const CodingUnit* CodingStructure::getCURestricted( const Position &pos, const C
   int xNbY  = pos.x << getChannelTypeScaleX( _chType, curCu.chromaFormat );
   int xCurr = curCu.blocks[_chType].x << getChannelTypeScaleX( _chType, curCu.chromaFormat );
   bool addCheck = (wavefrontsEnabled && (xNbY >> ctuSizeBit) >= (xCurr >> ctuSizeBit) + 1 ) ? false : true;
-  if( cu && CU::isSameSliceAndTile( *cu, curCu ) && ( cu->cs != curCu.cs || cu->idx <= curCu.idx ) && addCheck)
+  const CodingUnit* cu = addCheck && !isInConcurrentLane( pos, _chType, curCu.blocks[curCu.chType].lumaPos() ) ? getCU( pos, _chType ) : nullptr;
+  if( cu && CU::isSameSliceAndTile( *cu, curCu ) && ( cu->cs != curCu.cs || isPrecedingUnit( cu->idx, cu->blocks[_chType], curCu.idx, curCu.blocks[curCu.chType] ) ) )
 #else
-  if( cu && CU::isSameSliceAndTile( *cu, curCu ) && ( cu->cs != curCu.cs || cu->idx <= curCu.idx ) )
+  const CodingUnit* cu = !isInConcurrentLane( pos, _chType, curCu.blocks[curCu.chType].lumaPos() ) ? getCU( pos, _chType ) : nullptr;
+  if( cu && CU::isSameSliceAndTile( *cu, curCu ) && ( cu->cs != curCu.cs || isPrecedingUnit( cu->idx, cu->blocks[_chType], curCu.idx, curCu.blocks[curCu.chType] ) ) )
 #endif
   {
     return cu;
@@ -1384,22 +1452,24 @@ const CodingUnit* CodingStructure::getCURestricted( const Position &pos, const P
 const CodingUnit* CodingStructure::getCURestricted( const Position &pos, const unsigned curSliceIdx, const unsigned curTileIdx, const ChannelType _chType ) const
 #endif
 {
-  const CodingUnit* cu = getCU( pos, _chType );
 #if JVET_N0150_ONE_CTU_DELAY_WPP
   const bool wavefrontsEnabled = this->slice->getPPS()->getEntropyCodingSyncEnabledFlag();
   int ctuSizeBit = g_aucLog2[this->sps->getMaxCUWidth()];
   int xNbY  = pos.x << getChannelTypeScaleX( _chType, this->area.chromaFormat );
   int xCurr = curPos.x << getChannelTypeScaleX( _chType, this->area.chromaFormat );
   bool addCheck = (wavefrontsEnabled && (xNbY >> ctuSizeBit) >= (xCurr >> ctuSizeBit) + 1 ) ? false : true;
-  return ( cu && cu->slice->getIndependentSliceIdx() == curSliceIdx && cu->tileIdx == curTileIdx && addCheck ) ? cu : nullptr;
+  const Position curLumaPos( curPos.x << getChannelTypeScaleX( _chType, this->area.chromaFormat ), curPos.y << getChannelTypeScaleY( _chType, this->area.chromaFormat ) );
+  // the restriction is checked first, since the CTUs right of it might still be in decoding by another thread
+  const CodingUnit* cu = addCheck && !isInConcurrentLane( pos, _chType, curLumaPos ) ? getCU( pos, _chType ) : nullptr;
+  return ( cu && cu->slice->getIndependentSliceIdx() == curSliceIdx && cu->tileIdx == curTileIdx ) ? cu : nullptr;
 #else
+  const CodingUnit* cu = getCU( pos, _chType );
   return ( cu && cu->slice->getIndependentSliceIdx() == curSliceIdx && cu->tileIdx == curTileIdx ) ? cu : nullptr;
 #endif
 }
 
 const PredictionUnit* CodingStructure::getPURestricted( const Position &pos, const PredictionUnit& curPu, const ChannelType _chType ) const
 {
-  const PredictionUnit* pu = getPU( pos, _chType );
   // exists       same slice and tile                  pu precedes curPu in encoding order
   //                                                  (thus, is either from parent CS in RD-search or its index is lower)
 #if JVET_N0150_ONE_CTU_DELAY_WPP
@@ -1408,9 +1478,11 @@ const PredictionUnit* CodingStructure::getPURestricted( const Position &pos, con
   int xNbY  = pos.x << getChannelTypeScaleX( _chType, curPu.chromaFormat );
   int xCurr = curPu.blocks[_chType].x << getChannelTypeScaleX( _chType, curPu.chromaFormat );
   bool addCheck = (wavefrontsEnabled && (xNbY >> ctuSizeBit) >= (xCurr >> ctuSizeBit) + 1 ) ? false : true;
-  if( pu && CU::isSameSliceAndTile( *pu->cu, *curPu.cu ) && ( pu->cs != curPu.cs || pu->idx <= curPu.idx ) && addCheck )
+  const PredictionUnit* pu = addCheck && !isInConcurrentLane( pos, _chType, curPu.blocks[curPu.chType].lumaPos() ) ? getPU( pos, _chType ) : nullptr;
+  if( pu && CU::isSameSliceAndTile( *pu->cu, *curPu.cu ) && ( pu->cs != curPu.cs || isPrecedingUnit( pu->idx, pu->blocks[_chType], curPu.idx, curPu.blocks[curPu.chType] ) ) )
 #else
-  if( pu && CU::isSameSliceAndTile( *pu->cu, *curPu.cu ) && ( pu->cs != curPu.cs || pu->idx <= curPu.idx ) )
+  const PredictionUnit* pu = !isInConcurrentLane( pos, _chType, curPu.blocks[curPu.chType].lumaPos() ) ? getPU( pos, _chType ) : nullptr;
+  if( pu && CU::isSameSliceAndTile( *pu->cu, *curPu.cu ) && ( pu->cs != curPu.cs || isPrecedingUnit( pu->idx, pu->blocks[_chType], curPu.idx, curPu.blocks[curPu.chType] ) ) )
 #endif
   {
     return pu;
@@ -1423,7 +1495,6 @@ const PredictionUnit* CodingStructure::getPURestricted( const Position &pos, con
 
 const TransformUnit* CodingStructure::getTURestricted( const Position &pos, const TransformUnit& curTu, const ChannelType _chType ) const
 {
-  const TransformUnit* tu = getTU( pos, _chType );
   // exists       same slice and tile                  tu precedes curTu in encoding order
   //                                                  (thus, is either from parent CS in RD-search or its index is lower)
 #if JVET_N0150_ONE_CTU_DELAY_WPP
@@ -1432,9 +1503,11 @@ const TransformUnit* CodingStructure::getTURestricted( const Position &pos, cons
   int xNbY  = pos.x << getChannelTypeScaleX( _chType, curTu.chromaFormat );
   int xCurr = curTu.blocks[_chType].x << getChannelTypeScaleX( _chType, curTu.chromaFormat );
   bool addCheck = (wavefrontsEnabled && (xNbY >> ctuSizeBit) >= (xCurr >> ctuSizeBit) + 1 ) ? false : true;
-  if( tu && CU::isSameSliceAndTile( *tu->cu, *curTu.cu ) && ( tu->cs != curTu.cs || tu->idx <= curTu.idx ) && addCheck )
+  const TransformUnit* tu = addCheck && !isInConcurrentLane( pos, _chType, curTu.blocks[curTu.chType].lumaPos() ) ? getTU( pos, _chType ) : nullptr;
+  if( tu && CU::isSameSliceAndTile( *tu->cu, *curTu.cu ) && ( tu->cs != curTu.cs || isPrecedingUnit( tu->idx, tu->blocks[_chType], curTu.idx, curTu.blocks[curTu.chType] ) ) )
 #else
-  if( tu && CU::isSameSliceAndTile( *tu->cu, *curTu.cu ) && ( tu->cs != curTu.cs || tu->idx <= curTu.idx ) )
+  const TransformUnit* tu = !isInConcurrentLane( pos, _chType, curTu.blocks[curTu.chType].lumaPos() ) ? getTU( pos, _chType ) : nullptr;
+  if( tu && CU::isSameSliceAndTile( *tu->cu, *curTu.cu ) && ( tu->cs != curTu.cs || isPrecedingUnit( tu->idx, tu->blocks[_chType], curTu.idx, curTu.blocks[curTu.chType] ) ) )
 #endif
   {
     return tu;
@@ -44,6 +44,7 @@
 #include "UnitPartitioner.h"
 #include "Slice.h"
 #include <vector>
+#include <mutex>
 
 
 struct Picture;
@@ -172,6 +173,18 @@ public:
   cPUTraverser    traversePUs(const UnitArea& _unit, const ChannelType _chType) const;
   cTUTraverser    traverseTUs(const UnitArea& _unit, const ChannelType _chType) const;
   IbcLumaCoverage getIbcLumaCoverage(const CompArea& chromaArea) const;
+
+  // ---------------------------------------------------------------------------
+  // concurrent decoding of CTU rows (wavefront parallel processing) or bricks
+  // ---------------------------------------------------------------------------
+
+  void startCtuRowParallelism ( const int firstCtuRow, const int numCtuRows );
+  void startBrickParallelism  ( const std::vector<int>& ctuBrickLanes, const int numBricks );
+  void finishCtuParallelism   ();
+  bool isCtuParallel          () const { return m_ctuParallel; }
+
+  LutMotionCand&       getMotionLut( const Position& lumaPos );
+  const LutMotionCand& getMotionLut( const Position& lumaPos ) const;
   // ---------------------------------------------------------------------------
   // encoding search utilities
   // ---------------------------------------------------------------------------
@@ -243,6 +256,32 @@ private:
 
   MotionInfo *m_motionBuf;
 
+  bool                        m_ctuParallel;
+  bool                        m_ctuLanesIndependent;  ///< units of other lanes must not be accessed (bricks)
+  std::vector<int>            m_ctuLanes;             ///< lane (CTU row or brick) of each CTU in raster scan, -1 outside of the concurrently processed CTUs
+  std::vector<CodingUnit*>    m_laneFirstCU;
+  std::vector<CodingUnit*>    m_laneLastCU;
+  std::vector<LutMotionCand>  m_laneMotionLut;
+  std::mutex                  m_unitMutex;            ///< guards unit allocation while CTUs are processed concurrently
+
+  void xStartCtuParallelism( const int numLanes, const bool lanesIndependent );
+  int  getCtuLane          ( const Position& lumaPos ) const { return m_ctuLanes[( lumaPos.y >> pcv->maxCUHeightLog2 ) * pcv->widthInCtus + ( lumaPos.x >> pcv->maxCUWidthLog2 )]; }
+  bool isPrecedingUnit     ( const unsigned idx, const CompArea& blk, const unsigned curIdx, const CompArea& curBlk ) const
+  {
+    if( !m_ctuParallel ) return idx <= curIdx;
+    // with concurrent lanes, the unit index reflects the coding order only within a lane
+    const int lane = getCtuLane( blk.lumaPos() ), curLane = getCtuLane( curBlk.lumaPos() );
+    return lane < curLane || ( lane == curLane && idx <= curIdx );
+  }
+  bool isInConcurrentLane  ( const Position& pos, const ChannelType chType, const Position& curLumaPos ) const
+  {
+    // units of concurrently decoded bricks might be under construction
+    if( !m_ctuLanesIndependent || !area.blocks[chType].contains( pos ) ) return false;
+    const int scaleX = getChannelTypeScaleX( chType, area.chromaFormat ), scaleY = getChannelTypeScaleY( chType, area.chromaFormat );
+    const int lane   = getCtuLane( Position( pos.x << scaleX, pos.y << scaleY ) );
+    return lane >= 0 && lane != getCtuLane( curLumaPos );
+  }
+
 public:
 
   MotionBuf getMotionBuf( const     Area& _area );
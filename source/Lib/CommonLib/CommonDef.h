@@ -697,8 +697,6 @@ static inline int floorLog2(uint32_t x)
 #endif
 
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
-#include <omp.h>
-
 #define PARL_PARAM(DEF) , DEF
 #define PARL_PARAM0(DEF) DEF
 #else
@@ -682,12 +682,6 @@ namespace DQIntern
   };
 
 
-  struct Decision
-  {
-    int64_t rdCost;
-    TCoeff  absLevel;
-    int     prevId;
-  };
 
 
 
@@ -1019,6 +1013,7 @@ namespace DQIntern
   };
 
 #define RICEMAX 32
+  static const int64_t RDCOST_INVALID = std::numeric_limits<int64_t>::max();
   const int32_t g_goRiceBits[4][RICEMAX] =
   {
       { 32768,	65536,	98304,	131072,	163840,	196608,	262144,	262144,	327680,	327680,	327680,	327680,	393216,	393216,	393216,	393216,	393216,	393216,	393216,	393216,	458752,	458752,	458752,	458752,	458752,	458752,	458752,	458752,	458752,	458752,	458752,	458752},
@@ -1050,54 +1045,16 @@ namespace DQIntern
       m_goRiceZero    = 0;
     }
 
-#if JVET_N0193_LFNST
-    void checkRdCosts( const ScanPosType spt, const PQData& pqDataA, const PQData& pqDataB, Decision& decisionA, Decision& decisionB, bool zeroOut ) const
-#else
-    void checkRdCosts( const ScanPosType spt, const PQData& pqDataA, const PQData& pqDataB, Decision& decisionA, Decision& decisionB) const
-#endif
+    // costs of the transitions from this state with the levels of pqDataA, pqDataB and zero
+    void checkRdCosts( const ScanPosType spt, const PQData& pqDataA, const PQData& pqDataB, int64_t& rdCostA, int64_t& rdCostB, int64_t& rdCostZ, bool zeroOut ) const
     {
       const int32_t*  goRiceTab = g_goRiceBits[m_goRicePar];
-      int64_t         rdCostA   = m_rdCost + pqDataA.deltaDist;
-      int64_t         rdCostB   = m_rdCost + pqDataB.deltaDist;
-      int64_t         rdCostZ   = m_rdCost;
-#if JVET_N0193_LFNST
-      if( zeroOut )
+      rdCostA   = m_rdCost + pqDataA.deltaDist;
+      rdCostB   = m_rdCost + pqDataB.deltaDist;
+      rdCostZ   = m_rdCost;
+      if( m_remRegBins >= 4 )
       {
-        rdCostZ = m_rdCost;
-        if( m_remRegBins >= 4 )
-        {
-          if( spt == SCAN_ISCSBB )
-          {
-            rdCostZ += m_sigFracBits.intBits[ 0 ];
-          }
-          else if( spt == SCAN_SOCSBB )
-          {
-            rdCostZ += m_sbbFracBits.intBits[ 1 ] + m_sigFracBits.intBits[ 0 ];
-          }
-          else if( m_numSigSbb )
-          {
-            rdCostZ += m_sigFracBits.intBits[ 0 ];
-          }
-          else
-          {
-            rdCostZ = decisionA.rdCost;
-          }
-        }
-        else
-        {
-          rdCostZ += goRiceTab[ m_goRiceZero ];
-        }
-        if( rdCostZ < decisionA.rdCost )
-        {
-          decisionA.rdCost = rdCostZ;
-          decisionA.absLevel = 0;
-          decisionA.prevId = m_stateId;
-        }
-      }
-      else
-      {
-#endif
-        if( m_remRegBins >= 4 )
+        if( !zeroOut )
         {
           if( pqDataA.absLevel < 4 )
             rdCostA += m_coeffFracBits.bits[ pqDataA.absLevel ];
@@ -1113,59 +1070,47 @@ namespace DQIntern
             const unsigned value = ( pqDataB.absLevel - 4 ) >> 1;
             rdCostB += m_coeffFracBits.bits[ pqDataB.absLevel - ( value << 1 ) ] + goRiceTab[ value < RICEMAX ? value : RICEMAX - 1 ];
           }
-          if( spt == SCAN_ISCSBB )
-          {
-            rdCostA += m_sigFracBits.intBits[ 1 ];
-            rdCostB += m_sigFracBits.intBits[ 1 ];
-            rdCostZ += m_sigFracBits.intBits[ 0 ];
-          }
-          else if( spt == SCAN_SOCSBB )
-          {
-            rdCostA += m_sbbFracBits.intBits[ 1 ] + m_sigFracBits.intBits[ 1 ];
-            rdCostB += m_sbbFracBits.intBits[ 1 ] + m_sigFracBits.intBits[ 1 ];
-            rdCostZ += m_sbbFracBits.intBits[ 1 ] + m_sigFracBits.intBits[ 0 ];
-          }
-          else if( m_numSigSbb )
-          {
-            rdCostA += m_sigFracBits.intBits[ 1 ];
-            rdCostB += m_sigFracBits.intBits[ 1 ];
-            rdCostZ += m_sigFracBits.intBits[ 0 ];
-          }
-          else
-          {
-            rdCostZ = decisionA.rdCost;
-          }
         }
-        else
+        if( spt == SCAN_ISCSBB )
         {
-          rdCostA += ( 1 << SCALE_BITS ) + goRiceTab[ pqDataA.absLevel <= m_goRiceZero ? pqDataA.absLevel - 1 : ( pqDataA.absLevel < RICEMAX ? pqDataA.absLevel : RICEMAX - 1 ) ];
-          rdCostB += ( 1 << SCALE_BITS ) + goRiceTab[ pqDataB.absLevel <= m_goRiceZero ? pqDataB.absLevel - 1 : ( pqDataB.absLevel < RICEMAX ? pqDataB.absLevel : RICEMAX - 1 ) ];
-          rdCostZ += goRiceTab[ m_goRiceZero ];
+          rdCostA += m_sigFracBits.intBits[ 1 ];
+          rdCostB += m_sigFracBits.intBits[ 1 ];
+          rdCostZ += m_sigFracBits.intBits[ 0 ];
         }
-        if( rdCostA < decisionA.rdCost )
+        else if( spt == SCAN_SOCSBB )
         {
-          decisionA.rdCost = rdCostA;
-          decisionA.absLevel = pqDataA.absLevel;
-          decisionA.prevId = m_stateId;
+          rdCostA += m_sbbFracBits.intBits[ 1 ] + m_sigFracBits.intBits[ 1 ];
+          rdCostB += m_sbbFracBits.intBits[ 1 ] + m_sigFracBits.intBits[ 1 ];
+          rdCostZ += m_sbbFracBits.intBits[ 1 ] + m_sigFracBits.intBits[ 0 ];
         }
-        if( rdCostZ < decisionA.rdCost )
+        else if( m_numSigSbb )
         {
-          decisionA.rdCost = rdCostZ;
-          decisionA.absLevel = 0;
-          decisionA.prevId = m_stateId;
+          rdCostA += m_sigFracBits.intBits[ 1 ];
+          rdCostB += m_sigFracBits.intBits[ 1 ];
+          rdCostZ += m_sigFracBits.intBits[ 0 ];
         }
-        if( rdCostB < decisionB.rdCost )
+        else
         {
-          decisionB.rdCost = rdCostB;
-          decisionB.absLevel = pqDataB.absLevel;
-          decisionB.prevId = m_stateId;
+          rdCostZ = RDCOST_INVALID;
         }
-#if JVET_N0193_LFNST
       }
-#endif
+      else
+      {
+        if( !zeroOut )
+        {
+          rdCostA += ( 1 << SCALE_BITS ) + goRiceTab[ pqDataA.absLevel <= m_goRiceZero ? pqDataA.absLevel - 1 : ( pqDataA.absLevel < RICEMAX ? pqDataA.absLevel : RICEMAX - 1 ) ];
+          rdCostB += ( 1 << SCALE_BITS ) + goRiceTab[ pqDataB.absLevel <= m_goRiceZero ? pqDataB.absLevel - 1 : ( pqDataB.absLevel < RICEMAX ? pqDataB.absLevel : RICEMAX - 1 ) ];
+        }
+        rdCostZ += goRiceTab[ m_goRiceZero ];
+      }
+      if( zeroOut )
+      {
+        rdCostA = RDCOST_INVALID;
+        rdCostB = RDCOST_INVALID;
+      }
     }
 
-    inline void checkRdCostStart(int32_t lastOffset, const PQData &pqData, Decision &decision) const
+    inline int64_t rdCostStart( int32_t lastOffset, const PQData &pqData ) const
     {
       int64_t rdCost = pqData.deltaDist + lastOffset;
       if (pqData.absLevel < 4)
@@ -1177,23 +1122,12 @@ namespace DQIntern
         const unsigned value = (pqData.absLevel - 4) >> 1;
         rdCost += m_coeffFracBits.bits[pqData.absLevel - (value << 1)] + g_goRiceBits[m_goRicePar][value < RICEMAX ? value : RICEMAX-1];
       }
-      if( rdCost < decision.rdCost )
-      {
-        decision.rdCost   = rdCost;
-        decision.absLevel = pqData.absLevel;
-        decision.prevId   = -1;
-      }
+      return rdCost;
     }
 
-    inline void checkRdCostSkipSbb(Decision &decision) const
+    inline int64_t rdCostSkipSbb() const
     {
-      int64_t rdCost = m_rdCost + m_sbbFracBits.intBits[0];
-      if( rdCost < decision.rdCost )
-      {
-        decision.rdCost   = rdCost;
-        decision.absLevel = 0;
-        decision.prevId   = 4+m_stateId;
-      }
+      return m_rdCost + m_sbbFracBits.intBits[0];
     }
 
     inline void checkRdCostSkipSbbZeroOut(Decision &decision) const
@@ -1521,7 +1455,7 @@ namespace DQIntern
   class DepQuant : private RateEstimator
   {
   public:
-    DepQuant();
+    DepQuant( void ( *selectDecisions )( const DecisionCandidates&, Decision* ) );
 
 #if JVET_N0847_SCALING_LISTS
     void    quant   ( TransformUnit& tu, const CCoeffBuf& srcCoeff, const ComponentID compID, const QpParam& cQP, const double lambda, const Ctx& ctx, TCoeff& absSum, bool enableScalingLists, int* quantCoeff );
@@ -1549,11 +1483,12 @@ namespace DQIntern
     State       m_startState;
     Quantizer   m_quant;
     Decision    m_trellis[ MAX_TB_SIZEY * MAX_TB_SIZEY ][ 8 ];
+    void     ( *m_selectDecisions )( const DecisionCandidates&, Decision* );
   };
 
 
 #define TINIT(x) {*this,m_commonCtx,x}
-  DepQuant::DepQuant()
+  DepQuant::DepQuant( void ( *selectDecisions )( const DecisionCandidates&, Decision* ) )
     : RateEstimator ()
     , m_commonCtx   ()
     , m_allStates   {TINIT(0),TINIT(1),TINIT(2),TINIT(3),TINIT(0),TINIT(1),TINIT(2),TINIT(3),TINIT(0),TINIT(1),TINIT(2),TINIT(3)}
@@ -1561,6 +1496,7 @@ namespace DQIntern
     , m_prevStates  (  m_currStates + 4 )
     , m_skipStates  (  m_prevStates + 4 )
     , m_startState  TINIT(0)
+    , m_selectDecisions( selectDecisions )
   {}
 #undef TINIT
 
@@ -1612,45 +1548,36 @@ namespace DQIntern
 #else
     m_quant.preQuantCoeff( absCoeff, pqData );
 #endif
-#if JVET_N0193_LFNST
-    m_prevStates[0].checkRdCosts( spt, pqData[0], pqData[2], decisions[0], decisions[2], zeroOut );
-    m_prevStates[1].checkRdCosts( spt, pqData[0], pqData[2], decisions[2], decisions[0], zeroOut );
-    m_prevStates[2].checkRdCosts( spt, pqData[3], pqData[1], decisions[1], decisions[3], zeroOut );
-    m_prevStates[3].checkRdCosts( spt, pqData[3], pqData[1], decisions[3], decisions[1], zeroOut );
-#else
-    m_prevStates[0].checkRdCosts( spt, pqData[0], pqData[2], decisions[0], decisions[2]);
-    m_prevStates[1].checkRdCosts( spt, pqData[0], pqData[2], decisions[2], decisions[0]);
-    m_prevStates[2].checkRdCosts( spt, pqData[3], pqData[1], decisions[1], decisions[3]);
-    m_prevStates[3].checkRdCosts( spt, pqData[3], pqData[1], decisions[3], decisions[1]);
-#endif
-    if( spt==SCAN_EOCSBB )
+
+    DecisionCandidates cand;
+    m_prevStates[0].checkRdCosts( spt, pqData[0], pqData[2], cand.costA[0], cand.costB[0], cand.costZ[0], zeroOut );
+    m_prevStates[1].checkRdCosts( spt, pqData[0], pqData[2], cand.costA[1], cand.costB[1], cand.costZ[1], zeroOut );
+    m_prevStates[2].checkRdCosts( spt, pqData[3], pqData[1], cand.costA[2], cand.costB[2], cand.costZ[2], zeroOut );
+    m_prevStates[3].checkRdCosts( spt, pqData[3], pqData[1], cand.costA[3], cand.costB[3], cand.costZ[3], zeroOut );
+
+    const bool skipSbb = spt == SCAN_EOCSBB && !zeroOut;
+    cand.costSkip[0]  = skipSbb ? m_skipStates[0].rdCostSkipSbb() : RDCOST_INVALID;
+    cand.costSkip[1]  = skipSbb ? m_skipStates[1].rdCostSkipSbb() : RDCOST_INVALID;
+    cand.costSkip[2]  = skipSbb ? m_skipStates[2].rdCostSkipSbb() : RDCOST_INVALID;
+    cand.costSkip[3]  = skipSbb ? m_skipStates[3].rdCostSkipSbb() : RDCOST_INVALID;
+    cand.costStart[0] = zeroOut ? RDCOST_INVALID : m_startState.rdCostStart( lastOffset, pqData[0] );
+    cand.costStart[1] = RDCOST_INVALID;
+    cand.costStart[2] = zeroOut ? RDCOST_INVALID : m_startState.rdCostStart( lastOffset, pqData[2] );
+    cand.costStart[3] = RDCOST_INVALID;
+    for( int k = 0; k < 4; k++ )
     {
-#if JVET_N0193_LFNST
-      if( zeroOut )
-      {
-        m_skipStates[0].checkRdCostSkipSbbZeroOut( decisions[0] );
-        m_skipStates[1].checkRdCostSkipSbbZeroOut( decisions[1] );
-        m_skipStates[2].checkRdCostSkipSbbZeroOut( decisions[2] );
-        m_skipStates[3].checkRdCostSkipSbbZeroOut( decisions[3] );
-      }
-      else
-      {
-#endif
-        m_skipStates[0].checkRdCostSkipSbb( decisions[0] );
-        m_skipStates[1].checkRdCostSkipSbb( decisions[1] );
-        m_skipStates[2].checkRdCostSkipSbb( decisions[2] );
-        m_skipStates[3].checkRdCostSkipSbb( decisions[3] );
-#if JVET_N0193_LFNST
-      }
-#endif
+      cand.absLevel[k] = pqData[k].absLevel;
     }
+
+    m_selectDecisions( cand, decisions );
+
 #if JVET_N0193_LFNST
-    if( !zeroOut )
+    if( zeroOut && spt == SCAN_EOCSBB )
     {
-#endif
-    m_startState.checkRdCostStart( lastOffset, pqData[0], decisions[0] );
-    m_startState.checkRdCostStart( lastOffset, pqData[2], decisions[2] );
-#if JVET_N0193_LFNST
+      m_skipStates[0].checkRdCostSkipSbbZeroOut( decisions[0] );
+      m_skipStates[1].checkRdCostSkipSbbZeroOut( decisions[1] );
+      m_skipStates[2].checkRdCostSkipSbbZeroOut( decisions[2] );
+      m_skipStates[3].checkRdCostSkipSbbZeroOut( decisions[3] );
     }
 #endif
   }
@@ -1888,7 +1815,11 @@ DepQuant::DepQuant( const Quant* other, bool enc ) : QuantRDOQ( other )
 {
   const DepQuant* dq = dynamic_cast<const DepQuant*>( other );
   CHECK( other && !dq, "The DepQuant cast must be successfull!" );
-  p = new DQIntern::DepQuant();
+  m_selectDecisions = selectDecisionsCore;
+#if ENABLE_SIMD_OPT_DEPQUANT && defined(TARGET_SIMD_X86)
+  initDepQuantX86();
+#endif
+  p = new DQIntern::DepQuant( m_selectDecisions );
   if( enc )
   {
     DQIntern::g_Rom.init();
@@ -1900,6 +1831,38 @@ DepQuant::~DepQuant()
   delete static_cast<DQIntern::DepQuant*>(p);
 }
 
+static inline void checkDecision( DQIntern::Decision& decision, const int64_t rdCost, const TCoeff absLevel, const int prevId )
+{
+  if( rdCost < decision.rdCost )
+  {
+    decision.rdCost   = rdCost;
+    decision.absLevel = absLevel;
+    decision.prevId   = prevId;
+  }
+}
+
+void DepQuant::selectDecisionsCore( const DQIntern::DecisionCandidates& cand, DQIntern::Decision* decisions )
+{
+  checkDecision( decisions[0], cand.costA[0], cand.absLevel[0], 0 );
+  checkDecision( decisions[0], cand.costZ[0], 0,                0 );
+  checkDecision( decisions[2], cand.costB[0], cand.absLevel[2], 0 );
+  checkDecision( decisions[2], cand.costA[1], cand.absLevel[0], 1 );
+  checkDecision( decisions[2], cand.costZ[1], 0,                1 );
+  checkDecision( decisions[0], cand.costB[1], cand.absLevel[2], 1 );
+  checkDecision( decisions[1], cand.costA[2], cand.absLevel[3], 2 );
+  checkDecision( decisions[1], cand.costZ[2], 0,                2 );
+  checkDecision( decisions[3], cand.costB[2], cand.absLevel[1], 2 );
+  checkDecision( decisions[3], cand.costA[3], cand.absLevel[3], 3 );
+  checkDecision( decisions[3], cand.costZ[3], 0,                3 );
+  checkDecision( decisions[1], cand.costB[3], cand.absLevel[1], 3 );
+  for( int k = 0; k < 4; k++ )
+  {
+    checkDecision( decisions[k], cand.costSkip[k], 0, 4 + k );
+  }
+  checkDecision( decisions[0], cand.costStart[0], cand.absLevel[0], -1 );
+  checkDecision( decisions[2], cand.costStart[2], cand.absLevel[2], -1 );
+}
+
 void DepQuant::quant( TransformUnit &tu, const ComponentID &compID, const CCoeffBuf &pSrc, TCoeff &uiAbsSum, const QpParam &cQP, const Ctx& ctx )
 {
 #if JVET_N0280_RESIDUAL_CODING_TS
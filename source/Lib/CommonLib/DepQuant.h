@@ -47,6 +47,30 @@
 
 
 
+namespace DQIntern
+{
+  struct Decision
+  {
+    int64_t rdCost;
+    TCoeff  absLevel;
+    int     prevId;
+  };
+
+  // rate-distortion costs of all trellis transitions into the four states at one scan position, transitions that
+  // are not allowed carry the maximum cost. The previous states 0 and 1 feed the decisions 0 and 2 with the levels
+  // absLevel[0] (A) and absLevel[2] (B), the previous states 2 and 3 feed the decisions 1 and 3 with absLevel[3] (A)
+  // and absLevel[1] (B).
+  struct DecisionCandidates
+  {
+    int64_t costA    [4];   // per previous state
+    int64_t costB    [4];   // per previous state
+    int64_t costZ    [4];   // per previous state, level 0
+    int64_t costSkip [4];   // per decision, skipped sub-block
+    int64_t costStart[4];   // per decision, first coded coefficient
+    TCoeff  absLevel [4];
+  };
+}
+
 class DepQuant : public QuantRDOQ
 {
 public:
@@ -56,8 +80,19 @@ public:
   virtual void quant  ( TransformUnit &tu, const ComponentID &compID, const CCoeffBuf &pSrc, TCoeff &uiAbsSum, const QpParam &cQP, const Ctx& ctx );
   virtual void dequant( const TransformUnit &tu, CoeffBuf &dstCoeff, const ComponentID &compID, const QpParam &cQP );
 
+  // updates the decisions of the four states with the candidates in the order of the scalar trellis, the first
+  // of equal costs wins
+  static void selectDecisionsCore( const DQIntern::DecisionCandidates& cand, DQIntern::Decision* decisions );
+
+#if ENABLE_SIMD_OPT_DEPQUANT && defined(TARGET_SIMD_X86)
+  void initDepQuantX86();
+  template <X86_VEXT vext>
+  void _initDepQuantX86();
+#endif
+
 private:
   void* p;
+  void ( *m_selectDecisions )( const DQIntern::DecisionCandidates& cand, DQIntern::Decision* decisions );
 };
 
 
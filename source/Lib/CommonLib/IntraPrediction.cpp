@@ -139,6 +139,16 @@ IntraPrediction::IntraPrediction()
 
   m_piTemp = nullptr;
   m_pMdlmTemp = nullptr;
+
+  m_predIntraPlanar  = predIntraPlanarCore;
+  m_predIntraAng4Tap = predIntraAng4TapCore;
+  m_predIntraAng2Tap = predIntraAng2TapCore;
+  m_pdpcPlanarDc     = pdpcPlanarDcCore;
+  m_downsampleLuma   = downsampleLumaCore;
+
+#if ENABLE_SIMD_OPT_INTRAPRED && defined(TARGET_SIMD_X86)
+  initIntraPredictionX86();
+#endif
 }
 
 IntraPrediction::~IntraPrediction()
@@ -277,6 +287,53 @@ int IntraPrediction::getWideAngle( int width, int height, int predMode )
   return predMode;
 }
 
+const IntraPrediction::IntraPredAngPlan& IntraPrediction::getAngPlan( const int dirMode, const int width, const int height )
+{
+  struct PlanTable
+  {
+    IntraPredAngPlan plan[NUM_INTRA_MODE][MAX_CU_DEPTH + 1][MAX_CU_DEPTH + 1];
+
+    PlanTable()
+    {
+      static const int angTable[32]    = { 0,    1,    2,    3,    4,    6,     8,   10,   12,   14,   16,   18,   20,   23,   26,   29,   32,   35,   39,  45,  51,  57,  64,  73,  86, 102, 128, 171, 256, 341, 512, 1024 };
+      static const int invAngTable[32] = { 0, 8192, 4096, 2731, 2048, 1365,  1024,  819,  683,  585,  512,  455,  410,  356,  315,  282,  256,  234,  210, 182, 161, 144, 128, 112,  95,  80,  64,  48,  32,  24,  16,    8 }; // (256 * 32) / Angle
+
+      for( int mode = 0; mode < NUM_INTRA_MODE; mode++ )
+      {
+        for( int log2W = 0; log2W <= MAX_CU_DEPTH; log2W++ )
+        {
+          for( int log2H = 0; log2H <= MAX_CU_DEPTH; log2H++ )
+          {
+            IntraPredAngPlan& p = plan[mode][log2W][log2H];
+            const int predMode  = getWideAngle( 1 << log2W, 1 << log2H, mode );
+
+            p.predMode       = predMode;
+            p.isModeVer      = predMode >= DIA_IDX;
+            p.intraPredAngle = 0;
+            p.invAngle       = 0;
+            p.absAng         = 0;
+
+            if( mode > DC_IDX && mode < NUM_LUMA_MODE ) // intraPredAngle for directional modes
+            {
+              const int intraPredAngleMode = p.isModeVer ? predMode - VER_IDX : -( predMode - HOR_IDX );
+              const int absAngMode         = abs( intraPredAngleMode );
+
+              p.absAng         = angTable   [absAngMode];
+              p.invAngle       = invAngTable[absAngMode];
+              p.intraPredAngle = intraPredAngleMode < 0 ? -p.absAng : p.absAng;
+            }
+          }
+        }
+      }
+    }
+  };
+
+  static const PlanTable table;
+
+  CHECK( dirMode < 0 || dirMode >= NUM_INTRA_MODE, "Invalid intra mode" );
+  return table.plan[dirMode][g_aucLog2[width]][g_aucLog2[height]];
+}
+
 void IntraPrediction::setReferenceArrayLengths( const CompArea &area )
 {
   // set Top and Left reference samples length
@@ -315,7 +372,7 @@ void IntraPrediction::predIntraAng( const ComponentID compId, PelBuf &piPred, co
 
   switch (uiDirMode)
   {
-    case(PLANAR_IDX): xPredIntraPlanar(srcBuf, piPred); break;
+    case(PLANAR_IDX): m_predIntraPlanar(srcBuf, piPred); break;
     case(DC_IDX):     xPredIntraDc(srcBuf, piPred, channelType, false); break;
 #if JVET_N0413_RDPCM
     case(BDPCM_IDX):  xPredIntraBDPCM(srcBuf, piPred, pu.cu->bdpcmMode, clpRng); break;
@@ -329,35 +386,9 @@ void IntraPrediction::predIntraAng( const ComponentID compId, PelBuf &piPred, co
     const int scale = ((g_aucLog2[iWidth] - 2 + g_aucLog2[iHeight] - 2 + 2) >> 2);
     CHECK(scale < 0 || scale > 31, "PDPC: scale < 0 || scale > 31");
 
-    if (uiDirMode == PLANAR_IDX)
+    if (uiDirMode == PLANAR_IDX || uiDirMode == DC_IDX)
     {
-      for (int y = 0; y < iHeight; y++)
-      {
-        int wT = 32 >> std::min(31, ((y << 1) >> scale));
-        const Pel left = srcBuf.at(0, y + 1);
-        for (int x = 0; x < iWidth; x++)
-        {
-          const Pel top = srcBuf.at(x + 1, 0);
-          int wL = 32 >> std::min(31, ((x << 1) >> scale));
-          dstBuf.at(x, y) = ClipPel((wL * left + wT * top + (64 - wL - wT) * dstBuf.at(x, y) + 32) >> 6, clpRng);
-        }
-      }
-    }
-    else if (uiDirMode == DC_IDX)
-    {
-      const Pel topLeft = srcBuf.at(0, 0);
-      for (int y = 0; y < iHeight; y++)
-      {
-        int wT = 32 >> std::min(31, ((y << 1) >> scale));
-        const Pel left = srcBuf.at(0, y + 1);
-        for (int x = 0; x < iWidth; x++)
-        {
-          const Pel top = srcBuf.at(x + 1, 0);
-          int wL = 32 >> std::min(31, ((x << 1) >> scale));
-          int wTL = (wL >> 4) + (wT >> 4);
-          dstBuf.at(x, y) = ClipPel((wL * left + wT * top - wTL * topLeft + (64 - wL - wT + wTL) * dstBuf.at(x, y) + 32) >> 6, clpRng);
-        }
-      }
+      m_pdpcPlanarDc(srcBuf, dstBuf, uiDirMode == DC_IDX, clpRng);
     }
     else if (uiDirMode == HOR_IDX)
     {
@@ -408,15 +439,14 @@ void IntraPrediction::predIntraChromaLM(const ComponentID compID, PelBuf &piPred
   xGetLMParameters(pu, compID, chromaArea, a, b, iShift);
 
   ////// final prediction
-  piPred.copyFrom(Temp);
-  piPred.linearTransform(a, iShift, b, true, pu.cs->slice->clpRng(compID));
+  piPred.linearTransform(Temp, a, iShift, b, true, pu.cs->slice->clpRng(compID));
 }
 
 /** Function for deriving planar intra prediction. This function derives the prediction samples for planar mode (intra coding).
  */
 
 //NOTE: Bit-Limit - 24-bit source
-void IntraPrediction::xPredIntraPlanar( const CPelBuf &pSrc, PelBuf &pDst )
+void IntraPrediction::predIntraPlanarCore( const CPelBuf &pSrc, PelBuf &pDst )
 {
   const uint32_t width  = pDst.width;
   const uint32_t height = pDst.height;
@@ -477,6 +507,35 @@ void IntraPrediction::xPredIntraDc( const CPelBuf &pSrc, PelBuf &pDst, const Cha
   pDst.fill( dcval );
 }
 
+/** Position dependent prediction combination of the planar and DC predictions with the unfiltered top and left reference samples.
+ *  The weights wL and wT vanish from column (row) 3 << scale onwards, where the combination keeps the prediction unchanged.
+ */
+void IntraPrediction::pdpcPlanarDcCore( const CPelBuf &pSrc, PelBuf &pDst, const bool isDc, const ClpRng& clpRng )
+{
+  const int width   = pDst.width;
+  const int height  = pDst.height;
+  const int scale   = ((g_aucLog2[width] - 2 + g_aucLog2[height] - 2 + 2) >> 2);
+  const int endX    = std::min( width,  3 << scale );
+  const int endY    = std::min( height, 3 << scale );
+  const Pel topLeft = isDc ? pSrc.at( 0, 0 ) : 0;
+
+  for( int y = 0; y < height; y++ )
+  {
+    const int wT    = y < endY ? 32 >> ((y << 1) >> scale) : 0;
+    const Pel left  = pSrc.at( 0, y + 1 );
+    const int lineX = wT ? width : endX;
+    Pel*      dst   = pDst.bufAt( 0, y );
+
+    for( int x = 0; x < lineX; x++ )
+    {
+      const Pel top = pSrc.at( x + 1, 0 );
+      const int wL  = x < endX ? 32 >> ((x << 1) >> scale) : 0;
+      const int wTL = isDc ? (wL >> 4) + (wT >> 4) : 0;
+      dst[x] = ClipPel( (wL * left + wT * top - wTL * topLeft + (64 - wL - wT + wTL) * dst[x] + 32) >> 6, clpRng );
+    }
+  }
+}
+
 // Function for initialization of intra prediction parameters
 void IntraPrediction::initPredIntraParams(const PredictionUnit & pu, const CompArea area, const SPS& sps)
 {
@@ -489,31 +548,22 @@ void IntraPrediction::initPredIntraParams(const PredictionUnit & pu, const CompA
   const Size   puSize    = Size( area.width, area.height );
   const Size&  blockSize = useISP ? cuSize : puSize;
   const int      dirMode = PU::getFinalIntraMode(pu, chType);
-  const int     predMode = getWideAngle( blockSize.width, blockSize.height, dirMode );
+  const IntraPredAngPlan& plan = getAngPlan( dirMode, blockSize.width, blockSize.height );
+  const int     predMode = plan.predMode;
 
   m_ipaParam.whRatio              = std::max( unsigned( 1 ), blockSize.width  / blockSize.height ) ;
   m_ipaParam.hwRatio              = std::max( unsigned( 1 ), blockSize.height / blockSize.width  ) ;
-  m_ipaParam.isModeVer            = predMode >= DIA_IDX;
+  m_ipaParam.isModeVer            = plan.isModeVer;
   m_ipaParam.multiRefIndex        = isLuma (chType) ? pu.multiRefIdx : 0 ;
   m_ipaParam.refFilterFlag        = false;
   m_ipaParam.interpolationFlag    = false;
   m_ipaParam.applyPDPC            = !useISP && m_ipaParam.multiRefIndex == 0;
 
-  const int    intraPredAngleMode = (m_ipaParam.isModeVer) ? predMode - VER_IDX : -(predMode - HOR_IDX);
-
-
-  int absAng = 0;
+  const int absAng = plan.absAng;
   if (dirMode > DC_IDX && dirMode < NUM_LUMA_MODE) // intraPredAngle for directional modes
   {
-    static const int angTable[32]    = { 0,    1,    2,    3,    4,    6,     8,   10,   12,   14,   16,   18,   20,   23,   26,   29,   32,   35,   39,  45,  51,  57,  64,  73,  86, 102, 128, 171, 256, 341, 512, 1024 };
-    static const int invAngTable[32] = { 0, 8192, 4096, 2731, 2048, 1365,  1024,  819,  683,  585,  512,  455,  410,  356,  315,  282,  256,  234,  210, 182, 161, 144, 128, 112,  95,  80,  64,  48,  32,  24,  16,    8 }; // (256 * 32) / Angle
-
-    const int     absAngMode         = abs(intraPredAngleMode);
-    const int     signAng            = intraPredAngleMode < 0 ? -1 : 1;
-                  absAng             = angTable  [absAngMode];
-
-    m_ipaParam.invAngle              = invAngTable[absAngMode];
-    m_ipaParam.intraPredAngle        = signAng * absAng;
+    m_ipaParam.invAngle              = plan.invAngle;
+    m_ipaParam.intraPredAngle        = plan.intraPredAngle;
     m_ipaParam.applyPDPC            &= m_ipaParam.intraPredAngle == 0 || m_ipaParam.intraPredAngle >= 12; // intra prediction modes: HOR, VER, x, where x>=VDIA-8 or x<=2+8
   }
 
@@ -679,61 +729,39 @@ void IntraPrediction::xPredIntraAng( const CPelBuf &pSrc, PelBuf &pDst, const Ch
   }
   else
   {
-    Pel *pDsty=pDstBuf;
-    for (int y = 0, deltaPos = intraPredAngle * (1 + multiRefIdx); y<height; y++, deltaPos += intraPredAngle, pDsty += dstStride)
-    {
-      const int deltaInt   = deltaPos >> 5;
-      const int deltaFract = deltaPos & (32 - 1);
+    const int deltaPos = intraPredAngle * (1 + multiRefIdx);
 
-      if ( !isIntegerSlope( abs(intraPredAngle) ) )
+    if ( !isIntegerSlope( abs(intraPredAngle) ) )
+    {
+      if( isLuma(channelType) )
       {
-        if( isLuma(channelType) )
-        {
-          Pel                        p[4];
-          const bool                 useCubicFilter = !m_ipaParam.interpolationFlag;
-          TFilterCoeff const * const f              = (useCubicFilter) ? InterpolationFilter::getChromaFilterTable(deltaFract) : g_intraGaussFilter[deltaFract];
+        // only the cubic filter has negative coefficients and requires clipping
+        const bool                 useCubicFilter = !m_ipaParam.interpolationFlag;
+        TFilterCoeff const * const filter         = (useCubicFilter) ? InterpolationFilter::getChromaFilterTable(0) : g_intraGaussFilter[0];
 
-          int         refMainIndex   = deltaInt + 1;
-
-          for( int x = 0; x < width; x++, refMainIndex++ )
-          {
-            p[0] = refMain[refMainIndex - 1];
-            p[1] = refMain[refMainIndex];
-            p[2] = refMain[refMainIndex + 1];
-            p[3] = f[3] != 0 ? refMain[refMainIndex + 2] : 0;
-
-            pDstBuf[y*dstStride + x] = static_cast<Pel>((static_cast<int>(f[0] * p[0]) + static_cast<int>(f[1] * p[1]) + static_cast<int>(f[2] * p[2]) + static_cast<int>(f[3] * p[3]) + 32) >> 6);
-
-            if( useCubicFilter ) // only cubic filter has negative coefficients and requires clipping
-            {
-              pDstBuf[y*dstStride + x] = ClipPel( pDstBuf[y*dstStride + x], clpRng );
-            }
-          }
-        }
-        else
-        {
-          // Do linear filtering
-          const Pel *pRM = refMain + deltaInt + 1;
-          int lastRefMainPel = *pRM++;
-          for( int x = 0; x < width; pRM++, x++ )
-          {
-            int thisRefMainPel = *pRM;
-            pDsty[x + 0] = ( Pel ) ( ( ( 32 - deltaFract )*lastRefMainPel + deltaFract*thisRefMainPel + 16 ) >> 5 );
-            lastRefMainPel = thisRefMainPel;
-          }
-        }
+        m_predIntraAng4Tap( pDstBuf, dstStride, refMain, width, height, deltaPos, intraPredAngle, filter, useCubicFilter, clpRng );
       }
       else
       {
-        // Just copy the integer samples
-        for( int x = 0; x < width; x++ )
-        {
-          pDsty[x] = refMain[x + deltaInt + 1];
-        }
+        m_predIntraAng2Tap( pDstBuf, dstStride, refMain, width, height, deltaPos, intraPredAngle );
+      }
+    }
+    else
+    {
+      // Just copy the integer samples
+      Pel *pDsty = pDstBuf;
+      for( int y = 0, deltaInt = deltaPos >> 5; y < height; y++, deltaInt += intraPredAngle >> 5, pDsty += dstStride )
+      {
+        memcpy( pDsty, refMain + deltaInt + 1, width * sizeof( Pel ) );
       }
-      const int scale = ((g_aucLog2[width] - 2 + g_aucLog2[height] - 2 + 2) >> 2);
-      CHECK(scale < 0 || scale > 31, "PDPC: scale < 0 || scale > 31");
-      if (m_ipaParam.applyPDPC)
+    }
+
+    const int scale = ((g_aucLog2[width] - 2 + g_aucLog2[height] - 2 + 2) >> 2);
+    CHECK(scale < 0 || scale > 31, "PDPC: scale < 0 || scale > 31");
+    if (m_ipaParam.applyPDPC)
+    {
+      Pel *pDsty = pDstBuf;
+      for( int y = 0; y < height; y++, pDsty += dstStride )
       {
         if (m_ipaParam.intraPredAngle == 32) // intra prediction modes: 2 and VDIA
         {
@@ -792,6 +820,54 @@ void IntraPrediction::xPredIntraAng( const CPelBuf &pSrc, PelBuf &pDst, const Ch
   }
 }
 
+void IntraPrediction::predIntraAng4TapCore( Pel* pDst, const int dstStride, const Pel* refMain, const int width, const int height, const int deltaPos, const int intraPredAngle, const TFilterCoeff* filter, const bool useClip, const ClpRng& clpRng )
+{
+  Pel p[4];
+
+  for( int y = 0, pos = deltaPos; y < height; y++, pos += intraPredAngle, pDst += dstStride )
+  {
+    const int                  deltaInt   = pos >> 5;
+    const int                  deltaFract = pos & (32 - 1);
+    TFilterCoeff const * const f          = filter + (deltaFract << 2);
+
+    int refMainIndex = deltaInt + 1;
+
+    for( int x = 0; x < width; x++, refMainIndex++ )
+    {
+      p[0] = refMain[refMainIndex - 1];
+      p[1] = refMain[refMainIndex];
+      p[2] = refMain[refMainIndex + 1];
+      p[3] = f[3] != 0 ? refMain[refMainIndex + 2] : 0;
+
+      pDst[x] = static_cast<Pel>((static_cast<int>(f[0] * p[0]) + static_cast<int>(f[1] * p[1]) + static_cast<int>(f[2] * p[2]) + static_cast<int>(f[3] * p[3]) + 32) >> 6);
+
+      if( useClip )
+      {
+        pDst[x] = ClipPel( pDst[x], clpRng );
+      }
+    }
+  }
+}
+
+void IntraPrediction::predIntraAng2TapCore( Pel* pDst, const int dstStride, const Pel* refMain, const int width, const int height, const int deltaPos, const int intraPredAngle )
+{
+  for( int y = 0, pos = deltaPos; y < height; y++, pos += intraPredAngle, pDst += dstStride )
+  {
+    const int deltaInt   = pos >> 5;
+    const int deltaFract = pos & (32 - 1);
+
+    // Do linear filtering
+    const Pel *pRM = refMain + deltaInt + 1;
+    int lastRefMainPel = *pRM++;
+    for( int x = 0; x < width; pRM++, x++ )
+    {
+      int thisRefMainPel = *pRM;
+      pDst[x + 0] = ( Pel ) ( ( ( 32 - deltaFract )*lastRefMainPel + deltaFract*thisRefMainPel + 16 ) >> 5 );
+      lastRefMainPel = thisRefMainPel;
+    }
+  }
+}
+
 #if JVET_N0413_RDPCM
 void IntraPrediction::xPredIntraBDPCM(const CPelBuf &pSrc, PelBuf &pDst, const uint32_t dirMode, const ClpRng& clpRng )
 {
@@ -1498,6 +1574,62 @@ int isBelowLeftAvailable(const CodingUnit &cu, const ChannelType &chType, const
 }
 
 // LumaRecPixels
+void IntraPrediction::downsampleLumaCore( const Pel* pSrc, const int srcStride, Pel* pDst, const int dstStride, const int width, const int height, const LumaDownsampleFilter filter )
+{
+  switch( filter )
+  {
+  case LUMA_DS_COPY:
+    for( int j = 0; j < height; j++, pSrc += srcStride, pDst += dstStride )
+    {
+      memcpy( pDst, pSrc, width * sizeof( Pel ) );
+    }
+    break;
+  case LUMA_DS_2TO1:
+    for( int j = 0; j < height; j++, pSrc += srcStride, pDst += dstStride )
+    {
+      for( int i = 0; i < width; i++ )
+      {
+        pDst[i] = pSrc[2 * i];
+      }
+    }
+    break;
+  case LUMA_DS_3TAP:
+    for( int j = 0; j < height; j++, pSrc += srcStride, pDst += dstStride )
+    {
+      for( int i = 0; i < width; i++ )
+      {
+        pDst[i] = ( pSrc[2 * i] * 2 + pSrc[2 * i - 1] + pSrc[2 * i + 1] + 2 ) >> 2;
+      }
+    }
+    break;
+  case LUMA_DS_5TAP:
+    for( int j = 0; j < height; j++, pSrc += 2 * srcStride, pDst += dstStride )
+    {
+      for( int i = 0; i < width; i++ )
+      {
+        pDst[i] = ( pSrc[2 * i - srcStride]
+                  + pSrc[2 * i            ] * 4 + pSrc[2 * i - 1] + pSrc[2 * i + 1]
+                  + pSrc[2 * i + srcStride]
+                  + 4 ) >> 3;
+      }
+    }
+    break;
+  case LUMA_DS_6TAP:
+    for( int j = 0; j < height; j++, pSrc += 2 * srcStride, pDst += dstStride )
+    {
+      for( int i = 0; i < width; i++ )
+      {
+        pDst[i] = ( pSrc[2 * i            ] * 2 + pSrc[2 * i + 1            ] + pSrc[2 * i - 1            ]
+                  + pSrc[2 * i + srcStride] * 2 + pSrc[2 * i + 1 + srcStride] + pSrc[2 * i - 1 + srcStride]
+                  + 4 ) >> 3;
+      }
+    }
+    break;
+  default:
+    THROW( "Invalid luma downsampling filter" );
+  }
+}
+
 void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chromaArea)
 {
   int iDstStride = 0;
@@ -1638,6 +1770,22 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
   }
 #endif //JVET_N0671_CCLM
 
+  const bool isCollocated = pu.cs->sps->getCclmCollocatedChromaFlag();
+
+  LumaDownsampleFilter innerFilter    = isCollocated ? LUMA_DS_5TAP : LUMA_DS_6TAP;
+  LumaDownsampleFilter firstRowFilter = LUMA_DS_3TAP;
+#if JVET_N0671_CCLM
+  if( CHROMA_444 == pu.chromaFormat )
+  {
+    innerFilter    = LUMA_DS_COPY;
+    firstRowFilter = LUMA_DS_COPY;
+  }
+  else if( CHROMA_422 == pu.chromaFormat )
+  {
+    innerFilter    = isCollocated ? LUMA_DS_2TO1 : LUMA_DS_3TAP;
+  }
+#endif //JVET_N0671_CCLM
+
   if( bAboveAvaillable )
   {
     pDst  = pDst0    - iDstStride;
@@ -1646,92 +1794,40 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
     {
       addedAboveRight = avaiAboveRightUnits*chromaUnitWidth;
     }
-    for (int i = 0; i < uiCWidth + addedAboveRight; i++)
+
+    if (isFirstRowOfCtu)
+    {
+      piSrc = pRecSrc0 - iRecStride;
+      m_downsampleLuma( piSrc, iRecStride, pDst, iDstStride, uiCWidth + addedAboveRight, 1, firstRowFilter );
+    }
+    else
+    {
+      piSrc = pRecSrc0 - iRecStride2;
+      m_downsampleLuma( piSrc, iRecStride, pDst, iDstStride, uiCWidth + addedAboveRight, 1, innerFilter );
+    }
+
+    // the first sample uses a shorter filter without the left neighbour
+    if (!bLeftAvaillable)
     {
       if (isFirstRowOfCtu)
       {
-        piSrc = pRecSrc0 - iRecStride;
-
-#if JVET_N0671_CCLM
-        if ((i == 0 && !bLeftAvaillable) || (i == uiCWidth + addedAboveRight - 1 + logSubWidthC))
-#else //!JVET_N0671_CCLM
-        if (i == 0 && !bLeftAvaillable)
-#endif //JVET_N0671_CCLM
-        {
-#if JVET_N0671_CCLM
-          pDst[i] = piSrc[mult * i];
-#else //!JVET_N0671_CCLM
-          pDst[i] = piSrc[2 * i];
-#endif //JVET_N0671_CCLM
-        }
-        else
-        {
-#if JVET_N0671_CCLM
-          pDst[i] = (piSrc[mult * i] * c0_3tap + piSrc[mult * i - 1] * c1_3tap + piSrc[mult * i + 1] * c2_3tap + offset_3tap) >> shift_3tap;
-#else //!JVET_N0671_CCLM
-          pDst[i] = ( piSrc[2 * i] * 2 + piSrc[2 * i - 1] + piSrc[2 * i + 1] + 2 ) >> 2;
-#endif //JVET_N0671_CCLM
-        }
+        pDst[0] = piSrc[0];
       }
-      else if( pu.cs->sps->getCclmCollocatedChromaFlag() )
+      else if (isCollocated)
       {
-        piSrc = pRecSrc0 - iRecStride2;
-
-#if JVET_N0671_CCLM
-        if ((i == 0 && !bLeftAvaillable) || (i == uiCWidth + addedAboveRight - 1 + logSubWidthC))
-#else //!JVET_N0671_CCLM
-        if( i == 0 && !bLeftAvaillable )
-#endif //JVET_N0671_CCLM
-        {
 #if JVET_N0671_CCLM
-          pDst[i] = (piSrc[mult * i] * c0_3tap + piSrc[mult * i - strOffset] * c1_3tap + piSrc[mult * i + strOffset] * c2_3tap + offset_3tap) >> shift_3tap;
+        pDst[0] = (piSrc[0] * c0_3tap + piSrc[-strOffset] * c1_3tap + piSrc[strOffset] * c2_3tap + offset_3tap) >> shift_3tap;
 #else //!JVET_N0671_CCLM
-          pDst[i] = ( piSrc[2 * i] * 2 + piSrc[2 * i - iRecStride] + piSrc[2 * i + iRecStride] + 2 ) >> 2;
-#endif //JVET_N0671_CCLM
-        }
-        else
-        {
-#if JVET_N0671_CCLM
-          pDst[i] = (piSrc[mult * i - strOffset] * c0_5tap
-                  +  piSrc[mult * i]             * c1_5tap + piSrc[mult * i - 1] * c2_5tap + piSrc[mult * i + 1] * c3_5tap
-                  +  piSrc[mult * i + strOffset] * c4_5tap
-                  +  offset_5tap) >> shift_5tap;
-#else //!JVET_N0671_CCLM
-          pDst[i] = ( piSrc[2 * i - iRecStride]
-                    + piSrc[2 * i             ] * 4 + piSrc[2 * i - 1] + piSrc[2 * i + 1]
-                    + piSrc[2 * i + iRecStride]
-                    + 4 ) >> 3;
+        pDst[0] = ( piSrc[0] * 2 + piSrc[-iRecStride] + piSrc[iRecStride] + 2 ) >> 2;
 #endif //JVET_N0671_CCLM
-        }
       }
       else
       {
-        piSrc = pRecSrc0 - iRecStride2;
-
 #if JVET_N0671_CCLM
-        if ((i == 0 && !bLeftAvaillable) || (i == uiCWidth + addedAboveRight - 1 + logSubWidthC))
+        pDst[0] = (piSrc[0] * c0_2tap + piSrc[strOffset] * c1_2tap + offset_2tap) >> shift_2tap;
 #else //!JVET_N0671_CCLM
-        if (i == 0 && !bLeftAvaillable)
-#endif //JVET_N0671_CCLM
-        {
-#if JVET_N0671_CCLM
-          pDst[i] = (piSrc[mult * i] * c0_2tap + piSrc[mult * i + strOffset] * c1_2tap + offset_2tap) >> shift_2tap;
-#else //!JVET_N0671_CCLM
-          pDst[i] = ( piSrc[2 * i] + piSrc[2 * i + iRecStride] + 1 ) >> 1;
-#endif //JVET_N0671_CCLM
-        }
-        else
-        {
-#if JVET_N0671_CCLM
-          pDst[i] = ((piSrc[mult * i]            * c0_6tap + piSrc[mult * i - 1]             * c1_6tap + piSrc[mult * i + 1]             * c2_6tap)
-                  + (piSrc[mult * i + strOffset] * c3_6tap + piSrc[mult * i - 1 + strOffset] * c4_6tap + piSrc[mult * i + 1 + strOffset] * c5_6tap)
-                  + offset_6tap) >> shift_6tap;
-#else //!JVET_N0671_CCLM
-          pDst[i] = ( ( ( piSrc[2 * i             ] * 2 ) + piSrc[2 * i - 1             ] + piSrc[2 * i + 1             ] )
-                    + ( ( piSrc[2 * i + iRecStride] * 2 ) + piSrc[2 * i - 1 + iRecStride] + piSrc[2 * i + 1 + iRecStride] )
-                    + 4 ) >> 3;
+        pDst[0] = ( piSrc[0] + piSrc[iRecStride] + 1 ) >> 1;
 #endif //JVET_N0671_CCLM
-        }
       }
     }
   }
@@ -1754,7 +1850,7 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
 
     for (int j = 0; j < uiCHeight + addedLeftBelow; j++)
     {
-      if( pu.cs->sps->getCclmCollocatedChromaFlag() )
+      if( isCollocated )
       {
 #if JVET_N0671_CCLM
         if ((j == 0 && !bAboveAvaillable) || (j == uiCHeight + addedLeftBelow - 1 + logSubWidthC))
@@ -1799,12 +1895,22 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
     }
   }
 
-  // inner part from reconstructed picture buffer
+  // inner part from reconstructed picture buffer, the samples at the left and top border that fall back to
+  // shorter filters without the neighbouring reconstruction are overwritten below
+  m_downsampleLuma( pRecSrc0, iRecStride, pDst0, iDstStride, uiCWidth, uiCHeight, innerFilter );
+
   for( int j = 0; j < uiCHeight; j++ )
   {
-    for( int i = 0; i < uiCWidth; i++ )
+    const int numBorder = ( isCollocated && j == 0 && !bAboveAvaillable ) ? uiCWidth : ( bLeftAvaillable ? 0 : 1 );
+
+    if( numBorder == 0 )
+    {
+      break;
+    }
+
+    for( int i = 0; i < numBorder; i++ )
     {
-      if( pu.cs->sps->getCclmCollocatedChromaFlag() )
+      if( isCollocated )
       {
         if( i == 0 && !bLeftAvaillable )
         {
@@ -1825,60 +1931,22 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
 #endif //JVET_N0671_CCLM
           }
         }
-#if JVET_N0671_CCLM
-        else if ( j == 0 && !bAboveAvaillable )
-#else //JVET_N0671_CCLM
-        else if ( j == 0 && !bAboveAvaillable )
-#endif //JVET_N0671_CCLM
+        else
         {
 #if JVET_N0671_CCLM
           pDst0[i] = (pRecSrc0[mult * i] * c0_3tap + pRecSrc0[mult * i - 1] * c1_3tap + pRecSrc0[mult * i + 1] * c2_3tap + offset_3tap) >> shift_3tap;
 #else //!JVET_N0671_CCLM
           pDst0[i] = ( pRecSrc0[2 * i] * 2 + pRecSrc0[2 * i - 1] + pRecSrc0[2 * i + 1] + 2 ) >> 2;
-#endif //JVET_N0671_CCLM
-        }
-        else
-        {
-#if JVET_N0671_CCLM
-          pDst0[i] = (pRecSrc0[mult * i - strOffset] * c0_5tap
-                   +  pRecSrc0[mult * i]             * c1_5tap + pRecSrc0[mult * i - 1] * c2_5tap + pRecSrc0[mult * i + 1] * c3_5tap
-                   +  pRecSrc0[mult * i + strOffset] * c4_5tap
-                   +  offset_5tap) >> shift_5tap;
-#else //!JVET_N0671_CCLM
-          pDst0[i] = ( pRecSrc0[2 * i - iRecStride]
-                     + pRecSrc0[2 * i             ] * 4 + pRecSrc0[2 * i - 1] + pRecSrc0[2 * i + 1]
-                     + pRecSrc0[2 * i + iRecStride]
-                     + 4 ) >> 3;
 #endif //JVET_N0671_CCLM
         }
       }
       else
       {
-
 #if JVET_N0671_CCLM
-        if ((i == 0 && !bLeftAvaillable) || (i == uiCWidth - 1 + logSubWidthC))
-#else //JVET_N0671_CCLM
-        if ( i == 0 && !bLeftAvaillable )
-#endif //JVET_N0671_CCLM
-        {
-#if JVET_N0671_CCLM
-          pDst0[i] = (pRecSrc0[mult * i] * c0_2tap + pRecSrc0[mult * i + strOffset] * c1_2tap + offset_2tap) >> shift_2tap;
+        pDst0[i] = (pRecSrc0[mult * i] * c0_2tap + pRecSrc0[mult * i + strOffset] * c1_2tap + offset_2tap) >> shift_2tap;
 #else //!JVET_N0671_CCLM
-          pDst0[i] = ( pRecSrc0[2 * i] + pRecSrc0[2 * i + iRecStride] + 1 ) >> 1;
+        pDst0[i] = ( pRecSrc0[2 * i] + pRecSrc0[2 * i + iRecStride] + 1 ) >> 1;
 #endif //JVET_N0671_CCLM
-        }
-        else
-        {
-#if JVET_N0671_CCLM
-          pDst0[i] = (pRecSrc0[mult * i]             * c0_6tap + pRecSrc0[mult * i + 1]             * c1_6tap + pRecSrc0[mult * i - 1]             * c2_6tap
-                    + pRecSrc0[mult * i + strOffset] * c3_6tap + pRecSrc0[mult * i + 1 + strOffset] * c4_6tap + pRecSrc0[mult * i - 1 + strOffset] * c5_6tap
-                    + offset_6tap) >> shift_6tap;
-#else //!JVET_N0671_CCLM
-          pDst0[i] = ( pRecSrc0[2 * i             ] * 2 + pRecSrc0[2 * i + 1             ] + pRecSrc0[2 * i - 1             ]
-                     + pRecSrc0[2 * i + iRecStride] * 2 + pRecSrc0[2 * i + 1 + iRecStride] + pRecSrc0[2 * i - 1 + iRecStride]
-                     + 4 ) >> 3;
-#endif //JVET_N0671_CCLM
-        }
       }
     }
 
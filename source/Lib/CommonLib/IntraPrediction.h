@@ -65,6 +65,15 @@ enum PredBuf
 
 static const uint32_t MAX_INTRA_FILTER_DEPTHS=8;
 
+enum LumaDownsampleFilter // CCLM downsampling of the co-located luma onto the chroma sampling grid
+{
+  LUMA_DS_COPY = 0,       // 4:4:4
+  LUMA_DS_2TO1 = 1,       // every second sample of a row, collocated 4:2:2
+  LUMA_DS_3TAP = 2,       // horizontal [1 2 1] / 4, 4:2:2 and the above template in the first CTU row
+  LUMA_DS_5TAP = 3,       // cross [1; 1 4 1; 1] / 8, collocated 4:2:0
+  LUMA_DS_6TAP = 4,       // [1 2 1; 1 2 1] / 8, 4:2:0
+};
+
 class IntraPrediction
 {
 private:
@@ -103,6 +112,17 @@ private:
 
   IntraPredParam m_ipaParam;
 
+  struct IntraPredAngPlan // block-size dependent parameters of an intra mode, precomputed by getAngPlan
+  {
+    int16_t predMode;       // mode after the wide-angle mapping
+    int16_t intraPredAngle;
+    int16_t invAngle;
+    int16_t absAng;
+    bool    isModeVer;
+  };
+
+  static const IntraPredAngPlan& getAngPlan( const int dirMode, const int width, const int height );
+
   Pel* m_piTemp;
   Pel* m_pMdlmTemp; // for MDLM mode
 #if JVET_N0217_MATRIX_INTRAPRED
@@ -116,7 +136,6 @@ protected:
   int m_topRefLength;
   int m_leftRefLength;
   // prediction
-  void xPredIntraPlanar           ( const CPelBuf &pSrc, PelBuf &pDst );
   void xPredIntraDc               ( const CPelBuf &pSrc, PelBuf &pDst, const ChannelType channelType, const bool enableBoundaryFilter = true );
   void xPredIntraAng              ( const CPelBuf &pSrc, PelBuf &pDst, const ChannelType channelType, const ClpRng& clpRng);
 
@@ -144,10 +163,32 @@ protected:
   void destroy                    ();
 
   void xGetLMParameters(const PredictionUnit &pu, const ComponentID compID, const CompArea& chromaArea, int& a, int& b, int& iShift);
+
+  void ( *m_predIntraPlanar )( const CPelBuf &pSrc, PelBuf &pDst );
+  void ( *m_predIntraAng4Tap )( Pel* pDst, const int dstStride, const Pel* refMain, const int width, const int height, const int deltaPos, const int intraPredAngle, const TFilterCoeff* filter, const bool useClip, const ClpRng& clpRng );
+  void ( *m_predIntraAng2Tap )( Pel* pDst, const int dstStride, const Pel* refMain, const int width, const int height, const int deltaPos, const int intraPredAngle );
+  void ( *m_pdpcPlanarDc )( const CPelBuf &pSrc, PelBuf &pDst, const bool isDc, const ClpRng& clpRng );
+  void ( *m_downsampleLuma )( const Pel* pSrc, const int srcStride, Pel* pDst, const int dstStride, const int width, const int height, const LumaDownsampleFilter filter );
 public:
   IntraPrediction();
   virtual ~IntraPrediction();
 
+  // prediction kernels, refMain points to the main reference line with refMain[1] above (left of) the first sample
+  // and filter to the 32 x 4 coefficient table of the fractional positions
+  static void predIntraPlanarCore ( const CPelBuf &pSrc, PelBuf &pDst );
+  static void predIntraAng4TapCore( Pel* pDst, const int dstStride, const Pel* refMain, const int width, const int height, const int deltaPos, const int intraPredAngle, const TFilterCoeff* filter, const bool useClip, const ClpRng& clpRng );
+  static void predIntraAng2TapCore( Pel* pDst, const int dstStride, const Pel* refMain, const int width, const int height, const int deltaPos, const int intraPredAngle );
+  static void pdpcPlanarDcCore    ( const CPelBuf &pSrc, PelBuf &pDst, const bool isDc, const ClpRng& clpRng );
+  // CCLM kernel, pSrc points to the luma sample co-located with the first chroma sample of each output row and
+  // advances by two luma rows per output row for the 4:2:0 filters
+  static void downsampleLumaCore  ( const Pel* pSrc, const int srcStride, Pel* pDst, const int dstStride, const int width, const int height, const LumaDownsampleFilter filter );
+
+#if ENABLE_SIMD_OPT_INTRAPRED && defined(TARGET_SIMD_X86)
+  void initIntraPredictionX86();
+  template <X86_VEXT vext>
+  void _initIntraPredictionX86();
+#endif
+
   void init                       (ChromaFormat chromaFormatIDC, const unsigned bitDepthY);
 
   // Angular Intra
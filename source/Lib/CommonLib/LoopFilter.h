@@ -47,6 +47,67 @@
 
 #define DEBLOCK_SMALLEST_BLOCK  8
 
+/// filter selection and thresholds of one edge segment, shared by all its lines
+struct DeblockParam
+{
+  int  tc;
+  int  thrCut;          ///< luma weak filter: threshold of the per-line on/off decision
+  bool strong;          ///< strong (or long) filter instead of the weak filter
+  bool filterSecondP;   ///< luma weak filter: p1 is modified
+  bool filterSecondQ;   ///< luma weak filter: q1 is modified
+  bool partPNoFilter;   ///< samples on the P side are left unchanged (PCM or lossless)
+  bool partQNoFilter;   ///< samples on the Q side are left unchanged (PCM or lossless)
+  int  lengthP;         ///< luma long filter: number of modified samples on the P side (3, 5 or 7), 0 otherwise
+  int  lengthQ;         ///< luma long filter: number of modified samples on the Q side (3, 5 or 7), 0 otherwise
+
+  bool operator==( const DeblockParam& other ) const
+  {
+    return tc == other.tc && thrCut == other.thrCut && strong == other.strong && filterSecondP == other.filterSecondP && filterSecondQ == other.filterSecondQ
+        && partPNoFilter == other.partPNoFilter && partQNoFilter == other.partQNoFilter && lengthP == other.lengthP && lengthQ == other.lengthQ;
+  }
+};
+
+typedef void DeblockLinesFunc( Pel* src, const int offset, const int step, const int numLines, const DeblockParam& param, const ClpRng& clpRng );
+
+/// consecutive lines along one edge that are filtered together, segments with equal parameters are merged before filtering
+struct DeblockLineBatch
+{
+  DeblockLineBatch( DeblockLinesFunc* func, const int offset, const int step, const ClpRng& clpRng )
+    : filterLines( func ), src( nullptr ), numLines( 0 ), offset( offset ), step( step ), clpRng( clpRng ) {}
+  ~DeblockLineBatch() { flush(); }
+
+  void add( Pel* lineSrc, const int lines, const DeblockParam& lineParam )
+  {
+    if( numLines && ( src + numLines * step != lineSrc || !( param == lineParam ) ) )
+    {
+      flush();
+    }
+    if( !numLines )
+    {
+      src   = lineSrc;
+      param = lineParam;
+    }
+    numLines += lines;
+  }
+
+  void flush()
+  {
+    if( numLines )
+    {
+      filterLines( src, offset, step, numLines, param, clpRng );
+      numLines = 0;
+    }
+  }
+
+  DeblockLinesFunc* filterLines;
+  Pel*              src;
+  int               numLines;
+  const int         offset;
+  const int         step;
+  const ClpRng&     clpRng;
+  DeblockParam      param;
+};
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -96,10 +157,10 @@ private:
   void xSetMaxFilterLengthPQForCodingSubBlocks( const DeblockEdgeDir edgeDir, const CodingUnit& cu, const PredictionUnit& currPU, const bool& mvSubBlocks, const int& subBlockSize, const Area& areaPu );
 #endif
 
-  inline void xBilinearFilter     ( Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc ) const;
-  inline void xFilteringPandQ     ( Pel* src, int offset, int numberPSide, int numberQSide, int tc ) const;
-  inline void xPelFilterLuma      ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge = false, bool sideQisLarge = false, int maxFilterLengthP = 7, int maxFilterLengthQ = 7 ) const;
-  inline void xPelFilterChroma    ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary ) const;
+  static inline void xBilinearFilter  ( Pel* srcP, Pel* srcQ, int offset, int refMiddle, int refP, int refQ, int numberPSide, int numberQSide, const int* dbCoeffsP, const int* dbCoeffsQ, int tc );
+  static inline void xFilteringPandQ  ( Pel* src, int offset, int numberPSide, int numberQSide, int tc );
+  static inline void xPelFilterLuma   ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const int iThrCut, const bool bFilterSecondP, const bool bFilterSecondQ, const ClpRng& clpRng, bool sidePisLarge = false, bool sideQisLarge = false, int maxFilterLengthP = 7, int maxFilterLengthQ = 7 );
+  static inline void xPelFilterChroma ( Pel* piSrc, const int iOffset, const int tc, const bool sw, const bool bPartPNoFilter, const bool bPartQNoFilter, const ClpRng& clpRng, const bool largeBoundary );
   inline bool xUseStrongFiltering ( Pel* piSrc, const int iOffset, const int d, const int beta, const int tc, bool sidePisLarge = false, bool sideQisLarge = false, int maxFilterLengthP = 7, int maxFilterLengthQ = 7 ) const;//move the computation outside the function
   inline unsigned BsSet(unsigned val, const ComponentID compIdx) const;
   inline unsigned BsGet(unsigned val, const ComponentID compIdx) const;
@@ -114,11 +175,24 @@ private:
   static const uint8_t sm_tcTable[MAX_QP + 3];
   static const uint8_t sm_betaTable[MAX_QP + 1];
 
+  DeblockLinesFunc* m_filterLumaLines;
+  DeblockLinesFunc* m_filterChromaLines;
+
 public:
 
   LoopFilter();
   ~LoopFilter();
 
+  /// scalar deblocking of numLines lines starting at src, step is the distance between lines and offset the one between samples across the edge
+  static void filterLumaLinesCore  ( Pel* src, const int offset, const int step, const int numLines, const DeblockParam& param, const ClpRng& clpRng );
+  static void filterChromaLinesCore( Pel* src, const int offset, const int step, const int numLines, const DeblockParam& param, const ClpRng& clpRng );
+
+#if ENABLE_SIMD_OPT_DBLF && defined(TARGET_SIMD_X86)
+  void initLoopFilterX86();
+  template <X86_VEXT vext>
+  void _initLoopFilterX86();
+#endif
+
   /// CU-level deblocking function
   void xDeblockCU(CodingUnit& cu, const DeblockEdgeDir edgeDir);
   void  initEncPicYuvBuffer(ChromaFormat chromaFormat, int lumaWidth, int lumaHeight);
@@ -131,6 +205,8 @@ public:
   /// picture-level deblocking filter
   void loopFilterPic              ( CodingStructure& cs
                                     );
+  /// deblocking of the edges of one direction in a CTU row
+  void loopFilterCtuRow           ( CodingStructure& cs, const DeblockEdgeDir edgeDir, const int ctuRow );
 
   static int getBeta              ( const int qp )
   {
@@ -58,6 +58,12 @@ namespace Mip
     m_upsmpFactorHor( 0 ),
     m_upsmpFactorVer( 0 )
   {
+    m_computeMatrixTimesRedBndry = computeMatrixTimesRedBndryCore;
+    m_predictionUpsampling       = predictionUpsamplingCore;
+
+#if ENABLE_SIMD_OPT_MIP && defined(TARGET_SIMD_X86)
+    initPredictorMipX86();
+#endif
   }
 
 
@@ -145,10 +151,9 @@ namespace Mip
     }
   }
 
-  void PredictorMIP::getPrediction(int* const result, const int modeIdx, const int bitDepth)
+  void PredictorMIP::getPrediction(PelBuf& dst, const int modeIdx, const int bitDepth)
   {
     const bool transpose = isTransposed( modeIdx );
-    const bool needUpsampling = ( m_upsmpFactorHor > 1 ) || ( m_upsmpFactorVer > 1 );
 
     const short* matrix;
     const short* bias;
@@ -165,18 +170,16 @@ namespace Mip
       std::swap(leaveHorOut, leaveVerOut);
     }
     static_vector<int, MIP_MAX_REDUCED_OUTPUT_SAMPLES> bufReducedPred( m_reducedPredictionSize.area() );
-    int* const       reducedPred     = needUpsampling ? bufReducedPred.data() : result;
+    int* const       reducedPred     = bufReducedPred.data();
     const int* const reducedBoundary = transpose ? m_reducedBoundaryTransposed.data() : m_reducedBoundary.data();
     xComputeMatrixTimesRedBndryPlusBias( reducedPred, reducedBoundary, matrix, bias,
                                          leaveHorOut, leaveVerOut,
                                          shiftMatrix, shiftBias,
-                                         transpose, needUpsampling );
-    // Reduced prediction is transposed if ( transpose && needUpsampling ).
+                                         transpose );
 
-    if( needUpsampling )
-    {
-      predictionUpsampling( result, reducedPred, transpose );
-    }
+    // upsampling (if needed) and clipping to the sample range
+    m_predictionUpsampling( dst.buf, dst.stride, reducedPred, m_reducedPredictionSize, m_blockSize,
+                            m_boundaryForUpsamplingTop.data(), m_boundaryForUpsamplingLeft.data(), bitDepth );
   }
 
   bool PredictorMIP::isTransposed( const int modeIdx ) const
@@ -341,26 +344,35 @@ namespace Mip
   }
 
 
-  void PredictorMIP::predictionUpsampling( int* const dst, const int* const src, const bool transpose ) const
+  void PredictorMIP::predictionUpsamplingCore( Pel* dst, const int dstStride, const int* const src, const Size& reducedSize,
+                                               const Size& blockSize, const int* const bndryTop, const int* const bndryLeft, const int bitDepth )
   {
+    const unsigned int upsmpFactorHor = blockSize.width  / reducedSize.width;
+    const unsigned int upsmpFactorVer = blockSize.height / reducedSize.height;
+
+    static_vector<int, MIP_MAX_WIDTH * MIP_MAX_HEIGHT> bufUpsampled( blockSize.area() );
+    const int* result = bufUpsampled.data();
+
+    if( upsmpFactorHor == 1 && upsmpFactorVer == 1 )
+    {
+      result = src;
+    }
     // shorter side is upsampled first
-    if( m_blockSize.height > m_blockSize.width )
+    else if( blockSize.height > blockSize.width )
     {
+      int* const upsampled    = bufUpsampled.data();
       const int* verSrc       = nullptr;
       SizeType   verSrcStep   = 0;
       SizeType   verSrcStride = 0;
-      if( m_upsmpFactorHor > 1 )
+      if( upsmpFactorHor > 1 )
       {
-        const SizeType horSrcStep   = transpose ? m_reducedPredictionSize.height : 1;
-        const SizeType horSrcStride = transpose ? 1 : m_reducedPredictionSize.width;
-
-        int* const     horDst       = dst + ( m_upsmpFactorVer - 1 ) * m_blockSize.width;
-        const SizeType horDstStride = m_upsmpFactorVer * m_blockSize.width;
+        int* const     horDst       = upsampled + ( upsmpFactorVer - 1 ) * blockSize.width;
+        const SizeType horDstStride = upsmpFactorVer * blockSize.width;
 
-        predictionUpsampling1D( horDst, src, m_boundaryForUpsamplingLeft.data(),
-                                m_reducedPredictionSize.width, m_reducedPredictionSize.height,
-                                horSrcStep, horSrcStride, 1, horDstStride,
-                                m_upsmpFactorHor );
+        predictionUpsampling1D( horDst, src, bndryLeft,
+                                reducedSize.width, reducedSize.height,
+                                1, reducedSize.width, 1, horDstStride,
+                                upsmpFactorHor );
 
         verSrc       = horDst;
         verSrcStep   = horDstStride;
@@ -369,47 +381,53 @@ namespace Mip
       else
       {
         verSrc       = src;
-        verSrcStep   = transpose ? 1 : m_blockSize.width;
-        verSrcStride = transpose ? m_reducedPredictionSize.height : 1;
+        verSrcStep   = blockSize.width;
+        verSrcStride = 1;
       }
-      predictionUpsampling1D( dst, verSrc, m_boundaryForUpsamplingTop.data(),
-                              m_reducedPredictionSize.height, m_blockSize.width,
-                              verSrcStep, verSrcStride, m_blockSize.width, 1,
-                              m_upsmpFactorVer );
+      predictionUpsampling1D( upsampled, verSrc, bndryTop,
+                              reducedSize.height, blockSize.width,
+                              verSrcStep, verSrcStride, blockSize.width, 1,
+                              upsmpFactorVer );
     }
     else
     {
-      const int* horSrc = nullptr;
-      SizeType   horSrcStep = 0;
+      int* const upsampled    = bufUpsampled.data();
+      const int* horSrc       = nullptr;
+      SizeType   horSrcStep   = 0;
       SizeType   horSrcStride = 0;
-      if( m_upsmpFactorVer > 1 )
+      if( upsmpFactorVer > 1 )
       {
-        const SizeType verSrcStep   = transpose ? 1 : m_reducedPredictionSize.width;
-        const SizeType verSrcStride = transpose ? m_reducedPredictionSize.height : 1;
+        int* const     verDst       = upsampled + ( upsmpFactorHor - 1 );
+        const SizeType verDstStep   = blockSize.width;
+        const SizeType verDstStride = upsmpFactorHor;
 
-        int* const     verDst       = dst + ( m_upsmpFactorHor - 1 );
-        const SizeType verDstStep   = m_blockSize.width;
-        const SizeType verDstStride = m_upsmpFactorHor;
+        predictionUpsampling1D( verDst, src, bndryTop,
+                                reducedSize.height, reducedSize.width,
+                                reducedSize.width, 1, verDstStep, verDstStride,
+                                upsmpFactorVer );
 
-        predictionUpsampling1D( verDst, src, m_boundaryForUpsamplingTop.data(),
-                                m_reducedPredictionSize.height, m_reducedPredictionSize.width,
-                                verSrcStep, verSrcStride, verDstStep, verDstStride,
-                                m_upsmpFactorVer );
-
-        horSrc = verDst;
-        horSrcStep = verDstStride;
+        horSrc       = verDst;
+        horSrcStep   = verDstStride;
         horSrcStride = verDstStep;
       }
       else
       {
         horSrc       = src;
-        horSrcStep   = transpose ? m_blockSize.height : 1;
-        horSrcStride = transpose ? 1 : m_reducedPredictionSize.width;
+        horSrcStep   = 1;
+        horSrcStride = reducedSize.width;
+      }
+      predictionUpsampling1D( upsampled, horSrc, bndryLeft,
+                              reducedSize.width, blockSize.height,
+                              horSrcStep, horSrcStride, 1, blockSize.width,
+                              upsmpFactorHor );
+    }
+
+    for( int y = 0; y < blockSize.height; y++ )
+    {
+      for( int x = 0; x < blockSize.width; x++ )
+      {
+        dst[y * dstStride + x] = Pel( ClipBD<int>( result[y * blockSize.width + x], bitDepth ) );
       }
-      predictionUpsampling1D( dst, horSrc, m_boundaryForUpsamplingLeft.data(),
-                              m_reducedPredictionSize.width, m_blockSize.height,
-                              horSrcStep, horSrcStride, 1, m_blockSize.width,
-                              m_upsmpFactorHor );
     }
   }
 
@@ -455,33 +473,20 @@ namespace Mip
     }
   }
 
-  void PredictorMIP::xComputeMatrixTimesRedBndryPlusBias( int*const result, const int* const input,
-                                                          const short*matrix, const short*bias,
-                                                          const bool leaveHorOut, const bool leaveVerOut,
-                                                          const int shiftMatrix, const int shiftBias,
-                                                          const bool transpose, const bool needUpsampling )
+  void PredictorMIP::computeMatrixTimesRedBndryCore( int* const result, const int* const input, const int inputSize,
+                                                     const short* matrix, const short* bias, const int width, const int height,
+                                                     const int xStep, const int yStep, const int shiftMatrix, const int shiftBias )
   {
-    const int inputSize = m_reducedBoundarySize.width + m_reducedBoundarySize.height;
-
-    // Use local buffer for transposed result if no upsampling will be done.
-    static_vector<int, MIP_MAX_REDUCED_OUTPUT_SAMPLES> resBufTransposed( m_reducedPredictionSize.area() );
-    int*const resPtr = (transpose && !needUpsampling) ? resBufTransposed.data() : result;
-
     const int offset = 1 << (shiftMatrix - 1);
     CHECK(inputSize != 4 * (inputSize >> 2), "Error, input size not divisible by four");
 
     const short *weight = matrix;
 
-    const int intermediateWidth  = transpose ? m_reducedPredictionSize.height : m_reducedPredictionSize.width;
-    const int intermediateHeight = transpose ? m_reducedPredictionSize.width : m_reducedPredictionSize.height;
-    const int xStep = leaveHorOut ? 2 : 1;
-    const int yStep = leaveVerOut ? intermediateWidth : 0;
-
     int posRes  = 0;
     int posBias = 0;
-    for (int y = 0; y < intermediateHeight; y++)
+    for (int y = 0; y < height; y++)
     {
-      for (int x = 0; x < intermediateWidth; x++)
+      for (int x = 0; x < width; x++)
       {
         int tmp0 = 0;
         int tmp1 = 0;
@@ -494,7 +499,7 @@ namespace Mip
           tmp2 += input[i + 2] * weight[i + 2];
           tmp3 += input[i + 3] * weight[i + 3];
         }
-        resPtr[posRes++] = ((tmp0 + tmp1 + tmp2 + tmp3) + (bias[posBias] << shiftBias) + offset) >> shiftMatrix;
+        result[posRes++] = ((tmp0 + tmp1 + tmp2 + tmp3) + (bias[posBias] << shiftBias) + offset) >> shiftMatrix;
 
         weight  += xStep * inputSize;
         posBias += xStep;
@@ -502,9 +507,29 @@ namespace Mip
       weight  += yStep * inputSize;
       posBias += yStep;
     }
+  }
 
-    // Re-transpose if no upsampling will be done.
-    if( transpose && !needUpsampling )
+  void PredictorMIP::xComputeMatrixTimesRedBndryPlusBias( int*const result, const int* const input,
+                                                          const short*matrix, const short*bias,
+                                                          const bool leaveHorOut, const bool leaveVerOut,
+                                                          const int shiftMatrix, const int shiftBias,
+                                                          const bool transpose )
+  {
+    const int inputSize = m_reducedBoundarySize.width + m_reducedBoundarySize.height;
+
+    // Use local buffer for transposed result.
+    static_vector<int, MIP_MAX_REDUCED_OUTPUT_SAMPLES> resBufTransposed( m_reducedPredictionSize.area() );
+    int*const resPtr = transpose ? resBufTransposed.data() : result;
+
+    const int intermediateWidth  = transpose ? m_reducedPredictionSize.height : m_reducedPredictionSize.width;
+    const int intermediateHeight = transpose ? m_reducedPredictionSize.width : m_reducedPredictionSize.height;
+    const int xStep = leaveHorOut ? 2 : 1;
+    const int yStep = leaveVerOut ? intermediateWidth : 0;
+
+    m_computeMatrixTimesRedBndry( resPtr, input, inputSize, matrix, bias, intermediateWidth, intermediateHeight, xStep, yStep, shiftMatrix, shiftBias );
+
+    // Re-transpose so that the reduced prediction is always stored row by row.
+    if( transpose )
     {
       for( int y = 0; y < m_reducedPredictionSize.height; y++ )
       {
@@ -531,17 +556,8 @@ void MatrixIntraPrediction::prepareInputForPred(const CPelBuf &src, const Area&
 
 void MatrixIntraPrediction::predBlock( const Size &puSize, const int intraMode, PelBuf& dst, const int bitDepth )
 {
-  static_vector<int, MIP_MAX_WIDTH * MIP_MAX_HEIGHT> predMip(puSize.area());
-  int* const resultMip = predMip.data();
-  m_predictorMip.getPrediction(resultMip, intraMode, bitDepth);
-
-  for (int y = 0; y < puSize.height; y++)
-  {
-    for (int x = 0; x < puSize.width; x++)
-    {
-      dst.at(x, y) = Pel(ClipBD<int>(resultMip[y * puSize.width + x], bitDepth));
-    }
-  }
+  CHECKD( dst.width != puSize.width || dst.height != puSize.height, "Error: prediction buffer size mismatch" );
+  m_predictorMip.getPrediction(dst, intraMode, bitDepth);
 }
 
 #endif
@@ -53,7 +53,21 @@ namespace Mip
   public:
     PredictorMIP();
     void             deriveBoundaryData(const CPelBuf& src, const Area& block, const int bitDepth, const AvailableInfo &availInfo);
-    void             getPrediction     (int* const result, const int modeIdx, const int bitDepth);
+    void             getPrediction     (PelBuf& dst, const int modeIdx, const int bitDepth);
+
+    // kernels, the matrix rows of output line y start at row y * ( width * xStep + yStep ) and are xStep apart,
+    // the reduced prediction src is stored row by row
+    static void computeMatrixTimesRedBndryCore( int* const result, const int* const input, const int inputSize,
+                                                const short* matrix, const short* bias, const int width, const int height,
+                                                const int xStep, const int yStep, const int shiftMatrix, const int shiftBias );
+    static void predictionUpsamplingCore      ( Pel* dst, const int dstStride, const int* const src, const Size& reducedSize,
+                                                const Size& blockSize, const int* const bndryTop, const int* const bndryLeft, const int bitDepth );
+
+#if ENABLE_SIMD_OPT_MIP && defined(TARGET_SIMD_X86)
+    void initPredictorMipX86();
+    template <X86_VEXT vext>
+    void _initPredictorMipX86();
+#endif
 
   private:
     static_vector<int, MIP_MAX_INPUT_SIZE> m_reducedBoundary;           // downsampled             boundary of a block
@@ -74,7 +88,6 @@ namespace Mip
     static void boundaryDownsampling1D( int* reducedDst, int* fullSrcAndIntermediateDst, const SizeType srcLen, const SizeType dstLen, const bool saveIntermediate, const SizeType intermediateLen );
     static void doDownsampling( int* dst, const int* src, const SizeType srcLen, const SizeType dstLen );
 
-    void predictionUpsampling( int* const dst, const int* const src, const bool transpose ) const;
     static void predictionUpsampling1D( int* const dst, const int* const src, const int* const bndry,
                                         const SizeType srcSizeUpsmpDim, const SizeType srcSizeOrthDim,
                                         const SizeType srcStep, const SizeType srcStride,
@@ -91,7 +104,13 @@ namespace Mip
                                               const short*matrix, const short*bias,
                                               const bool leaveHorOut, const bool leaveVerOut,
                                               const int shiftMatrix, const int shiftBias,
-                                              const bool transpose, const bool needUpsampling );
+                                              const bool transpose );
+
+    void ( *m_computeMatrixTimesRedBndry )( int* const result, const int* const input, const int inputSize,
+                                            const short* matrix, const short* bias, const int width, const int height,
+                                            const int xStep, const int yStep, const int shiftMatrix, const int shiftBias );
+    void ( *m_predictionUpsampling )      ( Pel* dst, const int dstStride, const int* const src, const Size& reducedSize,
+                                            const Size& blockSize, const int* const bndryTop, const int* const bndryLeft, const int bitDepth );
   };
 }
 
@@ -38,103 +38,15 @@
 #include "Picture.h"
 #include "SEI.h"
 #include "ChromaFormat.h"
-#if ENABLE_WPP_PARALLELISM
-#if ENABLE_WPP_STATIC_LINK
-#include <atomic>
-#else
-#include <condition_variable>
-#endif
-#endif
-
 
 #if ENABLE_WPP_PARALLELISM || ENABLE_SPLIT_PARALLELISM
 #if ENABLE_WPP_PARALLELISM
-#if ENABLE_WPP_STATIC_LINK
-class SyncObj
-{
-public:
-  SyncObj() : m_Val(-1) {}
-  ~SyncObj()            {}
-
-  void reset()
-  {
-    m_Val = -1;
-  }
-
-  bool isReady( int64_t val ) const
-  {
-//    std::cout << "is ready m_Val " << m_Val << " val " << val << std::endl;
-    return m_Val >= val;
-  }
-
-  void wait( int64_t idx, int ctuPosY  )
-  {
-    while( ! isReady( idx ) )
-    {
-    }
-  }
-
-  void set( int64_t val, int ctuPosY)
-  {
-    m_Val = val;
-  }
-
-private:
-  std::atomic<int>         m_Val;
-};
-#else
-class SyncObj
-{
-public:
-  SyncObj() : m_Val(-1) {}
-  ~SyncObj()            {}
-
-  void reset()
-  {
-    std::unique_lock< std::mutex > lock( m_mutex );
-
-    m_Val = -1;
-  }
-
-  bool isReady( int64_t val ) const
-  {
-    return m_Val >= val;
-  }
-
-  void wait( int64_t idx, int ctuPosY  )
-  {
-    std::unique_lock< std::mutex > lock( m_mutex );
-
-    while( ! isReady( idx ) )
-    {
-      m_cv.wait( lock );
-    }
-  }
-
-  void set( int64_t val, int ctuPosY)
-  {
-    std::unique_lock< std::mutex > lock( m_mutex );
-    m_Val = val;
-    m_cv.notify_all();
-  }
-
-private:
-  int64_t                 m_Val;
-  std::condition_variable m_cv;
-  std::mutex              m_mutex;
-};
+thread_local int g_wppThreadId( 0 );
 #endif
-#endif
-
-int g_wppThreadId( 0 );
-#pragma omp threadprivate(g_wppThreadId)
 
 #if ENABLE_SPLIT_PARALLELISM
-int g_splitThreadId( 0 );
-#pragma omp threadprivate(g_splitThreadId)
-
-int g_splitJobId( 0 );
-#pragma omp threadprivate(g_splitJobId)
+thread_local int g_splitThreadId( 0 );
+thread_local int g_splitJobId( 0 );
 #endif
 
 Scheduler::Scheduler() :
@@ -146,7 +58,8 @@ Scheduler::Scheduler() :
   ,
 #endif
 #if ENABLE_SPLIT_PARALLELISM
-  m_numSplitThreads( 1 )
+  m_numSplitThreads( 1 ),
+  m_hasParallelBuffer( false )
 #endif
 {
 }
@@ -154,11 +67,11 @@ Scheduler::Scheduler() :
 Scheduler::~Scheduler()
 {
 #if ENABLE_WPP_PARALLELISM
-  for( auto & so : m_SyncObjs )
+  for( auto & lp : m_lineProgress )
   {
-    delete so;
+    delete lp;
   }
-  m_SyncObjs.clear();
+  m_lineProgress.clear();
 #endif
 }
 
@@ -221,7 +134,9 @@ void Scheduler::finishParallel()
 
 void Scheduler::setSplitThreadId( const int tId )
 {
-  g_splitThreadId = tId == CURR_THREAD_ID ? omp_get_thread_num() : tId;
+  g_splitThreadId = tId;
+
+  CHECK( g_splitThreadId >= PARL_SPLIT_MAX_NUM_THREADS, "The split thread ID " << g_splitThreadId << " is invalid!" );
 }
 
 #endif
@@ -253,7 +168,7 @@ unsigned Scheduler::getWppThreadId() const
 
 void Scheduler::setWppThreadId( const int tId )
 {
-  g_wppThreadId = tId == CURR_THREAD_ID ? omp_get_thread_num() : tId;
+  g_wppThreadId = tId;
 
   CHECK( g_wppThreadId >= PARL_WPP_MAX_NUM_THREADS, "The WPP thread ID " << g_wppThreadId << " is invalid!" );
 }
@@ -268,12 +183,11 @@ unsigned Scheduler::getDataId() const
   }
 #endif
 #if ENABLE_WPP_PARALLELISM
-  if( m_numWppThreads > 1 )
-  {
-    return getWppDataId();
-  }
-#endif
+  // the frame threads also select their encoder stack by the WPP thread ID, it is 0 otherwise
+  return getWppDataId();
+#else
   return 0;
+#endif
 }
 
 bool Scheduler::init( const int ctuYsize, const int ctuXsize, const int numWppThreadsRunning, const int numWppExtraLines, const int numSplitThreads )
@@ -289,22 +203,22 @@ bool Scheduler::init( const int ctuYsize, const int ctuXsize, const int numWppTh
   m_ctuYsize                = ctuYsize;
   m_ctuXsize                = ctuXsize;
 
-  if( m_SyncObjs.size() == 0 )
+  if( m_lineProgress.size() == 0 )
   {
-    m_SyncObjs.reserve( ctuYsize );
-    for( int i = (int)m_SyncObjs.size(); i < ctuYsize; i++ )
+    m_lineProgress.reserve( ctuYsize );
+    for( int i = (int)m_lineProgress.size(); i < ctuYsize; i++ )
     {
-      m_SyncObjs.push_back( new SyncObj );
+      m_lineProgress.push_back( new ProgressCounter );
     }
   }
   else
   {
-    CHECK( m_SyncObjs.size() != ctuYsize, "");
+    CHECK( m_lineProgress.size() != ctuYsize, "");
   }
 
   for( int i = 0; i < ctuYsize; i++ )
   {
-    m_SyncObjs[i]->reset();
+    m_lineProgress[i]->reset();
   }
 
   if( m_numWppThreads != m_numWppDataInstances )
@@ -315,7 +229,7 @@ bool Scheduler::init( const int ctuYsize, const int ctuXsize, const int numWppTh
     m_LineProc.clear();
     m_LineProc.resize(ctuYsize, false);
 
-    m_SyncObjs[0]->set(0,0);
+    m_lineProgress[0]->set( 1 );
     m_LineProc[0]=true;
   }
 #endif
@@ -336,25 +250,35 @@ int Scheduler::getNumPicInstances() const
 }
 
 #if ENABLE_WPP_PARALLELISM
-void Scheduler::wait( const int ctuPosX, const int ctuPosY )
+bool Scheduler::wait( const int ctuPosX, const int ctuPosY )
 {
+  // the line progress counts the CTUs, i.e. CTU x is finished (or may be started) once the counter reaches x+1
   if( m_numWppThreads == m_numWppDataInstances )
   {
-    if( ctuPosY > 0 && ctuPosX+1 < m_ctuXsize)
+    if( ctuPosY > 0 )
     {
-      m_SyncObjs[ctuPosY-1]->wait( ctuPosX+1, ctuPosY-1 );
+      // the CTU above right, or the last CTU of the line above
+      return m_lineProgress[ctuPosY-1]->wait( std::min( ctuPosX+2, m_ctuXsize ) );
     }
-    return;
+    return true;
   }
 
-  m_SyncObjs[ctuPosY]->wait( ctuPosX, ctuPosY );
+  return m_lineProgress[ctuPosY]->wait( ctuPosX+1 );
+}
+
+void Scheduler::abort()
+{
+  for( auto & lp : m_lineProgress )
+  {
+    lp->abort();
+  }
 }
 
 void Scheduler::setReady(const int ctuPosX, const int ctuPosY)
 {
   if( m_numWppThreads == m_numWppDataInstances )
   {
-    m_SyncObjs[ctuPosY]->set( ctuPosX, ctuPosY);
+    m_lineProgress[ctuPosY]->set( ctuPosX+1 );
     return;
   }
 
@@ -386,14 +310,14 @@ void Scheduler::setReady(const int ctuPosX, const int ctuPosY)
   {
     //  try to continue in the next row
     // go on in the current line
-    m_SyncObjs[pos.y]->set(pos.x, pos.y);
+    m_lineProgress[pos.y]->set( pos.x+1 );
     m_numWppThreadsRunning++;
   }
   else if( getNextCtu( pos, ctuPosY, 1 ) )
   {
     //  try to continue in the same row
     // go on in the current line
-    m_SyncObjs[pos.y]->set(pos.x, pos.y);
+    m_lineProgress[pos.y]->set( pos.x+1 );
     m_numWppThreadsRunning++;
   }
   for( int i = m_numWppThreadsRunning; i < m_numWppThreads; i++ )
@@ -403,7 +327,7 @@ void Scheduler::setReady(const int ctuPosX, const int ctuPosY)
     {
       if( getNextCtu( pos, m_firstNonFinishedLine+y, 1 ))
       {
-        m_SyncObjs[pos.y]->set(pos.x, pos.y);
+        m_lineProgress[pos.y]->set( pos.x+1 );
         m_numWppThreadsRunning++;
         break;
       }
@@ -1009,6 +933,7 @@ Picture::Picture()
   tileMap              = nullptr;
 #endif
   cs                   = nullptr;
+  unitCache            = nullptr;
   m_bIsBorderExtended  = false;
   usedByCurr           = false;
   longTerm             = false;
@@ -1044,6 +969,7 @@ void Picture::create(const ChromaFormat &_chromaFormat, const Size &size, const
 #if !KEEP_PRED_AND_RESI_SIGNALS
 
   m_ctuArea = UnitArea( _chromaFormat, Area( Position{ 0, 0 }, Size( _maxCUSize, _maxCUSize ) ) );
+  m_ctuSizedTempBuffers = true;
 #endif
   m_hashMap.clearAll();
 }
@@ -1103,12 +1029,14 @@ void Picture::destroy()
   }
 }
 
-void Picture::createTempBuffers( const unsigned _maxCUSize )
+void Picture::createTempBuffers( const unsigned _maxCUSize, const bool pictureSized )
 {
 #if KEEP_PRED_AND_RESI_SIGNALS
   const Area a( Position{ 0, 0 }, lumaSize() );
 #else
-  const Area a = m_ctuArea.Y();
+  // picture sized buffers are needed, if several CTUs are decoded concurrently
+  const Area a = pictureSized ? Area( Position{ 0, 0 }, lumaSize() ) : m_ctuArea.Y();
+  m_ctuSizedTempBuffers = !pictureSized;
 #endif
 
 #if ENABLE_SPLIT_PARALLELISM
@@ -1204,6 +1132,9 @@ void Picture::finalInit(const SPS& sps, const PPS& pps, APS& aps)
   }
   SEIs.clear();
   clearSliceBuffer();
+#if DECODER_STAGE_TIMING
+  stageTimes.reset();
+#endif
 
 #if JVET_N0857_TILES_BRICKS
   if( brickMap )
@@ -1231,7 +1162,8 @@ void Picture::finalInit(const SPS& sps, const PPS& pps, APS& aps)
   }
   else
   {
-    cs = new CodingStructure( g_globalUnitCache.cuCache, g_globalUnitCache.puCache, g_globalUnitCache.tuCache );
+    XUCache &cache = unitCache ? *unitCache : g_globalUnitCache;
+    cs = new CodingStructure( cache.cuCache, cache.puCache, cache.tuCache );
     cs->sps = &sps;
     cs->create( chromaFormatIDC, Area( 0, 0, iWidth, iHeight ), true );
   }
@@ -1387,6 +1319,13 @@ void Picture::extendPicBorder()
     return;
   }
 
+  fillPicBorder();
+
+  m_bIsBorderExtended = true;
+}
+
+void Picture::fillPicBorder()
+{
   for(int comp=0; comp<getNumberValidComponents( cs->area.chromaFormat ); comp++)
   {
     ComponentID compID = ComponentID( comp );
@@ -1482,8 +1421,6 @@ void Picture::extendPicBorder()
     }
 #endif
   }
-
-  m_bIsBorderExtended = true;
 }
 
 PelBuf Picture::getBuf( const ComponentID compID, const PictureType &type )
@@ -1508,7 +1445,7 @@ PelBuf Picture::getBuf( const CompArea &blk, const PictureType &type )
 
 #endif
 #if !KEEP_PRED_AND_RESI_SIGNALS
-  if( type == PIC_RESIDUAL || type == PIC_PREDICTION )
+  if( m_ctuSizedTempBuffers && ( type == PIC_RESIDUAL || type == PIC_PREDICTION ) )
   {
     CompArea localBlk = blk;
     localBlk.x &= ( cs->pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
@@ -1533,7 +1470,7 @@ const CPelBuf Picture::getBuf( const CompArea &blk, const PictureType &type ) co
 
 #endif
 #if !KEEP_PRED_AND_RESI_SIGNALS
-  if( type == PIC_RESIDUAL || type == PIC_PREDICTION )
+  if( m_ctuSizedTempBuffers && ( type == PIC_RESIDUAL || type == PIC_PREDICTION ) )
   {
     CompArea localBlk = blk;
     localBlk.x &= ( cs->pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
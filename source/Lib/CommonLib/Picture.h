@@ -48,12 +48,13 @@
 #include "CodingStructure.h"
 #include "Hash.h"
 #include "MCTS.h"
+#include "ThreadPool.h"
+#include "StageTiming.h"
 #include <deque>
 
 #if ENABLE_WPP_PARALLELISM || ENABLE_SPLIT_PARALLELISM
 #if ENABLE_WPP_PARALLELISM
 #include <mutex>
-class SyncObj;
 #endif
 
 #define CURR_THREAD_ID -1
@@ -71,20 +72,22 @@ public:
   void     setSplitJobId ( const int jobId );
   void     startParallel ();
   void     finishParallel();
-  void     setSplitThreadId( const int tId = CURR_THREAD_ID );
+  void     setSplitThreadId( const int tId );
   unsigned getNumSplitThreads() const { return m_numSplitThreads; };
 #endif
 #if ENABLE_WPP_PARALLELISM
   unsigned getWppDataId  ( int lId = CURR_THREAD_ID ) const;
   unsigned getWppThreadId() const;
-  void     setWppThreadId( const int tId = CURR_THREAD_ID );
+  void     setWppThreadId( const int tId );
 #endif
   unsigned getDataId     () const;
   bool init              ( const int ctuYsize, const int ctuXsize, const int numWppThreadsRunning, const int numWppExtraLines, const int numSplitThreads );
   int  getNumPicInstances() const;
 #if ENABLE_WPP_PARALLELISM
   void setReady          ( const int ctuPosX, const int ctuPosY );
-  void wait              ( const int ctuPosX, const int ctuPosY );
+  /// returns false if the wait was aborted
+  bool wait              ( const int ctuPosX, const int ctuPosY );
+  void abort             ();
 
 private:
   bool getNextCtu( Position& pos, int ctuLine, int offset );
@@ -100,7 +103,7 @@ private:
   std::vector<int>         m_LineDone;
   std::vector<bool>        m_LineProc;
   std::mutex               m_mutex;
-  std::vector<SyncObj*>    m_SyncObjs;
+  std::vector<ProgressCounter*> m_lineProgress;   ///< per CTU line, the number of finished CTUs, or of the CTUs that may be started with extra lines
 #endif
 #if ENABLE_SPLIT_PARALLELISM
 
@@ -247,7 +250,7 @@ struct Picture : public UnitArea
   void create(const ChromaFormat &_chromaFormat, const Size &size, const unsigned _maxCUSize, const unsigned margin, const bool bDecoder);
   void destroy();
 
-  void createTempBuffers( const unsigned _maxCUSize );
+  void createTempBuffers( const unsigned _maxCUSize, const bool pictureSized = false );
   void destroyTempBuffers();
 
          PelBuf     getOrigBuf(const CompArea &blk);
@@ -301,6 +304,8 @@ struct Picture : public UnitArea
   const CPelUnitBuf getBuf(const UnitArea &unit,     const PictureType &type) const;
 
   void extendPicBorder();
+  /// extends the border samples without checking or updating the border extension state
+  void fillPicBorder();
 #if JVET_N0415_CTB_ALF
 #if JVET_N0805_APS_LMCS  
   void finalInit(const SPS& sps, const PPS& pps, APS** alfApss, APS& lmcsAps);
@@ -338,6 +343,13 @@ public:
   int* m_spliceIdx;
   int  m_ctuNums;
 
+  // progress of the in-loop filtering, the following pictures wait for it when it runs concurrently to their decoding
+  ProgressCounter motionProgress;   ///< number of CTU rows with the final motion field (deblocked and DMVR refined)
+  ProgressCounter filterProgress;   ///< number of CTU rows with final samples, the number of CTU rows plus one once the border is extended
+#if DECODER_STAGE_TIMING
+  DecStageTimes   stageTimes;       ///< time spent in the decoding stages of this picture
+#endif
+
 #if ENABLE_SPLIT_PARALLELISM
 #if ENABLE_WPP_PARALLELISM
   PelStorage m_bufs[( PARL_SPLIT_MAX_NUM_JOBS * PARL_WPP_MAX_NUM_THREADS )][NUM_PIC_TYPES];
@@ -354,6 +366,7 @@ public:
   void               addPictureToHashMapForInter();
 
   CodingStructure*   cs;
+  XUCache*           unitCache;   ///< unit cache used by cs, the process wide g_globalUnitCache if not set
   std::deque<Slice*> slices;
   SEIMessages        SEIs;
 
@@ -370,8 +383,12 @@ public:
   std::vector<AQpLayer*> aqlayer;
 
 #if !KEEP_PRED_AND_RESI_SIGNALS
+public:
+  bool hasCtuSizedTempBuffers() const { return m_ctuSizedTempBuffers; }
+
 private:
   UnitArea m_ctuArea;
+  bool     m_ctuSizedTempBuffers;   ///< prediction and residual buffers only hold the current CTU
 #endif
 
 #if ENABLE_SPLIT_PARALLELISM
@@ -557,7 +557,7 @@ void Quant::init( uint32_t uiMaxTrSize,
 #endif
 }
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 void Quant::copyState( const Quant& other )
 {
   m_dLambda = other.m_dLambda;
@@ -85,6 +85,11 @@ QuantRDOQ::QuantRDOQ( const Quant* other ) : Quant( other )
 #if HEVC_USE_SCALING_LISTS
   xInitScalingList( rdoq );
 #endif
+
+  m_quantLevels = quantLevelsCore;
+#if ENABLE_SIMD_OPT_RDOQ && defined(TARGET_SIMD_X86)
+  initQuantRDOQX86();
+#endif
 }
 
 QuantRDOQ::~QuantRDOQ()
@@ -97,6 +102,36 @@ QuantRDOQ::~QuantRDOQ()
 
 
 
+bool QuantRDOQ::quantLevelsCore( const TCoeff* src, const int* qCoef, const double* errScale, const int stride, const int width, const int height,
+                                 const int defaultQCoef, const double defaultErrScale, const int qBits, const TCoeff maxLevel,
+                                 Intermediate_Int* levelDouble, TCoeff* maxAbsLevel, double* costCoeff0 )
+{
+  const Intermediate_Int levelOffset = Intermediate_Int( 1 ) << ( qBits - 1 );
+  const Intermediate_Int levelLimit  = std::numeric_limits<Intermediate_Int>::max() - levelOffset;
+  bool anySig = false;
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x++ )
+    {
+      const int    blkPos                  = y * stride + x;
+      const int    quantisationCoefficient = qCoef    ? qCoef   [blkPos] : defaultQCoef;
+      const double errorScale              = errScale ? errScale[blkPos] : defaultErrScale;
+      const int64_t tmpLevel               = int64_t( abs( src[blkPos] ) ) * quantisationCoefficient;
+      const Intermediate_Int lLevelDouble  = ( Intermediate_Int ) std::min<int64_t>( tmpLevel, levelLimit );
+      const uint32_t uiMaxAbsLevel         = std::min<uint32_t>( uint32_t( maxLevel ), uint32_t( ( lLevelDouble + levelOffset ) >> qBits ) );
+      const double dErr                    = double( lLevelDouble );
+
+      levelDouble[blkPos] = lLevelDouble;
+      maxAbsLevel[blkPos] = uiMaxAbsLevel;
+      costCoeff0 [blkPos] = dErr * dErr * errorScale;
+      anySig             |= uiMaxAbsLevel > 0;
+    }
+  }
+
+  return anySig;
+}
+
 /** Get the best level in RD sense
  *
  * \returns best quantized transform level for given scan position
@@ -783,8 +818,63 @@ void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
   const uint32_t lfnstIdx = tu.cu->lfnstIdx;
 #endif
 
+  //===== levels and costs of coding zero for the whole zero-out region =====
+  const int iRegionWidth  = std::min<int>( JVET_C0024_ZERO_OUT_TH, uiWidth );
+  const int iRegionHeight = std::min<int>( JVET_C0024_ZERO_OUT_TH, uiHeight );
+#if HEVC_USE_SCALING_LISTS
+  const bool bAnySig = m_quantLevels( plSrcCoeff, enableScalingLists ? piQCoef : nullptr, enableScalingLists ? pdErrScale : nullptr, uiWidth, iRegionWidth, iRegionHeight,
+                                      defaultQuantisationCoefficient, defaultErrorScale, iQBits, entropyCodingMaximum, m_levelDouble, m_maxAbsLevel, m_costCoeff0 );
+#else
+  const bool bAnySig = m_quantLevels( plSrcCoeff, nullptr, nullptr, uiWidth, iRegionWidth, iRegionHeight,
+                                      quantisationCoefficient, errorScale, iQBits, entropyCodingMaximum, m_levelDouble, m_maxAbsLevel, m_costCoeff0 );
+#endif
+
+  if( !bAnySig )
+  {
+    return;
+  }
+
+#if JVET_N0193_LFNST
+  // the first sub-block is the one at position (0,0)
+  auto getMaxNonZeroPosInCG = [&]( const int subSetId ) { return ( lfnstIdx > 0 && subSetId == 0 && ( ( uiWidth == 4 && uiHeight == 4 ) || ( uiWidth == 8 && uiHeight == 8 ) ) ) ? 7 : iCGSizeM1; };
+#else
+  auto getMaxNonZeroPosInCG = [&]( const int ) { return iCGSizeM1; };
+#endif
 
-  for (int subSetId = iCGNum - 1; subSetId >= 0; subSetId--)
+  //===== find last significant position =====
+  for( int subSetId = iCGNum - 1; subSetId >= 0 && iLastScanPos < 0; subSetId-- )
+  {
+    const int maxNonZeroPosInCG = getMaxNonZeroPosInCG( subSetId );
+    for( int iScanPosinCG = maxNonZeroPosInCG; iScanPosinCG >= 0; iScanPosinCG-- )
+    {
+      iScanPos = ( subSetId << cctx.log2CGSize() ) + iScanPosinCG;
+
+      if( m_maxAbsLevel[ cctx.blockPos( iScanPos ) ] )
+      {
+        iLastScanPos   = iScanPos;
+        iCGLastScanPos = subSetId;
+        break;
+      }
+    }
+  }
+
+  if( iLastScanPos < 0 )
+  {
+    return;
+  }
+
+  // the sub-blocks behind the last significant one only contribute the costs of coding zero
+  for( int subSetId = iCGNum - 1; subSetId > iCGLastScanPos; subSetId-- )
+  {
+    const int maxNonZeroPosInCG = getMaxNonZeroPosInCG( subSetId );
+    for( int iScanPosinCG = maxNonZeroPosInCG; iScanPosinCG >= 0; iScanPosinCG-- )
+    {
+      d64BlockUncodedCost += m_costCoeff0[ cctx.blockPos( ( subSetId << cctx.log2CGSize() ) + iScanPosinCG ) ];
+    }
+  }
+  d64BaseCost = d64BlockUncodedCost;
+
+  for (int subSetId = iCGLastScanPos; subSetId >= 0; subSetId--)
   {
     cctx.initSubblock( subSetId );
 
@@ -816,31 +906,20 @@ void QuantRDOQ::xRateDistOptQuant(TransformUnit &tu, const ComponentID &compID,
 
       // set coeff
 #if HEVC_USE_SCALING_LISTS
-      const int    quantisationCoefficient = (enableScalingLists) ? piQCoef   [uiBlkPos]               : defaultQuantisationCoefficient;
 #if HM_QTBT_AS_IN_JEM_QUANT
       const double errorScale              = (enableScalingLists) ? pdErrScale[uiBlkPos]               : defaultErrorScale;
 #else
       const double errorScale              = (enableScalingLists) ? pdErrScale[uiBlkPos] * blkErrScale : defaultErrorScale;
 #endif
 #endif
-      const int64_t  tmpLevel                = int64_t(abs(plSrcCoeff[ uiBlkPos ])) * quantisationCoefficient;
+      const Intermediate_Int lLevelDouble  = m_levelDouble[ uiBlkPos ];
+      uint32_t uiMaxAbsLevel        = uint32_t( m_maxAbsLevel[ uiBlkPos ] );
 
-      const Intermediate_Int lLevelDouble  = (Intermediate_Int)std::min<int64_t>(tmpLevel, std::numeric_limits<Intermediate_Int>::max() - (Intermediate_Int(1) << (iQBits - 1)));
-
-      uint32_t uiMaxAbsLevel        = std::min<uint32_t>(uint32_t(entropyCodingMaximum), uint32_t((lLevelDouble + (Intermediate_Int(1) << (iQBits - 1))) >> iQBits));
-
-      const double dErr         = double( lLevelDouble );
-      pdCostCoeff0[ iScanPos ]  = dErr * dErr * errorScale;
+      pdCostCoeff0[ iScanPos ]  = m_costCoeff0[ uiBlkPos ];
       d64BlockUncodedCost      += pdCostCoeff0[ iScanPos ];
       piDstCoeff[ uiBlkPos ]    = uiMaxAbsLevel;
 
-      if ( uiMaxAbsLevel > 0 && iLastScanPos < 0 )
-      {
-        iLastScanPos            = iScanPos;
-        iCGLastScanPos          = cctx.subSetId();
-      }
-
-      if ( iLastScanPos >= 0 )
+      if ( iScanPos <= iLastScanPos )
       {
 
 #if ENABLE_TRACING
@@ -71,6 +71,19 @@ public:
   void forwardRDPCM         ( TransformUnit &tu, const ComponentID &compID, const CCoeffBuf &pSrc, TCoeff &uiAbsSum, const QpParam &cQP, const Ctx &ctx );
 #endif
 
+  // first RDOQ pass over the width x height region in raster order: derives the scaled level, the maximum absolute
+  // level and the cost of coding zero for every coefficient, returns whether any maximum level is non-zero. Without
+  // scaling lists qCoef and errScale are null and the default values are used.
+  static bool quantLevelsCore( const TCoeff* src, const int* qCoef, const double* errScale, const int stride, const int width, const int height,
+                               const int defaultQCoef, const double defaultErrScale, const int qBits, const TCoeff maxLevel,
+                               Intermediate_Int* levelDouble, TCoeff* maxAbsLevel, double* costCoeff0 );
+
+#if ENABLE_SIMD_OPT_RDOQ && defined(TARGET_SIMD_X86)
+  void initQuantRDOQX86();
+  template <X86_VEXT vext>
+  void _initQuantRDOQX86();
+#endif
+
 private:
 #if HEVC_USE_SCALING_LISTS
 #if JVET_N0847_SCALING_LISTS
@@ -173,6 +186,10 @@ private:
   double m_pdCostSig          [MAX_TB_SIZEY * MAX_TB_SIZEY];
   double m_pdCostCoeff0       [MAX_TB_SIZEY * MAX_TB_SIZEY];
   double m_pdCostCoeffGroupSig[(MAX_TB_SIZEY * MAX_TB_SIZEY) >> MLS_CG_SIZE]; // even if CG size is 2 (if one of the sides is 2) instead of 4, there should be enough space
+  // results of the first pass in raster order
+  Intermediate_Int m_levelDouble [MAX_TB_SIZEY * MAX_TB_SIZEY];
+  TCoeff           m_maxAbsLevel [MAX_TB_SIZEY * MAX_TB_SIZEY];
+  double           m_costCoeff0  [MAX_TB_SIZEY * MAX_TB_SIZEY];
 #if HEVC_USE_SIGN_HIDING
   int    m_rateIncUp          [MAX_TB_SIZEY * MAX_TB_SIZEY];
   int    m_rateIncDown        [MAX_TB_SIZEY * MAX_TB_SIZEY];
@@ -182,6 +199,10 @@ private:
   TCoeff m_fullCoeff          [MAX_TB_SIZEY * MAX_TB_SIZEY];
 #endif
 #endif
+
+  bool ( *m_quantLevels )( const TCoeff* src, const int* qCoef, const double* errScale, const int stride, const int width, const int height,
+                           const int defaultQCoef, const double defaultErrScale, const int qBits, const TCoeff maxLevel,
+                           Intermediate_Int* levelDouble, TCoeff* maxAbsLevel, double* costCoeff0 );
 };// END CLASS DEFINITION QuantRDOQ
 
 //! \}
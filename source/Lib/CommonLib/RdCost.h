@@ -59,6 +59,18 @@ class EncCfg;
 // for function pointer
 typedef Distortion (*FpDistFunc) (const DistParam&);
 
+#if WCG_EXT
+/// luma level dependent distortion weights, shared by all RD cost instances of one encoder
+struct LumaLevelWeights
+{
+  std::vector<double> reshapeLumaLevelToWeightPLUT;
+  std::vector<double> lumaLevelToWeightPLUT;
+  uint32_t            signalType   = RESHAPE_SIGNAL_NULL;
+  double              chromaWeight = 1.0;
+  int                 lumaBD       = 10;
+};
+#endif
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -90,11 +102,17 @@ public:
 #if JVET_N0671_RDCOST_FIX
   int                   cShiftX;
   int                   cShiftY;
+#endif
+#if WCG_EXT
+  const LumaLevelWeights *lumaLevelWeights;  // used by the weighted SSE functions
 #endif
   DistParam() :
   org(), cur(), step( 1 ), bitDepth( 0 ), useMR( false ), applyWeight( false ), isBiPred( false ), wpCur( nullptr ), compID( MAX_NUM_COMPONENT ), maximumDistortionForEarlyExit( std::numeric_limits<Distortion>::max() ), subShift( 0 )
 #if JVET_N0671_RDCOST_FIX
   , cShiftX(-1), cShiftY(-1)
+#endif
+#if WCG_EXT
+  , lumaLevelWeights( nullptr )
 #endif
   { }
 };
@@ -112,11 +130,8 @@ private:
 #if WCG_EXT
   double                  m_dLambda_unadjusted; // TODO: check is necessary
   double                  m_DistScaleUnadjusted;
-  static std::vector<double> m_reshapeLumaLevelToWeightPLUT;
-  static std::vector<double> m_lumaLevelToWeightPLUT;
-  static uint32_t         m_signalType;
-  static double           m_chromaWeight;
-  static int              m_lumaBD;
+  static LumaLevelWeights m_defaultLumaLevelWeights;
+  LumaLevelWeights       *m_lumaLevelWeights;
 #if JVET_N0671_RDCOST_FIX
   ChromaFormat            m_cf;
 #endif // JVET_N0671_RDCOST_FIX
@@ -285,7 +300,7 @@ public:
     return length;
   }
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   void copyState( const RdCost& other );
 #endif
 
@@ -308,14 +323,16 @@ public:
 #if WCG_EXT
          void    saveUnadjustedLambda       ();
          void    initLumaLevelToWeightTable ();
-  inline double  getWPSNRLumaLevelWeight    (int val) { return m_lumaLevelToWeightPLUT[val]; }
+  inline double  getWPSNRLumaLevelWeight    (int val) { return m_lumaLevelWeights->lumaLevelToWeightPLUT[val]; }
   void           initLumaLevelToWeightTableReshape();
   void           updateReshapeLumaLevelToWeightTableChromaMD (std::vector<Pel>& ILUT);
   void           restoreReshapeLumaLevelToWeightTable        ();
-  inline double  getWPSNRReshapeLumaLevelWeight              (int val)                   { return m_reshapeLumaLevelToWeightPLUT[val]; }
-  void           setReshapeInfo                              (uint32_t type, int lumaBD) { m_signalType = type; m_lumaBD = lumaBD; }
+  inline double  getWPSNRReshapeLumaLevelWeight              (int val)                   { return m_lumaLevelWeights->reshapeLumaLevelToWeightPLUT[val]; }
+  void           setReshapeInfo                              (uint32_t type, int lumaBD) { m_lumaLevelWeights->signalType = type; m_lumaLevelWeights->lumaBD = lumaBD; }
   void           updateReshapeLumaLevelToWeightTable         (SliceReshapeInfo &sliceReshape, Pel *wtTable, double cwt);
-  inline std::vector<double>& getLumaLevelWeightTable        ()                   { return m_lumaLevelToWeightPLUT; }
+  inline std::vector<double>& getLumaLevelWeightTable        ()                   { return m_lumaLevelWeights->lumaLevelToWeightPLUT; }
+  // by default the weights are shared by all instances of the process, an encoder can attach its instances to its own
+  void           setLumaLevelWeights                         (LumaLevelWeights* weights) { m_lumaLevelWeights = weights; }
 #endif
 
 private:
@@ -329,7 +346,7 @@ private:
   static Distortion xGetSSE16N        ( const DistParam& pcDtParam );
 
 #if WCG_EXT
-  static Distortion getWeightedMSE    (int compIdx, const Pel org, const Pel cur, const uint32_t uiShift, const Pel orgLuma);
+  static Distortion getWeightedMSE    (const LumaLevelWeights& weights, int compIdx, const Pel org, const Pel cur, const uint32_t uiShift, const Pel orgLuma);
   static Distortion xGetSSE_WTD       ( const DistParam& pcDtParam );
   static Distortion xGetSSE2_WTD      ( const DistParam& pcDtParam );
   static Distortion xGetSSE4_WTD      ( const DistParam& pcDtParam );
@@ -112,6 +112,14 @@ const SAOBlkParam& SAOBlkParam::operator= (const SAOBlkParam& src)
 
 SampleAdaptiveOffset::SampleAdaptiveOffset()
 {
+  m_offsetEdgeLines = offsetEdgeLinesCore;
+  m_offsetBandLines = offsetBandLinesCore;
+  m_calcEdgeStats   = calcEdgeStatsCore;
+  m_calcBandStats   = calcBandStatsCore;
+
+#if ENABLE_SIMD_OPT_SAO && defined(TARGET_SIMD_X86)
+  initSampleAdaptiveOffsetX86();
+#endif
 }
 
 
@@ -297,6 +305,51 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
 #endif
   )
 {
+#if JVET_N0438_LOOP_FILTER_DISABLED_ACROSS_VIR_BOUND
+  if( !isCtuCrossedByVirtualBoundaries )
+#endif
+  {
+    // the edge class is derived directly from both neighbours, the sign line buffers below are only needed for skipping samples at virtual boundaries
+    const int startX = isLeftAvail  ? 0 : 1;
+    const int endX   = isRightAvail ? width : ( width - 1 );
+
+    switch( typeIdx )
+    {
+    case SAO_TYPE_EO_0:
+      m_offsetEdgeLines( srcBlk, resBlk, srcStride, resStride, startX, endX, height, -1, 1, offset, clpRng );
+      break;
+    case SAO_TYPE_EO_90:
+      {
+        const int startY = isAboveAvail ? 0 : 1;
+        const int endY   = isBelowAvail ? height : ( height - 1 );
+        m_offsetEdgeLines( srcBlk + startY * srcStride, resBlk + startY * resStride, srcStride, resStride, 0, width, endY - startY, -srcStride, srcStride, offset, clpRng );
+      }
+      break;
+    case SAO_TYPE_EO_135:
+      {
+        const int lastLine = height - 1;
+        m_offsetEdgeLines( srcBlk, resBlk, srcStride, resStride, isAboveLeftAvail ? 0 : 1, isAboveAvail ? endX : 1, 1, -srcStride - 1, srcStride + 1, offset, clpRng );
+        m_offsetEdgeLines( srcBlk + srcStride, resBlk + resStride, srcStride, resStride, startX, endX, height - 2, -srcStride - 1, srcStride + 1, offset, clpRng );
+        m_offsetEdgeLines( srcBlk + lastLine * srcStride, resBlk + lastLine * resStride, srcStride, resStride, isBelowAvail ? startX : ( width - 1 ), isBelowRightAvail ? width : ( width - 1 ), 1, -srcStride - 1, srcStride + 1, offset, clpRng );
+      }
+      break;
+    case SAO_TYPE_EO_45:
+      {
+        const int lastLine = height - 1;
+        m_offsetEdgeLines( srcBlk, resBlk, srcStride, resStride, isAboveAvail ? startX : ( width - 1 ), isAboveRightAvail ? width : ( width - 1 ), 1, -srcStride + 1, srcStride - 1, offset, clpRng );
+        m_offsetEdgeLines( srcBlk + srcStride, resBlk + resStride, srcStride, resStride, startX, endX, height - 2, -srcStride + 1, srcStride - 1, offset, clpRng );
+        m_offsetEdgeLines( srcBlk + lastLine * srcStride, resBlk + lastLine * resStride, srcStride, resStride, isBelowLeftAvail ? 0 : 1, isBelowAvail ? endX : 1, 1, -srcStride + 1, srcStride - 1, offset, clpRng );
+      }
+      break;
+    case SAO_TYPE_BO:
+      m_offsetBandLines( srcBlk, resBlk, srcStride, resStride, 0, width, height, channelBitDepth - NUM_SAO_BO_CLASSES_LOG2, offset, clpRng );
+      break;
+    default:
+      THROW( "Not a supported SAO types\n" );
+    }
+    return;
+  }
+
   int x,y, startX, startY, endX, endY, edgeType;
   int firstLineStartX, firstLineEndX, lastLineStartX, lastLineEndX;
   int8_t signLeft, signRight, signDown;
@@ -563,6 +616,63 @@ void SampleAdaptiveOffset::offsetBlock(const int channelBitDepth, const ClpRng&
   }
 }
 
+void SampleAdaptiveOffset::offsetEdgeLinesCore( const Pel* src, Pel* res, const int srcStride, const int resStride, const int startX, const int endX, const int numLines, const int neighbourA, const int neighbourB, const int* offset, const ClpRng& clpRng )
+{
+  for( int y = 0; y < numLines; y++ )
+  {
+    for( int x = startX; x < endX; x++ )
+    {
+      const int edgeType = sgn( src[x] - src[x + neighbourA] ) + sgn( src[x] - src[x + neighbourB] ) + 2;
+      res[x] = ClipPel<int>( src[x] + offset[edgeType], clpRng );
+    }
+    src += srcStride;
+    res += resStride;
+  }
+}
+
+void SampleAdaptiveOffset::offsetBandLinesCore( const Pel* src, Pel* res, const int srcStride, const int resStride, const int startX, const int endX, const int numLines, const int shiftBits, const int* offset, const ClpRng& clpRng )
+{
+  for( int y = 0; y < numLines; y++ )
+  {
+    for( int x = startX; x < endX; x++ )
+    {
+      res[x] = ClipPel<int>( src[x] + offset[src[x] >> shiftBits], clpRng );
+    }
+    src += srcStride;
+    res += resStride;
+  }
+}
+
+void SampleAdaptiveOffset::calcEdgeStatsCore( const Pel* src, const Pel* org, const int srcStride, const int orgStride, const int startX, const int endX, const int numLines, const int neighbourA, const int neighbourB, int64_t* diff, int64_t* count )
+{
+  for( int y = 0; y < numLines; y++ )
+  {
+    for( int x = startX; x < endX; x++ )
+    {
+      const int edgeType = sgn( src[x] - src[x + neighbourA] ) + sgn( src[x] - src[x + neighbourB] ) + 2;
+      diff [edgeType] += org[x] - src[x];
+      count[edgeType] ++;
+    }
+    src += srcStride;
+    org += orgStride;
+  }
+}
+
+void SampleAdaptiveOffset::calcBandStatsCore( const Pel* src, const Pel* org, const int srcStride, const int orgStride, const int startX, const int endX, const int numLines, const int shiftBits, int64_t* diff, int64_t* count )
+{
+  for( int y = 0; y < numLines; y++ )
+  {
+    for( int x = startX; x < endX; x++ )
+    {
+      const int bandIdx = src[x] >> shiftBits;
+      diff [bandIdx] += org[x] - src[x];
+      count[bandIdx] ++;
+    }
+    src += srcStride;
+    org += orgStride;
+  }
+}
+
 void SampleAdaptiveOffset::offsetCTU( const UnitArea& area, const CPelUnitBuf& src, PelUnitBuf& res, SAOBlkParam& saoblkParam, CodingStructure& cs)
 {
   const uint32_t numberOfComponents = getNumberValidComponents( area.chromaFormat );
@@ -641,40 +751,17 @@ void SampleAdaptiveOffset::offsetCTU( const UnitArea& area, const CPelUnitBuf& s
 void SampleAdaptiveOffset::SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkParams
                                       )
 {
-  CHECK(!saoBlkParams, "No parameters present");
-
-  xReconstructBlkSAOParams(cs, saoBlkParams);
-
-  const uint32_t numberOfComponents = getNumberValidComponents(cs.area.chromaFormat);
-  bool bAllDisabled = true;
-  for (uint32_t compIdx = 0; compIdx < numberOfComponents; compIdx++)
-  {
-    if (m_picSAOEnabled[compIdx])
-    {
-      bAllDisabled = false;
-    }
-  }
-  if (bAllDisabled)
+  if( !SAOPrepare( cs, saoBlkParams ) )
   {
     return;
   }
 
   const PreCalcValues& pcv = *cs.pcv;
-  PelUnitBuf rec = cs.getRecoBuf();
-  m_tempBuf.copyFrom( rec );
+  m_tempBuf.copyFrom( cs.getRecoBuf() );
 
-  int ctuRsAddr = 0;
-  for( uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
+  for( int ctuRow = 0; ctuRow < pcv.heightInCtus; ctuRow++ )
   {
-    for( uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
-    {
-      const uint32_t width  = (xPos + pcv.maxCUWidth  > pcv.lumaWidth)  ? (pcv.lumaWidth - xPos)  : pcv.maxCUWidth;
-      const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
-      const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
-
-      offsetCTU( area, m_tempBuf, rec, cs.picture->getSAO()[ctuRsAddr], cs);
-      ctuRsAddr++;
-    }
+    xOffsetCtuRow( cs, ctuRow );
   }
 
   DTRACE_UPDATE(g_trace_ctx, (std::make_pair("poc", cs.slice->getPOC())));
@@ -688,22 +775,79 @@ void SampleAdaptiveOffset::SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkP
   xPCMLFDisableProcess(cs);
 }
 
+bool SampleAdaptiveOffset::SAOPrepare( CodingStructure& cs, SAOBlkParam* saoBlkParams )
+{
+  CHECK(!saoBlkParams, "No parameters present");
+
+  xReconstructBlkSAOParams(cs, saoBlkParams);
+
+  const uint32_t numberOfComponents = getNumberValidComponents(cs.area.chromaFormat);
+  for (uint32_t compIdx = 0; compIdx < numberOfComponents; compIdx++)
+  {
+    if (m_picSAOEnabled[compIdx])
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void SampleAdaptiveOffset::SAOCopyCtuRow( CodingStructure& cs, const int ctuRow )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  const int            yPos   = ctuRow << pcv.maxCUHeightLog2;
+  const int            height = std::min( pcv.maxCUHeight, pcv.lumaHeight - yPos );
+  const UnitArea       rowArea( cs.area.chromaFormat, Area( 0, yPos, pcv.lumaWidth, height ) );
+
+  m_tempBuf.getBuf( rowArea ).copyFrom( cs.getRecoBuf( rowArea ) );
+}
+
+void SampleAdaptiveOffset::SAOProcessCtuRow( CodingStructure& cs, const int ctuRow )
+{
+  xOffsetCtuRow( cs, ctuRow );
+  xPCMLFDisableProcess( cs, ctuRow );
+}
+
+void SampleAdaptiveOffset::xOffsetCtuRow( CodingStructure& cs, const int ctuRow )
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  PelUnitBuf rec = cs.getRecoBuf();
+
+  const uint32_t yPos   = ctuRow << pcv.maxCUHeightLog2;
+  const uint32_t height = (yPos + pcv.maxCUHeight > pcv.lumaHeight) ? (pcv.lumaHeight - yPos) : pcv.maxCUHeight;
+  int ctuRsAddr = ctuRow * pcv.widthInCtus;
+  for( uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
+  {
+    const uint32_t width  = (xPos + pcv.maxCUWidth  > pcv.lumaWidth)  ? (pcv.lumaWidth - xPos)  : pcv.maxCUWidth;
+    const UnitArea area( cs.area.chromaFormat, Area(xPos , yPos, width, height) );
+
+    offsetCTU( area, m_tempBuf, rec, cs.picture->getSAO()[ctuRsAddr], cs);
+    ctuRsAddr++;
+  }
+}
+
 void SampleAdaptiveOffset::xPCMLFDisableProcess(CodingStructure& cs)
+{
+  for( int ctuRow = 0; ctuRow < cs.pcv->heightInCtus; ctuRow++ )
+  {
+    xPCMLFDisableProcess( cs, ctuRow );
+  }
+}
+
+void SampleAdaptiveOffset::xPCMLFDisableProcess( CodingStructure& cs, const int ctuRow )
 {
   const PreCalcValues& pcv = *cs.pcv;
   const bool bPCMFilter = (cs.sps->getPCMEnabledFlag() && cs.sps->getPCMFilterDisableFlag()) ? true : false;
 
   if( bPCMFilter || cs.pps->getTransquantBypassEnabledFlag() )
   {
-    for( uint32_t yPos = 0; yPos < pcv.lumaHeight; yPos += pcv.maxCUHeight )
+    const uint32_t yPos = ctuRow << pcv.maxCUHeightLog2;
+    for( uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
     {
-      for( uint32_t xPos = 0; xPos < pcv.lumaWidth; xPos += pcv.maxCUWidth )
-      {
-        UnitArea ctuArea( cs.area.chromaFormat, Area( xPos, yPos, pcv.maxCUWidth, pcv.maxCUHeight ) );
+      UnitArea ctuArea( cs.area.chromaFormat, Area( xPos, yPos, pcv.maxCUWidth, pcv.maxCUHeight ) );
 
-        // CU-based deblocking
-        xPCMCURestoration(cs, ctuArea);
-      }
+      // CU-based deblocking
+      xPCMCURestoration(cs, ctuArea);
     }
   }
 }
@@ -67,10 +67,26 @@ public:
   virtual ~SampleAdaptiveOffset();
   void SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkParams
                    );
+  // CTU-row based processing: SAOCopyCtuRow has to store the deblocked samples of the rows above, below and of the row itself before SAOProcessCtuRow
+  bool SAOPrepare      ( CodingStructure& cs, SAOBlkParam* saoBlkParams );   ///< returns false if SAO is disabled for the picture
+  void SAOCopyCtuRow   ( CodingStructure& cs, const int ctuRow );
+  void SAOProcessCtuRow( CodingStructure& cs, const int ctuRow );
   void create( int picWidth, int picHeight, ChromaFormat format, uint32_t maxCUWidth, uint32_t maxCUHeight, uint32_t maxCUDepth, uint32_t lumaBitShift, uint32_t chromaBitShift );
   void destroy();
   static int getMaxOffsetQVal(const int channelBitDepth) { return (1<<(std::min<int>(channelBitDepth,MAX_SAO_TRUNCATED_BITDEPTH)-5))-1; } //Table 9-32, inclusive
   void setReshaper(Reshape * p) { m_pcReshape = p; }
+
+  // line kernels, neighbourA and neighbourB are the positions of the two edge offset neighbours relative to the current sample
+  static void offsetEdgeLinesCore( const Pel* src, Pel* res, const int srcStride, const int resStride, const int startX, const int endX, const int numLines, const int neighbourA, const int neighbourB, const int* offset, const ClpRng& clpRng );
+  static void offsetBandLinesCore( const Pel* src, Pel* res, const int srcStride, const int resStride, const int startX, const int endX, const int numLines, const int shiftBits, const int* offset, const ClpRng& clpRng );
+  static void calcEdgeStatsCore  ( const Pel* src, const Pel* org, const int srcStride, const int orgStride, const int startX, const int endX, const int numLines, const int neighbourA, const int neighbourB, int64_t* diff, int64_t* count );
+  static void calcBandStatsCore  ( const Pel* src, const Pel* org, const int srcStride, const int orgStride, const int startX, const int endX, const int numLines, const int shiftBits, int64_t* diff, int64_t* count );
+
+#if ENABLE_SIMD_OPT_SAO && defined(TARGET_SIMD_X86)
+  void initSampleAdaptiveOffsetX86();
+  template <X86_VEXT vext>
+  void _initSampleAdaptiveOffsetX86();
+#endif
 protected:
   void deriveLoopFilterBoundaryAvailibility(CodingStructure& cs, const Position &pos,
     bool& isLeftAvail,
@@ -93,7 +109,9 @@ protected:
   void reconstructBlkSAOParam(SAOBlkParam& recParam, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES]);
   int  getMergeList(CodingStructure& cs, int ctuRsAddr, SAOBlkParam* blkParams, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES]);
   void offsetCTU(const UnitArea& area, const CPelUnitBuf& src, PelUnitBuf& res, SAOBlkParam& saoblkParam, CodingStructure& cs);
+  void xOffsetCtuRow(CodingStructure& cs, const int ctuRow);
   void xPCMLFDisableProcess(CodingStructure& cs);
+  void xPCMLFDisableProcess(CodingStructure& cs, const int ctuRow);
   void xPCMCURestoration(CodingStructure& cs, const UnitArea &ctuArea);
   void xPCMSampleRestoration(CodingUnit& cu, const ComponentID compID);
   void xReconstructBlkSAOParams(CodingStructure& cs, SAOBlkParam* saoBlkParams);
@@ -129,6 +147,12 @@ protected:
 
   std::vector<int8_t> m_signLineBuf1;
   std::vector<int8_t> m_signLineBuf2;
+
+  void ( *m_offsetEdgeLines )( const Pel* src, Pel* res, const int srcStride, const int resStride, const int startX, const int endX, const int numLines, const int neighbourA, const int neighbourB, const int* offset, const ClpRng& clpRng );
+  void ( *m_offsetBandLines )( const Pel* src, Pel* res, const int srcStride, const int resStride, const int startX, const int endX, const int numLines, const int shiftBits, const int* offset, const ClpRng& clpRng );
+  // used by the encoder to collect the per class statistics
+  void ( *m_calcEdgeStats   )( const Pel* src, const Pel* org, const int srcStride, const int orgStride, const int startX, const int endX, const int numLines, const int neighbourA, const int neighbourB, int64_t* diff, int64_t* count );
+  void ( *m_calcBandStats   )( const Pel* src, const Pel* org, const int srcStride, const int orgStride, const int startX, const int endX, const int numLines, const int shiftBits, int64_t* diff, int64_t* count );
 private:
   bool m_picSAOEnabled[MAX_NUM_COMPONENT];
 };
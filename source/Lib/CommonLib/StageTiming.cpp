@@ -0,0 +1,177 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     StageTiming.cpp
+    \brief    time measurement of the decoding stages
+*/
+
+#include "StageTiming.h"
+
+#if DECODER_STAGE_TIMING
+#include <iomanip>
+
+//! \ingroup CommonLib
+//! \{
+
+static inline double toMs( const int64_t ns )
+{
+  return ns * 1e-6;
+}
+
+DecStageTimes& DecStageTimes::operator=( const DecStageTimes& other )
+{
+  for( int i = 0; i < NUM_DEC_STAGES; i++ )
+  {
+    m_ns[i].store( other.get( DecStage( i ) ), std::memory_order_relaxed );
+  }
+  return *this;
+}
+
+void DecStageTimes::reset()
+{
+  for( int i = 0; i < NUM_DEC_STAGES; i++ )
+  {
+    m_ns[i].store( 0, std::memory_order_relaxed );
+  }
+}
+
+void DecStageTimes::add( const DecStageTimes& other )
+{
+  for( int i = 0; i < NUM_DEC_STAGES; i++ )
+  {
+    add( DecStage( i ), other.get( DecStage( i ) ) );
+  }
+}
+
+const char* DecStageStatistics::getStageName( const DecStage stage )
+{
+  static const char* names[NUM_DEC_STAGES] = { "nal_read", "cabac", "recon", "lmcs", "deblock", "sao", "alf", "output" };
+  return names[stage];
+}
+
+void DecStageStatistics::addPicture( const int poc, const uint64_t numLumaSamples, const DecStageTimes& times )
+{
+  m_pictures.push_back( PictureTimes() );
+  m_pictures.back().poc   = poc;
+  m_pictures.back().times = times;
+  m_sequence.add( times );
+  m_numLumaSamples += numLumaSamples;
+}
+
+void DecStageStatistics::printPicture( const MsgLevel msgl, const DecStageTimes& times ) const
+{
+  msg( msgl, "[ST" );
+  for( int i = DEC_STAGE_CABAC; i <= DEC_STAGE_ALF; i++ )
+  {
+    msg( msgl, " %s %.2f", getStageName( DecStage( i ) ), toMs( times.get( DecStage( i ) ) ) );
+  }
+  msg( msgl, "] " );
+}
+
+void DecStageStatistics::printSummary( const MsgLevel msgl, const double decodingTime ) const
+{
+  int64_t total = 0;
+  for( int i = 0; i < NUM_DEC_STAGES; i++ )
+  {
+    total += m_sequence.get( DecStage( i ) );
+  }
+
+  msg( msgl, "\nDecoding stage times (summed over all threads)\n" );
+  for( int i = 0; i < NUM_DEC_STAGES; i++ )
+  {
+    const int64_t ns = m_sequence.get( DecStage( i ) );
+    msg( msgl, "  %-10s %12.3f ms %6.2f %%\n", getStageName( DecStage( i ) ), toMs( ns ), total ? 100.0 * ns / total : 0.0 );
+  }
+  msg( msgl, "  %-10s %12.3f ms\n", "total", toMs( total ) );
+
+  if( decodingTime > 0 )
+  {
+    msg( msgl, "Throughput: %d pictures in %.3f sec, %.2f fps, %.2f Msamples/s (luma)\n", (int) m_pictures.size(), decodingTime,
+         m_pictures.size() / decodingTime, m_numLumaSamples * 1e-6 / decodingTime );
+  }
+}
+
+void DecStageStatistics::writeCSV( std::ostream& os ) const
+{
+  os << "poc";
+  for( int i = 0; i < NUM_DEC_STAGES; i++ )
+  {
+    os << "," << getStageName( DecStage( i ) ) << "_ms";
+  }
+  os << "\n" << std::fixed << std::setprecision( 3 );
+
+  for( const auto &pic : m_pictures )
+  {
+    os << pic.poc;
+    for( int i = 0; i < NUM_DEC_STAGES; i++ )
+    {
+      os << "," << toMs( pic.times.get( DecStage( i ) ) );
+    }
+    os << "\n";
+  }
+
+  // the sequence row includes the times not assigned to a picture
+  os << "total";
+  for( int i = 0; i < NUM_DEC_STAGES; i++ )
+  {
+    os << "," << toMs( m_sequence.get( DecStage( i ) ) );
+  }
+  os << "\n";
+}
+
+void DecStageStatistics::writeJSON( std::ostream& os ) const
+{
+  auto writeTimes = [&os]( const DecStageTimes& times )
+  {
+    for( int i = 0; i < NUM_DEC_STAGES; i++ )
+    {
+      os << ( i ? ", " : "" ) << "\"" << getStageName( DecStage( i ) ) << "_ms\": " << toMs( times.get( DecStage( i ) ) );
+    }
+  };
+
+  os << std::fixed << std::setprecision( 3 );
+  os << "{\n  \"pictures\": [\n";
+  for( size_t n = 0; n < m_pictures.size(); n++ )
+  {
+    os << "    { \"poc\": " << m_pictures[n].poc << ", ";
+    writeTimes( m_pictures[n].times );
+    os << ( n + 1 < m_pictures.size() ? " },\n" : " }\n" );
+  }
+  os << "  ],\n  \"sequence\": { \"num_pictures\": " << m_pictures.size() << ", \"num_luma_samples\": " << m_numLumaSamples << ", ";
+  writeTimes( m_sequence );
+  os << " }\n}\n";
+}
+
+//! \}
+
+#endif
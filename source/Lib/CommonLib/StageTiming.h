@@ -0,0 +1,138 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     StageTiming.h
+    \brief    time measurement of the decoding stages (header)
+*/
+
+#ifndef __STAGETIMING__
+#define __STAGETIMING__
+
+#include "CommonDef.h"
+
+#if DECODER_STAGE_TIMING
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <vector>
+
+//! \ingroup CommonLib
+//! \{
+
+enum DecStage
+{
+  DEC_STAGE_NAL_READ = 0,   ///< byte stream parsing and emulation prevention byte removal
+  DEC_STAGE_CABAC,          ///< CTU syntax parsing
+  DEC_STAGE_RECON,          ///< prediction and reconstruction of the CTUs
+  DEC_STAGE_LMCS,           ///< inverse luma mapping of the reconstructed picture
+  DEC_STAGE_DEBLOCK,
+  DEC_STAGE_SAO,
+  DEC_STAGE_ALF,
+  DEC_STAGE_OUTPUT,         ///< writing the output pictures
+  NUM_DEC_STAGES
+};
+
+/// accumulated time of each decoding stage in nanoseconds, stages running on several threads are summed up
+class DecStageTimes
+{
+public:
+  DecStageTimes()                                     { reset(); }
+  DecStageTimes( const DecStageTimes& other )         { *this = other; }
+  DecStageTimes& operator=( const DecStageTimes& other );
+
+  void    reset ();
+  void    add   ( const DecStage stage, const int64_t ns ) { m_ns[stage].fetch_add( ns, std::memory_order_relaxed ); }
+  void    add   ( const DecStageTimes& other );
+  int64_t get   ( const DecStage stage ) const             { return m_ns[stage].load( std::memory_order_relaxed ); }
+
+private:
+  std::atomic<int64_t> m_ns[NUM_DEC_STAGES];
+};
+
+/// adds the time from its construction to its destruction to a stage
+class DecStageTimer
+{
+public:
+  DecStageTimer( DecStageTimes& times, const DecStage stage ) : m_times( times ), m_stage( stage ), m_start( std::chrono::steady_clock::now() ) {}
+  ~DecStageTimer()
+  {
+    m_times.add( m_stage, std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - m_start ).count() );
+  }
+
+private:
+  DecStageTimes&                        m_times;
+  const DecStage                        m_stage;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+/// stage times per picture and for the whole sequence
+class DecStageStatistics
+{
+public:
+  DecStageStatistics() : m_numLumaSamples( 0 ) {}
+
+  void addPicture       ( const int poc, const uint64_t numLumaSamples, const DecStageTimes& times );
+  /// adds the times not assigned to a picture, e.g. the byte stream parsing
+  void addSequenceTimes ( const DecStageTimes& times )  { m_sequence.add( times ); }
+
+  void printPicture     ( const MsgLevel msgl, const DecStageTimes& times ) const;
+  /// prints the sequence totals and the throughput for the given decoding time
+  void printSummary     ( const MsgLevel msgl, const double decodingTime ) const;
+  void writeCSV         ( std::ostream& os ) const;
+  void writeJSON        ( std::ostream& os ) const;
+
+  static const char* getStageName( const DecStage stage );
+
+private:
+  struct PictureTimes
+  {
+    int           poc;
+    DecStageTimes times;
+  };
+
+  std::vector<PictureTimes> m_pictures;
+  DecStageTimes             m_sequence;
+  uint64_t                  m_numLumaSamples;
+};
+
+#define DEC_STAGE_TIMER( times, stage ) DecStageTimer decStageTimer( times, stage )
+
+//! \}
+
+#else
+
+#define DEC_STAGE_TIMER( times, stage )
+
+#endif
+
+#endif // __STAGETIMING__
@@ -0,0 +1,246 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ThreadPool.cpp
+    \brief    thread pool and progress synchronization used for parallel processing
+*/
+
+#include "ThreadPool.h"
+
+//! \ingroup CommonLib
+//! \{
+
+// ====================================================================================================================
+// ThreadPool
+// ====================================================================================================================
+
+ThreadPool::ThreadPool()
+  : m_numPending( 0 )
+  , m_stop      ( false )
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+  destroy();
+}
+
+void ThreadPool::create( const int numThreads )
+{
+  CHECK( !m_threads.empty(), "Thread pool already created" );
+  CHECK( numThreads < 1, "Thread pool requires at least one thread" );
+
+  m_stop = false;
+  for( int i = 0; i < numThreads; i++ )
+  {
+    m_threads.push_back( std::thread( &ThreadPool::xThreadLoop, this, i ) );
+  }
+}
+
+void ThreadPool::destroy()
+{
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_stop = true;
+  }
+  m_taskCond.notify_all();
+
+  for( auto &thread : m_threads )
+  {
+    thread.join();
+  }
+  m_threads.clear();
+  m_tasks.clear();
+  m_numPending = 0;
+}
+
+void ThreadPool::addTask( Task task )
+{
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_tasks.push_back( std::move( task ) );
+    m_numPending++;
+  }
+  m_taskCond.notify_one();
+}
+
+void ThreadPool::waitForTasks()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_doneCond.wait( lock, [this] { return m_numPending == 0; } );
+
+  if( m_exception )
+  {
+    std::exception_ptr exception = m_exception;
+    m_exception = nullptr;
+    std::rethrow_exception( exception );
+  }
+}
+
+void ThreadPool::runJobs( const int numJobs, const Job& job )
+{
+  struct JobState
+  {
+    std::atomic<int>        nextJob;
+    std::mutex              mutex;
+    std::condition_variable doneCond;
+    int                     numDone;
+    std::exception_ptr      exception;
+  };
+
+  // the helper tasks may only start after all jobs are taken, they must not access anything but the shared state then
+  std::shared_ptr<JobState> state = std::make_shared<JobState>();
+  state->nextJob = 0;
+  state->numDone = 0;
+
+  auto worker = [state, numJobs, &job]( const int workerIdx )
+  {
+    int jobIdx;
+    while( ( jobIdx = state->nextJob++ ) < numJobs )
+    {
+      std::exception_ptr exception;
+      try
+      {
+        job( workerIdx, jobIdx );
+      }
+      catch( ... )
+      {
+        exception = std::current_exception();
+      }
+
+      std::unique_lock<std::mutex> lock( state->mutex );
+      if( exception && !state->exception )
+      {
+        state->exception = exception;
+      }
+      if( ++state->numDone == numJobs )
+      {
+        state->doneCond.notify_all();
+      }
+    }
+  };
+
+  const int numHelpers = std::min( getNumThreads(), numJobs - 1 );
+  for( int i = 0; i < numHelpers; i++ )
+  {
+    addTask( [worker]( int threadIdx ) { worker( threadIdx + 1 ); } );
+  }
+
+  worker( 0 );
+
+  std::unique_lock<std::mutex> lock( state->mutex );
+  state->doneCond.wait( lock, [&state, numJobs] { return state->numDone == numJobs; } );
+
+  if( state->exception )
+  {
+    std::rethrow_exception( state->exception );
+  }
+}
+
+void ThreadPool::xThreadLoop( const int threadIdx )
+{
+  while( true )
+  {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_taskCond.wait( lock, [this] { return m_stop || !m_tasks.empty(); } );
+      if( m_tasks.empty() )
+      {
+        return;
+      }
+      task = std::move( m_tasks.front() );
+      m_tasks.pop_front();
+    }
+
+    std::exception_ptr exception;
+    try
+    {
+      task( threadIdx );
+    }
+    catch( ... )
+    {
+      exception = std::current_exception();
+    }
+
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      if( exception && !m_exception )
+      {
+        m_exception = exception;
+      }
+      if( --m_numPending == 0 )
+      {
+        m_doneCond.notify_all();
+      }
+    }
+  }
+}
+
+// ====================================================================================================================
+// ProgressCounter
+// ====================================================================================================================
+
+void ProgressCounter::reset( const int value )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_value   = value;
+  m_aborted = false;
+}
+
+void ProgressCounter::set( const int value )
+{
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_value = value;
+  }
+  m_cond.notify_all();
+}
+
+bool ProgressCounter::wait( const int value ) const
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_cond.wait( lock, [this, value] { return m_aborted || m_value >= value; } );
+  return m_value >= value;
+}
+
+void ProgressCounter::abort()
+{
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_aborted = true;
+  }
+  m_cond.notify_all();
+}
+
+//! \}
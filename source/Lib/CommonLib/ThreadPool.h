@@ -0,0 +1,116 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ThreadPool.h
+    \brief    thread pool and progress synchronization used for parallel processing (header)
+*/
+
+#ifndef __THREADPOOL__
+#define __THREADPOOL__
+
+#include "CommonDef.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <exception>
+#include <deque>
+#include <vector>
+
+//! \ingroup CommonLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// pool of worker threads processing tasks in FIFO order
+class ThreadPool
+{
+public:
+  typedef std::function<void( int threadIdx )> Task;   ///< task callback, receives the index of the executing worker thread
+  typedef std::function<void( int workerIdx, int jobIdx )> Job;   ///< job callback of runJobs, worker 0 is the calling thread
+
+  ThreadPool();
+  ~ThreadPool();
+
+  void create         ( const int numThreads );
+  void destroy        ();
+
+  int  getNumThreads  () const { return (int) m_threads.size(); }
+
+  void addTask        ( Task task );
+  /// blocks until all added tasks are finished, rethrows the first exception thrown by a task
+  void waitForTasks   ();
+  /// processes the jobs 0..numJobs-1 on the calling thread and the pool threads (workers 1..numThreads), every idle worker
+  /// takes over the next unprocessed job; returns when all jobs are finished, rethrows the first exception thrown by a job
+  void runJobs        ( const int numJobs, const Job& job );
+
+private:
+  void xThreadLoop    ( const int threadIdx );
+
+  std::vector<std::thread>  m_threads;
+  std::deque<Task>          m_tasks;
+  std::mutex                m_mutex;
+  std::condition_variable   m_taskCond;
+  std::condition_variable   m_doneCond;
+  int                       m_numPending;       ///< queued plus running tasks
+  bool                      m_stop;
+  std::exception_ptr        m_exception;
+};
+
+/// monotonically increasing progress value, other threads can wait for a value to be reached
+class ProgressCounter
+{
+public:
+  ProgressCounter() : m_value( 0 ), m_aborted( false ) {}
+
+  void reset          ( const int value = 0 );
+  void set            ( const int value );
+  /// returns false if the wait was aborted before the value was reached
+  bool wait           ( const int value ) const;
+  void abort          ();
+
+private:
+  mutable std::mutex              m_mutex;
+  mutable std::condition_variable m_cond;
+  int                             m_value;
+  bool                            m_aborted;
+};
+
+//! \}
+
+#endif // __THREADPOOL__
@@ -55,6 +55,10 @@
 
 typedef void FwdTrans(const TCoeff*, TCoeff*, int, int, int, int);
 typedef void InvTrans(const TCoeff*, TCoeff*, int, int, int, int, const TCoeff, const TCoeff);
+#if JVET_N0193_LFNST
+typedef void FwdLfnst(const TCoeff*, TCoeff*, const uint32_t, const uint32_t, const uint32_t, const int);
+typedef void InvLfnst(const TCoeff*, TCoeff*, const uint32_t, const uint32_t, const uint32_t, const int);
+#endif
 
 // ====================================================================================================================
 // Class definition
@@ -87,8 +91,11 @@ public:
 #endif
 
 #if JVET_N0193_LFNST
-  void fwdLfnstNxN( int* src, int* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize );
-  void invLfnstNxN( int* src, int* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize );
+  void fwdLfnstNxN( int* src, int* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize ) { m_fwdLfnst( src, dst, mode, index, size, zeroOutSize ); }
+  void invLfnstNxN( int* src, int* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize ) { m_invLfnst( src, dst, mode, index, size, zeroOutSize ); }
+
+  static void fwdLfnstNxNCore( const TCoeff* src, TCoeff* dst, const uint32_t mode, const uint32_t index, const uint32_t size, const int zeroOutSize );
+  static void invLfnstNxNCore( const TCoeff* src, TCoeff* dst, const uint32_t mode, const uint32_t index, const uint32_t size, const int zeroOutSize );
 
   uint32_t getLFNSTIntraMode( int wideAngPredMode );
   bool     getTransposeFlag ( uint32_t intraMode  );
@@ -129,10 +136,16 @@ public:
 #endif
 
 
-#if ENABLE_SPLIT_PARALLELISM
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   void    copyState( const TrQuant& other );
 #endif
 
+#if ENABLE_SIMD_OPT_TRAFO && defined(TARGET_SIMD_X86)
+  void    initTrQuantX86();
+  template <X86_VEXT vext>
+  void    _initTrQuantX86();
+#endif
+
 protected:
   TCoeff*  m_plTempCoeff;
   uint32_t     m_uiMaxTrSize;
@@ -141,6 +154,13 @@ protected:
 
   bool     m_scalingListEnabledFlag;
 
+  FwdTrans* m_fwdTrans[NUM_TRANS_TYPE][g_numTransformMatrixSizes];
+  InvTrans* m_invTrans[NUM_TRANS_TYPE][g_numTransformMatrixSizes];
+#if JVET_N0193_LFNST
+  FwdLfnst* m_fwdLfnst;
+  InvLfnst* m_invLfnst;
+#endif
+
 private:
 #if JVET_N0847_SCALING_LISTS
 	DepQuant *m_quant;          //!< Quantizer
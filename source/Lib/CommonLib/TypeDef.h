@@ -264,23 +264,19 @@ typedef std::pair<int, int>  TrCost;
 #endif
 
 #ifndef ENABLE_WPP_PARALLELISM
-#define ENABLE_WPP_PARALLELISM                            0
+#define ENABLE_WPP_PARALLELISM                            1 // encoding of CTU rows on a thread pool, the number of threads is set with --WppThreads
 #endif
 #if ENABLE_WPP_PARALLELISM
-#ifndef ENABLE_WPP_STATIC_LINK
-#define ENABLE_WPP_STATIC_LINK                            0 // bug fix static link
-#endif
 #define PARL_WPP_MAX_NUM_THREADS                         16
 
 #endif
 #ifndef ENABLE_SPLIT_PARALLELISM
-#define ENABLE_SPLIT_PARALLELISM                          0
+#define ENABLE_SPLIT_PARALLELISM                          1 // concurrent evaluation of the split candidates of a CU, the number of threads is set with --NumSplitThreads
 #endif
 #if ENABLE_SPLIT_PARALLELISM
 #define PARL_SPLIT_MAX_NUM_JOBS                           6                             // number of parallel jobs that can be defined and need memory allocated
 #define NUM_RESERVERD_SPLIT_JOBS                        ( PARL_SPLIT_MAX_NUM_JOBS + 1 )  // number of all data structures including the merge thread (0)
 #define PARL_SPLIT_MAX_NUM_THREADS                        PARL_SPLIT_MAX_NUM_JOBS
-#define NUM_SPLIT_THREADS_IF_MSVC                         4
 
 #endif
 
@@ -359,6 +355,10 @@ typedef std::pair<int, int>  TrCost;
 #define RExt__DECODER_DEBUG_STATISTICS                    1
 #endif
 
+#ifndef DECODER_STAGE_TIMING
+#define DECODER_STAGE_TIMING                              0 ///< 0 (default) = decoder reports as normal, 1 = decoder measures the time of each decoding stage per picture and sequence
+#endif
+
 // ====================================================================================================================
 // Tool Switches - transitory (these macros are likely to be removed in future revisions)
 // ====================================================================================================================
@@ -388,6 +388,14 @@ typedef std::pair<int, int>  TrCost;
 #define ENABLE_SIMD_OPT_DIST                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the distortion calculations(SAD,SSE,HADAMARD), no impact on RD performance
 #define ENABLE_SIMD_OPT_AFFINE_ME                       ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for affine ME, no impact on RD performance
 #define ENABLE_SIMD_OPT_ALF                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for ALF
+#define ENABLE_SIMD_OPT_BITSTREAM                       ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the emulation prevention byte removal, no impact on RD performance
+#define ENABLE_SIMD_OPT_TRAFO                           ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the DCT-II/DST-VII/DCT-VIII core transforms and the LFNST, no impact on RD performance
+#define ENABLE_SIMD_OPT_DBLF                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the deblocking filter, no impact on RD performance
+#define ENABLE_SIMD_OPT_SAO                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for SAO, no impact on RD performance
+#define ENABLE_SIMD_OPT_INTRAPRED                       ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the planar/angular intra prediction, PDPC and CCLM, no impact on RD performance
+#define ENABLE_SIMD_OPT_MIP                             ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the matrix-based intra prediction, no impact on RD performance
+#define ENABLE_SIMD_OPT_DEPQUANT                        ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the dependent quantization trellis, no impact on RD performance
+#define ENABLE_SIMD_OPT_RDOQ                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for the level derivation of the RDOQ, no impact on RD performance
 #if ENABLE_SIMD_OPT_BUFFER
 #define ENABLE_SIMD_OPT_GBI                               1                                                 ///< SIMD optimization for GBi
 #endif
@@ -65,41 +65,59 @@ UnitArea CS::getArea( const CodingStructure &cs, const UnitArea &area, const Cha
 {
   return isDualITree( cs ) ? area.singleChan( chType ) : area;
 }
-void CS::setRefinedMotionField(CodingStructure &cs)
+static void setRefinedMotionFieldCU( CodingUnit& cu )
 {
-  for (CodingUnit *cu : cs.cus)
+  for (auto &pu : CU::traversePUs(cu))
   {
-    for (auto &pu : CU::traversePUs(*cu))
+    PredictionUnit subPu = pu;
+    int dx, dy, x, y, num = 0;
+    dy = std::min<int>(pu.lumaSize().height, DMVR_SUBCU_HEIGHT);
+    dx = std::min<int>(pu.lumaSize().width, DMVR_SUBCU_WIDTH);
+    Position puPos = pu.lumaPos();
+    if (PU::checkDMVRCondition(pu))
     {
-      PredictionUnit subPu = pu;
-      int dx, dy, x, y, num = 0;
-      dy = std::min<int>(pu.lumaSize().height, DMVR_SUBCU_HEIGHT);
-      dx = std::min<int>(pu.lumaSize().width, DMVR_SUBCU_WIDTH);
-      Position puPos = pu.lumaPos();
-      if (PU::checkDMVRCondition(pu))
+      for (y = puPos.y; y < (puPos.y + pu.lumaSize().height); y = y + dy)
       {
-        for (y = puPos.y; y < (puPos.y + pu.lumaSize().height); y = y + dy)
+        for (x = puPos.x; x < (puPos.x + pu.lumaSize().width); x = x + dx)
         {
-          for (x = puPos.x; x < (puPos.x + pu.lumaSize().width); x = x + dx)
-          {
-            subPu.UnitArea::operator=(UnitArea(pu.chromaFormat, Area(x, y, dx, dy)));
-            subPu.mv[0] = pu.mv[0];
-            subPu.mv[1] = pu.mv[1];
-            subPu.mv[REF_PIC_LIST_0] += pu.mvdL0SubPu[num];
-            subPu.mv[REF_PIC_LIST_1] -= pu.mvdL0SubPu[num];
+          subPu.UnitArea::operator=(UnitArea(pu.chromaFormat, Area(x, y, dx, dy)));
+          subPu.mv[0] = pu.mv[0];
+          subPu.mv[1] = pu.mv[1];
+          subPu.mv[REF_PIC_LIST_0] += pu.mvdL0SubPu[num];
+          subPu.mv[REF_PIC_LIST_1] -= pu.mvdL0SubPu[num];
 #if JVET_N0334_MVCLIPPING
-            subPu.mv[REF_PIC_LIST_0].clipToStorageBitDepth();
-            subPu.mv[REF_PIC_LIST_1].clipToStorageBitDepth();
+          subPu.mv[REF_PIC_LIST_0].clipToStorageBitDepth();
+          subPu.mv[REF_PIC_LIST_1].clipToStorageBitDepth();
 #endif
-            pu.mvdL0SubPu[num].setZero();
-            num++;
-            PU::spanMotionInfo(subPu);
-          }
+          pu.mvdL0SubPu[num].setZero();
+          num++;
+          PU::spanMotionInfo(subPu);
         }
       }
     }
   }
 }
+
+void CS::setRefinedMotionField(CodingStructure &cs)
+{
+  for (CodingUnit *cu : cs.cus)
+  {
+    setRefinedMotionFieldCU(*cu);
+  }
+}
+
+void CS::setRefinedMotionField(CodingStructure &cs, const int ctuRow)
+{
+  const PreCalcValues& pcv = *cs.pcv;
+  for (int x = 0; x < pcv.widthInCtus; x++)
+  {
+    const UnitArea ctuArea(pcv.chrFormat, Area(x << pcv.maxCUWidthLog2, ctuRow << pcv.maxCUHeightLog2, pcv.maxCUWidth, pcv.maxCUHeight));
+    for (auto &cu : cs.traverseCUs(CS::getArea(cs, ctuArea, CH_L), CH_L))
+    {
+      setRefinedMotionFieldCU(cu);
+    }
+  }
+}
 // CU tools
 
 bool CU::isIntra(const CodingUnit &cu)
@@ -1309,7 +1327,7 @@ bool PU::xCheckSimilarMotion(const int mergeCandIndex, const int prevCnt, const
 
 #if JVET_L0090_PAIR_AVG
 
-bool PU::addMergeHMVPCand(const CodingStructure &cs, MergeCtx& mrgCtx, bool canFastExit, const int& mrgCandIdx, const uint32_t maxNumMergeCandMin1, int &cnt, const int prevCnt, bool isAvailableSubPu, unsigned subPuMvpPos
+bool PU::addMergeHMVPCand(const PredictionUnit &pu, MergeCtx& mrgCtx, bool canFastExit, const int& mrgCandIdx, const uint32_t maxNumMergeCandMin1, int &cnt, const int prevCnt, bool isAvailableSubPu, unsigned subPuMvpPos
   , bool ibcFlag
   , bool isShared
 )
@@ -1320,7 +1338,11 @@ bool PU::addMergeHMVPCand(const CodingStructure &cs, MergeCtx& mrgCtx, bool isCa
 )
 #endif
 {
+#if JVET_L0090_PAIR_AVG
+  const CodingStructure& cs = *pu.cs;
+#endif
   const Slice& slice = *cs.slice;
+  const LutMotionCand& motionLut = cs.getMotionLut( pu.lumaPos() );
   MotionInfo miNeighbor;
   bool hasPruned[MRG_MAX_NUM_CANDS];
   memset(hasPruned, 0, MRG_MAX_NUM_CANDS * sizeof(bool));
@@ -1329,9 +1351,9 @@ bool PU::addMergeHMVPCand(const CodingStructure &cs, MergeCtx& mrgCtx, bool isCa
     hasPruned[subPuMvpPos] = true;
   }
 #if JVET_N0266_SMALL_BLOCKS
-  auto &lut = ibcFlag ? ( isShared ? cs.motionLut.lutShareIbc : cs.motionLut.lutIbc ) : cs.motionLut.lut;
+  auto &lut = ibcFlag ? ( isShared ? motionLut.lutShareIbc : motionLut.lutIbc ) : motionLut.lut;
 #else
-  auto &lut = ibcFlag ? ( isShared ? cs.motionLut.lutShareIbc : cs.motionLut.lutIbc ) : ( isShared ? cs.motionLut.lutShare : cs.motionLut.lut );
+  auto &lut = ibcFlag ? ( isShared ? motionLut.lutShareIbc : motionLut.lutIbc ) : ( isShared ? motionLut.lutShare : motionLut.lut );
 #endif
   int num_avai_candInLUT = (int) lut.size();
 
@@ -1562,7 +1584,7 @@ void PU::getIBCMergeCandidates(const PredictionUnit &pu, MergeCtx& mrgCtx, const
     bool  isShared = ((pu.Y().lumaSize().width != pu.shareParentSize.width) || (pu.Y().lumaSize().height != pu.shareParentSize.height));
 
 #if JVET_L0090_PAIR_AVG
-    bool bFound = addMergeHMVPCand(cs, mrgCtx, canFastExit
+    bool bFound = addMergeHMVPCand(pu, mrgCtx, canFastExit
       , mrgCandIdx
       , maxNumMergeCandMin1, cnt
       , spatialCandPos
@@ -2000,7 +2022,7 @@ void PU::getInterMergeCandidates( const PredictionUnit &pu, MergeCtx& mrgCtx,
 #else
     bool  isShared = ((pu.Y().lumaSize().width != pu.shareParentSize.width) || (pu.Y().lumaSize().height != pu.shareParentSize.height));
 #endif
-    bool bFound = addMergeHMVPCand(cs, mrgCtx, canFastExit
+    bool bFound = addMergeHMVPCand(pu, mrgCtx, canFastExit
       , mrgCandIdx
       , maxNumMergeCandMin1, cnt
       , spatialCandPos
@@ -3515,7 +3537,8 @@ void PU::addAMVPHMVPCand(const PredictionUnit &pu, const RefPicList eRefPicList,
   const Slice &slice = *(*pu.cs).slice;
 
   MotionInfo neibMi;
-  auto &lut = CU::isIBC(*pu.cu) ? pu.cs->motionLut.lutIbc : pu.cs->motionLut.lut;
+  const LutMotionCand& motionLut = pu.cs->getMotionLut( pu.lumaPos() );
+  auto &lut = CU::isIBC(*pu.cu) ? motionLut.lutIbc : motionLut.lut;
   int num_avai_candInLUT = (int) lut.size();
   int num_allowedCand = std::min(MAX_NUM_HMVP_AVMPCANDS, num_avai_candInLUT);
 
@@ -0,0 +1,104 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     BitStreamX86.h
+    \brief    SIMD search for emulation prevention bytes.
+*/
+
+//! \ingroup CommonLib
+//! \{
+
+
+#include "CommonLib/CommonDef.h"
+#include "CommonDefX86.h"
+#include "CommonLib/BitStream.h"
+
+
+#if ENABLE_SIMD_OPT_BITSTREAM
+#ifdef TARGET_SIMD_X86
+
+template<X86_VEXT vext>
+size_t findEmulationPrevention_SIMD( const uint8_t* buf, size_t pos, size_t size )
+{
+  // candidates are two zero bytes followed by a byte not larger than 0x03, the byte sequences without candidates are skipped
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vzero  = _mm256_setzero_si256();
+    const __m256i vthree = _mm256_set1_epi8( 0x03 );
+    while( pos + 34 <= size )
+    {
+      __m256i v0 = _mm256_loadu_si256( ( const __m256i* ) ( buf + pos     ) );
+      __m256i v1 = _mm256_loadu_si256( ( const __m256i* ) ( buf + pos + 1 ) );
+      __m256i v2 = _mm256_loadu_si256( ( const __m256i* ) ( buf + pos + 2 ) );
+      __m256i vc = _mm256_and_si256( _mm256_cmpeq_epi8( _mm256_or_si256( v0, v1 ), vzero ),
+                                     _mm256_cmpeq_epi8( _mm256_min_epu8( v2, vthree ), v2 ) );
+      const uint32_t mask = ( uint32_t ) _mm256_movemask_epi8( vc );
+      if( mask )
+      {
+        return pos + floorLog2( mask & ( ~mask + 1 ) );
+      }
+      pos += 32;
+    }
+  }
+#endif
+  const __m128i vzero  = _mm_setzero_si128();
+  const __m128i vthree = _mm_set1_epi8( 0x03 );
+  while( pos + 18 <= size )
+  {
+    __m128i v0 = _mm_loadu_si128( ( const __m128i* ) ( buf + pos     ) );
+    __m128i v1 = _mm_loadu_si128( ( const __m128i* ) ( buf + pos + 1 ) );
+    __m128i v2 = _mm_loadu_si128( ( const __m128i* ) ( buf + pos + 2 ) );
+    __m128i vc = _mm_and_si128( _mm_cmpeq_epi8( _mm_or_si128( v0, v1 ), vzero ),
+                                _mm_cmpeq_epi8( _mm_min_epu8( v2, vthree ), v2 ) );
+    const uint32_t mask = ( uint32_t ) _mm_movemask_epi8( vc );
+    if( mask )
+    {
+      return pos + floorLog2( mask & ( ~mask + 1 ) );
+    }
+    pos += 16;
+  }
+  return findEmulationPreventionCore( buf, pos, size );
+}
+
+template<X86_VEXT vext>
+void BitstreamOps::_initBitstreamOpsX86()
+{
+  findEmulationPrevention = findEmulationPrevention_SIMD<vext>;
+}
+
+template void BitstreamOps::_initBitstreamOpsX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+#endif
+//! \}
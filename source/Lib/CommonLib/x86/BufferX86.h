@@ -919,6 +919,146 @@ void linTf_SSE_entry( const Pel* src, int srcStride, Pel *dst, int dstStride, in
   }
 }
 
+// The LUT is gathered with 32-bit loads at the 16-bit positions of the indices. The last entry is read from the upper
+// half of the word at the second to last entry, so that no load crosses the end of the table.
+#ifdef USE_AVX2
+static inline __m256i gatherLut_AVX2( const Pel* lut, const __m256i idx, const __m256i lastIdx, const __m256i loadIdx )
+{
+  const __m256i clipIdx = _mm256_min_epi32( _mm256_max_epi32( idx, _mm256_setzero_si256() ), lastIdx );
+  const __m256i load    = _mm256_min_epi32( clipIdx, loadIdx );
+  const __m256i val     = _mm256_i32gather_epi32( ( const int* ) lut, load, sizeof( Pel ) );
+  return _mm256_and_si256( _mm256_srlv_epi32( val, _mm256_slli_epi32( _mm256_sub_epi32( clipIdx, load ), 4 ) ), _mm256_set1_epi32( 0xffff ) );
+}
+#endif
+
+template<X86_VEXT vext>
+void applyLut_SIMD( Pel* ptr, int ptrStride, int width, int height, const Pel* lut, int lutSize )
+{
+#ifdef USE_AVX2
+  if( vext >= AVX2 && ( width & 7 ) == 0 && lutSize > 1 )
+  {
+    const __m256i vLastIdx = _mm256_set1_epi32( lutSize - 1 );
+    const __m256i vLoadIdx = _mm256_set1_epi32( lutSize - 2 );
+
+    for( int y = 0; y < height; y++ )
+    {
+      int x = 0;
+      for( ; x + 16 <= width; x += 16 )
+      {
+        const __m256i src = _mm256_loadu_si256( ( const __m256i* ) &ptr[x] );
+        const __m256i lo  = gatherLut_AVX2( lut, _mm256_cvtepi16_epi32( _mm256_castsi256_si128( src ) ),      vLastIdx, vLoadIdx );
+        const __m256i hi  = gatherLut_AVX2( lut, _mm256_cvtepi16_epi32( _mm256_extracti128_si256( src, 1 ) ), vLastIdx, vLoadIdx );
+        _mm256_storeu_si256( ( __m256i* ) &ptr[x], _mm256_permute4x64_epi64( _mm256_packus_epi32( lo, hi ), 0xd8 ) );
+      }
+      if( x < width )
+      {
+        const __m256i val = gatherLut_AVX2( lut, _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &ptr[x] ) ), vLastIdx, vLoadIdx );
+        _mm_storeu_si128( ( __m128i* ) &ptr[x], _mm256_castsi256_si128( _mm256_permute4x64_epi64( _mm256_packus_epi32( val, val ), 0xd8 ) ) );
+      }
+      ptr += ptrStride;
+    }
+    return;
+  }
+#endif
+
+  applyLutCore( ptr, ptrStride, width, height, lut, lutSize );
+}
+
+// The forward scaling divides by the scale factor in double precision, which is exact for the value range of the
+// chroma residuals.
+template<X86_VEXT vext>
+void scaleSignal_SIMD( Pel* ptr, int ptrStride, int width, int height, int scale, bool dir, const ClpRng& clpRng )
+{
+  if( width & 3 )
+  {
+    scaleSignalCore( ptr, ptrStride, width, height, scale, dir, clpRng );
+    return;
+  }
+
+  const int maxAbsclipBD = ( 1 << clpRng.bd ) - 1;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && ( width & 7 ) == 0 )
+  {
+    const __m256i vMax    = _mm256_set1_epi32( maxAbsclipBD );
+    const __m256d vScale  = _mm256_set1_pd( double( scale ) );
+    const __m256i vOffset = _mm256_set1_epi32( dir ? scale >> 1 : 1 << ( CSCALE_FP_PREC - 1 ) );
+#if JVET_N0220_LMCS_SIMPLIFICATION
+    const __m256i vMin    = _mm256_set1_epi32( -maxAbsclipBD - ( dir ? 0 : 1 ) );
+#else
+    const __m256i vMin    = _mm256_set1_epi32( -maxAbsclipBD );
+#endif
+    const __m256i vMul    = _mm256_set1_epi32( scale );
+
+    for( int y = 0; y < height; y++ )
+    {
+      for( int x = 0; x < width; x += 8 )
+      {
+        __m256i val = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &ptr[x] ) );
+        __m256i res;
+        if( dir )
+        {
+          const __m256i num = _mm256_add_epi32( _mm256_slli_epi32( _mm256_abs_epi32( val ), CSCALE_FP_PREC ), vOffset );
+          const __m128i qLo = _mm256_cvttpd_epi32( _mm256_div_pd( _mm256_cvtepi32_pd( _mm256_castsi256_si128( num ) ), vScale ) );
+          const __m128i qHi = _mm256_cvttpd_epi32( _mm256_div_pd( _mm256_cvtepi32_pd( _mm256_extracti128_si256( num, 1 ) ), vScale ) );
+          res = _mm256_sign_epi32( _mm256_inserti128_si256( _mm256_castsi128_si256( qLo ), qHi, 1 ), val );
+          res = _mm256_min_epi32( _mm256_max_epi32( res, vMin ), vMax );
+        }
+        else
+        {
+#if JVET_N0220_LMCS_SIMPLIFICATION
+          val = _mm256_min_epi32( _mm256_max_epi32( val, vMin ), vMax );
+#endif
+          res = _mm256_srai_epi32( _mm256_add_epi32( _mm256_mullo_epi32( _mm256_abs_epi32( val ), vMul ), vOffset ), CSCALE_FP_PREC );
+          res = _mm256_sign_epi32( res, val );
+        }
+        res = _mm256_permute4x64_epi64( _mm256_packs_epi32( res, res ), 0xd8 );
+        _mm_storeu_si128( ( __m128i* ) &ptr[x], _mm256_castsi256_si128( res ) );
+      }
+      ptr += ptrStride;
+    }
+    return;
+  }
+#endif
+
+  const __m128i vMax    = _mm_set1_epi32( maxAbsclipBD );
+  const __m128d vScale  = _mm_set1_pd( double( scale ) );
+  const __m128i vOffset = _mm_set1_epi32( dir ? scale >> 1 : 1 << ( CSCALE_FP_PREC - 1 ) );
+#if JVET_N0220_LMCS_SIMPLIFICATION
+  const __m128i vMin    = _mm_set1_epi32( -maxAbsclipBD - ( dir ? 0 : 1 ) );
+#else
+  const __m128i vMin    = _mm_set1_epi32( -maxAbsclipBD );
+#endif
+  const __m128i vMul    = _mm_set1_epi32( scale );
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x += 4 )
+    {
+      __m128i val = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &ptr[x] ) );
+      __m128i res;
+      if( dir )
+      {
+        const __m128i num = _mm_add_epi32( _mm_slli_epi32( _mm_abs_epi32( val ), CSCALE_FP_PREC ), vOffset );
+        const __m128i qLo = _mm_cvttpd_epi32( _mm_div_pd( _mm_cvtepi32_pd( num ), vScale ) );
+        const __m128i qHi = _mm_cvttpd_epi32( _mm_div_pd( _mm_cvtepi32_pd( _mm_unpackhi_epi64( num, num ) ), vScale ) );
+        res = _mm_sign_epi32( _mm_unpacklo_epi64( qLo, qHi ), val );
+        res = _mm_min_epi32( _mm_max_epi32( res, vMin ), vMax );
+      }
+      else
+      {
+#if JVET_N0220_LMCS_SIMPLIFICATION
+        val = _mm_min_epi32( _mm_max_epi32( val, vMin ), vMax );
+#endif
+        res = _mm_srai_epi32( _mm_add_epi32( _mm_mullo_epi32( _mm_abs_epi32( val ), vMul ), vOffset ), CSCALE_FP_PREC );
+        res = _mm_sign_epi32( res, val );
+      }
+      _mm_storel_epi64( ( __m128i* ) &ptr[x], _mm_packs_epi32( res, res ) );
+    }
+    ptr += ptrStride;
+  }
+}
+
 template<X86_VEXT vext>
 void PelBufferOps::_initPelBufOpsX86()
 {
@@ -937,6 +1077,9 @@ void PelBufferOps::_initPelBufOpsX86()
 
   linTf8 = linTf_SSE_entry<vext, 8>;
   linTf4 = linTf_SSE_entry<vext, 4>;
+
+  applyLut    = applyLut_SIMD<vext>;
+  scaleSignal = scaleSignal_SIMD<vext>;
 #if ENABLE_SIMD_OPT_GBI
   removeWeightHighFreq8 = removeWeightHighFreq_SSE<vext, 8>;
   removeWeightHighFreq4 = removeWeightHighFreq_SSE<vext, 4>;
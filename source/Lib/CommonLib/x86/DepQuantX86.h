@@ -0,0 +1,163 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     DepQuantX86.h
+    \brief    SIMD decision update of the dependent quantization trellis.
+*/
+
+//! \ingroup CommonLib
+//! \{
+
+
+#include "CommonLib/CommonDef.h"
+#include "CommonDefX86.h"
+#include "CommonLib/DepQuant.h"
+
+
+#if ENABLE_SIMD_OPT_DEPQUANT
+#ifdef TARGET_SIMD_X86
+
+static_assert( sizeof( DQIntern::Decision ) == 2 * sizeof( int64_t ), "Decision is loaded as rdCost and ( absLevel, prevId ) pair" );
+
+// payload of a decision candidate in the 64-bit layout of ( absLevel, prevId )
+#define DQ_PAYLOAD( absLevel, prevId ) ( absLevel ), ( prevId )
+
+// The four decisions are kept in the lane order ( 0, 2, 1, 3 ), in which the previous states 0 and 1 feed the lower
+// and the previous states 2 and 3 the upper half. Each step compares one candidate per decision in the order of the
+// scalar trellis and only takes strictly lower costs.
+template<X86_VEXT vext>
+void selectDecisions_SIMD( const DQIntern::DecisionCandidates& cand, DQIntern::Decision* decisions )
+{
+  const int lv0 = cand.absLevel[0];
+  const int lv1 = cand.absLevel[1];
+  const int lv2 = cand.absLevel[2];
+  const int lv3 = cand.absLevel[3];
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i d01   = _mm256_loadu_si256( ( const __m256i* ) &decisions[0] );
+    const __m256i d23   = _mm256_loadu_si256( ( const __m256i* ) &decisions[2] );
+    __m256i       cost  = _mm256_unpacklo_epi64( d01, d23 );
+    __m256i       pay   = _mm256_unpackhi_epi64( d01, d23 );
+
+    const __m256i costA = _mm256_loadu_si256( ( const __m256i* ) cand.costA );
+    const __m256i costB = _mm256_loadu_si256( ( const __m256i* ) cand.costB );
+    const __m256i costZ = _mm256_loadu_si256( ( const __m256i* ) cand.costZ );
+
+#define DQ_CHECK_AVX2( CCOST, CPAY )                                    \
+    {                                                                   \
+      const __m256i cCost = CCOST;                                      \
+      const __m256i mask  = _mm256_cmpgt_epi64( cost, cCost );          \
+      cost = _mm256_blendv_epi8( cost, cCost, mask );                   \
+      pay  = _mm256_blendv_epi8( pay,  CPAY,  mask );                   \
+    }
+
+    DQ_CHECK_AVX2( _mm256_unpacklo_epi64( costA, costB ),
+                   _mm256_setr_epi32( DQ_PAYLOAD( lv0, 0 ), DQ_PAYLOAD( lv2, 0 ), DQ_PAYLOAD( lv3, 2 ), DQ_PAYLOAD( lv1, 2 ) ) );
+    DQ_CHECK_AVX2( _mm256_blend_epi32( costZ, costA, 0xcc ),
+                   _mm256_setr_epi32( DQ_PAYLOAD(   0, 0 ), DQ_PAYLOAD( lv0, 1 ), DQ_PAYLOAD(   0, 2 ), DQ_PAYLOAD( lv3, 3 ) ) );
+    DQ_CHECK_AVX2( _mm256_unpackhi_epi64( costB, costZ ),
+                   _mm256_setr_epi32( DQ_PAYLOAD( lv2, 1 ), DQ_PAYLOAD(   0, 1 ), DQ_PAYLOAD( lv1, 3 ), DQ_PAYLOAD(   0, 3 ) ) );
+    DQ_CHECK_AVX2( _mm256_permute4x64_epi64( _mm256_loadu_si256( ( const __m256i* ) cand.costSkip ), 0xd8 ),
+                   _mm256_setr_epi32( DQ_PAYLOAD(   0, 4 ), DQ_PAYLOAD(   0, 6 ), DQ_PAYLOAD(   0, 5 ), DQ_PAYLOAD(   0, 7 ) ) );
+    DQ_CHECK_AVX2( _mm256_permute4x64_epi64( _mm256_loadu_si256( ( const __m256i* ) cand.costStart ), 0xd8 ),
+                   _mm256_setr_epi32( DQ_PAYLOAD( lv0, -1 ), DQ_PAYLOAD( lv2, -1 ), DQ_PAYLOAD( 0, -2 ), DQ_PAYLOAD( 0, -2 ) ) );
+#undef DQ_CHECK_AVX2
+
+    _mm256_storeu_si256( ( __m256i* ) &decisions[0], _mm256_unpacklo_epi64( cost, pay ) );
+    _mm256_storeu_si256( ( __m256i* ) &decisions[2], _mm256_unpackhi_epi64( cost, pay ) );
+  }
+  else
+#endif
+  {
+    // lower half holds the decisions ( 0, 2 ), upper half the decisions ( 1, 3 )
+    const __m128i d0    = _mm_loadu_si128( ( const __m128i* ) &decisions[0] );
+    const __m128i d1    = _mm_loadu_si128( ( const __m128i* ) &decisions[1] );
+    const __m128i d2    = _mm_loadu_si128( ( const __m128i* ) &decisions[2] );
+    const __m128i d3    = _mm_loadu_si128( ( const __m128i* ) &decisions[3] );
+    __m128i       costL = _mm_unpacklo_epi64( d0, d2 );
+    __m128i       payL  = _mm_unpackhi_epi64( d0, d2 );
+    __m128i       costH = _mm_unpacklo_epi64( d1, d3 );
+    __m128i       payH  = _mm_unpackhi_epi64( d1, d3 );
+
+    const __m128i costAL = _mm_loadu_si128( ( const __m128i* ) &cand.costA[0] );
+    const __m128i costAH = _mm_loadu_si128( ( const __m128i* ) &cand.costA[2] );
+    const __m128i costBL = _mm_loadu_si128( ( const __m128i* ) &cand.costB[0] );
+    const __m128i costBH = _mm_loadu_si128( ( const __m128i* ) &cand.costB[2] );
+    const __m128i costZL = _mm_loadu_si128( ( const __m128i* ) &cand.costZ[0] );
+    const __m128i costZH = _mm_loadu_si128( ( const __m128i* ) &cand.costZ[2] );
+    const __m128i skip01 = _mm_loadu_si128( ( const __m128i* ) &cand.costSkip[0] );
+    const __m128i skip23 = _mm_loadu_si128( ( const __m128i* ) &cand.costSkip[2] );
+    const __m128i strt01 = _mm_loadu_si128( ( const __m128i* ) &cand.costStart[0] );
+    const __m128i strt23 = _mm_loadu_si128( ( const __m128i* ) &cand.costStart[2] );
+
+#define DQ_CHECK_SSE( COST, PAY, CCOST, CPAY )                          \
+    {                                                                   \
+      const __m128i cCost = CCOST;                                      \
+      const __m128i mask  = _mm_cmpgt_epi64( COST, cCost );             \
+      COST = _mm_blendv_epi8( COST, cCost, mask );                      \
+      PAY  = _mm_blendv_epi8( PAY,  CPAY,  mask );                      \
+    }
+
+    DQ_CHECK_SSE( costL, payL, _mm_unpacklo_epi64( costAL, costBL ),        _mm_setr_epi32( DQ_PAYLOAD( lv0,  0 ), DQ_PAYLOAD( lv2,  0 ) ) );
+    DQ_CHECK_SSE( costH, payH, _mm_unpacklo_epi64( costAH, costBH ),        _mm_setr_epi32( DQ_PAYLOAD( lv3,  2 ), DQ_PAYLOAD( lv1,  2 ) ) );
+    DQ_CHECK_SSE( costL, payL, _mm_blend_epi16( costZL, costAL, 0xf0 ),     _mm_setr_epi32( DQ_PAYLOAD(   0,  0 ), DQ_PAYLOAD( lv0,  1 ) ) );
+    DQ_CHECK_SSE( costH, payH, _mm_blend_epi16( costZH, costAH, 0xf0 ),     _mm_setr_epi32( DQ_PAYLOAD(   0,  2 ), DQ_PAYLOAD( lv3,  3 ) ) );
+    DQ_CHECK_SSE( costL, payL, _mm_unpackhi_epi64( costBL, costZL ),        _mm_setr_epi32( DQ_PAYLOAD( lv2,  1 ), DQ_PAYLOAD(   0,  1 ) ) );
+    DQ_CHECK_SSE( costH, payH, _mm_unpackhi_epi64( costBH, costZH ),        _mm_setr_epi32( DQ_PAYLOAD( lv1,  3 ), DQ_PAYLOAD(   0,  3 ) ) );
+    DQ_CHECK_SSE( costL, payL, _mm_unpacklo_epi64( skip01, skip23 ),        _mm_setr_epi32( DQ_PAYLOAD(   0,  4 ), DQ_PAYLOAD(   0,  6 ) ) );
+    DQ_CHECK_SSE( costH, payH, _mm_unpackhi_epi64( skip01, skip23 ),        _mm_setr_epi32( DQ_PAYLOAD(   0,  5 ), DQ_PAYLOAD(   0,  7 ) ) );
+    DQ_CHECK_SSE( costL, payL, _mm_unpacklo_epi64( strt01, strt23 ),        _mm_setr_epi32( DQ_PAYLOAD( lv0, -1 ), DQ_PAYLOAD( lv2, -1 ) ) );
+#undef DQ_CHECK_SSE
+
+    _mm_storeu_si128( ( __m128i* ) &decisions[0], _mm_unpacklo_epi64( costL, payL ) );
+    _mm_storeu_si128( ( __m128i* ) &decisions[2], _mm_unpackhi_epi64( costL, payL ) );
+    _mm_storeu_si128( ( __m128i* ) &decisions[1], _mm_unpacklo_epi64( costH, payH ) );
+    _mm_storeu_si128( ( __m128i* ) &decisions[3], _mm_unpackhi_epi64( costH, payH ) );
+  }
+}
+
+#undef DQ_PAYLOAD
+
+template <X86_VEXT vext>
+void DepQuant::_initDepQuantX86()
+{
+  m_selectDecisions = selectDecisions_SIMD<vext>;
+}
+
+template void DepQuant::_initDepQuantX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+#endif
+//! \}
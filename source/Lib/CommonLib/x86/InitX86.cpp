@@ -50,6 +50,19 @@
 
 #include "CommonLib/IbcHashMap.h"
 
+#include "CommonLib/BitStream.h"
+
+#include "CommonLib/LoopFilter.h"
+
+#include "CommonLib/SampleAdaptiveOffset.h"
+
+#include "CommonLib/IntraPrediction.h"
+
+#include "CommonLib/MatrixIntraPrediction.h"
+
+#include "CommonLib/DepQuant.h"
+#include "CommonLib/QuantRDOQ.h"
+
 #ifdef TARGET_SIMD_X86
 
 
@@ -122,6 +135,106 @@ void RdCost::initRdCostX86()
 }
 #endif
 
+#if ENABLE_SIMD_OPT_TRAFO
+void TrQuant::initTrQuantX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext){
+    case AVX512:
+    case AVX2:
+      _initTrQuantX86<AVX2>();
+      break;
+    case AVX:
+    case SSE42:
+    case SSE41:
+      _initTrQuantX86<SSE41>();
+      break;
+    default:
+      break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_DBLF
+void LoopFilter::initLoopFilterX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext){
+    case AVX512:
+    case AVX2:
+      _initLoopFilterX86<AVX2>();
+      break;
+    case AVX:
+    case SSE42:
+    case SSE41:
+      _initLoopFilterX86<SSE41>();
+      break;
+    default:
+      break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_SAO
+void SampleAdaptiveOffset::initSampleAdaptiveOffsetX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext){
+    case AVX512:
+    case AVX2:
+      _initSampleAdaptiveOffsetX86<AVX2>();
+      break;
+    case AVX:
+    case SSE42:
+    case SSE41:
+      _initSampleAdaptiveOffsetX86<SSE41>();
+      break;
+    default:
+      break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_INTRAPRED
+void IntraPrediction::initIntraPredictionX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext){
+    case AVX512:
+    case AVX2:
+      _initIntraPredictionX86<AVX2>();
+      break;
+    case AVX:
+    case SSE42:
+    case SSE41:
+      _initIntraPredictionX86<SSE41>();
+      break;
+    default:
+      break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_MIP && JVET_N0217_MATRIX_INTRAPRED
+void Mip::PredictorMIP::initPredictorMipX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext){
+    case AVX512:
+    case AVX2:
+      _initPredictorMipX86<AVX2>();
+      break;
+    case AVX:
+    case SSE42:
+    case SSE41:
+      _initPredictorMipX86<SSE41>();
+      break;
+    default:
+      break;
+  }
+}
+#endif
+
 #if ENABLE_SIMD_OPT_AFFINE_ME
 void AffineGradientSearch::initAffineGradientSearchX86()
 {
@@ -167,6 +280,29 @@ void AdaptiveLoopFilter::initAdaptiveLoopFilterX86()
 }
 #endif
 
+#if ENABLE_SIMD_OPT_BITSTREAM
+void BitstreamOps::initBitstreamOpsX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch ( vext )
+  {
+  case AVX512:
+  case AVX2:
+    _initBitstreamOpsX86<AVX2>();
+    break;
+  case AVX:
+    _initBitstreamOpsX86<AVX>();
+    break;
+  case SSE42:
+  case SSE41:
+    _initBitstreamOpsX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
 #if ENABLE_SIMD_OPT_IBC
 void IbcHashMap::initIbcHashMapX86()
 {
@@ -186,5 +322,47 @@ void IbcHashMap::initIbcHashMapX86()
 }
 #endif
 
+#if ENABLE_SIMD_OPT_DEPQUANT
+void DepQuant::initDepQuantX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext)
+  {
+  case AVX512:
+  case AVX2:
+    _initDepQuantX86<AVX2>();
+    break;
+  case AVX:
+  case SSE42:
+    _initDepQuantX86<SSE42>();
+    break;
+  case SSE41:
+  default:
+    break;
+  }
+}
+#endif
+
+#if ENABLE_SIMD_OPT_RDOQ
+void QuantRDOQ::initQuantRDOQX86()
+{
+  auto vext = read_x86_extension_flags();
+  switch (vext)
+  {
+  case AVX512:
+  case AVX2:
+    _initQuantRDOQX86<AVX2>();
+    break;
+  case AVX:
+  case SSE42:
+  case SSE41:
+    _initQuantRDOQX86<SSE41>();
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
 #endif
 
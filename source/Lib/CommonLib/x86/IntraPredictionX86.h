@@ -0,0 +1,502 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     IntraPredictionX86.h
+    \brief    SIMD planar prediction, angular interpolation, PDPC and CCLM luma downsampling for intra prediction.
+*/
+
+//! \ingroup CommonLib
+//! \{
+
+
+#include "CommonLib/CommonDef.h"
+#include "CommonDefX86.h"
+#include "CommonLib/IntraPrediction.h"
+
+
+#if ENABLE_SIMD_OPT_INTRAPRED
+#ifdef TARGET_SIMD_X86
+
+// IntraVecSSE4 holds 4, IntraVecSSE 8 and IntraVecAVX2 16 samples of 16 bit. unpacklo/unpackhi interleave within 128-bit
+// lanes, packs32 of the two madd results of the interleaved halves restores the sample order. packs32Seq packs the madd
+// results of two consecutive loads, of which IntraVecSSE4 only uses the lower half.
+struct IntraVecSSE
+{
+  typedef __m128i T;
+  static const int numSamples = 8;
+
+  static inline T    load   ( const Pel* src )                { return _mm_loadu_si128( ( const __m128i* ) src ); }
+  static inline void store  ( Pel* dst, const T a )           { _mm_storeu_si128( ( __m128i* ) dst, a ); }
+  static inline T    set1   ( const int v )                   { return _mm_set1_epi16( v ); }
+  static inline T    set1_32( const int v )                   { return _mm_set1_epi32( v ); }
+  static inline T    ramp   ()                                { return _mm_setr_epi16( 0, 1, 2, 3, 4, 5, 6, 7 ); }
+  static inline T    zero   ()                                { return _mm_setzero_si128(); }
+  static inline T    add    ( const T a, const T b )          { return _mm_add_epi16( a, b ); }
+  static inline T    sub    ( const T a, const T b )          { return _mm_sub_epi16( a, b ); }
+  static inline T    srai   ( const T a, const int n )        { return _mm_srai_epi16( a, n ); }
+  static inline T    min    ( const T a, const T b )          { return _mm_min_epi16( a, b ); }
+  static inline T    max    ( const T a, const T b )          { return _mm_max_epi16( a, b ); }
+  static inline T    unpacklo( const T a, const T b )         { return _mm_unpacklo_epi16( a, b ); }
+  static inline T    unpackhi( const T a, const T b )         { return _mm_unpackhi_epi16( a, b ); }
+  static inline T    madd   ( const T a, const T b )          { return _mm_madd_epi16( a, b ); }
+  static inline T    add32  ( const T a, const T b )          { return _mm_add_epi32( a, b ); }
+  static inline T    sub32  ( const T a, const T b )          { return _mm_sub_epi32( a, b ); }
+  static inline T    mullo32( const T a, const T b )          { return _mm_mullo_epi32( a, b ); }
+  static inline T    sll32  ( const T a, const int n )        { return _mm_sll_epi32( a, _mm_cvtsi32_si128( n ) ); }
+  static inline T    sra32  ( const T a, const int n )        { return _mm_sra_epi32( a, _mm_cvtsi32_si128( n ) ); }
+  static inline T    packs32( const T a, const T b )          { return _mm_packs_epi32( a, b ); }
+  static inline T    packs32Seq( const T a, const T b )       { return _mm_packs_epi32( a, b ); }
+};
+
+struct IntraVecSSE4 : public IntraVecSSE
+{
+  static const int numSamples = 4;
+
+  static inline T    load   ( const Pel* src )                { return _mm_loadl_epi64( ( const __m128i* ) src ); }
+  static inline void store  ( Pel* dst, const T a )           { _mm_storel_epi64( ( __m128i* ) dst, a ); }
+  static inline T    packs32Seq( const T a, const T b )       { return _mm_packs_epi32( _mm_unpacklo_epi64( a, b ), a ); }
+};
+
+#ifdef USE_AVX2
+struct IntraVecAVX2
+{
+  typedef __m256i T;
+  static const int numSamples = 16;
+
+  static inline T    load   ( const Pel* src )                { return _mm256_loadu_si256( ( const __m256i* ) src ); }
+  static inline void store  ( Pel* dst, const T a )           { _mm256_storeu_si256( ( __m256i* ) dst, a ); }
+  static inline T    set1   ( const int v )                   { return _mm256_set1_epi16( v ); }
+  static inline T    set1_32( const int v )                   { return _mm256_set1_epi32( v ); }
+  static inline T    ramp   ()                                { return _mm256_setr_epi16( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 ); }
+  static inline T    zero   ()                                { return _mm256_setzero_si256(); }
+  static inline T    add    ( const T a, const T b )          { return _mm256_add_epi16( a, b ); }
+  static inline T    sub    ( const T a, const T b )          { return _mm256_sub_epi16( a, b ); }
+  static inline T    srai   ( const T a, const int n )        { return _mm256_srai_epi16( a, n ); }
+  static inline T    min    ( const T a, const T b )          { return _mm256_min_epi16( a, b ); }
+  static inline T    max    ( const T a, const T b )          { return _mm256_max_epi16( a, b ); }
+  static inline T    unpacklo( const T a, const T b )         { return _mm256_unpacklo_epi16( a, b ); }
+  static inline T    unpackhi( const T a, const T b )         { return _mm256_unpackhi_epi16( a, b ); }
+  static inline T    madd   ( const T a, const T b )          { return _mm256_madd_epi16( a, b ); }
+  static inline T    add32  ( const T a, const T b )          { return _mm256_add_epi32( a, b ); }
+  static inline T    sub32  ( const T a, const T b )          { return _mm256_sub_epi32( a, b ); }
+  static inline T    mullo32( const T a, const T b )          { return _mm256_mullo_epi32( a, b ); }
+  static inline T    sll32  ( const T a, const int n )        { return _mm256_sll_epi32( a, _mm_cvtsi32_si128( n ) ); }
+  static inline T    sra32  ( const T a, const int n )        { return _mm256_sra_epi32( a, _mm_cvtsi32_si128( n ) ); }
+  static inline T    packs32( const T a, const T b )          { return _mm256_packs_epi32( a, b ); }
+  static inline T    packs32Seq( const T a, const T b )       { return _mm256_permute4x64_epi64( _mm256_packs_epi32( a, b ), 0xd8 ); }
+};
+#endif
+
+// pair of 16-bit coefficients ( c0, c1 ) for madd with samples interleaved as ( a0, a1 )
+static inline int coeffPair( const int c0, const int c1 )
+{
+  return ( c1 << 16 ) | ( c0 & 0xffff );
+}
+
+template<typename V>
+static inline int predAng4TapLine( Pel* dst, const Pel* ref, const int startX, const int width, const TFilterCoeff* f, const bool useClip, const ClpRng& clpRng )
+{
+  typedef typename V::T T;
+
+  const T c01  = V::set1_32( coeffPair( f[0], f[1] ) );
+  const T c23  = V::set1_32( coeffPair( f[2], f[3] ) );
+  const T vrnd = V::set1_32( 32 );
+
+  int x = startX;
+  for( ; x + V::numSamples <= width; x += V::numSamples )
+  {
+    const T a0 = V::load( ref + x - 1 );
+    const T a1 = V::load( ref + x     );
+    const T a2 = V::load( ref + x + 1 );
+    const T a3 = V::load( ref + x + 2 );
+
+    const T lo = V::add32( V::madd( V::unpacklo( a0, a1 ), c01 ), V::madd( V::unpacklo( a2, a3 ), c23 ) );
+    const T hi = V::add32( V::madd( V::unpackhi( a0, a1 ), c01 ), V::madd( V::unpackhi( a2, a3 ), c23 ) );
+
+    T res = V::packs32( V::sra32( V::add32( lo, vrnd ), 6 ), V::sra32( V::add32( hi, vrnd ), 6 ) );
+    if( useClip )
+    {
+      res = V::min( V::max( res, V::set1( clpRng.min ) ), V::set1( clpRng.max ) );
+    }
+    V::store( dst + x, res );
+  }
+  return x;
+}
+
+template<X86_VEXT vext>
+void predIntraAng4Tap_SIMD( Pel* pDst, const int dstStride, const Pel* refMain, const int width, const int height, const int deltaPos, const int intraPredAngle, const TFilterCoeff* filter, const bool useClip, const ClpRng& clpRng )
+{
+  if( width & 3 )
+  {
+    IntraPrediction::predIntraAng4TapCore( pDst, dstStride, refMain, width, height, deltaPos, intraPredAngle, filter, useClip, clpRng );
+    return;
+  }
+
+  for( int y = 0, pos = deltaPos; y < height; y++, pos += intraPredAngle, pDst += dstStride )
+  {
+    const Pel*          ref = refMain + ( pos >> 5 ) + 1;
+    const TFilterCoeff* f   = filter + ( ( pos & 31 ) << 2 );
+
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      x = predAng4TapLine<IntraVecAVX2>( pDst, ref, x, width, f, useClip, clpRng );
+    }
+#endif
+    x = predAng4TapLine<IntraVecSSE >( pDst, ref, x, width, f, useClip, clpRng );
+    x = predAng4TapLine<IntraVecSSE4>( pDst, ref, x, width, f, useClip, clpRng );
+  }
+}
+
+template<typename V>
+static inline int predAng2TapLine( Pel* dst, const Pel* ref, const int startX, const int width, const int deltaFract )
+{
+  typedef typename V::T T;
+
+  const T c01  = V::set1_32( coeffPair( 32 - deltaFract, deltaFract ) );
+  const T vrnd = V::set1_32( 16 );
+
+  int x = startX;
+  for( ; x + V::numSamples <= width; x += V::numSamples )
+  {
+    const T a0 = V::load( ref + x     );
+    const T a1 = V::load( ref + x + 1 );
+
+    const T lo = V::madd( V::unpacklo( a0, a1 ), c01 );
+    const T hi = V::madd( V::unpackhi( a0, a1 ), c01 );
+
+    V::store( dst + x, V::packs32( V::sra32( V::add32( lo, vrnd ), 5 ), V::sra32( V::add32( hi, vrnd ), 5 ) ) );
+  }
+  return x;
+}
+
+template<X86_VEXT vext>
+void predIntraAng2Tap_SIMD( Pel* pDst, const int dstStride, const Pel* refMain, const int width, const int height, const int deltaPos, const int intraPredAngle )
+{
+  if( width & 3 )
+  {
+    IntraPrediction::predIntraAng2TapCore( pDst, dstStride, refMain, width, height, deltaPos, intraPredAngle );
+    return;
+  }
+
+  for( int y = 0, pos = deltaPos; y < height; y++, pos += intraPredAngle, pDst += dstStride )
+  {
+    const Pel* ref        = refMain + ( pos >> 5 ) + 1;
+    const int  deltaFract = pos & 31;
+
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      x = predAng2TapLine<IntraVecAVX2>( pDst, ref, x, width, deltaFract );
+    }
+#endif
+    x = predAng2TapLine<IntraVecSSE >( pDst, ref, x, width, deltaFract );
+    x = predAng2TapLine<IntraVecSSE4>( pDst, ref, x, width, deltaFract );
+  }
+}
+
+// planar prediction of the columns from startX on, the vertical interpolation is accumulated over the rows
+template<typename V>
+static inline int predPlanarCols( const Pel* top, Pel* dst, const int dstStride, const int startX, const int width, const int height,
+                                  const int* leftColumn, const int* rightColumn, const int bottomLeft, const int log2W, const int log2H )
+{
+  typedef typename V::T T;
+
+  const int finalShift = 1 + log2W + log2H;
+  const T   voffset    = V::set1_32( 1 << ( log2W + log2H ) );
+  const T   vbottom    = V::set1_32( bottomLeft );
+  const T   vzero      = V::zero();
+
+  int x = startX;
+  for( ; x + V::numSamples <= width; x += V::numSamples )
+  {
+    const T t      = V::load( top + x );
+    const T tLo    = V::unpacklo( t, vzero );
+    const T tHi    = V::unpackhi( t, vzero );
+    const T xIdx   = V::add( V::ramp(), V::set1( x + 1 ) );
+    const T xLo    = V::unpacklo( xIdx, vzero );
+    const T xHi    = V::unpackhi( xIdx, vzero );
+    const T diffLo = V::sub32( vbottom, tLo );
+    const T diffHi = V::sub32( vbottom, tHi );
+
+    T vertLo = V::sll32( tLo, log2H );
+    T vertHi = V::sll32( tHi, log2H );
+
+    Pel* pred = dst + x;
+    for( int y = 0; y < height; y++, pred += dstStride )
+    {
+      vertLo = V::add32( vertLo, diffLo );
+      vertHi = V::add32( vertHi, diffHi );
+
+      const T left  = V::set1_32( leftColumn [y] );
+      const T right = V::set1_32( rightColumn[y] );
+      const T horLo = V::add32( left, V::mullo32( xLo, right ) );
+      const T horHi = V::add32( left, V::mullo32( xHi, right ) );
+
+      const T resLo = V::sra32( V::add32( V::add32( V::sll32( horLo, log2H ), V::sll32( vertLo, log2W ) ), voffset ), finalShift );
+      const T resHi = V::sra32( V::add32( V::add32( V::sll32( horHi, log2H ), V::sll32( vertHi, log2W ) ), voffset ), finalShift );
+      V::store( pred, V::packs32( resLo, resHi ) );
+    }
+  }
+  return x;
+}
+
+template<X86_VEXT vext>
+void predIntraPlanar_SIMD( const CPelBuf &pSrc, PelBuf &pDst )
+{
+  const int width  = pDst.width;
+  const int height = pDst.height;
+
+  if( width & 3 )
+  {
+    IntraPrediction::predIntraPlanarCore( pSrc, pDst );
+    return;
+  }
+
+  const int log2W = g_aucLog2[width];
+  const int log2H = g_aucLog2[height < 2 ? 2 : height];
+
+  int leftColumn[MAX_CU_SIZE], rightColumn[MAX_CU_SIZE];
+
+  const Pel* top        = pSrc.buf + 1;
+  const int  topRight   = top[width];
+  const int  bottomLeft = pSrc.at( 0, height + 1 );
+
+  for( int k = 0; k < height; k++ )
+  {
+    const int left = pSrc.at( 0, k + 1 );
+    rightColumn[k] = topRight - left;
+    leftColumn [k] = left << log2W;
+  }
+
+  int x = 0;
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    x = predPlanarCols<IntraVecAVX2>( top, pDst.buf, pDst.stride, x, width, height, leftColumn, rightColumn, bottomLeft, log2W, log2H );
+  }
+#endif
+  x = predPlanarCols<IntraVecSSE >( top, pDst.buf, pDst.stride, x, width, height, leftColumn, rightColumn, bottomLeft, log2W, log2H );
+  x = predPlanarCols<IntraVecSSE4>( top, pDst.buf, pDst.stride, x, width, height, leftColumn, rightColumn, bottomLeft, log2W, log2H );
+}
+
+template<typename V>
+static inline int pdpcPlanarDcLine( Pel* dst, const Pel* top, const Pel* weightL, const int startX, const int endX,
+                                    const int left, const int wT, const int topLeft, const bool isDc, const ClpRng& clpRng )
+{
+  typedef typename V::T T;
+
+  const T vleft    = V::set1( left );
+  const T vtopLeft = V::set1( topLeft );
+  const T vwT      = V::set1( wT );
+  const T vwTL     = V::set1( isDc ? wT >> 4 : 0 );
+  const T v64      = V::set1( 64 - wT );
+  const T vrnd     = V::set1_32( 32 );
+  const T vmin     = V::set1( clpRng.min );
+  const T vmax     = V::set1( clpRng.max );
+
+  int x = startX;
+  for( ; x < endX; x += V::numSamples )
+  {
+    const T d   = V::load( dst + x );
+    const T t   = V::load( top + x );
+    const T wL  = V::load( weightL + x );
+    const T wTL = isDc ? V::add( V::srai( wL, 4 ), vwTL ) : V::zero();
+    const T wD  = V::add( V::sub( v64, wL ), wTL );
+
+    // wL * left + wT * top and wD * dst - wTL * topLeft
+    const T lt  = V::unpacklo( vleft, t ), ltH = V::unpackhi( vleft, t );
+    const T wLT = V::unpacklo( wL, vwT ),  wLTH = V::unpackhi( wL, vwT );
+    const T dtl = V::unpacklo( d, vtopLeft ), dtlH = V::unpackhi( d, vtopLeft );
+    const T wDT = V::unpacklo( wD, V::sub( V::zero(), wTL ) ), wDTH = V::unpackhi( wD, V::sub( V::zero(), wTL ) );
+
+    const T lo = V::add32( V::add32( V::madd( lt,  wLT  ), V::madd( dtl,  wDT  ) ), vrnd );
+    const T hi = V::add32( V::add32( V::madd( ltH, wLTH ), V::madd( dtlH, wDTH ) ), vrnd );
+
+    V::store( dst + x, V::min( V::max( V::packs32( V::sra32( lo, 6 ), V::sra32( hi, 6 ) ), vmin ), vmax ) );
+  }
+  return x;
+}
+
+template<X86_VEXT vext>
+void pdpcPlanarDc_SIMD( const CPelBuf &pSrc, PelBuf &pDst, const bool isDc, const ClpRng& clpRng )
+{
+  const int width  = pDst.width;
+  const int height = pDst.height;
+
+  if( width & 3 )
+  {
+    IntraPrediction::pdpcPlanarDcCore( pSrc, pDst, isDc, clpRng );
+    return;
+  }
+
+  const int scale   = ( ( g_aucLog2[width] - 2 + g_aucLog2[height] - 2 + 2 ) >> 2 );
+  // column and row from which the weights vanish, rounded up to the vector size
+  const int endX    = std::min( width,  ( ( 3 << scale ) + 3 ) & ~3 );
+  const int endY    = std::min( height, 3 << scale );
+  const Pel topLeft = isDc ? pSrc.at( 0, 0 ) : 0;
+  const Pel* top    = pSrc.buf + 1;
+
+  Pel weightL[MAX_CU_SIZE];
+  for( int x = 0; x < width; x++ )
+  {
+    weightL[x] = 32 >> std::min( 31, ( ( x << 1 ) >> scale ) );
+  }
+
+  for( int y = 0; y < height; y++ )
+  {
+    const int wT    = y < endY ? 32 >> ( ( y << 1 ) >> scale ) : 0;
+    const int left  = pSrc.at( 0, y + 1 );
+    const int lineX = wT ? width : endX;
+    Pel*      dst   = pDst.bufAt( 0, y );
+
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      x = pdpcPlanarDcLine<IntraVecAVX2>( dst, top, weightL, x, lineX & ~15, left, wT, topLeft, isDc, clpRng );
+    }
+#endif
+    x = pdpcPlanarDcLine<IntraVecSSE >( dst, top, weightL, x, lineX & ~7, left, wT, topLeft, isDc, clpRng );
+    x = pdpcPlanarDcLine<IntraVecSSE4>( dst, top, weightL, x, lineX,      left, wT, topLeft, isDc, clpRng );
+  }
+}
+
+// CCLM luma downsampling of numSamples chroma samples per iteration from two consecutive luma loads, the horizontal
+// pairs ( 2i, 2i + 1 ) are reduced by madd, the pairs ( 2i - 1, 2i ) come from the loads shifted by one sample
+template<typename V, LumaDownsampleFilter filter>
+static inline int downsampleLumaLine( const Pel* src, const int srcStride, Pel* dst, const int startX, const int width )
+{
+  typedef typename V::T T;
+
+  const int N     = V::numSamples;
+  const T   c10   = V::set1_32( coeffPair( 1, 0 ) );
+  const T   c11   = V::set1_32( coeffPair( 1, 1 ) );
+  const T   c41   = V::set1_32( coeffPair( 4, 1 ) );
+  const int shift = filter == LUMA_DS_2TO1 ? 0 : filter == LUMA_DS_3TAP ? 2 : 3;
+  const T   vrnd  = V::set1_32( ( 1 << shift ) >> 1 );
+
+  int x = startX;
+  for( ; x + N <= width; x += N )
+  {
+    const Pel* s = src + 2 * x;
+    T lo, hi;
+
+    if( filter == LUMA_DS_2TO1 )
+    {
+      lo = V::madd( V::load( s     ), c10 );
+      hi = V::madd( V::load( s + N ), c10 );
+    }
+    else if( filter == LUMA_DS_3TAP )
+    {
+      lo = V::madd( V::add( V::load( s     ), V::load( s - 1     ) ), c11 );
+      hi = V::madd( V::add( V::load( s + N ), V::load( s - 1 + N ) ), c11 );
+    }
+    else if( filter == LUMA_DS_5TAP )
+    {
+      const T vl = V::add( V::load( s - 1     ), V::add( V::load( s - srcStride     ), V::load( s + srcStride     ) ) );
+      const T vh = V::add( V::load( s - 1 + N ), V::add( V::load( s - srcStride + N ), V::load( s + srcStride + N ) ) );
+
+      lo = V::add32( V::madd( V::load( s     ), c41 ), V::madd( vl, c10 ) );
+      hi = V::add32( V::madd( V::load( s + N ), c41 ), V::madd( vh, c10 ) );
+    }
+    else
+    {
+      const T vl = V::add( V::add( V::load( s             ), V::load( s - 1             ) ),
+                           V::add( V::load( s + srcStride ), V::load( s - 1 + srcStride ) ) );
+      const T vh = V::add( V::add( V::load( s + N             ), V::load( s - 1 + N             ) ),
+                           V::add( V::load( s + N + srcStride ), V::load( s - 1 + N + srcStride ) ) );
+
+      lo = V::madd( vl, c11 );
+      hi = V::madd( vh, c11 );
+    }
+
+    V::store( dst + x, V::packs32Seq( V::sra32( V::add32( lo, vrnd ), shift ), V::sra32( V::add32( hi, vrnd ), shift ) ) );
+  }
+  return x;
+}
+
+template<X86_VEXT vext, LumaDownsampleFilter filter>
+static void downsampleLumaBlk( const Pel* pSrc, const int srcStride, Pel* pDst, const int dstStride, const int width, const int height )
+{
+  const int srcStride2 = ( filter == LUMA_DS_5TAP || filter == LUMA_DS_6TAP ) ? srcStride << 1 : srcStride;
+
+  for( int y = 0; y < height; y++, pSrc += srcStride2, pDst += dstStride )
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      x = downsampleLumaLine<IntraVecAVX2, filter>( pSrc, srcStride, pDst, x, width );
+    }
+#endif
+    x = downsampleLumaLine<IntraVecSSE,  filter>( pSrc, srcStride, pDst, x, width );
+    x = downsampleLumaLine<IntraVecSSE4, filter>( pSrc, srcStride, pDst, x, width );
+
+    if( x < width )
+    {
+      IntraPrediction::downsampleLumaCore( pSrc + 2 * x, srcStride, pDst + x, dstStride, width - x, 1, filter );
+    }
+  }
+}
+
+template<X86_VEXT vext>
+void downsampleLuma_SIMD( const Pel* pSrc, const int srcStride, Pel* pDst, const int dstStride, const int width, const int height, const LumaDownsampleFilter filter )
+{
+  switch( filter )
+  {
+  case LUMA_DS_2TO1: downsampleLumaBlk<vext, LUMA_DS_2TO1>( pSrc, srcStride, pDst, dstStride, width, height ); break;
+  case LUMA_DS_3TAP: downsampleLumaBlk<vext, LUMA_DS_3TAP>( pSrc, srcStride, pDst, dstStride, width, height ); break;
+  case LUMA_DS_5TAP: downsampleLumaBlk<vext, LUMA_DS_5TAP>( pSrc, srcStride, pDst, dstStride, width, height ); break;
+  case LUMA_DS_6TAP: downsampleLumaBlk<vext, LUMA_DS_6TAP>( pSrc, srcStride, pDst, dstStride, width, height ); break;
+  default:           IntraPrediction::downsampleLumaCore( pSrc, srcStride, pDst, dstStride, width, height, filter ); break;
+  }
+}
+
+template <X86_VEXT vext>
+void IntraPrediction::_initIntraPredictionX86()
+{
+  m_predIntraPlanar  = predIntraPlanar_SIMD<vext>;
+  m_predIntraAng4Tap = predIntraAng4Tap_SIMD<vext>;
+  m_predIntraAng2Tap = predIntraAng2Tap_SIMD<vext>;
+  m_pdpcPlanarDc     = pdpcPlanarDc_SIMD<vext>;
+  m_downsampleLuma   = downsampleLuma_SIMD<vext>;
+}
+
+template void IntraPrediction::_initIntraPredictionX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+#endif
+//! \}
@@ -0,0 +1,490 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     LoopFilterX86.h
+    \brief    SIMD deblocking filter, filters 4 (SSE) or 8 (AVX2) lines of an edge at once.
+*/
+
+//! \ingroup CommonLib
+//! \{
+
+
+#include "CommonLib/CommonDef.h"
+#include "CommonDefX86.h"
+#include "CommonLib/LoopFilter.h"
+
+
+#if ENABLE_SIMD_OPT_DBLF
+#ifdef TARGET_SIMD_X86
+
+// The samples across the edge are kept in a sample array s[16] of int32 vectors with one line per lane,
+// s[7 - k] holding p_k and s[8 + k] holding q_k. Horizontal edges load the sample rows directly,
+// vertical edges load the lines and transpose them with an 8x8 16-bit transposition in both directions.
+
+struct DblfVecSSE
+{
+  typedef __m128i T;
+  static const int numLanes = 4;
+
+  static inline T set1  ( const int v )            { return _mm_set1_epi32( v ); }
+  static inline T add   ( const T a, const T b )   { return _mm_add_epi32( a, b ); }
+  static inline T sub   ( const T a, const T b )   { return _mm_sub_epi32( a, b ); }
+  static inline T sll   ( const T a, const int n ) { return _mm_slli_epi32( a, n ); }
+  static inline T sra   ( const T a, const int n ) { return _mm_srai_epi32( a, n ); }
+  static inline T mul   ( const T a, const int c ) { return _mm_mullo_epi32( a, _mm_set1_epi32( c ) ); }
+  static inline T abs   ( const T a )              { return _mm_abs_epi32( a ); }
+  static inline T lt    ( const T a, const T b )   { return _mm_cmplt_epi32( a, b ); }
+  static inline T clip  ( const T lo, const T hi, const T a ) { return _mm_min_epi32( _mm_max_epi32( a, lo ), hi ); }
+  static inline T blend ( const T a, const T b, const T mask ) { return _mm_blendv_epi8( a, b, mask ); }
+
+  static inline T       unpack( const __m128i a )       { return _mm_cvtepi16_epi32( a ); }
+  static inline __m128i pack  ( const T a )             { return _mm_packs_epi32( a, a ); }
+  static inline T       loadRow ( const Pel* src )      { return unpack( _mm_loadl_epi64( ( const __m128i* ) src ) ); }
+  static inline void    storeRow( Pel* dst, const T a ) { _mm_storel_epi64( ( __m128i* ) dst, pack( a ) ); }
+};
+
+#ifdef USE_AVX2
+struct DblfVecAVX2
+{
+  typedef __m256i T;
+  static const int numLanes = 8;
+
+  static inline T set1  ( const int v )            { return _mm256_set1_epi32( v ); }
+  static inline T add   ( const T a, const T b )   { return _mm256_add_epi32( a, b ); }
+  static inline T sub   ( const T a, const T b )   { return _mm256_sub_epi32( a, b ); }
+  static inline T sll   ( const T a, const int n ) { return _mm256_slli_epi32( a, n ); }
+  static inline T sra   ( const T a, const int n ) { return _mm256_srai_epi32( a, n ); }
+  static inline T mul   ( const T a, const int c ) { return _mm256_mullo_epi32( a, _mm256_set1_epi32( c ) ); }
+  static inline T abs   ( const T a )              { return _mm256_abs_epi32( a ); }
+  static inline T lt    ( const T a, const T b )   { return _mm256_cmpgt_epi32( b, a ); }
+  static inline T clip  ( const T lo, const T hi, const T a ) { return _mm256_min_epi32( _mm256_max_epi32( a, lo ), hi ); }
+  static inline T blend ( const T a, const T b, const T mask ) { return _mm256_blendv_epi8( a, b, mask ); }
+
+  static inline T       unpack( const __m128i a )       { return _mm256_cvtepi16_epi32( a ); }
+  static inline __m128i pack  ( const T a )             { return _mm_packs_epi32( _mm256_castsi256_si128( a ), _mm256_extracti128_si256( a, 1 ) ); }
+  static inline T       loadRow ( const Pel* src )      { return unpack( _mm_loadu_si128( ( const __m128i* ) src ) ); }
+  static inline void    storeRow( Pel* dst, const T a ) { _mm_storeu_si128( ( __m128i* ) dst, pack( a ) ); }
+};
+#endif
+
+static inline void transpose8x8_epi16( __m128i* r )
+{
+  const __m128i a0 = _mm_unpacklo_epi16( r[0], r[1] );
+  const __m128i a1 = _mm_unpackhi_epi16( r[0], r[1] );
+  const __m128i a2 = _mm_unpacklo_epi16( r[2], r[3] );
+  const __m128i a3 = _mm_unpackhi_epi16( r[2], r[3] );
+  const __m128i a4 = _mm_unpacklo_epi16( r[4], r[5] );
+  const __m128i a5 = _mm_unpackhi_epi16( r[4], r[5] );
+  const __m128i a6 = _mm_unpacklo_epi16( r[6], r[7] );
+  const __m128i a7 = _mm_unpackhi_epi16( r[6], r[7] );
+
+  const __m128i b0 = _mm_unpacklo_epi32( a0, a2 );
+  const __m128i b1 = _mm_unpackhi_epi32( a0, a2 );
+  const __m128i b2 = _mm_unpacklo_epi32( a1, a3 );
+  const __m128i b3 = _mm_unpackhi_epi32( a1, a3 );
+  const __m128i b4 = _mm_unpacklo_epi32( a4, a6 );
+  const __m128i b5 = _mm_unpackhi_epi32( a4, a6 );
+  const __m128i b6 = _mm_unpacklo_epi32( a5, a7 );
+  const __m128i b7 = _mm_unpackhi_epi32( a5, a7 );
+
+  r[0] = _mm_unpacklo_epi64( b0, b4 );
+  r[1] = _mm_unpackhi_epi64( b0, b4 );
+  r[2] = _mm_unpacklo_epi64( b1, b5 );
+  r[3] = _mm_unpackhi_epi64( b1, b5 );
+  r[4] = _mm_unpacklo_epi64( b2, b6 );
+  r[5] = _mm_unpackhi_epi64( b2, b6 );
+  r[6] = _mm_unpacklo_epi64( b3, b7 );
+  r[7] = _mm_unpackhi_epi64( b3, b7 );
+}
+
+// loads the sample positions [first, last) of V::numLanes lines, src points to the first sample after the edge of the first line
+template<typename V>
+static inline void loadSamples( const Pel* src, const int offset, const int step, const int first, const int last, typename V::T* s )
+{
+  if( step == 1 )
+  {
+    for( int i = first; i < last; i++ )
+    {
+      s[i] = V::loadRow( src + ( i - 8 ) * offset );
+    }
+    return;
+  }
+
+  for( int b = first; b < last; b += 8 )
+  {
+    __m128i r[8];
+    for( int i = 0; i < 8; i++ )
+    {
+      r[i] = i < V::numLanes ? _mm_loadu_si128( ( const __m128i* ) ( src + i * step + b - 8 ) ) : _mm_setzero_si128();
+    }
+    transpose8x8_epi16( r );
+    for( int k = 0; k < 8; k++ )
+    {
+      s[b + k] = V::unpack( r[k] );
+    }
+  }
+}
+
+// stores the sample positions [first, last), vertical edges write back the complete loaded range [loadFirst, loadLast)
+template<typename V>
+static inline void storeSamples( Pel* src, const int offset, const int step, const int first, const int last, const int loadFirst, const int loadLast, const typename V::T* s )
+{
+  if( step == 1 )
+  {
+    for( int i = first; i < last; i++ )
+    {
+      V::storeRow( src + ( i - 8 ) * offset, s[i] );
+    }
+    return;
+  }
+
+  for( int b = loadFirst; b < loadLast; b += 8 )
+  {
+    __m128i r[8];
+    for( int k = 0; k < 8; k++ )
+    {
+      r[k] = V::pack( s[b + k] );
+    }
+    transpose8x8_epi16( r );
+    for( int i = 0; i < V::numLanes; i++ )
+    {
+      _mm_storeu_si128( ( __m128i* ) ( src + i * step + b - 8 ), r[i] );
+    }
+  }
+}
+
+template<typename V>
+static inline typename V::T clipAround( const typename V::T a, const int c, const typename V::T val )
+{
+  const typename V::T vc = V::set1( c );
+  return V::clip( V::sub( a, vc ), V::add( a, vc ), val );
+}
+
+template<typename V>
+static inline void weakFilterLuma( typename V::T* s, const DeblockParam& param, const ClpRng& clpRng )
+{
+  typedef typename V::T T;
+
+  const T p0 = s[7], p1 = s[6], p2 = s[5];
+  const T q0 = s[8], q1 = s[9], q2 = s[10];
+
+  const T vtc  = V::set1( param.tc );
+  const T vtc2 = V::set1( param.tc >> 1 );
+  const T vmin = V::set1( clpRng.min );
+  const T vmax = V::set1( clpRng.max );
+
+  const T dq0p0 = V::sub( q0, p0 );
+  const T dq1p1 = V::sub( q1, p1 );
+  T delta       = V::sra( V::add( V::sub( V::add( V::sll( dq0p0, 3 ), dq0p0 ), V::add( V::sll( dq1p1, 1 ), dq1p1 ) ), V::set1( 8 ) ), 4 );
+  const T mask  = V::lt( V::abs( delta ), V::set1( param.thrCut ) );
+  delta         = V::clip( V::sub( V::set1( 0 ), vtc ), vtc, delta );
+
+  if( !param.partPNoFilter )
+  {
+    s[7] = V::blend( p0, V::clip( vmin, vmax, V::add( p0, delta ) ), mask );
+    if( param.filterSecondP )
+    {
+      const T delta1 = V::clip( V::sub( V::set1( 0 ), vtc2 ), vtc2, V::sra( V::add( V::sub( V::sra( V::add( V::add( p2, p0 ), V::set1( 1 ) ), 1 ), p1 ), delta ), 1 ) );
+      s[6] = V::blend( p1, V::clip( vmin, vmax, V::add( p1, delta1 ) ), mask );
+    }
+  }
+  if( !param.partQNoFilter )
+  {
+    s[8] = V::blend( q0, V::clip( vmin, vmax, V::sub( q0, delta ) ), mask );
+    if( param.filterSecondQ )
+    {
+      const T delta2 = V::clip( V::sub( V::set1( 0 ), vtc2 ), vtc2, V::sra( V::sub( V::sub( V::sra( V::add( V::add( q2, q0 ), V::set1( 1 ) ), 1 ), q1 ), delta ), 1 ) );
+      s[9] = V::blend( q1, V::clip( vmin, vmax, V::add( q1, delta2 ) ), mask );
+    }
+  }
+}
+
+template<typename V>
+static inline void strongFilterLuma( typename V::T* s, const DeblockParam& param )
+{
+  typedef typename V::T T;
+
+  const T p0 = s[7], p1 = s[6], p2 = s[5], p3 = s[4];
+  const T q0 = s[8], q1 = s[9], q2 = s[10], q3 = s[11];
+  const int tc = param.tc;
+
+  const T p0q0 = V::add( p0, q0 );
+  const T rnd2 = V::set1( 2 );
+  const T rnd4 = V::set1( 4 );
+
+  if( !param.partPNoFilter )
+  {
+    // (p2 + 2*p1 + 2*p0 + 2*q0 + q1 + 4) >> 3, (p2 + p1 + p0 + q0 + 2) >> 2, (2*p3 + 3*p2 + p1 + p0 + q0 + 4) >> 3
+    const T sum = V::add( V::add( p2, p1 ), p0q0 );
+    s[7] = clipAround<V>( p0, 3 * tc, V::sra( V::add( V::add( sum, V::add( p1, p0q0 ) ), V::add( q1, rnd4 ) ), 3 ) );
+    s[6] = clipAround<V>( p1, 2 * tc, V::sra( V::add( sum, rnd2 ), 2 ) );
+    s[5] = clipAround<V>( p2,     tc, V::sra( V::add( V::add( sum, V::sll( V::add( p3, p2 ), 1 ) ), rnd4 ), 3 ) );
+  }
+  if( !param.partQNoFilter )
+  {
+    // (p1 + 2*p0 + 2*q0 + 2*q1 + q2 + 4) >> 3, (p0 + q0 + q1 + q2 + 2) >> 2, (p0 + q0 + q1 + 3*q2 + 2*q3 + 4) >> 3
+    const T sum = V::add( V::add( q2, q1 ), p0q0 );
+    s[8]  = clipAround<V>( q0, 3 * tc, V::sra( V::add( V::add( sum, V::add( q1, p0q0 ) ), V::add( p1, rnd4 ) ), 3 ) );
+    s[9]  = clipAround<V>( q1, 2 * tc, V::sra( V::add( sum, rnd2 ), 2 ) );
+    s[10] = clipAround<V>( q2,     tc, V::sra( V::add( V::add( sum, V::sll( V::add( q3, q2 ), 1 ) ), rnd4 ), 3 ) );
+  }
+}
+
+// sum of p_k + q_k for k in [first, last)
+template<typename V>
+static inline typename V::T sumPQ( const typename V::T* s, const int first, const int last )
+{
+  typename V::T sum = V::add( s[7 - first], s[8 + first] );
+  for( int k = first + 1; k < last; k++ )
+  {
+    sum = V::add( sum, V::add( s[7 - k], s[8 + k] ) );
+  }
+  return sum;
+}
+
+template<typename V>
+static inline void longFilterLuma( typename V::T* s, const DeblockParam& param )
+{
+  typedef typename V::T T;
+
+  static const int dbCoeffs7[7] = { 59, 50, 41, 32, 23, 14, 5 };
+  static const int dbCoeffs5[5] = { 58, 45, 32, 19, 6 };
+  static const int dbCoeffs3[3] = { 53, 32, 11 };
+  static const int tc7[7]       = { 6, 5, 4, 3, 2, 1, 1 };
+  static const int tc3[3]       = { 6, 4, 2 };
+
+  const int lenP = param.lengthP;
+  const int lenQ = param.lengthQ;
+
+  // p_k = s[7 - k], q_k = s[8 + k]
+  const T refP = V::sra( V::add( V::add( s[8 - lenP], s[7 - lenP] ), V::set1( 1 ) ), 1 );
+  const T refQ = V::sra( V::add( V::add( s[7 + lenQ], s[8 + lenQ] ), V::set1( 1 ) ), 1 );
+  T refMiddle;
+
+  if( lenP == lenQ && lenP == 5 )
+  {
+    refMiddle = V::sra( V::add( V::add( V::sll( sumPQ<V>( s, 0, 3 ), 1 ), sumPQ<V>( s, 3, 5 ) ), V::set1( 8 ) ), 4 );
+  }
+  else if( lenP == lenQ )
+  {
+    refMiddle = V::sra( V::add( V::add( V::sll( sumPQ<V>( s, 0, 1 ), 1 ), sumPQ<V>( s, 1, 7 ) ), V::set1( 8 ) ), 4 );
+  }
+  else if( lenP + lenQ == 12 )
+  {
+    refMiddle = V::sra( V::add( V::add( V::sll( sumPQ<V>( s, 0, 2 ), 1 ), sumPQ<V>( s, 2, 6 ) ), V::set1( 8 ) ), 4 );
+  }
+  else if( lenP + lenQ == 10 )
+  {
+    // the large side contributes 2*L0 + L1 + ... + L6, the small side 3*S0 + 3*S1 + 2*S2
+    const int dirL = lenP == 7 ? -1 : 1;
+    const T*  L    = s + ( lenP == 7 ? 7 : 8 );
+    const T*  S    = s + ( lenP == 7 ? 8 : 7 );
+    T sumL = V::add( L[0], L[0] );
+    for( int k = 1; k < 7; k++ )
+    {
+      sumL = V::add( sumL, L[k * dirL] );
+    }
+    const T S01  = V::add( S[0], S[-dirL] );
+    const T sumS = V::add( V::add( V::sll( S01, 1 ), S01 ), V::sll( S[-2 * dirL], 1 ) );
+    refMiddle = V::sra( V::add( V::add( sumL, sumS ), V::set1( 8 ) ), 4 );
+  }
+  else
+  {
+    refMiddle = V::sra( V::add( sumPQ<V>( s, 0, 4 ), V::set1( 4 ) ), 3 );
+  }
+
+  const T rnd = V::set1( 32 );
+  if( !param.partPNoFilter )
+  {
+    const int* coeffs = lenP == 7 ? dbCoeffs7 : lenP == 5 ? dbCoeffs5 : dbCoeffs3;
+    const int* tcMult = lenP == 3 ? tc3 : tc7;
+    const T    diff   = V::sub( refMiddle, refP );
+    const T    base   = V::add( V::sll( refP, 6 ), rnd );
+    for( int k = 0; k < lenP; k++ )
+    {
+      s[7 - k] = clipAround<V>( s[7 - k], ( param.tc * tcMult[k] ) >> 1, V::sra( V::add( base, V::mul( diff, coeffs[k] ) ), 6 ) );
+    }
+  }
+  if( !param.partQNoFilter )
+  {
+    const int* coeffs = lenQ == 7 ? dbCoeffs7 : lenQ == 5 ? dbCoeffs5 : dbCoeffs3;
+    const int* tcMult = lenQ == 3 ? tc3 : tc7;
+    const T    diff   = V::sub( refMiddle, refQ );
+    const T    base   = V::add( V::sll( refQ, 6 ), rnd );
+    for( int k = 0; k < lenQ; k++ )
+    {
+      s[8 + k] = clipAround<V>( s[8 + k], ( param.tc * tcMult[k] ) >> 1, V::sra( V::add( base, V::mul( diff, coeffs[k] ) ), 6 ) );
+    }
+  }
+}
+
+template<typename V>
+static inline void filterLumaLanes( Pel* src, const int offset, const int step, const DeblockParam& param, const ClpRng& clpRng )
+{
+  typename V::T s[16];
+
+  // lengthP and lengthQ are only set for the long filter, which reads up to p7 and q7
+  const bool isLong    = param.lengthP > 0;
+  const int  loadFirst = isLong ?  0 :  4;
+  const int  loadLast  = isLong ? 16 : 12;
+
+  loadSamples<V>( src, offset, step, loadFirst, loadLast, s );
+
+  if( isLong )
+  {
+    longFilterLuma<V>( s, param );
+    storeSamples<V>( src, offset, step, 8 - param.lengthP, 8 + param.lengthQ, loadFirst, loadLast, s );
+  }
+  else if( param.strong )
+  {
+    strongFilterLuma<V>( s, param );
+    storeSamples<V>( src, offset, step, 5, 11, loadFirst, loadLast, s );
+  }
+  else
+  {
+    weakFilterLuma<V>( s, param, clpRng );
+    storeSamples<V>( src, offset, step, 6, 10, loadFirst, loadLast, s );
+  }
+}
+
+template<typename V>
+static inline void filterChromaLanes( Pel* src, const int offset, const int step, const DeblockParam& param, const ClpRng& clpRng )
+{
+  typedef typename V::T T;
+  T s[16];
+
+  loadSamples<V>( src, offset, step, 4, 12, s );
+
+  const T p0 = s[7], p1 = s[6], p2 = s[5], p3 = s[4];
+  const T q0 = s[8], q1 = s[9], q2 = s[10], q3 = s[11];
+  const int tc = param.tc;
+  const T rnd4 = V::set1( 4 );
+
+  if( param.strong )
+  {
+    const T p0q0 = V::add( V::add( p0, q0 ), rnd4 );
+    if( !param.partPNoFilter )
+    {
+      // (3*p3 + 2*p2 + p1 + p0 + q0 + 4) >> 3, (2*p3 + p2 + 2*p1 + p0 + q0 + q1 + 4) >> 3, (p3 + p2 + p1 + 2*p0 + q0 + q1 + q2 + 4) >> 3
+      const T p3p2 = V::add( p3, p2 );
+      const T sum  = V::add( V::add( p3p2, p1 ), p0q0 );
+      s[5] = clipAround<V>( p2, tc, V::sra( V::add( V::add( sum, p3p2 ), p3 ), 3 ) );
+      s[6] = clipAround<V>( p1, tc, V::sra( V::add( V::add( sum, q1 ), V::add( p3, p1 ) ), 3 ) );
+      s[7] = clipAround<V>( p0, tc, V::sra( V::add( V::add( sum, p0 ), V::add( q1, q2 ) ), 3 ) );
+    }
+    if( !param.partQNoFilter )
+    {
+      const T q3q2 = V::add( q3, q2 );
+      const T sum  = V::add( V::add( q3q2, q1 ), p0q0 );
+      s[10] = clipAround<V>( q2, tc, V::sra( V::add( V::add( sum, q3q2 ), q3 ), 3 ) );
+      s[9]  = clipAround<V>( q1, tc, V::sra( V::add( V::add( sum, p1 ), V::add( q3, q1 ) ), 3 ) );
+      s[8]  = clipAround<V>( q0, tc, V::sra( V::add( V::add( sum, q0 ), V::add( p1, p2 ) ), 3 ) );
+    }
+    storeSamples<V>( src, offset, step, 5, 11, 4, 12, s );
+  }
+  else
+  {
+    const T vtc   = V::set1( tc );
+    const T vmin  = V::set1( clpRng.min );
+    const T vmax  = V::set1( clpRng.max );
+    const T delta = V::clip( V::sub( V::set1( 0 ), vtc ), vtc, V::sra( V::add( V::add( V::sll( V::sub( q0, p0 ), 2 ), V::sub( p1, q1 ) ), rnd4 ), 3 ) );
+    if( !param.partPNoFilter )
+    {
+      s[7] = V::clip( vmin, vmax, V::add( p0, delta ) );
+    }
+    if( !param.partQNoFilter )
+    {
+      s[8] = V::clip( vmin, vmax, V::sub( q0, delta ) );
+    }
+    storeSamples<V>( src, offset, step, 7, 9, 4, 12, s );
+  }
+}
+
+template<X86_VEXT vext>
+static void filterLumaLines_SIMD( Pel* src, const int offset, const int step, const int numLines, const DeblockParam& param, const ClpRng& clpRng )
+{
+  int line = 0;
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    for( ; line + DblfVecAVX2::numLanes <= numLines; line += DblfVecAVX2::numLanes )
+    {
+      filterLumaLanes<DblfVecAVX2>( src + line * step, offset, step, param, clpRng );
+    }
+  }
+#endif
+  for( ; line + DblfVecSSE::numLanes <= numLines; line += DblfVecSSE::numLanes )
+  {
+    filterLumaLanes<DblfVecSSE>( src + line * step, offset, step, param, clpRng );
+  }
+  if( line < numLines )
+  {
+    LoopFilter::filterLumaLinesCore( src + line * step, offset, step, numLines - line, param, clpRng );
+  }
+}
+
+template<X86_VEXT vext>
+static void filterChromaLines_SIMD( Pel* src, const int offset, const int step, const int numLines, const DeblockParam& param, const ClpRng& clpRng )
+{
+  int line = 0;
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    for( ; line + DblfVecAVX2::numLanes <= numLines; line += DblfVecAVX2::numLanes )
+    {
+      filterChromaLanes<DblfVecAVX2>( src + line * step, offset, step, param, clpRng );
+    }
+  }
+#endif
+  for( ; line + DblfVecSSE::numLanes <= numLines; line += DblfVecSSE::numLanes )
+  {
+    filterChromaLanes<DblfVecSSE>( src + line * step, offset, step, param, clpRng );
+  }
+  if( line < numLines )
+  {
+    LoopFilter::filterChromaLinesCore( src + line * step, offset, step, numLines - line, param, clpRng );
+  }
+}
+
+template <X86_VEXT vext>
+void LoopFilter::_initLoopFilterX86()
+{
+  m_filterLumaLines   = filterLumaLines_SIMD<vext>;
+  m_filterChromaLines = filterChromaLines_SIMD<vext>;
+}
+
+template void LoopFilter::_initLoopFilterX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+#endif
+//! \}
@@ -0,0 +1,308 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     MatrixIntraPredictionX86.h
+    \brief    SIMD matrix-vector product and upsampling for the matrix-based intra prediction.
+*/
+
+//! \ingroup CommonLib
+//! \{
+
+
+#include "CommonLib/CommonDef.h"
+#include "CommonDefX86.h"
+#include "CommonLib/MatrixIntraPrediction.h"
+
+
+#if ENABLE_SIMD_OPT_MIP && JVET_N0217_MATRIX_INTRAPRED
+#ifdef TARGET_SIMD_X86
+
+namespace Mip
+{
+// the reduced boundary holds 4 or 8 samples and the reduced prediction at most 8 samples per line, so the kernels
+// work on 128-bit vectors for all extensions
+
+template<X86_VEXT vext>
+void computeMatrixTimesRedBndry_SIMD( int* const result, const int* const input, const int inputSize,
+                                      const short* matrix, const short* bias, const int width, const int height,
+                                      const int xStep, const int yStep, const int shiftMatrix, const int shiftBias )
+{
+  CHECKD( inputSize != 4 && inputSize != 8, "Error, unsupported input size" );
+  CHECKD( width & 3, "Error, output width not divisible by four" );
+
+  // input as 16-bit samples, the four samples of the small input are repeated for two matrix rows per vector
+  const __m128i vin = inputSize == 8 ? _mm_packs_epi32( _mm_loadu_si128( ( const __m128i* ) input ), _mm_loadu_si128( ( const __m128i* ) ( input + 4 ) ) )
+                                     : _mm_packs_epi32( _mm_loadu_si128( ( const __m128i* ) input ), _mm_loadu_si128( ( const __m128i* ) input ) );
+  const __m128i voffset = _mm_set1_epi32( 1 << ( shiftMatrix - 1 ) );
+  const int     rowStep = xStep * inputSize;
+
+  const short* weight  = matrix;
+  int*         res     = result;
+  int          posBias = 0;
+
+  for( int y = 0; y < height; y++ )
+  {
+    for( int x = 0; x < width; x += 4, res += 4 )
+    {
+      __m128i sum;
+      if( inputSize == 8 )
+      {
+        const __m128i m0 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* )   weight                ), vin );
+        const __m128i m1 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( weight +     rowStep ) ), vin );
+        const __m128i m2 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( weight + 2 * rowStep ) ), vin );
+        const __m128i m3 = _mm_madd_epi16( _mm_loadu_si128( ( const __m128i* ) ( weight + 3 * rowStep ) ), vin );
+        sum = _mm_hadd_epi32( _mm_hadd_epi32( m0, m1 ), _mm_hadd_epi32( m2, m3 ) );
+      }
+      else
+      {
+        const __m128i w01 = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* )   weight                ), _mm_loadl_epi64( ( const __m128i* ) ( weight +     rowStep ) ) );
+        const __m128i w23 = _mm_unpacklo_epi64( _mm_loadl_epi64( ( const __m128i* ) ( weight + 2 * rowStep ) ), _mm_loadl_epi64( ( const __m128i* ) ( weight + 3 * rowStep ) ) );
+        sum = _mm_hadd_epi32( _mm_madd_epi16( w01, vin ), _mm_madd_epi16( w23, vin ) );
+      }
+
+      const __m128i vbias = _mm_setr_epi32( bias[posBias] << shiftBias, bias[posBias + xStep] << shiftBias, bias[posBias + 2 * xStep] << shiftBias, bias[posBias + 3 * xStep] << shiftBias );
+      sum = _mm_sra_epi32( _mm_add_epi32( _mm_add_epi32( sum, vbias ), voffset ), _mm_cvtsi32_si128( shiftMatrix ) );
+      _mm_storeu_si128( ( __m128i* ) res, sum );
+
+      weight  += 4 * rowStep;
+      posBias += 4 * xStep;
+    }
+    weight  += yStep * inputSize;
+    posBias += yStep;
+  }
+}
+
+// ( ( u - p ) * before + p * behind + rounding ) >> log2( u ) of interleaved before/behind samples with rounding towards the nearest
+// integer and ties away from zero for negative values, as in PredictorMIP::predictionUpsampling1D
+static inline __m128i upsampleRound( const __m128i v, const __m128i vround, const __m128i vshift )
+{
+  return _mm_sra_epi32( _mm_add_epi32( _mm_add_epi32( v, vround ), _mm_srai_epi32( v, 31 ) ), vshift );
+}
+
+// one line between the lines before and behind at position p of the upsampling factor u = 1 << log2Factor
+static inline void upsampleLineVer( Pel* dst, const Pel* before, const Pel* behind, const int width, const int p, const int log2Factor,
+                                    const bool clip, const __m128i vmax )
+{
+  const __m128i vweight = _mm_set1_epi32( ( p << 16 ) | ( ( 1 << log2Factor ) - p ) );
+  const __m128i vround  = _mm_set1_epi32( 1 << ( log2Factor - 1 ) );
+  const __m128i vshift  = _mm_cvtsi32_si128( log2Factor );
+
+  int x = 0;
+  for( ; x + 8 <= width; x += 8 )
+  {
+    const __m128i b   = _mm_loadu_si128( ( const __m128i* ) ( before + x ) );
+    const __m128i a   = _mm_loadu_si128( ( const __m128i* ) ( behind + x ) );
+    const __m128i lo  = upsampleRound( _mm_madd_epi16( _mm_unpacklo_epi16( b, a ), vweight ), vround, vshift );
+    const __m128i hi  = upsampleRound( _mm_madd_epi16( _mm_unpackhi_epi16( b, a ), vweight ), vround, vshift );
+    __m128i       res = _mm_packs_epi32( lo, hi );
+    if( clip )
+    {
+      res = _mm_min_epi16( _mm_max_epi16( res, _mm_setzero_si128() ), vmax );
+    }
+    _mm_storeu_si128( ( __m128i* ) ( dst + x ), res );
+  }
+  if( x < width )
+  {
+    const __m128i b   = _mm_loadl_epi64( ( const __m128i* ) ( before + x ) );
+    const __m128i a   = _mm_loadl_epi64( ( const __m128i* ) ( behind + x ) );
+    const __m128i lo  = upsampleRound( _mm_madd_epi16( _mm_unpacklo_epi16( b, a ), vweight ), vround, vshift );
+    __m128i       res = _mm_packs_epi32( lo, lo );
+    if( clip )
+    {
+      res = _mm_min_epi16( _mm_max_epi16( res, _mm_setzero_si128() ), vmax );
+    }
+    _mm_storel_epi64( ( __m128i* ) ( dst + x ), res );
+  }
+}
+
+// one line of srcLen samples upsampled by u = 1 << log2Factor, starting from the boundary sample bndry
+static inline void upsampleLineHor( Pel* dst, const Pel* src, const int srcLen, const int bndry, const int log2Factor,
+                                    const bool clip, const __m128i vmax )
+{
+  const int     factor = 1 << log2Factor;
+  const __m128i vround = _mm_set1_epi32( 1 << ( log2Factor - 1 ) );
+  const __m128i vshift = _mm_cvtsi32_si128( log2Factor );
+  const __m128i vmask  = _mm_set1_epi16( factor - 1 );
+  const __m128i vramp  = _mm_setr_epi16( 1, 2, 3, 4, 5, 6, 7, 8 );
+
+  // boundary sample followed by the source line of at most 8 samples, padded for the unaligned loads
+  Pel ext[24] = { 0 };
+  ext[0] = bndry;
+  memcpy( ext + 1, src, srcLen * sizeof( Pel ) );
+
+  for( int x = 0; x < srcLen * factor; x += 8 )
+  {
+    const int idx = x >> log2Factor;
+    __m128i before, behind;
+    if( factor == 2 )
+    {
+      before = _mm_unpacklo_epi16( _mm_loadu_si128( ( const __m128i* ) ( ext + idx     ) ), _mm_loadu_si128( ( const __m128i* ) ( ext + idx     ) ) );
+      behind = _mm_unpacklo_epi16( _mm_loadu_si128( ( const __m128i* ) ( ext + idx + 1 ) ), _mm_loadu_si128( ( const __m128i* ) ( ext + idx + 1 ) ) );
+    }
+    else if( factor == 4 )
+    {
+      const __m128i b = _mm_unpacklo_epi16( _mm_loadu_si128( ( const __m128i* ) ( ext + idx     ) ), _mm_loadu_si128( ( const __m128i* ) ( ext + idx     ) ) );
+      const __m128i a = _mm_unpacklo_epi16( _mm_loadu_si128( ( const __m128i* ) ( ext + idx + 1 ) ), _mm_loadu_si128( ( const __m128i* ) ( ext + idx + 1 ) ) );
+      before = _mm_unpacklo_epi32( b, b );
+      behind = _mm_unpacklo_epi32( a, a );
+    }
+    else
+    {
+      before = _mm_set1_epi16( ext[idx    ] );
+      behind = _mm_set1_epi16( ext[idx + 1] );
+    }
+
+    // weights u - p of the sample before and p of the sample behind, p = ( x & ( u - 1 ) ) + 1
+    const __m128i wBehind = _mm_add_epi16( _mm_and_si128( _mm_add_epi16( _mm_set1_epi16( x ), _mm_sub_epi16( vramp, _mm_set1_epi16( 1 ) ) ), vmask ), _mm_set1_epi16( 1 ) );
+    const __m128i wBefore = _mm_sub_epi16( _mm_set1_epi16( factor ), wBehind );
+
+    const __m128i lo  = upsampleRound( _mm_madd_epi16( _mm_unpacklo_epi16( before, behind ), _mm_unpacklo_epi16( wBefore, wBehind ) ), vround, vshift );
+    const __m128i hi  = upsampleRound( _mm_madd_epi16( _mm_unpackhi_epi16( before, behind ), _mm_unpackhi_epi16( wBefore, wBehind ) ), vround, vshift );
+    __m128i       res = _mm_packs_epi32( lo, hi );
+    if( clip )
+    {
+      res = _mm_min_epi16( _mm_max_epi16( res, _mm_setzero_si128() ), vmax );
+    }
+    _mm_storeu_si128( ( __m128i* ) ( dst + x ), res );
+  }
+}
+
+template<X86_VEXT vext>
+void predictionUpsampling_SIMD( Pel* dst, const int dstStride, const int* const src, const Size& reducedSize,
+                                const Size& blockSize, const int* const bndryTop, const int* const bndryLeft, const int bitDepth )
+{
+  const int redWidth       = reducedSize.width;
+  const int redHeight      = reducedSize.height;
+  const int width          = blockSize.width;
+  const int height         = blockSize.height;
+  const int log2FactorHor  = g_aucLog2[width  / redWidth ];
+  const int log2FactorVer  = g_aucLog2[height / redHeight];
+  const __m128i vmax       = _mm_set1_epi16( ( 1 << bitDepth ) - 1 );
+
+  CHECKD( redWidth & 3, "Error, reduced prediction width not divisible by four" );
+
+  // reduced prediction as 16-bit samples
+  Pel reduced[MIP_MAX_REDUCED_OUTPUT_SAMPLES];
+  for( int i = 0; i < redWidth * redHeight; i += 4 )
+  {
+    const __m128i v = _mm_loadu_si128( ( const __m128i* ) ( src + i ) );
+    _mm_storel_epi64( ( __m128i* ) ( reduced + i ), _mm_packs_epi32( v, v ) );
+  }
+
+  if( log2FactorHor == 0 && log2FactorVer == 0 )
+  {
+    for( int y = 0; y < height; y++ )
+    {
+      const __m128i v = _mm_loadl_epi64( ( const __m128i* ) ( reduced + y * redWidth ) );
+      _mm_storel_epi64( ( __m128i* ) ( dst + y * dstStride ), _mm_min_epi16( _mm_max_epi16( v, _mm_setzero_si128() ), vmax ) );
+    }
+    return;
+  }
+
+  Pel upsampled[MIP_MAX_WIDTH * MIP_MAX_HEIGHT];
+  Pel top[MIP_MAX_WIDTH];
+
+  // shorter side is upsampled first
+  if( height > width )
+  {
+    const Pel* lines      = reduced;
+    int        lineStride = redWidth;
+    if( log2FactorHor > 0 )
+    {
+      for( int y = 0; y < redHeight; y++ )
+      {
+        upsampleLineHor( upsampled + y * width, reduced + y * redWidth, redWidth, bndryLeft[y], log2FactorHor, false, vmax );
+      }
+      lines      = upsampled;
+      lineStride = width;
+    }
+
+    for( int x = 0; x < width; x++ )
+    {
+      top[x] = bndryTop[x];
+    }
+
+    const Pel* before = top;
+    for( int y = 0; y < redHeight; y++ )
+    {
+      const Pel* behind = lines + y * lineStride;
+      for( int p = 1; p <= ( 1 << log2FactorVer ); p++ )
+      {
+        upsampleLineVer( dst + ( ( y << log2FactorVer ) + p - 1 ) * dstStride, before, behind, width, p, log2FactorVer, true, vmax );
+      }
+      before = behind;
+    }
+  }
+  else
+  {
+    const Pel* lines = reduced;
+    if( log2FactorVer > 0 )
+    {
+      for( int x = 0; x < redWidth; x++ )
+      {
+        top[x] = bndryTop[x];
+      }
+
+      const Pel* before = top;
+      for( int y = 0; y < redHeight; y++ )
+      {
+        const Pel* behind = reduced + y * redWidth;
+        for( int p = 1; p <= ( 1 << log2FactorVer ); p++ )
+        {
+          upsampleLineVer( upsampled + ( ( y << log2FactorVer ) + p - 1 ) * redWidth, before, behind, redWidth, p, log2FactorVer, false, vmax );
+        }
+        before = behind;
+      }
+      lines = upsampled;
+    }
+
+    for( int y = 0; y < height; y++ )
+    {
+      upsampleLineHor( dst + y * dstStride, lines + y * redWidth, redWidth, bndryLeft[y], log2FactorHor, true, vmax );
+    }
+  }
+}
+
+template <X86_VEXT vext>
+void PredictorMIP::_initPredictorMipX86()
+{
+  m_computeMatrixTimesRedBndry = computeMatrixTimesRedBndry_SIMD<vext>;
+  m_predictionUpsampling       = predictionUpsampling_SIMD<vext>;
+}
+
+template void PredictorMIP::_initPredictorMipX86<SIMDX86>();
+} // namespace Mip
+
+#endif // TARGET_SIMD_X86
+#endif
+//! \}
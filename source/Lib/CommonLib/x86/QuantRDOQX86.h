@@ -0,0 +1,159 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     QuantRDOQX86.h
+    \brief    SIMD level derivation of the RDOQ.
+*/
+
+//! \ingroup CommonLib
+//! \{
+
+
+#include "CommonLib/CommonDef.h"
+#include "CommonDefX86.h"
+#include "CommonLib/QuantRDOQ.h"
+
+#include <limits>
+
+
+#if ENABLE_SIMD_OPT_RDOQ
+#ifdef TARGET_SIMD_X86
+
+static_assert( sizeof( Intermediate_Int ) == sizeof( int ), "The scaled levels are processed as 32-bit integers" );
+
+// The scaled level |coeff| * qCoef can exceed 32 bit with scaling lists, it is derived and clipped in double
+// precision, in which all products are exact. The cost of coding zero is computed with the same operations as in the
+// scalar code.
+template<X86_VEXT vext>
+bool quantLevels_SIMD( const TCoeff* src, const int* qCoef, const double* errScale, const int stride, const int width, const int height,
+                       const int defaultQCoef, const double defaultErrScale, const int qBits, const TCoeff maxLevel,
+                       Intermediate_Int* levelDouble, TCoeff* maxAbsLevel, double* costCoeff0 )
+{
+  if( width & 3 )
+  {
+    return QuantRDOQ::quantLevelsCore( src, qCoef, errScale, stride, width, height, defaultQCoef, defaultErrScale, qBits, maxLevel, levelDouble, maxAbsLevel, costCoeff0 );
+  }
+
+  const int     levelOffset = 1 << ( qBits - 1 );
+  const double  levelLimit  = double( std::numeric_limits<int>::max() - levelOffset );
+  const __m128i vOffset     = _mm_set1_epi32( levelOffset );
+  const __m128i vShift      = _mm_cvtsi32_si128( qBits );
+  const __m128i vMaxLevel   = _mm_set1_epi32( maxLevel );
+  __m128i       vSig        = _mm_setzero_si128();
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256d vLimit = _mm256_set1_pd( levelLimit );
+    const __m256d vQCoef = _mm256_set1_pd( double( defaultQCoef ) );
+    const __m256d vScale = _mm256_set1_pd( defaultErrScale );
+
+    for( int y = 0; y < height; y++ )
+    {
+      for( int x = 0; x < width; x += 4 )
+      {
+        const int     blkPos = y * stride + x;
+        const __m128i absSrc = _mm_abs_epi32( _mm_loadu_si128( ( const __m128i* ) &src[blkPos] ) );
+        const __m256d q      = qCoef    ? _mm256_cvtepi32_pd( _mm_loadu_si128( ( const __m128i* ) &qCoef[blkPos] ) ) : vQCoef;
+        const __m256d scale  = errScale ? _mm256_loadu_pd( &errScale[blkPos] ) : vScale;
+
+        const __m256d lvlD   = _mm256_min_pd( _mm256_mul_pd( _mm256_cvtepi32_pd( absSrc ), q ), vLimit );
+        const __m128i lvl    = _mm256_cvttpd_epi32( lvlD );
+        const __m128i maxAbs = _mm_min_epi32( _mm_sra_epi32( _mm_add_epi32( lvl, vOffset ), vShift ), vMaxLevel );
+
+        _mm_storeu_si128( ( __m128i* ) &levelDouble[blkPos], lvl );
+        _mm_storeu_si128( ( __m128i* ) &maxAbsLevel[blkPos], maxAbs );
+        _mm256_storeu_pd( &costCoeff0[blkPos], _mm256_mul_pd( _mm256_mul_pd( lvlD, lvlD ), scale ) );
+
+        vSig = _mm_or_si128( vSig, maxAbs );
+      }
+    }
+  }
+  else
+#endif
+  {
+    const __m128d vLimit = _mm_set1_pd( levelLimit );
+    const __m128d vQCoef = _mm_set1_pd( double( defaultQCoef ) );
+    const __m128d vScale = _mm_set1_pd( defaultErrScale );
+
+    for( int y = 0; y < height; y++ )
+    {
+      for( int x = 0; x < width; x += 4 )
+      {
+        const int     blkPos = y * stride + x;
+        const __m128i absSrc = _mm_abs_epi32( _mm_loadu_si128( ( const __m128i* ) &src[blkPos] ) );
+        __m128d       qLo    = vQCoef;
+        __m128d       qHi    = vQCoef;
+        __m128d       sLo    = vScale;
+        __m128d       sHi    = vScale;
+        if( qCoef )
+        {
+          const __m128i q = _mm_loadu_si128( ( const __m128i* ) &qCoef[blkPos] );
+          qLo = _mm_cvtepi32_pd( q );
+          qHi = _mm_cvtepi32_pd( _mm_unpackhi_epi64( q, q ) );
+        }
+        if( errScale )
+        {
+          sLo = _mm_loadu_pd( &errScale[blkPos] );
+          sHi = _mm_loadu_pd( &errScale[blkPos + 2] );
+        }
+
+        const __m128d lvlLo  = _mm_min_pd( _mm_mul_pd( _mm_cvtepi32_pd( absSrc ), qLo ), vLimit );
+        const __m128d lvlHi  = _mm_min_pd( _mm_mul_pd( _mm_cvtepi32_pd( _mm_unpackhi_epi64( absSrc, absSrc ) ), qHi ), vLimit );
+        const __m128i lvl    = _mm_unpacklo_epi64( _mm_cvttpd_epi32( lvlLo ), _mm_cvttpd_epi32( lvlHi ) );
+        const __m128i maxAbs = _mm_min_epi32( _mm_sra_epi32( _mm_add_epi32( lvl, vOffset ), vShift ), vMaxLevel );
+
+        _mm_storeu_si128( ( __m128i* ) &levelDouble[blkPos], lvl );
+        _mm_storeu_si128( ( __m128i* ) &maxAbsLevel[blkPos], maxAbs );
+        _mm_storeu_pd( &costCoeff0[blkPos],     _mm_mul_pd( _mm_mul_pd( lvlLo, lvlLo ), sLo ) );
+        _mm_storeu_pd( &costCoeff0[blkPos + 2], _mm_mul_pd( _mm_mul_pd( lvlHi, lvlHi ), sHi ) );
+
+        vSig = _mm_or_si128( vSig, maxAbs );
+      }
+    }
+  }
+
+  return !_mm_testz_si128( vSig, vSig );
+}
+
+template <X86_VEXT vext>
+void QuantRDOQ::_initQuantRDOQX86()
+{
+  m_quantLevels = quantLevels_SIMD<vext>;
+}
+
+template void QuantRDOQ::_initQuantRDOQX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+#endif
+//! \}
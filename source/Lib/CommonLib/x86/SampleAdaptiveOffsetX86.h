@@ -0,0 +1,418 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     SampleAdaptiveOffsetX86.h
+    \brief    SIMD edge class derivation, band lookup and statistics collection for SAO.
+*/
+
+//! \ingroup CommonLib
+//! \{
+
+
+#include "CommonLib/CommonDef.h"
+#include "CommonDefX86.h"
+#include "CommonLib/SampleAdaptiveOffset.h"
+
+
+#if ENABLE_SIMD_OPT_SAO
+#ifdef TARGET_SIMD_X86
+
+// 16-bit sample vectors, SaoVecSSE holds 8 and SaoVecAVX2 16 samples
+struct SaoVecSSE
+{
+  typedef __m128i T;
+  static const int numSamples = 8;
+
+  static inline T    load  ( const Pel* src )           { return _mm_loadu_si128( ( const __m128i* ) src ); }
+  static inline void store ( Pel* dst, const T a )      { _mm_storeu_si128( ( __m128i* ) dst, a ); }
+  static inline T    set1  ( const int v )              { return _mm_set1_epi16( v ); }
+  static inline T    zero  ()                           { return _mm_setzero_si128(); }
+  static inline T    add   ( const T a, const T b )     { return _mm_add_epi16( a, b ); }
+  static inline T    sub   ( const T a, const T b )     { return _mm_sub_epi16( a, b ); }
+  static inline T    min   ( const T a, const T b )     { return _mm_min_epi16( a, b ); }
+  static inline T    max   ( const T a, const T b )     { return _mm_max_epi16( a, b ); }
+  static inline T    cmpgt ( const T a, const T b )     { return _mm_cmpgt_epi16( a, b ); }
+  static inline T    cmpeq ( const T a, const T b )     { return _mm_cmpeq_epi16( a, b ); }
+  static inline T    andv  ( const T a, const T b )     { return _mm_and_si128( a, b ); }
+  static inline T    mullo ( const T a, const T b )     { return _mm_mullo_epi16( a, b ); }
+  static inline T    srl   ( const T a, const int n )   { return _mm_srli_epi16( a, n ); }
+  static inline T    shuffle( const __m128i table, const T idx ) { return _mm_shuffle_epi8( table, idx ); }
+  // sum of adjacent 16-bit pairs in 32-bit lanes
+  static inline T    madd  ( const T a )                { return _mm_madd_epi16( a, _mm_set1_epi16( 1 ) ); }
+  static inline T    add32 ( const T a, const T b )     { return _mm_add_epi32( a, b ); }
+  static inline int  hsum32( const T a )
+  {
+    const __m128i s = _mm_add_epi32( a, _mm_shuffle_epi32( a, 0x4e ) );
+    return _mm_cvtsi128_si32( _mm_add_epi32( s, _mm_shuffle_epi32( s, 0xb1 ) ) );
+  }
+  static inline int  hmin  ( const T a )                { return _mm_cvtsi128_si32( _mm_minpos_epu16( a ) ) & 0xffff; }
+  static inline int  hmax  ( const T a )                { return 0xffff - hmin( _mm_xor_si128( a, _mm_set1_epi16( -1 ) ) ); }
+};
+
+#ifdef USE_AVX2
+struct SaoVecAVX2
+{
+  typedef __m256i T;
+  static const int numSamples = 16;
+
+  static inline T    load  ( const Pel* src )           { return _mm256_loadu_si256( ( const __m256i* ) src ); }
+  static inline void store ( Pel* dst, const T a )      { _mm256_storeu_si256( ( __m256i* ) dst, a ); }
+  static inline T    set1  ( const int v )              { return _mm256_set1_epi16( v ); }
+  static inline T    zero  ()                           { return _mm256_setzero_si256(); }
+  static inline T    add   ( const T a, const T b )     { return _mm256_add_epi16( a, b ); }
+  static inline T    sub   ( const T a, const T b )     { return _mm256_sub_epi16( a, b ); }
+  static inline T    min   ( const T a, const T b )     { return _mm256_min_epi16( a, b ); }
+  static inline T    max   ( const T a, const T b )     { return _mm256_max_epi16( a, b ); }
+  static inline T    cmpgt ( const T a, const T b )     { return _mm256_cmpgt_epi16( a, b ); }
+  static inline T    cmpeq ( const T a, const T b )     { return _mm256_cmpeq_epi16( a, b ); }
+  static inline T    andv  ( const T a, const T b )     { return _mm256_and_si256( a, b ); }
+  static inline T    mullo ( const T a, const T b )     { return _mm256_mullo_epi16( a, b ); }
+  static inline T    srl   ( const T a, const int n )   { return _mm256_srli_epi16( a, n ); }
+  static inline T    shuffle( const __m128i table, const T idx ) { return _mm256_shuffle_epi8( _mm256_broadcastsi128_si256( table ), idx ); }
+  static inline T    madd  ( const T a )                { return _mm256_madd_epi16( a, _mm256_set1_epi16( 1 ) ); }
+  static inline T    add32 ( const T a, const T b )     { return _mm256_add_epi32( a, b ); }
+  static inline int  hsum32( const T a )                { return SaoVecSSE::hsum32( _mm_add_epi32( _mm256_castsi256_si128( a ), _mm256_extracti128_si256( a, 1 ) ) ); }
+  static inline int  hmin  ( const T a )                { return SaoVecSSE::hmin( _mm_min_epu16( _mm256_castsi256_si128( a ), _mm256_extracti128_si256( a, 1 ) ) ); }
+  static inline int  hmax  ( const T a )                { return SaoVecSSE::hmax( _mm_max_epu16( _mm256_castsi256_si128( a ), _mm256_extracti128_si256( a, 1 ) ) ); }
+};
+#endif
+
+// edge class 0..4 of each sample, i.e. sgn( c - a ) + sgn( c - b ) + 2
+template<typename V>
+static inline typename V::T edgeClass( const typename V::T c, const typename V::T a, const typename V::T b )
+{
+  const typename V::T signA = V::sub( V::cmpgt( a, c ), V::cmpgt( c, a ) );
+  const typename V::T signB = V::sub( V::cmpgt( b, c ), V::cmpgt( c, b ) );
+  return V::add( V::add( signA, signB ), V::set1( 2 ) );
+}
+
+template<typename V>
+static inline int offsetEdgeLine( const Pel* src, Pel* res, const int startX, const int endX, const int neighbourA, const int neighbourB, const __m128i table, const ClpRng& clpRng )
+{
+  typedef typename V::T T;
+
+  // byte shuffle indices 2 * class and 2 * class + 1 select the 16-bit offset of the class
+  const T vmul = V::set1( 0x0202 );
+  const T vidx = V::set1( 0x0100 );
+  const T vmin = V::set1( clpRng.min );
+  const T vmax = V::set1( clpRng.max );
+
+  int x = startX;
+  for( ; x + V::numSamples <= endX; x += V::numSamples )
+  {
+    const T c   = V::load( src + x );
+    const T cls = edgeClass<V>( c, V::load( src + x + neighbourA ), V::load( src + x + neighbourB ) );
+    const T off = V::shuffle( table, V::add( V::mullo( cls, vmul ), vidx ) );
+    V::store( res + x, V::min( V::max( V::add( c, off ), vmin ), vmax ) );
+  }
+  return x;
+}
+
+template<X86_VEXT vext>
+static void offsetEdgeLines_SIMD( const Pel* src, Pel* res, const int srcStride, const int resStride, const int startX, const int endX, const int numLines, const int neighbourA, const int neighbourB, const int* offset, const ClpRng& clpRng )
+{
+  const __m128i table = _mm_setr_epi16( offset[0], offset[1], offset[2], offset[3], offset[4], 0, 0, 0 );
+
+  for( int y = 0; y < numLines; y++ )
+  {
+    int x = startX;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      x = offsetEdgeLine<SaoVecAVX2>( src, res, x, endX, neighbourA, neighbourB, table, clpRng );
+    }
+#endif
+    x = offsetEdgeLine<SaoVecSSE>( src, res, x, endX, neighbourA, neighbourB, table, clpRng );
+    if( x < endX )
+    {
+      SampleAdaptiveOffset::offsetEdgeLinesCore( src, res, 0, 0, x, endX, 1, neighbourA, neighbourB, offset, clpRng );
+    }
+    src += srcStride;
+    res += resStride;
+  }
+}
+
+template<typename V>
+static inline int offsetBandLine( const Pel* src, Pel* res, const int startX, const int endX, const int shiftBits, const int numBands, const int* bands, const int* offset, const ClpRng& clpRng )
+{
+  typedef typename V::T T;
+
+  const T vmin = V::set1( clpRng.min );
+  const T vmax = V::set1( clpRng.max );
+
+  int x = startX;
+  for( ; x + V::numSamples <= endX; x += V::numSamples )
+  {
+    const T c    = V::load( src + x );
+    const T band = V::srl( c, shiftBits );
+    T       off  = V::zero();
+    for( int i = 0; i < numBands; i++ )
+    {
+      off = V::add( off, V::andv( V::cmpeq( band, V::set1( bands[i] ) ), V::set1( offset[bands[i]] ) ) );
+    }
+    V::store( res + x, V::min( V::max( V::add( c, off ), vmin ), vmax ) );
+  }
+  return x;
+}
+
+template<X86_VEXT vext>
+static void offsetBandLines_SIMD( const Pel* src, Pel* res, const int srcStride, const int resStride, const int startX, const int endX, const int numLines, const int shiftBits, const int* offset, const ClpRng& clpRng )
+{
+  // only the bands with a non-zero offset need to be looked up, these are at most 4 for the band offset types
+  int bands[NUM_SAO_BO_CLASSES];
+  int numBands = 0;
+  for( int i = 0; i < ( NUM_SAO_BO_CLASSES ); i++ )
+  {
+    if( offset[i] )
+    {
+      bands[numBands++] = i;
+    }
+  }
+
+  for( int y = 0; y < numLines; y++ )
+  {
+    int x = startX;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      x = offsetBandLine<SaoVecAVX2>( src, res, x, endX, shiftBits, numBands, bands, offset, clpRng );
+    }
+#endif
+    x = offsetBandLine<SaoVecSSE>( src, res, x, endX, shiftBits, numBands, bands, offset, clpRng );
+    if( x < endX )
+    {
+      SampleAdaptiveOffset::offsetBandLinesCore( src, res, 0, 0, x, endX, 1, shiftBits, offset, clpRng );
+    }
+    src += srcStride;
+    res += resStride;
+  }
+}
+
+template<typename V>
+static inline int calcEdgeStatsLine( const Pel* src, const Pel* org, const int startX, const int endX, const int neighbourA, const int neighbourB, typename V::T* vdiff, typename V::T* vcount )
+{
+  typedef typename V::T T;
+
+  int x = startX;
+  for( ; x + V::numSamples <= endX; x += V::numSamples )
+  {
+    const T c   = V::load( src + x );
+    const T d   = V::sub( V::load( org + x ), c );
+    const T cls = edgeClass<V>( c, V::load( src + x + neighbourA ), V::load( src + x + neighbourB ) );
+
+    // the plain class is derived from the totals
+    vdiff[NUM_SAO_EO_CLASSES] = V::add32( vdiff[NUM_SAO_EO_CLASSES], V::madd( d ) );
+    for( int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+    {
+      if( k != SAO_CLASS_EO_PLAIN )
+      {
+        const T mask = V::cmpeq( cls, V::set1( k ) );
+        vdiff [k] = V::add32( vdiff[k], V::madd( V::andv( mask, d ) ) );
+        vcount[k] = V::add32( vcount[k], V::madd( mask ) );
+      }
+    }
+  }
+  return x;
+}
+
+template<X86_VEXT vext>
+static void calcEdgeStats_SIMD( const Pel* src, const Pel* org, const int srcStride, const int orgStride, const int startX, const int endX, const int numLines, const int neighbourA, const int neighbourB, int64_t* diff, int64_t* count )
+{
+  int64_t sumDiff [NUM_SAO_EO_CLASSES + 1] = { 0 };
+  int64_t sumCount[NUM_SAO_EO_CLASSES]     = { 0 };
+  int     numVecSamples = 0;
+
+#ifdef USE_AVX2
+  __m256i vdiff256[NUM_SAO_EO_CLASSES + 1], vcount256[NUM_SAO_EO_CLASSES];
+  for( int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    vdiff256[k] = vcount256[k] = _mm256_setzero_si256();
+  }
+  vdiff256[NUM_SAO_EO_CLASSES] = _mm256_setzero_si256();
+#endif
+  __m128i vdiff[NUM_SAO_EO_CLASSES + 1], vcount[NUM_SAO_EO_CLASSES];
+  for( int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    vdiff[k] = vcount[k] = _mm_setzero_si128();
+  }
+  vdiff[NUM_SAO_EO_CLASSES] = _mm_setzero_si128();
+
+  for( int y = 0; y < numLines; y++ )
+  {
+    int x = startX;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      x = calcEdgeStatsLine<SaoVecAVX2>( src, org, x, endX, neighbourA, neighbourB, vdiff256, vcount256 );
+    }
+#endif
+    x = calcEdgeStatsLine<SaoVecSSE>( src, org, x, endX, neighbourA, neighbourB, vdiff, vcount );
+    numVecSamples += x - startX;
+    if( x < endX )
+    {
+      SampleAdaptiveOffset::calcEdgeStatsCore( src, org, 0, 0, x, endX, 1, neighbourA, neighbourB, sumDiff, sumCount );
+    }
+    src += srcStride;
+    org += orgStride;
+  }
+
+  // the mask lanes are -1, so the vector counts are negated
+  int vecCount = 0;
+  for( int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    if( k != SAO_CLASS_EO_PLAIN )
+    {
+      int d = SaoVecSSE::hsum32( vdiff[k] ), c = -SaoVecSSE::hsum32( vcount[k] );
+#ifdef USE_AVX2
+      d += SaoVecAVX2::hsum32( vdiff256[k] );
+      c -= SaoVecAVX2::hsum32( vcount256[k] );
+#endif
+      sumDiff [k] += d;
+      sumCount[k] += c;
+      sumDiff [NUM_SAO_EO_CLASSES] -= d;
+      vecCount += c;
+    }
+  }
+  int totalDiff = SaoVecSSE::hsum32( vdiff[NUM_SAO_EO_CLASSES] );
+#ifdef USE_AVX2
+  totalDiff += SaoVecAVX2::hsum32( vdiff256[NUM_SAO_EO_CLASSES] );
+#endif
+  sumDiff [SAO_CLASS_EO_PLAIN] += sumDiff[NUM_SAO_EO_CLASSES] + totalDiff;
+  sumCount[SAO_CLASS_EO_PLAIN] += numVecSamples - vecCount;
+
+  for( int k = 0; k < NUM_SAO_EO_CLASSES; k++ )
+  {
+    diff [k] += sumDiff [k];
+    count[k] += sumCount[k];
+  }
+}
+
+template<typename V>
+static inline void calcBandStatsLine( const Pel* src, const Pel* org, const int width, const int shiftBits, int64_t* diff, int64_t* count )
+{
+  typedef typename V::T T;
+
+  const int numVec = width / V::numSamples;
+  T vmin = V::load( src );
+  T vmax = vmin;
+  for( int i = 1; i < numVec; i++ )
+  {
+    const T c = V::load( src + i * V::numSamples );
+    vmin = V::min( vmin, c );
+    vmax = V::max( vmax, c );
+  }
+
+  const int firstBand = V::hmin( vmin ) >> shiftBits;
+  const int lastBand  = V::hmax( vmax ) >> shiftBits;
+
+  // a line usually covers only a few bands, otherwise the scalar accumulation is faster
+  if( lastBand - firstBand >= 8 )
+  {
+    SampleAdaptiveOffset::calcBandStatsCore( src, org, 0, 0, 0, numVec * V::numSamples, 1, shiftBits, diff, count );
+    return;
+  }
+
+  T vdiff[8], vcount[8];
+  for( int b = 0; b <= lastBand - firstBand; b++ )
+  {
+    vdiff[b] = vcount[b] = V::zero();
+  }
+  for( int i = 0; i < numVec; i++ )
+  {
+    const T c    = V::load( src + i * V::numSamples );
+    const T d    = V::sub( V::load( org + i * V::numSamples ), c );
+    const T band = V::srl( c, shiftBits );
+    for( int b = 0; b <= lastBand - firstBand; b++ )
+    {
+      const T mask = V::cmpeq( band, V::set1( firstBand + b ) );
+      vdiff [b] = V::add32( vdiff[b], V::madd( V::andv( mask, d ) ) );
+      vcount[b] = V::add32( vcount[b], V::madd( mask ) );
+    }
+  }
+  for( int b = 0; b <= lastBand - firstBand; b++ )
+  {
+    diff [firstBand + b] += V::hsum32( vdiff[b] );
+    count[firstBand + b] -= V::hsum32( vcount[b] );
+  }
+}
+
+template<X86_VEXT vext>
+static void calcBandStats_SIMD( const Pel* src, const Pel* org, const int srcStride, const int orgStride, const int startX, const int endX, const int numLines, const int shiftBits, int64_t* diff, int64_t* count )
+{
+  const int width = endX - startX;
+  int       numSIMD = width & ~( SaoVecSSE::numSamples - 1 );
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    numSIMD = width & ~( SaoVecAVX2::numSamples - 1 );
+  }
+#endif
+
+  src += startX;
+  org += startX;
+  for( int y = 0; y < numLines; y++ )
+  {
+    if( numSIMD )
+    {
+#ifdef USE_AVX2
+      if( vext >= AVX2 )
+      {
+        calcBandStatsLine<SaoVecAVX2>( src, org, numSIMD, shiftBits, diff, count );
+      }
+      else
+#endif
+      calcBandStatsLine<SaoVecSSE>( src, org, numSIMD, shiftBits, diff, count );
+    }
+    if( numSIMD < width )
+    {
+      SampleAdaptiveOffset::calcBandStatsCore( src, org, 0, 0, numSIMD, width, 1, shiftBits, diff, count );
+    }
+    src += srcStride;
+    org += orgStride;
+  }
+}
+
+template <X86_VEXT vext>
+void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86()
+{
+  m_offsetEdgeLines = offsetEdgeLines_SIMD<vext>;
+  m_offsetBandLines = offsetBandLines_SIMD<vext>;
+  m_calcEdgeStats   = calcEdgeStats_SIMD<vext>;
+  m_calcBandStats   = calcBandStats_SIMD<vext>;
+}
+
+template void SampleAdaptiveOffset::_initSampleAdaptiveOffsetX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+#endif
+//! \}
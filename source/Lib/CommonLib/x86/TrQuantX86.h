@@ -0,0 +1,584 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TrQuantX86.h
+    \brief    SIMD matrix multiplication for the DCT-II, DST-VII and DCT-VIII core transforms.
+*/
+
+//! \ingroup CommonLib
+//! \{
+
+
+#include "CommonLib/CommonDef.h"
+#include "CommonDefX86.h"
+#include "CommonLib/Rom.h"
+#include "CommonLib/TrQuant.h"
+
+#include <limits>
+
+
+#if ENABLE_SIMD_OPT_TRAFO
+#ifdef TARGET_SIMD_X86
+
+template<int trType, int trSize>
+static inline const TMatrixCoeff* getTrCoreMatrix( const TransformDirection dir )
+{
+  switch( trType )
+  {
+  case DCT2:
+    switch( trSize )
+    {
+    case  4: return g_trCoreDCT2P4 [dir][0];
+    case  8: return g_trCoreDCT2P8 [dir][0];
+    case 16: return g_trCoreDCT2P16[dir][0];
+    case 32: return g_trCoreDCT2P32[dir][0];
+    case 64: return g_trCoreDCT2P64[dir][0];
+    }
+    break;
+  case DCT8:
+    switch( trSize )
+    {
+    case  4: return g_trCoreDCT8P4 [dir][0];
+    case  8: return g_trCoreDCT8P8 [dir][0];
+    case 16: return g_trCoreDCT8P16[dir][0];
+    case 32: return g_trCoreDCT8P32[dir][0];
+    }
+    break;
+  case DST7:
+    switch( trSize )
+    {
+    case  4: return g_trCoreDST7P4 [dir][0];
+    case  8: return g_trCoreDST7P8 [dir][0];
+    case 16: return g_trCoreDST7P16[dir][0];
+    case 32: return g_trCoreDST7P32[dir][0];
+    }
+    break;
+  }
+  THROW( "Unsupported transform" );
+  return nullptr;
+}
+
+static inline void transpose4x4_epi32( __m128i& r0, __m128i& r1, __m128i& r2, __m128i& r3 )
+{
+  const __m128i t0 = _mm_unpacklo_epi32( r0, r1 );
+  const __m128i t1 = _mm_unpacklo_epi32( r2, r3 );
+  const __m128i t2 = _mm_unpackhi_epi32( r0, r1 );
+  const __m128i t3 = _mm_unpackhi_epi32( r2, r3 );
+
+  r0 = _mm_unpacklo_epi64( t0, t1 );
+  r1 = _mm_unpackhi_epi64( t0, t1 );
+  r2 = _mm_unpacklo_epi64( t2, t3 );
+  r3 = _mm_unpackhi_epi64( t2, t3 );
+}
+
+// loads the samples k..k+3 of the four lines starting at src as four vectors holding one sample position each
+static inline void loadTransposed4x4( const TCoeff* src, const int stride, __m128i* dst )
+{
+  dst[0] = _mm_loadu_si128( ( const __m128i* ) ( src              ) );
+  dst[1] = _mm_loadu_si128( ( const __m128i* ) ( src +     stride ) );
+  dst[2] = _mm_loadu_si128( ( const __m128i* ) ( src + 2 * stride ) );
+  dst[3] = _mm_loadu_si128( ( const __m128i* ) ( src + 3 * stride ) );
+
+  transpose4x4_epi32( dst[0], dst[1], dst[2], dst[3] );
+}
+
+/** forward transform as a matrix multiplication, four (SSE) or eight (AVX2) lines are transformed in parallel.
+ *  For DCT-II the first butterfly stage is applied before, halving the number of multiplications. The sums are
+ *  accumulated in 32 bit with wrap-around like the partial butterflies, thus the results are identical.
+ */
+template<X86_VEXT vext, int trType, int trSize>
+void fastForwardTrafo_SIMD( const TCoeff *src, TCoeff *dst, int shift, int line, int iSkipLine, int iSkipLine2 )
+{
+  static constexpr bool useEvenOdd = trType == DCT2 && trSize >= 8;
+  static constexpr int  numTaps    = useEvenOdd ? trSize / 2 : trSize;
+
+  const TMatrixCoeff *tc     = getTrCoreMatrix<trType, trSize>( TRANSFORM_FORWARD );
+  const int  rnd_factor      = ( shift > 0 ) ? ( 1 << ( shift - 1 ) ) : 0;
+  const int  reducedLine     = line - iSkipLine;
+  const int  cutoff          = trSize - iSkipLine2;
+  int        i               = 0;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vrnd = _mm256_set1_epi32( rnd_factor );
+    __m256i       vsrc[trSize];
+    __m256i       veo [trSize];
+
+    for( ; i + 8 <= reducedLine; i += 8 )
+    {
+      for( int k = 0; k < trSize; k += 4 )
+      {
+        __m128i lo[4], hi[4];
+        loadTransposed4x4( src + ( i     ) * trSize + k, trSize, lo );
+        loadTransposed4x4( src + ( i + 4 ) * trSize + k, trSize, hi );
+        for( int n = 0; n < 4; n++ )
+        {
+          vsrc[k + n] = _mm256_inserti128_si256( _mm256_castsi128_si256( lo[n] ), hi[n], 1 );
+        }
+      }
+      if( useEvenOdd )
+      {
+        for( int k = 0; k < numTaps; k++ )
+        {
+          veo[          k] = _mm256_add_epi32( vsrc[k], vsrc[trSize - 1 - k] );
+          veo[numTaps + k] = _mm256_sub_epi32( vsrc[k], vsrc[trSize - 1 - k] );
+        }
+      }
+
+      const TMatrixCoeff* iT = tc;
+      for( int j = 0; j < cutoff; j++ )
+      {
+        const __m256i* vin  = useEvenOdd ? veo + ( j & 1 ) * numTaps : vsrc;
+        __m256i        vsum = vrnd;
+        for( int k = 0; k < numTaps; k++ )
+        {
+          vsum = _mm256_add_epi32( vsum, _mm256_mullo_epi32( vin[k], _mm256_set1_epi32( iT[k] ) ) );
+        }
+        _mm256_storeu_si256( ( __m256i* ) &dst[j * line + i], _mm256_srai_epi32( vsum, shift ) );
+        iT += trSize;
+      }
+    }
+  }
+#endif
+
+  const __m128i vrnd = _mm_set1_epi32( rnd_factor );
+  __m128i       vsrc[trSize];
+  __m128i       veo [trSize];
+
+  for( ; i + 4 <= reducedLine; i += 4 )
+  {
+    for( int k = 0; k < trSize; k += 4 )
+    {
+      loadTransposed4x4( src + i * trSize + k, trSize, vsrc + k );
+    }
+    if( useEvenOdd )
+    {
+      for( int k = 0; k < numTaps; k++ )
+      {
+        veo[          k] = _mm_add_epi32( vsrc[k], vsrc[trSize - 1 - k] );
+        veo[numTaps + k] = _mm_sub_epi32( vsrc[k], vsrc[trSize - 1 - k] );
+      }
+    }
+
+    const TMatrixCoeff* iT = tc;
+    for( int j = 0; j < cutoff; j++ )
+    {
+      const __m128i* vin  = useEvenOdd ? veo + ( j & 1 ) * numTaps : vsrc;
+      __m128i        vsum = vrnd;
+      for( int k = 0; k < numTaps; k++ )
+      {
+        vsum = _mm_add_epi32( vsum, _mm_mullo_epi32( vin[k], _mm_set1_epi32( iT[k] ) ) );
+      }
+      _mm_storeu_si128( ( __m128i* ) &dst[j * line + i], _mm_srai_epi32( vsum, shift ) );
+      iT += trSize;
+    }
+  }
+
+  // remaining lines of one and two point wide blocks
+  for( ; i < reducedLine; i++ )
+  {
+    const TCoeff*       pSrc = src + i * trSize;
+    const TMatrixCoeff* iT   = tc;
+    for( int j = 0; j < cutoff; j++ )
+    {
+      int iSum = 0;
+      for( int k = 0; k < trSize; k++ )
+      {
+        iSum += pSrc[k] * iT[k];
+      }
+      dst[j * line + i] = ( iSum + rnd_factor ) >> shift;
+      iT += trSize;
+    }
+  }
+
+  if( iSkipLine )
+  {
+    TCoeff *pCoef = dst + reducedLine;
+    for( int j = 0; j < cutoff; j++ )
+    {
+      memset( pCoef, 0, sizeof( TCoeff ) * iSkipLine );
+      pCoef += line;
+    }
+  }
+
+  if( iSkipLine2 )
+  {
+    memset( dst + line * cutoff, 0, sizeof( TCoeff ) * line * iSkipLine2 );
+  }
+}
+
+/** inverse transform as a matrix multiplication, four (SSE) or eight (AVX2) output samples of a line are computed in parallel.
+ *  For DCT-II the even and odd coefficients are accumulated separately and only the first half of the outputs is
+ *  multiplied out, the second half is the mirrored difference. Only the first trSize - iSkipLine2 coefficients of
+ *  each line are read, the zeroed-out ones do not contribute.
+ */
+template<X86_VEXT vext, int trType, int trSize>
+void fastInverseTrafo_SIMD( const TCoeff *src, TCoeff *dst, int shift, int line, int iSkipLine, int iSkipLine2, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  static constexpr bool useEvenOdd = trType == DCT2 && trSize >= 8;
+  static constexpr int  numOut     = useEvenOdd ? trSize / 2 : trSize;
+
+  const TMatrixCoeff *iT     = getTrCoreMatrix<trType, trSize>( TRANSFORM_INVERSE );
+  const int  rnd_factor      = 1 << ( shift - 1 );
+  const int  reducedLine     = line - iSkipLine;
+  const int  cutoff          = trSize - iSkipLine2;
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 && numOut >= 8 )
+  {
+    static constexpr int numVec = numOut >= 8 ? numOut / 8 : 1;
+    const __m256i vrnd = _mm256_set1_epi32( rnd_factor );
+    const __m256i vmin = _mm256_set1_epi32( outputMinimum );
+    const __m256i vmax = _mm256_set1_epi32( outputMaximum );
+    const __m256i vrev = _mm256_setr_epi32( 7, 6, 5, 4, 3, 2, 1, 0 );
+
+    for( int i = 0; i < reducedLine; i++ )
+    {
+      __m256i veven[numVec], vodd[numVec];
+      for( int n = 0; n < numVec; n++ )
+      {
+        veven[n] = vrnd;
+        vodd [n] = _mm256_setzero_si256();
+      }
+      for( int k = 0; k < cutoff; k += 2 )
+      {
+        const __m256i vc0 = _mm256_set1_epi32( src[( k     ) * line + i] );
+        const __m256i vc1 = _mm256_set1_epi32( src[( k + 1 ) * line + i] );
+        const TMatrixCoeff* pT0 = iT + ( k     ) * trSize;
+        const TMatrixCoeff* pT1 = iT + ( k + 1 ) * trSize;
+        for( int n = 0; n < numVec; n++ )
+        {
+          const __m256i vt0 = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &pT0[n * 8] ) );
+          const __m256i vt1 = _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* ) &pT1[n * 8] ) );
+          veven[n] = _mm256_add_epi32( veven[n], _mm256_mullo_epi32( vc0, vt0 ) );
+          vodd [n] = _mm256_add_epi32( vodd [n], _mm256_mullo_epi32( vc1, vt1 ) );
+        }
+      }
+      TCoeff* pDst = dst + i * trSize;
+      for( int n = 0; n < numVec; n++ )
+      {
+        const __m256i vres = _mm256_srai_epi32( _mm256_add_epi32( veven[n], vodd[n] ), shift );
+        _mm256_storeu_si256( ( __m256i* ) &pDst[n * 8], _mm256_min_epi32( vmax, _mm256_max_epi32( vmin, vres ) ) );
+        if( useEvenOdd )
+        {
+          const __m256i vmir = _mm256_srai_epi32( _mm256_sub_epi32( veven[n], vodd[n] ), shift );
+          _mm256_storeu_si256( ( __m256i* ) &pDst[trSize - 8 - n * 8], _mm256_permutevar8x32_epi32( _mm256_min_epi32( vmax, _mm256_max_epi32( vmin, vmir ) ), vrev ) );
+        }
+      }
+    }
+  }
+  else
+#endif
+  {
+    static constexpr int numVec = numOut / 4;
+    const __m128i vrnd = _mm_set1_epi32( rnd_factor );
+    const __m128i vmin = _mm_set1_epi32( outputMinimum );
+    const __m128i vmax = _mm_set1_epi32( outputMaximum );
+
+    for( int i = 0; i < reducedLine; i++ )
+    {
+      __m128i veven[numVec], vodd[numVec];
+      for( int n = 0; n < numVec; n++ )
+      {
+        veven[n] = vrnd;
+        vodd [n] = _mm_setzero_si128();
+      }
+      for( int k = 0; k < cutoff; k += 2 )
+      {
+        const __m128i vc0 = _mm_set1_epi32( src[( k     ) * line + i] );
+        const __m128i vc1 = _mm_set1_epi32( src[( k + 1 ) * line + i] );
+        const TMatrixCoeff* pT0 = iT + ( k     ) * trSize;
+        const TMatrixCoeff* pT1 = iT + ( k + 1 ) * trSize;
+        for( int n = 0; n < numVec; n++ )
+        {
+          const __m128i vt0 = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &pT0[n * 4] ) );
+          const __m128i vt1 = _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* ) &pT1[n * 4] ) );
+          veven[n] = _mm_add_epi32( veven[n], _mm_mullo_epi32( vc0, vt0 ) );
+          vodd [n] = _mm_add_epi32( vodd [n], _mm_mullo_epi32( vc1, vt1 ) );
+        }
+      }
+      TCoeff* pDst = dst + i * trSize;
+      for( int n = 0; n < numVec; n++ )
+      {
+        const __m128i vres = _mm_srai_epi32( _mm_add_epi32( veven[n], vodd[n] ), shift );
+        _mm_storeu_si128( ( __m128i* ) &pDst[n * 4], _mm_min_epi32( vmax, _mm_max_epi32( vmin, vres ) ) );
+        if( useEvenOdd )
+        {
+          const __m128i vmir = _mm_srai_epi32( _mm_sub_epi32( veven[n], vodd[n] ), shift );
+          _mm_storeu_si128( ( __m128i* ) &pDst[trSize - 4 - n * 4], _mm_shuffle_epi32( _mm_min_epi32( vmax, _mm_max_epi32( vmin, vmir ) ), 0x1b ) );
+        }
+      }
+    }
+  }
+
+  if( iSkipLine )
+  {
+    memset( dst + reducedLine * trSize, 0, ( iSkipLine * trSize ) * sizeof( TCoeff ) );
+  }
+}
+
+#if JVET_N0193_LFNST
+// The LFNST kernels as 16-bit matrices for pmaddwd: the forward matrices in their original layout, one output per
+// row, and the inverse matrices with the rows 2k and 2k+1 interleaved, such that one 32-bit word holds the weights of
+// two consecutive input coefficients for one output.
+struct LfnstPackedMatrices
+{
+  int16_t fwd4x4[4][2][16][16];
+  int16_t fwd8x8[4][2][16][48];
+  int16_t inv4x4[4][2][8][16][2];
+  int16_t inv8x8[4][2][8][48][2];
+
+  LfnstPackedMatrices()
+  {
+    for( int mode = 0; mode < 4; mode++ )
+    {
+      for( int index = 0; index < 2; index++ )
+      {
+        for( int i = 0; i < 16; i++ )
+        {
+          for( int j = 0; j < 16; j++ )
+          {
+            fwd4x4[mode][index][i][j]            = g_lfnst4x4[mode][index][i][j];
+            inv4x4[mode][index][i >> 1][j][i & 1] = g_lfnst4x4[mode][index][i][j];
+          }
+          for( int j = 0; j < 48; j++ )
+          {
+            fwd8x8[mode][index][i][j]            = g_lfnst8x8[mode][index][i][j];
+            inv8x8[mode][index][i >> 1][j][i & 1] = g_lfnst8x8[mode][index][i][j];
+          }
+        }
+      }
+    }
+  }
+};
+
+static inline const LfnstPackedMatrices& getLfnstPackedMatrices()
+{
+  static const LfnstPackedMatrices packed;
+  return packed;
+}
+
+// the packed kernels take 16-bit input coefficients, other inputs are left to the scalar implementation
+static inline bool isInt16( const TCoeff* src, const int num )
+{
+  __m128i vMin = _mm_set1_epi32( std::numeric_limits<int16_t>::max() );
+  __m128i vMax = _mm_set1_epi32( std::numeric_limits<int16_t>::min() );
+  for( int i = 0; i < num; i += 4 )
+  {
+    const __m128i v = _mm_loadu_si128( ( const __m128i* ) &src[i] );
+    vMin = _mm_min_epi32( vMin, v );
+    vMax = _mm_max_epi32( vMax, v );
+  }
+  const __m128i vOut = _mm_or_si128( _mm_cmplt_epi32( vMin, _mm_set1_epi32( std::numeric_limits<int16_t>::min() ) ),
+                                     _mm_cmpgt_epi32( vMax, _mm_set1_epi32( std::numeric_limits<int16_t>::max() ) ) );
+  return _mm_testz_si128( vOut, vOut );
+}
+
+template<X86_VEXT vext>
+void fwdLfnstNxN_SIMD( const TCoeff* src, TCoeff* dst, const uint32_t mode, const uint32_t index, const uint32_t size, const int zeroOutSize )
+{
+  const int trSize = ( size > 4 ) ? 48 : 16;
+
+  if( !isInt16( src, trSize ) )
+  {
+    TrQuant::fwdLfnstNxNCore( src, dst, mode, index, size, zeroOutSize );
+    return;
+  }
+
+  const LfnstPackedMatrices& packed = getLfnstPackedMatrices();
+  const int16_t*             trMat  = ( size > 4 ) ? packed.fwd8x8[mode][index][0] : packed.fwd4x4[mode][index][0];
+  const __m128i              vRound = _mm_set1_epi32( 64 );
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    __m256i vSrc[3];
+    for( int k = 0; k < trSize / 16; k++ )
+    {
+      const __m256i s = _mm256_packs_epi32( _mm256_loadu_si256( ( const __m256i* ) &src[16 * k] ), _mm256_loadu_si256( ( const __m256i* ) &src[16 * k + 8] ) );
+      vSrc[k]         = _mm256_permute4x64_epi64( s, 0xd8 );
+    }
+
+    for( int j = 0; j < zeroOutSize; j += 8 )
+    {
+      __m256i acc[8];
+      for( int r = 0; r < 8; r++ )
+      {
+        const int16_t* row = trMat + ( j + r ) * trSize;
+        acc[r]             = _mm256_madd_epi16( vSrc[0], _mm256_loadu_si256( ( const __m256i* ) row ) );
+        for( int k = 1; k < trSize / 16; k++ )
+        {
+          acc[r] = _mm256_add_epi32( acc[r], _mm256_madd_epi16( vSrc[k], _mm256_loadu_si256( ( const __m256i* ) &row[16 * k] ) ) );
+        }
+      }
+      const __m256i sum03 = _mm256_hadd_epi32( _mm256_hadd_epi32( acc[0], acc[1] ), _mm256_hadd_epi32( acc[2], acc[3] ) );
+      const __m256i sum47 = _mm256_hadd_epi32( _mm256_hadd_epi32( acc[4], acc[5] ), _mm256_hadd_epi32( acc[6], acc[7] ) );
+      __m256i       sum   = _mm256_add_epi32( _mm256_permute2x128_si256( sum03, sum47, 0x20 ), _mm256_permute2x128_si256( sum03, sum47, 0x31 ) );
+      sum                 = _mm256_srai_epi32( _mm256_add_epi32( sum, _mm256_set1_epi32( 64 ) ), 7 );
+      _mm256_storeu_si256( ( __m256i* ) &dst[j], sum );
+    }
+  }
+  else
+#endif
+  {
+    __m128i vSrc[6];
+    for( int k = 0; k < trSize / 8; k++ )
+    {
+      vSrc[k] = _mm_packs_epi32( _mm_loadu_si128( ( const __m128i* ) &src[8 * k] ), _mm_loadu_si128( ( const __m128i* ) &src[8 * k + 4] ) );
+    }
+
+    for( int j = 0; j < zeroOutSize; j += 4 )
+    {
+      __m128i acc[4];
+      for( int r = 0; r < 4; r++ )
+      {
+        const int16_t* row = trMat + ( j + r ) * trSize;
+        acc[r]             = _mm_madd_epi16( vSrc[0], _mm_loadu_si128( ( const __m128i* ) row ) );
+        for( int k = 1; k < trSize / 8; k++ )
+        {
+          acc[r] = _mm_add_epi32( acc[r], _mm_madd_epi16( vSrc[k], _mm_loadu_si128( ( const __m128i* ) &row[8 * k] ) ) );
+        }
+      }
+      __m128i sum = _mm_hadd_epi32( _mm_hadd_epi32( acc[0], acc[1] ), _mm_hadd_epi32( acc[2], acc[3] ) );
+      sum         = _mm_srai_epi32( _mm_add_epi32( sum, vRound ), 7 );
+      _mm_storeu_si128( ( __m128i* ) &dst[j], sum );
+    }
+  }
+
+  ::memset( dst + zeroOutSize, 0, ( trSize - zeroOutSize ) * sizeof( TCoeff ) );
+}
+
+template<X86_VEXT vext>
+void invLfnstNxN_SIMD( const TCoeff* src, TCoeff* dst, const uint32_t mode, const uint32_t index, const uint32_t size, const int zeroOutSize )
+{
+  const int trSize = ( size > 4 ) ? 48 : 16;
+
+  if( !isInt16( src, zeroOutSize ) )
+  {
+    TrQuant::invLfnstNxNCore( src, dst, mode, index, size, zeroOutSize );
+    return;
+  }
+
+  const int                  maxLog2TrDynamicRange = 15;
+  const LfnstPackedMatrices& packed                = getLfnstPackedMatrices();
+  const int16_t*             trMat                 = ( size > 4 ) ? packed.inv8x8[mode][index][0][0] : packed.inv4x4[mode][index][0][0];
+
+  // pairs of input coefficients, matching the interleaved matrix rows
+  int32_t srcPairs[8];
+  for( int k = 0; k < zeroOutSize / 2; k++ )
+  {
+    srcPairs[k] = ( src[2 * k] & 0xffff ) | ( src[2 * k + 1] * ( 1 << 16 ) );
+  }
+
+#ifdef USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vMin   = _mm256_set1_epi32( -( 1 << maxLog2TrDynamicRange ) );
+    const __m256i vMax   = _mm256_set1_epi32( ( 1 << maxLog2TrDynamicRange ) - 1 );
+    const __m256i vRound = _mm256_set1_epi32( 64 );
+
+    for( int j = 0; j < trSize; j += 8 )
+    {
+      __m256i acc = _mm256_setzero_si256();
+      for( int k = 0; k < zeroOutSize / 2; k++ )
+      {
+        acc = _mm256_add_epi32( acc, _mm256_madd_epi16( _mm256_set1_epi32( srcPairs[k] ), _mm256_loadu_si256( ( const __m256i* ) &trMat[( k * trSize + j ) * 2] ) ) );
+      }
+      acc = _mm256_srai_epi32( _mm256_add_epi32( acc, vRound ), 7 );
+      _mm256_storeu_si256( ( __m256i* ) &dst[j], _mm256_min_epi32( _mm256_max_epi32( acc, vMin ), vMax ) );
+    }
+  }
+  else
+#endif
+  {
+    const __m128i vMin   = _mm_set1_epi32( -( 1 << maxLog2TrDynamicRange ) );
+    const __m128i vMax   = _mm_set1_epi32( ( 1 << maxLog2TrDynamicRange ) - 1 );
+    const __m128i vRound = _mm_set1_epi32( 64 );
+
+    for( int j = 0; j < trSize; j += 4 )
+    {
+      __m128i acc = _mm_setzero_si128();
+      for( int k = 0; k < zeroOutSize / 2; k++ )
+      {
+        acc = _mm_add_epi32( acc, _mm_madd_epi16( _mm_set1_epi32( srcPairs[k] ), _mm_loadu_si128( ( const __m128i* ) &trMat[( k * trSize + j ) * 2] ) ) );
+      }
+      acc = _mm_srai_epi32( _mm_add_epi32( acc, vRound ), 7 );
+      _mm_storeu_si128( ( __m128i* ) &dst[j], _mm_min_epi32( _mm_max_epi32( acc, vMin ), vMax ) );
+    }
+  }
+}
+#endif
+
+template<X86_VEXT vext>
+void TrQuant::_initTrQuantX86()
+{
+  m_fwdTrans[DCT2][1] = fastForwardTrafo_SIMD<vext, DCT2,  4>;
+  m_fwdTrans[DCT2][2] = fastForwardTrafo_SIMD<vext, DCT2,  8>;
+  m_fwdTrans[DCT2][3] = fastForwardTrafo_SIMD<vext, DCT2, 16>;
+  m_fwdTrans[DCT2][4] = fastForwardTrafo_SIMD<vext, DCT2, 32>;
+  m_fwdTrans[DCT2][5] = fastForwardTrafo_SIMD<vext, DCT2, 64>;
+  m_fwdTrans[DCT8][1] = fastForwardTrafo_SIMD<vext, DCT8,  4>;
+  m_fwdTrans[DCT8][2] = fastForwardTrafo_SIMD<vext, DCT8,  8>;
+  m_fwdTrans[DCT8][3] = fastForwardTrafo_SIMD<vext, DCT8, 16>;
+  m_fwdTrans[DCT8][4] = fastForwardTrafo_SIMD<vext, DCT8, 32>;
+  m_fwdTrans[DST7][1] = fastForwardTrafo_SIMD<vext, DST7,  4>;
+  m_fwdTrans[DST7][2] = fastForwardTrafo_SIMD<vext, DST7,  8>;
+  m_fwdTrans[DST7][3] = fastForwardTrafo_SIMD<vext, DST7, 16>;
+  m_fwdTrans[DST7][4] = fastForwardTrafo_SIMD<vext, DST7, 32>;
+
+  m_invTrans[DCT2][1] = fastInverseTrafo_SIMD<vext, DCT2,  4>;
+  m_invTrans[DCT2][2] = fastInverseTrafo_SIMD<vext, DCT2,  8>;
+  m_invTrans[DCT2][3] = fastInverseTrafo_SIMD<vext, DCT2, 16>;
+  m_invTrans[DCT2][4] = fastInverseTrafo_SIMD<vext, DCT2, 32>;
+  m_invTrans[DCT2][5] = fastInverseTrafo_SIMD<vext, DCT2, 64>;
+  m_invTrans[DCT8][1] = fastInverseTrafo_SIMD<vext, DCT8,  4>;
+  m_invTrans[DCT8][2] = fastInverseTrafo_SIMD<vext, DCT8,  8>;
+  m_invTrans[DCT8][3] = fastInverseTrafo_SIMD<vext, DCT8, 16>;
+  m_invTrans[DCT8][4] = fastInverseTrafo_SIMD<vext, DCT8, 32>;
+  m_invTrans[DST7][1] = fastInverseTrafo_SIMD<vext, DST7,  4>;
+  m_invTrans[DST7][2] = fastInverseTrafo_SIMD<vext, DST7,  8>;
+  m_invTrans[DST7][3] = fastInverseTrafo_SIMD<vext, DST7, 16>;
+  m_invTrans[DST7][4] = fastInverseTrafo_SIMD<vext, DST7, 32>;
+#if JVET_N0193_LFNST
+
+  m_fwdLfnst = fwdLfnstNxN_SIMD<vext>;
+  m_invLfnst = invLfnstNxN_SIMD<vext>;
+#endif
+}
+
+template void TrQuant::_initTrQuantX86<SIMDX86>();
+
+#endif // TARGET_SIMD_X86
+#endif
+//! \}
@@ -0,0 +1 @@
+#include "../QuantRDOQX86.h"
@@ -39,11 +39,31 @@
 
 #include <stdint.h>
 #include <vector>
+#include <fstream>
 #include "AnnexBread.h"
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
 #include "CommonLib/CodingStatistics.h"
 #endif
 
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#if defined( TARGET_SIMD_X86 ) && ( defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 ) )
+#include <emmintrin.h>
+#define ANNEXB_SCAN_SSE2 1
+#else
+#define ANNEXB_SCAN_SSE2 0
+#endif
+
 using namespace std;
 
 //! \ingroup DecoderLib
@@ -195,4 +215,264 @@ byteStreamNALUnit(
   stats.m_numBytesInNALUnit = uint32_t(nalUnit.size());
   return eof;
 }
+
+
+// ====================================================================================================================
+// MappedInputByteStream
+// ====================================================================================================================
+
+/**
+ * Returns the position of the first byte-aligned three-byte sequence
+ * 0x000000 or 0x000001 at or after pos, or size if there is none.
+ */
+static size_t findNALUnitEnd( const uint8_t* data, size_t pos, const size_t size )
+{
+#if ANNEXB_SCAN_SSE2
+  const __m128i vzero = _mm_setzero_si128();
+  const __m128i vmask = _mm_set1_epi8( ( char ) 0xfe );
+  while( pos + 18 <= size )
+  {
+    // candidate positions: two zero bytes followed by a byte <= 1
+    const __m128i v0 = _mm_loadu_si128( ( const __m128i* ) ( data + pos     ) );
+    const __m128i v1 = _mm_loadu_si128( ( const __m128i* ) ( data + pos + 1 ) );
+    const __m128i v2 = _mm_loadu_si128( ( const __m128i* ) ( data + pos + 2 ) );
+    const __m128i vc = _mm_and_si128( _mm_and_si128( _mm_cmpeq_epi8( v0, vzero ), _mm_cmpeq_epi8( v1, vzero ) ),
+                                      _mm_cmpeq_epi8( _mm_and_si128( v2, vmask ), vzero ) );
+    const int     cand = _mm_movemask_epi8( vc );
+    if( cand )
+    {
+      int idx = 0;
+      while( !( ( cand >> idx ) & 1 ) )
+      {
+        idx++;
+      }
+      return pos + idx;
+    }
+    pos += 16;
+  }
+#endif
+  for( ; pos + 3 <= size; pos++ )
+  {
+    if( data[pos + 2] <= 1 && data[pos + 1] == 0 && data[pos] == 0 )
+    {
+      return pos;
+    }
+  }
+  return size;
+}
+
+MappedInputByteStream::MappedInputByteStream()
+: m_data    ( nullptr )
+, m_size    ( 0 )
+, m_pos     ( 0 )
+, m_isOpen  ( false )
+, m_isMapped( false )
+#ifdef _WIN32
+, m_fileHandle( nullptr )
+, m_mapHandle ( nullptr )
+#endif
+{
+}
+
+bool MappedInputByteStream::open( const std::string& fileName )
+{
+  close();
+
+#ifdef _WIN32
+  HANDLE fileHandle = CreateFileA( fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+  if( fileHandle != INVALID_HANDLE_VALUE )
+  {
+    LARGE_INTEGER fileSize;
+    if( GetFileType( fileHandle ) == FILE_TYPE_DISK && GetFileSizeEx( fileHandle, &fileSize ) && fileSize.QuadPart > 0 )
+    {
+      HANDLE mapHandle = CreateFileMapping( fileHandle, NULL, PAGE_READONLY, 0, 0, NULL );
+      if( mapHandle )
+      {
+        const void* view = MapViewOfFile( mapHandle, FILE_MAP_READ, 0, 0, 0 );
+        if( view )
+        {
+          m_fileHandle = fileHandle;
+          m_mapHandle  = mapHandle;
+          m_data       = ( const uint8_t* ) view;
+          m_size       = size_t( fileSize.QuadPart );
+          m_isMapped   = true;
+          m_isOpen     = true;
+          return true;
+        }
+        CloseHandle( mapHandle );
+      }
+    }
+    CloseHandle( fileHandle );
+  }
+#else
+  const int fd = ::open( fileName.c_str(), O_RDONLY );
+  if( fd >= 0 )
+  {
+    struct stat fileStat;
+    if( fstat( fd, &fileStat ) == 0 && S_ISREG( fileStat.st_mode ) && fileStat.st_size > 0 )
+    {
+      void* view = mmap( nullptr, size_t( fileStat.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+      if( view != MAP_FAILED )
+      {
+        madvise( view, size_t( fileStat.st_size ), MADV_SEQUENTIAL );
+        ::close( fd );
+        m_data     = ( const uint8_t* ) view;
+        m_size     = size_t( fileStat.st_size );
+        m_isMapped = true;
+        m_isOpen   = true;
+        return true;
+      }
+    }
+    ::close( fd );
+  }
+#endif
+
+  // the file can not be mapped (empty file, pipe, ...), read it completely
+  std::ifstream file( fileName.c_str(), std::ifstream::in | std::ifstream::binary );
+  if( !file )
+  {
+    return false;
+  }
+  m_buffer.assign( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+  m_data   = m_buffer.empty() ? nullptr : &m_buffer[0];
+  m_size   = m_buffer.size();
+  m_isOpen = true;
+  return true;
+}
+
+void MappedInputByteStream::open( const uint8_t* data, size_t size )
+{
+  close();
+
+  m_data   = size ? data : nullptr;
+  m_size   = size;
+  m_isOpen = true;
+}
+
+void MappedInputByteStream::close()
+{
+  if( m_isMapped )
+  {
+#ifdef _WIN32
+    UnmapViewOfFile( m_data );
+    CloseHandle( ( HANDLE ) m_mapHandle );
+    CloseHandle( ( HANDLE ) m_fileHandle );
+    m_mapHandle  = nullptr;
+    m_fileHandle = nullptr;
+#else
+    munmap( ( void* ) m_data, m_size );
+#endif
+  }
+  m_buffer.clear();
+  m_data     = nullptr;
+  m_size     = 0;
+  m_pos      = 0;
+  m_isOpen   = false;
+  m_isMapped = false;
+}
+
+bool MappedInputByteStream::xIsStartCode( size_t pos ) const
+{
+  if( pos + 3 <= m_size && m_data[pos] == 0 && m_data[pos + 1] == 0 )
+  {
+    if( m_data[pos + 2] == 1 )
+    {
+      return true;
+    }
+    return pos + 4 <= m_size && m_data[pos + 2] == 0 && m_data[pos + 3] == 1;
+  }
+  return false;
+}
+
+bool MappedInputByteStream::readNALUnit( const uint8_t*& nalUnit, size_t& nalUnitSize, AnnexBStats& stats )
+{
+  nalUnit     = nullptr;
+  nalUnitSize = 0;
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  CodingStatistics::SStat &statBits=CodingStatistics::GetStatisticEP(STATS__NAL_UNIT_PACKING);
+#endif
+
+  /* leading_zero_8bits up to the four-byte sequence 0x00000001 or the
+   * three-byte sequence 0x000001 */
+  while( !xIsStartCode( m_pos ) )
+  {
+    if( eof() )
+    {
+      return true;
+    }
+    const uint8_t leading_zero_8bits = m_data[m_pos++];
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    statBits.bits+=8; statBits.count++;
+#endif
+    if( leading_zero_8bits != 0 ) { THROW( "Leading zero bits not zero" ); }
+    stats.m_numLeadingZero8BitsBytes++;
+  }
+
+  /* zero_byte and start_code_prefix_one_3bytes */
+  if( m_data[m_pos + 2] != 1 )
+  {
+    m_pos++;
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    statBits.bits+=8; statBits.count++;
+#endif
+    stats.m_numZeroByteBytes++;
+  }
+  m_pos += 3;
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  statBits.bits+=24; statBits.count+=3;
+#endif
+  stats.m_numStartCodePrefixBytes += 3;
+
+  /* the NAL unit ends before the next byte-aligned 0x000000 or 0x000001,
+   * or at the end of the byte stream */
+  const size_t nalUnitEnd = findNALUnitEnd( m_data, m_pos, m_size );
+  nalUnit     = m_data + m_pos;
+  nalUnitSize = nalUnitEnd - m_pos;
+  m_pos       = nalUnitEnd;
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+  CodingStatistics::SStat &bodyStats=CodingStatistics::GetStatisticEP(STATS__NAL_UNIT_TOTAL_BODY);
+  bodyStats.bits+=8*int64_t(nalUnitSize); bodyStats.count+=int64_t(nalUnitSize);
+#endif
+
+  /* trailing_zero_8bits up to the next start code or the end of the byte stream */
+  while( !eof() && !xIsStartCode( m_pos ) )
+  {
+    const uint8_t trailing_zero_8bits = m_data[m_pos++];
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    statBits.bits+=8; statBits.count++;
+#endif
+    CHECK( trailing_zero_8bits != 0, "Trailing zero bits not '0'" );
+    stats.m_numTrailingZero8BitsBytes++;
+  }
+  return eof();
+}
+
+/**
+ * Extract a single nalUnit from the mapped byte stream bs while
+ * accumulating bytestream statistics into stats.
+ *
+ * Returns true if EOF was reached (NB, nalunit data may be valid),
+ *         otherwise false.
+ */
+bool
+byteStreamNALUnit(
+  MappedInputByteStream& bs,
+  vector<uint8_t>& nalUnit,
+  AnnexBStats& stats)
+{
+  bool           eof         = false;
+  const uint8_t* nalData     = nullptr;
+  size_t         nalDataSize = 0;
+  try
+  {
+    eof = bs.readNALUnit(nalData, nalDataSize, stats);
+  }
+  catch (...)
+  {
+    eof = true;
+  }
+  nalUnit.assign(nalData, nalData + nalDataSize);
+  stats.m_numBytesInNALUnit = uint32_t(nalUnit.size());
+  return eof;
+}
 //! \}
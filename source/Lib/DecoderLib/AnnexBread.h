@@ -43,6 +43,7 @@
 
 #include <stdint.h>
 #include <istream>
+#include <string>
 #include <vector>
 
 #include "CommonLib/CommonDef.h"
@@ -192,7 +193,69 @@ struct AnnexBStats
   }
 };
 
+/**
+ * Byte stream source that maps the whole bitstream file into memory.
+ *
+ * The NAL units are located with a vectorized scan for the next start
+ * code and handed out as spans into the mapped file, the bytes are not
+ * pulled one by one through a std::istream. Files that can not be mapped
+ * (e.g. pipes) are read into memory completely instead.
+ */
+class MappedInputByteStream
+{
+public:
+  MappedInputByteStream();
+  ~MappedInputByteStream() { close(); }
+
+  /**
+   * Map the file, returns false if it can not be opened.
+   */
+  bool open( const std::string& fileName );
+  /**
+   * Read from a byte stream in memory, the data is not copied and has to
+   * stay valid until the stream is closed.
+   */
+  void open( const uint8_t* data, size_t size );
+  void close();
+
+  bool     isOpen       () const { return m_isOpen; }
+  /**
+   * returns true if all bytes of the stream have been consumed.
+   */
+  bool     eof          () const { return m_pos >= m_size; }
+  size_t   getPosition  () const { return m_pos; }
+  /**
+   * Move the read position, e.g. back to the start of a NAL unit that
+   * has to be decoded again.
+   */
+  void     setPosition  ( size_t pos ) { CHECK( pos > m_size, "Position beyond the end of the byte stream" ); m_pos = pos; }
+
+  /**
+   * Extract the next NAL unit as a span [nalUnit, nalUnit + nalUnitSize)
+   * into the mapped file, the stream is advanced behind the trailing zero
+   * bytes. Follows the same rules as byteStreamNALUnit() for InputByteStream.
+   *
+   * Returns true if the end of the byte stream was reached.
+   */
+  bool     readNALUnit  ( const uint8_t*& nalUnit, size_t& nalUnitSize, AnnexBStats& stats );
+
+private:
+  bool     xIsStartCode ( size_t pos ) const;
+
+  const uint8_t*       m_data;        /* first byte of the stream */
+  size_t               m_size;        /* number of bytes in the stream */
+  size_t               m_pos;         /* read position */
+  bool                 m_isOpen;      /* an empty file has no data, but is open */
+  bool                 m_isMapped;    /* m_data points to a file mapping, otherwise to m_buffer or external memory */
+  std::vector<uint8_t> m_buffer;      /* file content, if the file could not be mapped */
+#ifdef _WIN32
+  void*                m_fileHandle;
+  void*                m_mapHandle;
+#endif
+};
+
 bool byteStreamNALUnit(InputByteStream& bs, std::vector<uint8_t>& nalUnit, AnnexBStats& stats);
+bool byteStreamNALUnit(MappedInputByteStream& bs, std::vector<uint8_t>& nalUnit, AnnexBStats& stats);
 
 //! \}
 
@@ -38,11 +38,6 @@
 
 #include "BinDecoder.h"
 #include "CommonLib/Rom.h"
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-#include "CommonLib/CodingStatistics.h"
-#endif
-
-#include "CommonLib/dtrace_next.h"
 
 #define CNT_OFFSET 0
 
@@ -55,6 +50,7 @@ BinDecoderBase::BinDecoderBase( const BinProbModel* dummy )
   , m_Range     ( 0 )
   , m_Value     ( 0 )
   , m_bitsNeeded( 0 )
+  , m_numPadBytes( 0 )
 {}
 
 
@@ -77,13 +73,17 @@ void BinDecoderBase::start()
   CodingStatistics::UpdateCABACStat(STATS__CABAC_INITIALISATION, 512, 510, 0);
 #endif
   m_Range       = 510;
-  m_Value       = ( m_Bitstream->readByte() << 8 ) + m_Bitstream->readByte();
-  m_bitsNeeded  = -8;
+  m_Value       = 0;
+  m_numPadBytes = 0;
+  // the first word fills the 9 bit offset, the remaining 23 bits are read ahead
+  m_bitsNeeded  = 9 - 1;
+  xReadWord();
 }
 
 
 void BinDecoderBase::finish()
 {
+  // the bytes read ahead were returned by the terminating bin
   unsigned lastByte;
   m_Bitstream->peekPreviousByte( lastByte );
   CHECK( ( ( lastByte << ( 8 + m_bitsNeeded ) ) & 0xff ) != 0x80,
@@ -103,12 +103,11 @@ unsigned BinDecoderBase::decodeBinEP()
   m_Value            += m_Value;
   if( ++m_bitsNeeded >= 0 )
   {
-    m_Value          += m_Bitstream->readByte();
-    m_bitsNeeded      = -8;
+    xReadWord();
   }
 
   unsigned bin = 0;
-  unsigned SR  = m_Range << 7;
+  uint64_t SR  = uint64_t( m_Range ) << VALUE_SHIFT;
   if( m_Value >= SR )
   {
     m_Value   -= SR;
@@ -136,8 +135,13 @@ unsigned BinDecoderBase::decodeBinsEP( unsigned numBins )
   unsigned bins    = 0;
   while(   remBins > 8 )
   {
-    m_Value     = ( m_Value << 8 ) + ( m_Bitstream->readByte() << ( 8 + m_bitsNeeded ) );
-    unsigned SR =   m_Range << 15;
+    m_Value     <<= 8;
+    m_bitsNeeded += 8;
+    if( m_bitsNeeded >= 0 )
+    {
+      xReadWord();
+    }
+    uint64_t SR = uint64_t( m_Range ) << ( VALUE_SHIFT + 8 );
     for( int i = 0; i < 8; i++ )
     {
       bins += bins;
@@ -154,10 +158,9 @@ unsigned BinDecoderBase::decodeBinsEP( unsigned numBins )
   m_Value       <<= remBins;
   if( m_bitsNeeded >= 0 )
   {
-    m_Value      += m_Bitstream->readByte() << m_bitsNeeded;
-    m_bitsNeeded -= 8;
+    xReadWord();
   }
-  unsigned SR = m_Range << ( remBins + 7 );
+  uint64_t SR = uint64_t( m_Range ) << ( remBins + VALUE_SHIFT );
   for ( int i = 0; i < remBins; i++ )
   {
     bins += bins;
@@ -228,9 +231,11 @@ unsigned BinDecoderBase::decodeRemAbsEP( unsigned goRicePar, bool useLimitedPref
 unsigned BinDecoderBase::decodeBinTrm()
 {
   m_Range    -= 2;
-  unsigned SR = m_Range << 7;
+  uint64_t SR = uint64_t( m_Range ) << VALUE_SHIFT;
   if( m_Value >= SR )
   {
+    // the arithmetic decoding ends, the bitstream continues behind the byte with the last bit of the offset
+    xReturnReadAhead();
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     CodingStatistics::UpdateCABACStat     ( STATS__CABAC_TRM_BITS,       m_Range+2, 2, 1 );
     CodingStatistics::IncrementStatisticEP( STATS__BYTE_ALIGNMENT_BITS, -m_bitsNeeded, 0 );
@@ -246,10 +251,9 @@ unsigned BinDecoderBase::decodeBinTrm()
     {
       m_Range += m_Range;
       m_Value += m_Value;
-      if( ++m_bitsNeeded == 0 )
+      if( ++m_bitsNeeded >= 0 )
       {
-        m_Value      += m_Bitstream->readByte();
-        m_bitsNeeded  = -8;
+        xReadWord();
       }
     }
     return 0;
@@ -290,21 +294,20 @@ unsigned BinDecoderBase::decodeAlignedBinsEP( unsigned numBins )
     //   > The comparison against the symbol range of 128 is simply a test on the next-most-significant bit
     //   > "Subtracting" the symbol range if the decoded bin is 1 simply involves clearing that bit.
     //  As a result, the required bins are simply the <binsToRead> next-most-significant bits of m_Value
-    //  (m_Value is stored MSB-aligned in a 16-bit buffer - hence the shift of 15)
+    //  (the offset starts at bit VALUE_SHIFT of m_Value, its MSB is bit VALUE_SHIFT + 8)
     //
-    //    m_Value = |0|V|V|V|V|V|V|V|V|B|B|B|B|B|B|B|        (V = usable bit, B = potential buffered bit (buffer refills when m_bitsNeeded >= 0))
+    //    m_Value = |0|V|V|V|V|V|V|V|V|B|B|...|B|        (V = usable bit, B = potential buffered bit (buffer refills when m_bitsNeeded >= 0))
     //
-    unsigned binsToRead = std::min<unsigned>( remBins, 8 ); //read bytes if able to take advantage of the system's byte-read function
+    unsigned binsToRead = std::min<unsigned>( remBins, 8 );
     unsigned binMask    = ( 1 << binsToRead ) - 1;
-    unsigned newBins    = ( m_Value >> (15 - binsToRead) ) & binMask;
+    unsigned newBins    = unsigned( m_Value >> ( VALUE_SHIFT + 8 - binsToRead ) ) & binMask;
     bins                = ( bins    << binsToRead) | newBins;
-    m_Value             = ( m_Value << binsToRead) & 0x7FFF;
+    m_Value             = ( m_Value << binsToRead) & ( ( uint64_t( 1 ) << ( VALUE_SHIFT + 8 ) ) - 1 );
     remBins            -= binsToRead;
     m_bitsNeeded       += binsToRead;
     if( m_bitsNeeded >= 0 )
     {
-      m_Value          |= m_Bitstream->readByte() << m_bitsNeeded;
-      m_bitsNeeded     -= 8;
+      xReadWord();
     }
   }
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
@@ -322,69 +325,33 @@ unsigned BinDecoderBase::decodeAlignedBinsEP( unsigned numBins )
 
 
 
-template <class BinProbModel>
-TBinDecoder<BinProbModel>::TBinDecoder()
-  : BinDecoderBase( static_cast<const BinProbModel*>    ( nullptr ) )
-  , m_Ctx         ( static_cast<CtxStore<BinProbModel>&>( *this   ) )
-{}
-
-
-template <class BinProbModel>
-unsigned TBinDecoder<BinProbModel>::decodeBin( unsigned ctxId )
+void BinDecoderBase::xReturnReadAhead()
 {
-  BinProbModel& rcProbModel = m_Ctx[ctxId];
-  unsigned      bin         = rcProbModel.mps();
-  uint32_t      LPS         = rcProbModel.getLPS( m_Range );
-
-  DTRACE( g_trace_ctx, D_CABAC, "%d" " %d " "%d" "  " "[%d:%d]" "  " "%2d(MPS=%d)"  "  " , DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), ctxId, m_Range, m_Range-LPS, LPS, ( unsigned int )( rcProbModel.state() ), m_Value < ( ( m_Range - LPS ) << 7 ) );
-  //DTRACE( g_trace_ctx, D_CABAC, " %d " "%d" "  " "[%d:%d]" "  " "%2d(MPS=%d)"  "  ", DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), m_Range, m_Range - LPS, LPS, (unsigned int)( rcProbModel.state() ), m_Value < ( ( m_Range - LPS ) << 7 ) );
-
-  m_Range   -=  LPS;
-  uint32_t      SR          = m_Range << 7;
-  if( m_Value < SR )
-  {
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    CodingStatistics::UpdateCABACStat( *ptype, m_Range+LPS, m_Range, int( bin ) );
-#endif
-    // MPS path
-    if( m_Range < 256 )
-    {
-      int numBits   = rcProbModel.getRenormBitsRange( m_Range );
-      m_Range     <<= numBits;
-      m_Value     <<= numBits;
-      m_bitsNeeded += numBits;
-      if( m_bitsNeeded >= 0 )
-      {
-        m_Value      += m_Bitstream->readByte() << m_bitsNeeded;
-        m_bitsNeeded -= 8;
-      }
-    }
-  }
-  else
+  // keep less than a byte read ahead, as if the bitstream was read byte by byte
+  const int numBitsReadAhead = -m_bitsNeeded - 1;
+  const int numBytes         = numBitsReadAhead >> 3;
+  if( numBytes == 0 )
   {
-    bin = 1 - bin;
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    CodingStatistics::UpdateCABACStat( *ptype, m_Range+LPS, LPS, int( bin ) );
-#endif
-    // LPS path
-    int numBits   = rcProbModel.getRenormBitsLPS( LPS );
-    m_Value      -= SR;
-    m_Value       = m_Value << numBits;
-    m_Range       = LPS     << numBits;
-    m_bitsNeeded += numBits;
-    if( m_bitsNeeded >= 0 )
-    {
-      m_Value      += m_Bitstream->readByte() << m_bitsNeeded;
-      m_bitsNeeded -= 8;
-    }
+    return;
   }
-  rcProbModel.update( bin );
-  //DTRACE_DECR_COUNTER( g_trace_ctx, D_CABAC );
-  DTRACE_WITHOUT_COUNT( g_trace_ctx, D_CABAC, "  -  " "%d" "\n", bin );
-  return  bin;
+  m_Value      &= ~( ( uint64_t( 1 ) << ( VALUE_SHIFT - ( numBitsReadAhead & 7 ) ) ) - 1 );
+  m_bitsNeeded += 8 * numBytes;
+
+  const unsigned numPadBytes = std::min<unsigned>( numBytes, m_numPadBytes );
+  CHECK( numPadBytes < m_numPadBytes, "CABAC stream ended before the terminating bin" );
+  m_numPadBytes = 0;
+  m_Bitstream->unreadBytes( numBytes - numPadBytes );
 }
 
 
 
+
+template <class BinProbModel>
+TBinDecoder<BinProbModel>::TBinDecoder()
+  : BinDecoderBase( static_cast<const BinProbModel*>    ( nullptr ) )
+  , m_Ctx         ( static_cast<CtxStore<BinProbModel>&>( *this   ) )
+{}
+
+
 template class TBinDecoder<BinProbModel_Std>;
 
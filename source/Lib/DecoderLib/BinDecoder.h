@@ -40,10 +40,11 @@
 
 #include "CommonLib/Contexts.h"
 #include "CommonLib/BitStream.h"
+#include "CommonLib/dtrace_next.h"
 
 
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-class CodingStatisticsClassType;
+#include "CommonLib/CodingStatistics.h"
 #endif
 
 
@@ -65,9 +66,6 @@ public:
   void      set     ( const CodingStatisticsClassType& type) { ptype = &type; }
 #endif
 
-public:
-  virtual unsigned  decodeBin           ( unsigned ctxId    ) = 0;
-
 public:
   unsigned          decodeBinEP         ();
   unsigned          decodeBinsEP        ( unsigned numBins  );
@@ -75,14 +73,28 @@ public:
   unsigned          decodeBinTrm        ();
   unsigned          decodeBinsPCM       ( unsigned numBins  );
   void              align               ();
-  unsigned          getNumBitsRead      () { return m_Bitstream->getNumBitsRead() + m_bitsNeeded; }
+  unsigned          getNumBitsRead      () { return m_Bitstream->getNumBitsRead() + 8 * m_numPadBytes + m_bitsNeeded; }
 private:
   unsigned          decodeAlignedBinsEP ( unsigned numBins  );
+  void              xReturnReadAhead    ();
 protected:
+  /// appends the next 32 bits of the bitstream below the bits held in m_Value
+  void              xReadWord           ()
+  {
+    uint32_t word;
+    m_numPadBytes += m_Bitstream->readWordPadded( word );
+    m_Value       += uint64_t( word ) << m_bitsNeeded;
+    m_bitsNeeded  -= 32;
+  }
+
+  /// the 9 bit offset compared against m_Range starts at this bit of m_Value, the bits below are read ahead
+  static const int  VALUE_SHIFT = 31;
+
   InputBitstream*   m_Bitstream;
   uint32_t          m_Range;
-  uint32_t          m_Value;
-  int32_t           m_bitsNeeded;
+  uint64_t          m_Value;
+  int32_t           m_bitsNeeded;         ///< negated number of bits read ahead minus one, the next word is read when it gets non-negative
+  uint32_t          m_numPadBytes;        ///< zero bytes read beyond the end of the bitstream
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   const CodingStatisticsClassType* ptype;
 #endif
@@ -103,6 +115,59 @@ private:
 
 
 
+template <class BinProbModel>
+inline unsigned TBinDecoder<BinProbModel>::decodeBin( unsigned ctxId )
+{
+  BinProbModel& rcProbModel = m_Ctx[ctxId];
+  unsigned      bin         = rcProbModel.mps();
+  uint32_t      LPS         = rcProbModel.getLPS( m_Range );
+
+  DTRACE( g_trace_ctx, D_CABAC, "%d" " %d " "%d" "  " "[%d:%d]" "  " "%2d(MPS=%d)"  "  " , DTRACE_GET_COUNTER( g_trace_ctx, D_CABAC ), ctxId, m_Range, m_Range-LPS, LPS, ( unsigned int )( rcProbModel.state() ), m_Value < ( uint64_t( m_Range - LPS ) << VALUE_SHIFT ) );
+
+  m_Range   -=  LPS;
+  uint64_t      SR          = uint64_t( m_Range ) << VALUE_SHIFT;
+  if( m_Value < SR )
+  {
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    CodingStatistics::UpdateCABACStat( *ptype, m_Range+LPS, m_Range, int( bin ) );
+#endif
+    // MPS path
+    if( m_Range < 256 )
+    {
+      int numBits   = rcProbModel.getRenormBitsRange( m_Range );
+      m_Range     <<= numBits;
+      m_Value     <<= numBits;
+      m_bitsNeeded += numBits;
+      if( m_bitsNeeded >= 0 )
+      {
+        xReadWord();
+      }
+    }
+  }
+  else
+  {
+    bin = 1 - bin;
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    CodingStatistics::UpdateCABACStat( *ptype, m_Range+LPS, LPS, int( bin ) );
+#endif
+    // LPS path
+    int numBits   = rcProbModel.getRenormBitsLPS( LPS );
+    m_Value      -= SR;
+    m_Value       = m_Value << numBits;
+    m_Range       = LPS     << numBits;
+    m_bitsNeeded += numBits;
+    if( m_bitsNeeded >= 0 )
+    {
+      xReadWord();
+    }
+  }
+  rcProbModel.update( bin );
+  DTRACE_WITHOUT_COUNT( g_trace_ctx, D_CABAC, "  -  " "%d" "\n", bin );
+  return  bin;
+}
+
+
+
 typedef TBinDecoder<BinProbModel_Std>   BinDecoder_Std;
 
 
@@ -48,7 +48,7 @@
 class CABACReader
 {
 public:
-  CABACReader(BinDecoderBase& binDecoder) : shareStateDec(0), m_BinDecoder(binDecoder), m_Bitstream(0) {}
+  CABACReader(BinDecoder_Std& binDecoder) : shareStateDec(0), m_BinDecoder(binDecoder), m_Bitstream(0) {}
   virtual ~CABACReader() {}
 
 public:
@@ -171,7 +171,7 @@ public:
   Position    shareParentPos;
   Size        shareParentSize;
 private:
-  BinDecoderBase& m_BinDecoder;
+  BinDecoder_Std& m_BinDecoder;
   InputBitstream* m_Bitstream;
 };
 
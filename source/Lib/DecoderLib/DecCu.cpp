@@ -62,7 +62,8 @@
 
 DecCu::DecCu()
 {
-  m_tmpStorageLCU = NULL;
+  m_tmpStorageLCU  = NULL;
+  m_waitForRefPics = false;
 }
 
 DecCu::~DecCu()
@@ -101,6 +102,16 @@ void DecCu::destoryDecCuReshaprBuf()
 
 void DecCu::decompressCtu( CodingStructure& cs, const UnitArea& ctuArea )
 {
+  if( m_waitForRefPics && cs.slice->getEnableTMVPFlag() && !cs.slice->isIntra() )
+  {
+    // the temporal motion candidates are restricted to the same CTU row of the collocated picture
+    const Slice&   slice  = *cs.slice;
+    const Picture* colPic = slice.getRefPic( RefPicList( slice.isInterB() ? 1 - slice.getColFromL0Flag() : 0 ), slice.getColRefIdx() );
+    if( colPic && !colPic->motionProgress.wait( ( ctuArea.lumaPos().y >> cs.pcv->maxCUHeightLog2 ) + 1 ) )
+    {
+      THROW( "In-loop filtering of the collocated picture failed" );
+    }
+  }
 
   const int maxNumChannelType = cs.pcv->chrFormat != CHROMA_400 && CS::isDualITree( cs ) ? 2 : 1;
   if (!cs.pcv->isEncoder)
@@ -122,10 +133,11 @@ void DecCu::decompressCtu( CodingStructure& cs, const UnitArea& ctuArea )
         if ((currCU.shareParentPos.x >= 0) && (!(currCU.shareParentPos.x == prevTmpPos.x && currCU.shareParentPos.y == prevTmpPos.y)))
         {
           m_shareStateDec = GEN_ON_SHARED_BOUND;
+          LutMotionCand& motionLut = cs.getMotionLut( ctuArea.lumaPos() );
 #if !JVET_N0266_SMALL_BLOCKS
-          cs.motionLut.lutShare = cs.motionLut.lut;
+          motionLut.lutShare = motionLut.lut;
 #endif
-          cs.motionLut.lutShareIbc = cs.motionLut.lutIbc;
+          motionLut.lutShareIbc = motionLut.lutIbc;
         }
 
         if (currCU.shareParentPos.x < 0)
@@ -138,6 +150,13 @@ void DecCu::decompressCtu( CodingStructure& cs, const UnitArea& ctuArea )
       {
         xDeriveCUMV(currCU);
       }
+      if( m_waitForRefPics && currCU.predMode == MODE_INTER )
+      {
+        for( auto &pu : CU::traversePUs( currCU ) )
+        {
+          xWaitForRefPics( pu );
+        }
+      }
       switch( currCU.predMode )
       {
       case MODE_INTER:
@@ -490,7 +509,8 @@ void DecCu::xReconInter(CodingUnit &cu)
     {
       MotionInfo mi = pu.getMotionInfo();
       mi.GBiIdx = (mi.interDir == 3) ? cu.GBiIdx : GBI_DEFAULT;
-      cu.cs->addMiToLut(CU::isIBC(cu) ? cu.cs->motionLut.lutIbc : cu.cs->motionLut.lut, mi );
+      LutMotionCand& motionLut = cu.cs->getMotionLut( cu.lumaPos() );
+      cu.cs->addMiToLut(CU::isIBC(cu) ? motionLut.lutIbc : motionLut.lut, mi );
     }
   }
 
@@ -670,6 +690,75 @@ void DecCu::xDecodeInterTexture(CodingUnit &cu)
   }
 }
 
+void DecCu::xWaitForRefPics( const PredictionUnit& pu )
+{
+  // margin for the interpolation filter taps, the DMVR search range and the BDOF padding
+  static const int refMargin = 8;
+
+  const Slice&         slice = *pu.cs->slice;
+  const PreCalcValues& pcv   = *pu.cs->pcv;
+  const Area&          area  = pu.Y();
+  const CMotionBuf     mb    = pu.getMotionBuf();
+
+  for( int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+  {
+    const RefPicList refList = RefPicList( l );
+    int minMv[MAX_NUM_REF][2];
+    int maxMv[MAX_NUM_REF][2];
+    bool used[MAX_NUM_REF] = { false };
+
+    // affine, SbTMVP and triangle PUs carry different motion per sub-block
+    for( int y = 0; y < mb.height; y++ )
+    {
+      for( int x = 0; x < mb.width; x++ )
+      {
+        const MotionInfo& mi = mb.at( x, y );
+        if( !( mi.interDir & ( 1 << l ) ) )
+        {
+          continue;
+        }
+        const int refIdx = mi.refIdx[l];
+        if( !used[refIdx] )
+        {
+          used[refIdx]     = true;
+          minMv[refIdx][0] = maxMv[refIdx][0] = mi.mv[l].hor;
+          minMv[refIdx][1] = maxMv[refIdx][1] = mi.mv[l].ver;
+        }
+        minMv[refIdx][0] = std::min( minMv[refIdx][0], mi.mv[l].hor );
+        minMv[refIdx][1] = std::min( minMv[refIdx][1], mi.mv[l].ver );
+        maxMv[refIdx][0] = std::max( maxMv[refIdx][0], mi.mv[l].hor );
+        maxMv[refIdx][1] = std::max( maxMv[refIdx][1], mi.mv[l].ver );
+      }
+    }
+
+    for( int refIdx = 0; refIdx < slice.getNumRefIdx( refList ); refIdx++ )
+    {
+      if( !used[refIdx] )
+      {
+        continue;
+      }
+      const Picture* refPic = slice.getRefPic( refList, refIdx );
+
+      const int left   = area.x                 + ( minMv[refIdx][0] >> MV_FRACTIONAL_BITS_INTERNAL ) - refMargin;
+      const int top    = area.y                 + ( minMv[refIdx][1] >> MV_FRACTIONAL_BITS_INTERNAL ) - refMargin;
+      const int right  = area.x + area.width  + ( maxMv[refIdx][0] >> MV_FRACTIONAL_BITS_INTERNAL ) + refMargin;
+      const int bottom = area.y + area.height + ( maxMv[refIdx][1] >> MV_FRACTIONAL_BITS_INTERNAL ) + refMargin;
+
+      // blocks reaching into the picture margin also need the border extension, the wrap around buffer is filled with it
+      int ctuRows = pcv.heightInCtus + 1;
+      if( left >= 0 && top >= 0 && right <= (int) pcv.lumaWidth && bottom <= (int) pcv.lumaHeight && !slice.getSPS()->getWrapAroundEnabledFlag() )
+      {
+        ctuRows = ( ( bottom - 1 ) >> pcv.maxCUHeightLog2 ) + 1;
+      }
+
+      if( !refPic->filterProgress.wait( ctuRows ) )
+      {
+        THROW( "In-loop filtering of the reference picture failed" );
+      }
+    }
+  }
+}
+
 void DecCu::xDeriveCUMV( CodingUnit &cu )
 {
   for( auto &pu : CU::traversePUs( cu ) )
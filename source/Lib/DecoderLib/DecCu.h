@@ -74,6 +74,8 @@ public:
   void destoryDecCuReshaprBuf();
 
   void setShareStateDec (int shareStateDecIn)  { m_shareStateDec = shareStateDecIn; }
+  /// wait for the in-loop filtering of the reference pictures before the motion compensation
+  void setWaitForRefPics( bool b )             { m_waitForRefPics = b; }
 #if ENABLE_SPLIT_PARALLELISM
   int  getShareStateDec () const { return m_shareStateDec; }
 #endif
@@ -92,6 +94,7 @@ protected:
   void xDecodeInterTU     ( TransformUnit&   tu, const ComponentID compID );
 
   void xDeriveCUMV        ( CodingUnit&      cu );
+  void xWaitForRefPics    ( const PredictionUnit& pu );
   PelStorage        *m_tmpStorageLCU;
 private:
   TrQuant*          m_pcTrQuant;
@@ -99,6 +102,7 @@ private:
   InterPrediction*  m_pcInterPred;
 
   int               m_shareStateDec;
+  bool              m_waitForRefPics;
 
   MotionInfo        m_SubPuMiBuf[(MAX_CU_SIZE * MAX_CU_SIZE) >> (MIN_CU_LOG2 << 1)];
 
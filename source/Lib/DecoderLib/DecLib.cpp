@@ -389,16 +389,23 @@ DecLib::DecLib()
   , m_parameterSetManager()
   , m_apcSlicePilot(NULL)
   , m_SEIs()
-  , m_cIntraPred()
-  , m_cInterPred()
-  , m_cTrQuant()
+  , m_numDecThreads( 1 )
+  , m_threadPool( nullptr )
+  , m_loopFilterPipelineDepth( 0 )
+  , m_loopFilterThread( nullptr )
+  , m_loopFilterRowThreads( nullptr )
+  , m_cIntraPred( nullptr )
+  , m_cInterPred( nullptr )
+  , m_cTrQuant( nullptr )
   , m_cSliceDecoder()
-  , m_cCuDecoder()
+  , m_cCuDecoder( nullptr )
   , m_HLSReader()
+  , m_CABACDecoder( nullptr )
   , m_seiReader()
   , m_cLoopFilter()
   , m_cSAO()
   , m_cReshaper()
+  , m_cRdCost( nullptr )
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   , m_cacheModel()
 #endif
@@ -424,6 +431,9 @@ DecLib::DecLib()
 #if ENABLE_SIMD_OPT_BUFFER
   g_pelBufOP.initPelBufOpsX86();
 #endif
+#if ENABLE_SIMD_OPT_BITSTREAM
+  g_bitstreamOps.initBitstreamOpsX86();
+#endif
 }
 
 DecLib::~DecLib()
@@ -439,6 +449,44 @@ void DecLib::create()
 {
   m_apcSlicePilot = new Slice;
   m_uiSliceSegmentIdx = 0;
+
+  CHECK( m_numDecThreads < 1, "Invalid number of decoding threads" );
+
+  m_cIntraPred   = new IntraPrediction[m_numDecThreads];
+  m_cInterPred   = new InterPrediction[m_numDecThreads];
+  m_cTrQuant     = new TrQuant        [m_numDecThreads];
+  m_cCuDecoder   = new DecCu          [m_numDecThreads];
+  m_CABACDecoder = new CABACDecoder   [m_numDecThreads];
+  m_cRdCost      = new RdCost         [m_numDecThreads];
+
+  if( m_numDecThreads > 1 )
+  {
+    m_threadPool = new ThreadPool;
+    m_threadPool->create( m_numDecThreads );
+  }
+
+#if ENABLE_TRACING
+  // the trace output relies on the processing order
+  m_loopFilterPipelineDepth = 0;
+#endif
+  CHECK( m_loopFilterPipelineDepth < 0, "Invalid loop filter pipeline depth" );
+  if( m_loopFilterPipelineDepth > 0 )
+  {
+    m_loopFilterThread = new ThreadPool;
+    m_loopFilterThread->create( 1 );
+  }
+#if !ENABLE_TRACING && JVET_N0415_CTB_ALF
+  if( m_numDecThreads > 1 )
+  {
+    // deblocking runs on the calling thread, SAO and ALF follow on the rows below
+    m_loopFilterRowThreads = new ThreadPool;
+    m_loopFilterRowThreads->create( 2 );
+  }
+#endif
+  for( int i = 0; i < m_numDecThreads; i++ )
+  {
+    m_cCuDecoder[i].setWaitForRefPics( m_loopFilterThread != nullptr );
+  }
 }
 
 void DecLib::destroy()
@@ -447,6 +495,48 @@ void DecLib::destroy()
   m_apcSlicePilot = NULL;
 
   m_cSliceDecoder.destroy();
+
+  if( m_threadPool )
+  {
+    m_threadPool->destroy();
+    delete m_threadPool;
+    m_threadPool = nullptr;
+  }
+
+  if( m_loopFilterThread )
+  {
+    m_loopFilterThread->destroy();
+    delete m_loopFilterThread;
+    m_loopFilterThread = nullptr;
+  }
+
+  if( m_loopFilterRowThreads )
+  {
+    m_loopFilterRowThreads->destroy();
+    delete m_loopFilterRowThreads;
+    m_loopFilterRowThreads = nullptr;
+  }
+
+  if( m_cCuDecoder )
+  {
+    for( int i = 0; i < m_numDecThreads; i++ )
+    {
+      m_cCuDecoder[i].destoryDecCuReshaprBuf();
+    }
+  }
+
+  delete[] m_cIntraPred;
+  delete[] m_cInterPred;
+  delete[] m_cTrQuant;
+  delete[] m_cCuDecoder;
+  delete[] m_CABACDecoder;
+  delete[] m_cRdCost;
+  m_cIntraPred   = nullptr;
+  m_cInterPred   = nullptr;
+  m_cTrQuant     = nullptr;
+  m_cCuDecoder   = nullptr;
+  m_CABACDecoder = nullptr;
+  m_cRdCost      = nullptr;
 }
 
 void DecLib::init(
@@ -455,17 +545,30 @@ void DecLib::init(
 #endif
 )
 {
-  m_cSliceDecoder.init( &m_CABACDecoder, &m_cCuDecoder );
+  m_cSliceDecoder.init( m_CABACDecoder, m_cCuDecoder, m_threadPool );
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   m_cacheModel.create( cacheCfgFileName );
   m_cacheModel.clear( );
-  m_cInterPred.cacheAssign( &m_cacheModel );
+  for( int i = 0; i < m_numDecThreads; i++ )
+  {
+    m_cInterPred[i].cacheAssign( &m_cacheModel );
+  }
 #endif
   DTRACE_UPDATE( g_trace_ctx, std::make_pair( "final", 1 ) );
 }
 
 void DecLib::deletePicBuffer ( )
 {
+  if( m_loopFilterThread )
+  {
+    m_loopFilterThread->waitForTasks();
+  }
+  for( auto job: m_loopFilterJobs )
+  {
+    delete job;
+  }
+  m_loopFilterJobs.clear();
+
   PicList::iterator  iterPic   = m_cListPic.begin();
   int iSize = int( m_cListPic.size() );
 
@@ -477,6 +580,7 @@ void DecLib::deletePicBuffer ( )
     delete pcPic;
     pcPic = NULL;
   }
+  m_cListPic.clear();
   m_cALF.destroy();
   m_cSAO.destroy();
   m_cLoopFilter.destroy();
@@ -484,7 +588,13 @@ void DecLib::deletePicBuffer ( )
   m_cacheModel.reportSequence( );
   m_cacheModel.destroy( );
 #endif
-  m_cCuDecoder.destoryDecCuReshaprBuf();
+  if( m_cCuDecoder )
+  {
+    for( int i = 0; i < m_numDecThreads; i++ )
+    {
+      m_cCuDecoder[i].destoryDecCuReshaprBuf();
+    }
+  }
   m_cReshaper.destroy();
 }
 
@@ -495,6 +605,7 @@ Picture* DecLib::xGetNewPicBuffer ( const SPS &sps, const PPS &pps, const uint32
   if (m_cListPic.size() < (uint32_t)m_iMaxRefPicNum)
   {
     pcPic = new Picture();
+    pcPic->unitCache = &m_unitCache;
 
     pcPic->create( sps.getChromaFormatIdc(), Size( sps.getPicWidthInLumaSamples(), sps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), sps.getMaxCUWidth() + 16, true );
 
@@ -507,6 +618,10 @@ Picture* DecLib::xGetNewPicBuffer ( const SPS &sps, const PPS &pps, const uint32
   for(auto * p: m_cListPic)
   {
     pcPic = p;  // workaround because range-based for-loops don't work with existing variables
+    if( isLoopFilterPending( pcPic ) )
+    {
+      continue;
+    }
     if ( pcPic->reconstructed == false && ! pcPic->neededForOutput )
     {
       pcPic->neededForOutput = false;
@@ -529,6 +644,7 @@ Picture* DecLib::xGetNewPicBuffer ( const SPS &sps, const PPS &pps, const uint32
     m_iMaxRefPicNum++;
 
     pcPic = new Picture();
+    pcPic->unitCache = &m_unitCache;
 
     m_cListPic.push_back( pcPic );
 
@@ -546,6 +662,8 @@ Picture* DecLib::xGetNewPicBuffer ( const SPS &sps, const PPS &pps, const uint32
   pcPic->setBorderExtension( false );
   pcPic->neededForOutput = false;
   pcPic->reconstructed = false;
+  pcPic->motionProgress.reset();
+  pcPic->filterProgress.reset();
 
   return pcPic;
 }
@@ -558,22 +676,105 @@ void DecLib::executeLoopFilters()
     return; // nothing to deblock
   }
 
-  m_pcPic->cs->slice->startProcessingTimer();
-
   CodingStructure& cs = *m_pcPic->cs;
 
-  if (cs.sps->getUseReshaper() && m_cReshaper.getSliceReshaperInfo().getUseSliceReshaper())
+  const bool reshaped = cs.sps->getUseReshaper() && m_cReshaper.getSliceReshaperInfo().getUseSliceReshaper();
+  if( reshaped )
+  {
+    m_pcPic->cs->slice->startProcessingTimer();
+    DEC_STAGE_TIMER( m_pcPic->stageTimes, DEC_STAGE_LMCS );
+    CHECK((m_cReshaper.getRecReshaped() == false), "Rec picture is not reshaped!");
+    m_pcPic->getRecoBuf(COMPONENT_Y).rspSignal(m_cReshaper.getInvLUT());
+    m_cReshaper.setRecReshaped(false);
+    m_pcPic->cs->slice->stopProcessingTimer();
+  }
+
+  if( !m_loopFilterThread )
+  {
+    xExecuteLoopFilters( m_pcPic, reshaped ? &m_cReshaper : nullptr );
+    return;
+  }
+
+  // hand the picture over to the loop filter thread, the decoding continues with the next picture
+  LoopFilterJob* job = new LoopFilterJob;
+  job->pic      = m_pcPic;
+  job->reshaped = reshaped;
+  if( reshaped )
+  {
+    job->reshaper = m_cReshaper;
+  }
+#if JVET_N0415_CTB_ALF
+#if JVET_N0805_APS_LMCS
+  APS** alfApss = cs.slice->getAlfAPSs();
+#else
+  APS** alfApss = cs.slice->getAPSs();
+#endif
+  for( int i = 0; i < MAX_NUM_APS; i++ )
+  {
+    if( alfApss[i] )
+    {
+      job->alfApss[i] = *alfApss[i];
+      alfApss[i]      = &job->alfApss[i];
+    }
+  }
+#endif
+
+  // the border is extended by the loop filter thread, Slice::setRefPicList of the following pictures must not touch it
+  m_pcPic->setBorderExtension( true );
+
+  m_loopFilterJobs.push_back( job );
+  m_loopFilterThread->addTask( [this, job]( int )
   {
-      CHECK((m_cReshaper.getRecReshaped() == false), "Rec picture is not reshaped!");
-      m_pcPic->getRecoBuf(COMPONENT_Y).rspSignal(m_cReshaper.getInvLUT());
-      m_cReshaper.setRecReshaped(false);
-      m_cSAO.setReshaper(&m_cReshaper);
+    Picture* pic = job->pic;
+    try
+    {
+      xExecuteLoopFilters( pic, job->reshaped ? &job->reshaper : nullptr );
+      pic->fillPicBorder();
+      pic->filterProgress.set( pic->cs->pcv->heightInCtus + 1 );
+    }
+    catch( ... )
+    {
+      // release the pictures waiting for the reference samples
+      pic->motionProgress.abort();
+      pic->filterProgress.abort();
+      throw;
+    }
+  } );
+}
+
+void DecLib::xExecuteLoopFilters( Picture* pic, Reshape* reshaper )
+{
+  pic->cs->slice->startProcessingTimer();
+
+  CodingStructure& cs  = *pic->cs;
+  const SPS&       sps = *cs.sps;
+  const PPS&       pps = *cs.pps;
+
+  // Initialise the loop filters for the settings of the picture
+  m_cSAO.create( sps.getPicWidthInLumaSamples(), sps.getPicHeightInLumaSamples(), sps.getChromaFormatIdc(), sps.getMaxCUWidth(), sps.getMaxCUHeight(), sps.getMaxCodingDepth(), pps.getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_LUMA), pps.getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_CHROMA) );
+  m_cLoopFilter.create( sps.getMaxCodingDepth() );
+  if( sps.getALFEnabledFlag() )
+  {
+    m_cALF.create( sps.getPicWidthInLumaSamples(), sps.getPicHeightInLumaSamples(), sps.getChromaFormatIdc(), sps.getMaxCUWidth(), sps.getMaxCUHeight(), sps.getMaxCodingDepth(), sps.getBitDepths().recon );
+  }
+  if( reshaper )
+  {
+    m_cSAO.setReshaper( reshaper );
   }
+
+#if ENABLE_TRACING || !JVET_N0415_CTB_ALF
+  // the trace output is written for the whole picture after each filter
   // deblocking filter
-  m_cLoopFilter.loopFilterPic( cs );
-  CS::setRefinedMotionField(cs);
+  {
+    DEC_STAGE_TIMER( pic->stageTimes, DEC_STAGE_DEBLOCK );
+    m_cLoopFilter.loopFilterPic( cs );
+    CS::setRefinedMotionField(cs);
+  }
+  pic->motionProgress.set( cs.pcv->heightInCtus );
+
   if( cs.sps->getSAOEnabledFlag() )
   {
+    DEC_STAGE_TIMER( pic->stageTimes, DEC_STAGE_SAO );
     m_cSAO.SAOProcess( cs, cs.picture->getSAO() );
   }
 
@@ -585,6 +786,7 @@ void DecLib::executeLoopFilters()
     if (cs.slice->getTileGroupAlfEnabledFlag())
 #endif
     {
+      DEC_STAGE_TIMER( pic->stageTimes, DEC_STAGE_ALF );
       // ALF decodes the differentially coded coefficients and stores them in the parameters structure.
       // Code could be restructured to do directly after parsing. So far we just pass a fresh non-const
       // copy in case the APS gets used more than once.
@@ -597,10 +799,182 @@ void DecLib::executeLoopFilters()
     }
 
   }
+  pic->filterProgress.set( cs.pcv->heightInCtus );
+
+#else
+  xFilterCtuRows( pic );
+#endif
 
-  m_pcPic->cs->slice->stopProcessingTimer();
+  pic->cs->slice->stopProcessingTimer();
 }
 
+#if JVET_N0415_CTB_ALF
+/**
+ - in-loop filtering in a sliding window of CTU rows, a filter stage processes a row as soon as its input rows are final
+ - the deblocked samples of a row are final with the deblocking of the row below, SAO and ALF read one row above and below
+ - with several decoding threads SAO and ALF run in parallel to the deblocking of the rows below
+ .
+*/
+void DecLib::xFilterCtuRows( Picture* pic )
+{
+  CodingStructure& cs      = *pic->cs;
+  const int        numRows = cs.pcv->heightInCtus;
+
+  const bool sao = cs.sps->getSAOEnabledFlag() && m_cSAO.SAOPrepare( cs, cs.picture->getSAO() );
+  const bool alf = cs.sps->getALFEnabledFlag() && cs.slice->getTileGroupAlfEnabledFlag( COMPONENT_Y ) && m_cALF.ALFPrepare( cs );
+
+  m_deblockedCtuRows.reset();
+  m_saoCtuRows.reset();
+
+  if( m_loopFilterRowThreads )
+  {
+    m_loopFilterRowThreads->addTask( [this, pic, numRows, sao]( int )
+    {
+      try
+      {
+        for( int ctuRow = 0; ctuRow < numRows; ctuRow++ )
+        {
+          if( !xSaoCtuRow( pic, ctuRow, sao ) )
+          {
+            break;
+          }
+        }
+      }
+      catch( ... )
+      {
+        m_saoCtuRows.abort();
+        throw;
+      }
+    } );
+    m_loopFilterRowThreads->addTask( [this, pic, numRows, alf]( int )
+    {
+      for( int ctuRow = 0; ctuRow < numRows; ctuRow++ )
+      {
+        if( !xAlfCtuRow( pic, ctuRow, alf ) )
+        {
+          break;
+        }
+      }
+    } );
+
+    try
+    {
+      for( int ctuRow = 0; ctuRow < numRows; ctuRow++ )
+      {
+        xDeblockCtuRow( pic, ctuRow );
+      }
+    }
+    catch( ... )
+    {
+      m_deblockedCtuRows.abort();
+      m_loopFilterRowThreads->waitForTasks();
+      throw;
+    }
+    m_loopFilterRowThreads->waitForTasks();
+    return;
+  }
+
+  int saoRow = 0;
+  int alfRow = 0;
+  for( int ctuRow = 0; ctuRow < numRows; ctuRow++ )
+  {
+    xDeblockCtuRow( pic, ctuRow );
+
+    const int deblockedRows = ctuRow + 1 < numRows ? ctuRow : numRows;
+    while( saoRow < numRows && deblockedRows >= std::min( saoRow + 2, numRows ) )
+    {
+      xSaoCtuRow( pic, saoRow++, sao );
+    }
+    while( alfRow < numRows && saoRow >= std::min( alfRow + 2, numRows ) )
+    {
+      xAlfCtuRow( pic, alfRow++, alf );
+    }
+  }
+}
+
+void DecLib::xDeblockCtuRow( Picture* pic, const int ctuRow )
+{
+  CodingStructure& cs      = *pic->cs;
+  const int        numRows = cs.pcv->heightInCtus;
+
+  {
+    DEC_STAGE_TIMER( pic->stageTimes, DEC_STAGE_DEBLOCK );
+    m_cLoopFilter.loopFilterCtuRow( cs, EDGE_VER, ctuRow );
+    m_cLoopFilter.loopFilterCtuRow( cs, EDGE_HOR, ctuRow );
+
+    // the horizontal edges of this row were the last to modify the samples and to use the unrefined motion of the row above
+    if( ctuRow > 0 )
+    {
+      CS::setRefinedMotionField( cs, ctuRow - 1 );
+    }
+    if( ctuRow + 1 == numRows )
+    {
+      CS::setRefinedMotionField( cs, ctuRow );
+    }
+  }
+
+  const int finalRows = ctuRow + 1 < numRows ? ctuRow : numRows;
+  pic->motionProgress.set( finalRows );
+  m_deblockedCtuRows.set( finalRows );
+}
+
+bool DecLib::xSaoCtuRow( Picture* pic, const int ctuRow, const bool sao )
+{
+  CodingStructure& cs      = *pic->cs;
+  const int        numRows = cs.pcv->heightInCtus;
+
+  if( !m_deblockedCtuRows.wait( std::min( ctuRow + 2, numRows ) ) )
+  {
+    m_saoCtuRows.abort();
+    return false;
+  }
+
+  if( sao )
+  {
+    DEC_STAGE_TIMER( pic->stageTimes, DEC_STAGE_SAO );
+    // each row is copied before its SAO overwrites it, the row below is read as well
+    if( ctuRow == 0 )
+    {
+      m_cSAO.SAOCopyCtuRow( cs, ctuRow );
+    }
+    if( ctuRow + 1 < numRows )
+    {
+      m_cSAO.SAOCopyCtuRow( cs, ctuRow + 1 );
+    }
+    m_cSAO.SAOProcessCtuRow( cs, ctuRow );
+  }
+  m_saoCtuRows.set( ctuRow + 1 );
+  return true;
+}
+
+bool DecLib::xAlfCtuRow( Picture* pic, const int ctuRow, const bool alf )
+{
+  CodingStructure& cs      = *pic->cs;
+  const int        numRows = cs.pcv->heightInCtus;
+
+  if( !m_saoCtuRows.wait( std::min( ctuRow + 2, numRows ) ) )
+  {
+    return false;
+  }
+
+  if( alf )
+  {
+    DEC_STAGE_TIMER( pic->stageTimes, DEC_STAGE_ALF );
+    if( ctuRow == 0 )
+    {
+      m_cALF.ALFCopyCtuRow( cs, ctuRow );
+    }
+    if( ctuRow + 1 < numRows )
+    {
+      m_cALF.ALFCopyCtuRow( cs, ctuRow + 1 );
+    }
+    m_cALF.ALFProcessCtuRow( cs, ctuRow );
+  }
+  pic->filterProgress.set( ctuRow + 1 );
+  return true;
+}
+#endif
+
 void DecLib::finishPictureLight(int& poc, PicList*& rpcListPic )
 {
   Slice*  pcSlice = m_pcPic->cs->slice;
@@ -614,17 +988,92 @@ void DecLib::finishPictureLight(int& poc, PicList*& rpcListPic )
 }
 
 void DecLib::finishPicture(int& poc, PicList*& rpcListPic, MsgLevel msgl )
+{
+  if( m_loopFilterThread )
+  {
+    // only the pictures exceeding the pipeline depth are waited for
+    while( (int) m_loopFilterJobs.size() > m_loopFilterPipelineDepth )
+    {
+      poc = m_loopFilterJobs.front()->pic->getPOC();
+      xFinishLoopFilterJob( msgl );
+    }
+    Slice::sortPicList( m_cListPic ); // sorting for application output
+    rpcListPic = &m_cListPic;
+    m_bFirstSliceInPicture = true;
+    return;
+  }
+
+  xFinishPicture( m_pcPic, msgl );
+
+  poc                 = m_pcPic->getPOC();
+  rpcListPic          = &m_cListPic;
+  m_bFirstSliceInPicture  = true; // TODO: immer true? hier ist irgendwas faul
+}
+
+void DecLib::finishPendingPictures(int& poc, PicList*& rpcListPic, MsgLevel msgl )
+{
+  if( m_loopFilterJobs.empty() )
+  {
+    return;
+  }
+  while( !m_loopFilterJobs.empty() )
+  {
+    poc = m_loopFilterJobs.front()->pic->getPOC();
+    xFinishLoopFilterJob( msgl );
+  }
+  rpcListPic = &m_cListPic;
+}
+
+bool DecLib::isLoopFilterPending( const Picture* pic ) const
+{
+  for( auto job: m_loopFilterJobs )
+  {
+    if( job->pic == pic )
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void DecLib::xFinishLoopFilterJob( MsgLevel msgl )
+{
+  LoopFilterJob* job = m_loopFilterJobs.front();
+  Picture*       pic = job->pic;
+
+  if( !pic->filterProgress.wait( pic->cs->pcv->heightInCtus + 1 ) )
+  {
+    // rethrows the exception of the loop filter thread
+    m_loopFilterThread->waitForTasks();
+    THROW( "In-loop filtering aborted" );
+  }
+  m_loopFilterJobs.pop_front();
+
+  // the APS copies are gone with the job
+#if JVET_N0415_CTB_ALF
+#if JVET_N0805_APS_LMCS
+  pic->cs->slice->setAlfAPSs( pic->cs->alfApss );
+#else
+  pic->cs->slice->setAPSs( pic->cs->apss );
+#endif
+#endif
+  delete job;
+
+  xFinishPicture( pic, msgl );
+}
+
+void DecLib::xFinishPicture( Picture* pic, MsgLevel msgl )
 {
 #if RExt__DECODER_DEBUG_TOOL_STATISTICS
   CodingStatistics::StatTool& s = CodingStatistics::GetStatisticTool( STATS__TOOL_TOTAL_FRAME );
   s.count++;
-  s.pixels = s.count * m_pcPic->Y().width * m_pcPic->Y().height;
+  s.pixels = s.count * pic->Y().width * pic->Y().height;
 #endif
 
-  Slice*  pcSlice = m_pcPic->cs->slice;
+  Slice*  pcSlice = pic->cs->slice;
 
   char c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
-  if (!m_pcPic->referenced)
+  if (!pic->referenced)
   {
     c += 32;  // tolower
   }
@@ -635,6 +1084,10 @@ void DecLib::finishPicture(int& poc, PicList*& rpcListPic, MsgLevel msgl )
          c,
          pcSlice->getSliceQp() );
   msg( msgl, "[DT %6.3f] ", pcSlice->getProcessingTime() );
+#if DECODER_STAGE_TIMING
+  m_stageStatistics.addPicture( pic->getPOC(), uint64_t( pic->lwidth() ) * pic->lheight(), pic->stageTimes );
+  m_stageStatistics.printPicture( msgl, pic->stageTimes );
+#endif
 
   for (int iRefList = 0; iRefList < 2; iRefList++)
   {
@@ -647,29 +1100,25 @@ void DecLib::finishPicture(int& poc, PicList*& rpcListPic, MsgLevel msgl )
   }
   if (m_decodedPictureHashSEIEnabled)
   {
-    SEIMessages pictureHashes = getSeisByType(m_pcPic->SEIs, SEI::DECODED_PICTURE_HASH );
+    SEIMessages pictureHashes = getSeisByType(pic->SEIs, SEI::DECODED_PICTURE_HASH );
     const SEIDecodedPictureHash *hash = ( pictureHashes.size() > 0 ) ? (SEIDecodedPictureHash*) *(pictureHashes.begin()) : NULL;
     if (pictureHashes.size() > 1)
     {
       msg( WARNING, "Warning: Got multiple decoded picture hash SEI messages. Using first.");
     }
-    m_numberOfChecksumErrorsDetected += calcAndPrintHashStatus(((const Picture*) m_pcPic)->getRecoBuf(), hash, pcSlice->getSPS()->getBitDepths(), msgl);
+    m_numberOfChecksumErrorsDetected += calcAndPrintHashStatus(((const Picture*) pic)->getRecoBuf(), hash, pcSlice->getSPS()->getBitDepths(), msgl);
   }
 
   msg( msgl, "\n");
 
-  m_pcPic->neededForOutput = (pcSlice->getPicOutputFlag() ? true : false);
-  m_pcPic->reconstructed = true;
-
+  pic->neededForOutput = (pcSlice->getPicOutputFlag() ? true : false);
+  pic->reconstructed = true;
 
   Slice::sortPicList( m_cListPic ); // sorting for application output
-  poc                 = pcSlice->getPOC();
-  rpcListPic          = &m_cListPic;
-  m_bFirstSliceInPicture  = true; // TODO: immer true? hier ist irgendwas faul
 
-  m_pcPic->destroyTempBuffers();
-  m_pcPic->cs->destroyCoeffs();
-  m_pcPic->cs->releaseIntermediateData();
+  pic->destroyTempBuffers();
+  pic->cs->destroyCoeffs();
+  pic->cs->releaseIntermediateData();
 }
 
 void DecLib::checkNoOutputPriorPics (PicList* pcListPic)
@@ -679,6 +1128,10 @@ void DecLib::checkNoOutputPriorPics (PicList* pcListPic)
     return;
   }
 
+  // the output flag of the pictures still in the loop filter pipeline is set when they are finished
+  int poc;
+  finishPendingPictures( poc, pcListPic );
+
   PicList::iterator  iterPic   = pcListPic->begin();
 
   while (iterPic != pcListPic->end())
@@ -708,6 +1161,12 @@ void DecLib::xUpdateRasInit(Slice* slice)
 void DecLib::xCreateLostPicture(int iLostPoc)
 {
   msg( INFO, "\ninserting lost poc : %d\n",iLostPoc);
+
+  // the lost picture is copied from a finished one
+  int       poc;
+  PicList*  picList = nullptr;
+  finishPendingPictures( poc, picList );
+
   Picture *cFillPic = xGetNewPicBuffer(*(m_parameterSetManager.getFirstSPS()), *(m_parameterSetManager.getFirstPPS()), 0);
 
   CHECK( !cFillPic->slices.size(), "No slices in picture" );
@@ -742,6 +1201,8 @@ void DecLib::xCreateLostPicture(int iLostPoc)
   xUpdatePreviousTid0POC(cFillPic->slices[0]);
   cFillPic->reconstructed = true;
   cFillPic->neededForOutput = true;
+  cFillPic->motionProgress.set( cFillPic->cs->pcv->heightInCtus );
+  cFillPic->filterProgress.set( cFillPic->cs->pcv->heightInCtus + 1 );
   if(m_pocRandomAccess == MAX_INT)
   {
     m_pocRandomAccess = iLostPoc;
@@ -894,7 +1355,7 @@ void DecLib::xActivateParameterSets()
 #if JVET_N0857_RECT_SLICES
     m_parameterSetManager.getPPS(m_apcSlicePilot->getPPSId())->setNumBricksInPic((int)m_pcPic->brickMap->bricks.size());
 #endif
-    m_pcPic->createTempBuffers( m_pcPic->cs->pps->pcv->maxCUWidth );
+    m_pcPic->createTempBuffers( m_pcPic->cs->pps->pcv->maxCUWidth, m_threadPool != nullptr );
     m_pcPic->cs->createCoeffs();
 
     m_pcPic->allocateNewSlice();
@@ -934,11 +1395,12 @@ void DecLib::xActivateParameterSets()
 #endif
     m_pcPic->cs->pcv   = pps->pcv;
 
-    // Initialise the various objects for the new set of settings
-    m_cSAO.create( sps->getPicWidthInLumaSamples(), sps->getPicHeightInLumaSamples(), sps->getChromaFormatIdc(), sps->getMaxCUWidth(), sps->getMaxCUHeight(), sps->getMaxCodingDepth(), pps->getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_LUMA), pps->getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_CHROMA) );
-    m_cLoopFilter.create( sps->getMaxCodingDepth() );
-    m_cIntraPred.init( sps->getChromaFormatIdc(), sps->getBitDepth( CHANNEL_TYPE_LUMA ) );
-    m_cInterPred.init( &m_cRdCost, sps->getChromaFormatIdc() );
+    // Initialise the various objects for the new set of settings, the loop filters are set up when they are executed
+    for( int i = 0; i < m_numDecThreads; i++ )
+    {
+      m_cIntraPred[i].init( sps->getChromaFormatIdc(), sps->getBitDepth( CHANNEL_TYPE_LUMA ) );
+      m_cInterPred[i].init( &m_cRdCost[i], sps->getChromaFormatIdc() );
+    }
     if (sps->getUseReshaper())
     {
       m_cReshaper.createDec(sps->getBitDepth(CHANNEL_TYPE_LUMA));
@@ -968,26 +1430,25 @@ void DecLib::xActivateParameterSets()
     m_SEIs.clear();
 
     // Recursive structure
-    m_cCuDecoder.init( &m_cTrQuant, &m_cIntraPred, &m_cInterPred );
-    if (sps->getUseReshaper())
+    for( int i = 0; i < m_numDecThreads; i++ )
     {
-      m_cCuDecoder.initDecCuReshaper(&m_cReshaper, sps->getChromaFormatIdc());
-    }
+      m_cCuDecoder[i].init( &m_cTrQuant[i], &m_cIntraPred[i], &m_cInterPred[i] );
+      if (sps->getUseReshaper())
+      {
+        m_cCuDecoder[i].initDecCuReshaper(&m_cReshaper, sps->getChromaFormatIdc());
+      }
+      // the scaling list tables are shared with the first instance
 #if MAX_TB_SIZE_SIGNALLING
-    m_cTrQuant.init( nullptr, sps->getMaxTbSize(), false, false, false, false, false );
+      m_cTrQuant[i].init( i == 0 ? nullptr : m_cTrQuant[0].getQuant(), sps->getMaxTbSize(), false, false, false, false, false );
 #else
-    m_cTrQuant.init( nullptr, MAX_TB_SIZEY, false, false, false, false, false );
+      m_cTrQuant[i].init( i == 0 ? nullptr : m_cTrQuant[0].getQuant(), MAX_TB_SIZEY, false, false, false, false, false );
 #endif
 
-    // RdCost
-    m_cRdCost.setCostMode ( COST_STANDARD_LOSSY ); // not used in decoder side RdCost stuff -> set to default
+      // RdCost
+      m_cRdCost[i].setCostMode ( COST_STANDARD_LOSSY ); // not used in decoder side RdCost stuff -> set to default
+    }
 
     m_cSliceDecoder.create();
-
-    if( sps->getALFEnabledFlag() )
-    {
-      m_cALF.create( sps->getPicWidthInLumaSamples(), sps->getPicHeightInLumaSamples(), sps->getChromaFormatIdc(), sps->getMaxCUWidth(), sps->getMaxCUHeight(), sps->getMaxCodingDepth(), sps->getBitDepths().recon );
-    }
   }
   else
   {
@@ -1485,7 +1946,7 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
 
 
 #if HEVC_USE_SCALING_LISTS
-  Quant *quant = m_cTrQuant.getQuant();
+  Quant *quant = m_cTrQuant[0].getQuant();
 
   if(pcSlice->getSPS()->getScalingListFlag())
   {
@@ -1503,11 +1964,10 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
       scalingList.setDefaultScalingList();
     }
     quant->setScalingListDec(scalingList);
-    quant->setUseScalingList(true);
   }
-  else
+  for( int i = 0; i < m_numDecThreads; i++ )
   {
-    quant->setUseScalingList(false);
+    m_cTrQuant[i].getQuant()->setUseScalingList( pcSlice->getSPS()->getScalingListFlag() );
   }
 #endif
 
@@ -1576,6 +2036,7 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
     m_cReshaper.setRecReshaped(false);
   }
 
+  // the temporal motion vector prediction needs the final motion field of the collocated picture
   //  Decode a picture
   m_cSliceDecoder.decompressSlice( pcSlice, &( nalu.getBitstream() ), ( m_pcPic->poc == getDebugPOC() ? getDebugCTU() : -1 ) );
 
@@ -1609,6 +2070,11 @@ void DecLib::xDecodeDPS( InputNALUnit& nalu )
 
 void DecLib::xDecodeSPS( InputNALUnit& nalu )
 {
+  // the pictures in the loop filter pipeline may still use the parameter set to be replaced
+  int       poc;
+  PicList*  picList = nullptr;
+  finishPendingPictures( poc, picList );
+
   SPS* sps = new SPS();
   m_HLSReader.setBitstream( &nalu.getBitstream() );
   m_HLSReader.parseSPS( sps );
@@ -1619,6 +2085,11 @@ void DecLib::xDecodeSPS( InputNALUnit& nalu )
 
 void DecLib::xDecodePPS( InputNALUnit& nalu )
 {
+  // the pictures in the loop filter pipeline may still use the parameter set to be replaced
+  int       poc;
+  PicList*  picList = nullptr;
+  finishPendingPictures( poc, picList );
+
   PPS* pps = new PPS();
   m_HLSReader.setBitstream( &nalu.getBitstream() );
 #if JVET_N0438_LOOP_FILTER_DISABLED_ACROSS_VIR_BOUND
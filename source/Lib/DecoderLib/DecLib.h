@@ -54,6 +54,7 @@
 #include "CommonLib/SEI.h"
 #include "CommonLib/Unit.h"
 #include "CommonLib/Reshape.h"
+#include "CommonLib/ThreadPool.h"
 
 class InputNALUnit;
 
@@ -76,6 +77,7 @@ private:
   int                     m_lastRasPoc;
 
   PicList                 m_cListPic;         //  Dynamic buffer
+  XUCache                 m_unitCache;        ///< coding units of the pictures in m_cListPic, separate per decoder instance
   ParameterSetManager     m_parameterSetManager;  // storage for parameter sets
   Slice*                  m_apcSlicePilot;
 
@@ -86,21 +88,40 @@ private:
   int                     m_iTargetLayer;                       ///< target stream layer to be decoded
 #endif
 
-  // functional classes
-  IntraPrediction         m_cIntraPred;
-  InterPrediction         m_cInterPred;
-  TrQuant                 m_cTrQuant;
+  // parallel processing
+  int                     m_numDecThreads;                ///< number of threads used for decoding, 1: no parallel decoding
+  ThreadPool*             m_threadPool;
+
+  /// picture handed over to the loop filter thread
+  struct LoopFilterJob
+  {
+    Picture*  pic;
+    APS       alfApss[MAX_NUM_APS];   ///< copies of the ALF APSs, the parameter sets can be replaced while the picture is filtered
+    bool      reshaped;
+    Reshape   reshaper;               ///< copy of the LMCS state used for the PCM sample restoration in SAO
+  };
+  int                     m_loopFilterPipelineDepth;      ///< number of pictures that may be in-loop filtered while the following pictures are decoded
+  ThreadPool*             m_loopFilterThread;
+  std::deque<LoopFilterJob*> m_loopFilterJobs;            ///< pictures handed over to the loop filter thread in decoding order
+  ThreadPool*             m_loopFilterRowThreads;         ///< runs the SAO and the ALF stage of the CTU-row based in-loop filtering
+  ProgressCounter         m_deblockedCtuRows;             ///< CTU rows with final deblocked samples
+  ProgressCounter         m_saoCtuRows;                   ///< CTU rows with final SAO output
+
+  // functional classes, the CTU decoding tools exist once per decoding thread
+  IntraPrediction*        m_cIntraPred;
+  InterPrediction*        m_cInterPred;
+  TrQuant*                m_cTrQuant;
   DecSlice                m_cSliceDecoder;
-  DecCu                   m_cCuDecoder;
+  DecCu*                  m_cCuDecoder;
   HLSyntaxReader          m_HLSReader;
-  CABACDecoder            m_CABACDecoder;
+  CABACDecoder*           m_CABACDecoder;
   SEIReader               m_seiReader;
   LoopFilter              m_cLoopFilter;
   SampleAdaptiveOffset    m_cSAO;
   AdaptiveLoopFilter      m_cALF;
   Reshape                 m_cReshaper;                        ///< reshaper class
   // decoder side RD cost computation
-  RdCost                  m_cRdCost;                      ///< RD cost computation class
+  RdCost*                 m_cRdCost;                      ///< RD cost computation class
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   CacheModel              m_cacheModel;
 #endif
@@ -128,6 +149,9 @@ private:
   bool                    m_warningMessageSkipPicture;
 
   std::list<InputNALUnit*> m_prefixSEINALUs; /// Buffered up prefix SEI NAL Units.
+#if DECODER_STAGE_TIMING
+  DecStageStatistics      m_stageStatistics;
+#endif
   int                     m_debugPOC;
   int                     m_debugCTU;
 public:
@@ -138,6 +162,10 @@ public:
   void  destroy ();
 
   void  setDecodedPictureHashSEIEnabled(int enabled) { m_decodedPictureHashSEIEnabled=enabled; }
+  void  setNumDecThreads  ( int n )                  { m_numDecThreads = n; }   ///< has to be set before create()
+  int   getNumDecThreads  () const                   { return m_numDecThreads; }
+  void  setLoopFilterPipelineDepth( int n )         { m_loopFilterPipelineDepth = n; }   ///< has to be set before create()
+  int   getLoopFilterPipelineDepth() const           { return m_loopFilterPipelineDepth; }
 
   void  init(
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
@@ -150,6 +178,9 @@ public:
   void  executeLoopFilters();
   void  finishPicture(int& poc, PicList*& rpcListPic, MsgLevel msgl = INFO);
   void  finishPictureLight(int& poc, PicList*& rpcListPic );
+  /// waits for the pictures handed over to the loop filter thread and finishes them
+  void  finishPendingPictures(int& poc, PicList*& rpcListPic, MsgLevel msgl = INFO);
+  bool  isLoopFilterPending( const Picture* pic ) const;
   void  checkNoOutputPriorPics (PicList* rpcListPic);
 
 #if JVET_N0278_HLS
@@ -164,6 +195,9 @@ public:
   void  setFirstSliceInSequence (bool val) { m_bFirstSliceInSequence = val; }
   void  setDecodedSEIMessageOutputStream(std::ostream *pOpStream) { m_pDecodedSEIOutputStream = pOpStream; }
   uint32_t  getNumberOfChecksumErrorsDetected() const { return m_numberOfChecksumErrorsDetected; }
+#if DECODER_STAGE_TIMING
+  DecStageStatistics& getStageStatistics()            { return m_stageStatistics; }
+#endif
 
   int  getDebugCTU( )               const { return m_debugCTU; }
   void setDebugCTU( int debugCTU )        { m_debugCTU = debugCTU; }
@@ -175,6 +209,14 @@ protected:
   Picture * xGetNewPicBuffer(const SPS &sps, const PPS &pps, const uint32_t temporalLayer);
   void  xCreateLostPicture (int iLostPOC);
 
+  void      xExecuteLoopFilters( Picture* pic, Reshape* reshaper );
+  void      xFilterCtuRows( Picture* pic );
+  void      xDeblockCtuRow( Picture* pic, const int ctuRow );
+  bool      xSaoCtuRow( Picture* pic, const int ctuRow, const bool sao );
+  bool      xAlfCtuRow( Picture* pic, const int ctuRow, const bool alf );
+  void      xFinishPicture( Picture* pic, MsgLevel msgl );
+  void      xFinishLoopFilterJob( MsgLevel msgl );
+
   void      xActivateParameterSets();
   bool      xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDisplay);
 #if HEVC_VPS || JVET_N0278_HLS
@@ -0,0 +1,372 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     DecSession.cpp
+    \brief    decoder session, decodes in-memory bitstreams and hands out the pictures in output order
+*/
+
+#include "DecSession.h"
+#include "AnnexBread.h"
+#include "NALread.h"
+
+#include <mutex>
+
+//! \ingroup DecoderLib
+//! \{
+
+// the ROM tables are shared by all sessions, they are created by the first and destroyed by the last one
+static std::mutex s_romMutex;
+static int        s_numRomUsers = 0;
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+DecSession::DecSession()
+  : m_isCreated       ( false )
+  , m_pcListPic       ( nullptr )
+  , m_iSkipFrame      ( 0 )
+  , m_iPOCLastDisplay ( -MAX_INT )
+  , m_loopFiltered    ( false )
+{
+}
+
+DecSession::~DecSession()
+{
+  destroy();
+}
+
+void DecSession::create( const DecSessionCfg& cfg, OutputCallback outputCallback )
+{
+  CHECK( m_isCreated, "Decoder session already created" );
+
+  {
+    std::unique_lock<std::mutex> lock( s_romMutex );
+    if( s_numRomUsers++ == 0 )
+    {
+      initROM();
+    }
+  }
+
+  m_cfg            = cfg;
+  m_outputCallback = outputCallback;
+
+  m_decLib.setNumDecThreads( m_cfg.numDecThreads );
+  m_decLib.setLoopFilterPipelineDepth( m_cfg.loopFilterPipelineDepth );
+  m_decLib.create();
+  m_decLib.init(
+#if JVET_J0090_MEMORY_BANDWITH_MEASURE
+    ""
+#endif
+  );
+  m_decLib.setDecodedPictureHashSEIEnabled( m_cfg.decodedPictureHashSEIEnabled );
+#if JVET_N0278_HLS
+  m_decLib.setTargetDecLayer( m_cfg.targetLayer );
+#endif
+
+  m_isCreated = true;
+}
+
+void DecSession::destroy()
+{
+  if( !m_isCreated )
+  {
+    return;
+  }
+
+  m_decLib.deletePicBuffer();
+  m_decLib.destroy();
+  m_pcListPic = nullptr;
+  m_isCreated = false;
+
+  std::unique_lock<std::mutex> lock( s_romMutex );
+  if( --s_numRomUsers == 0 )
+  {
+    destroyROM();
+  }
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+void DecSession::pushNALUnit( const uint8_t* data, size_t size )
+{
+  CHECK( !m_isCreated, "Decoder session not created" );
+
+  if( size == 0 )
+  {
+    msg( ERROR, "Warning: Attempt to decode an empty NAL unit\n" );
+    return;
+  }
+  xDecodeNALUnit( data, size );
+}
+
+void DecSession::pushByteStream( const uint8_t* data, size_t size )
+{
+  MappedInputByteStream bytestream;
+  bytestream.open( data, size );
+
+  while( !bytestream.eof() )
+  {
+    AnnexBStats    stats = AnnexBStats();
+    const uint8_t* nalUnit;
+    size_t         nalUnitSize;
+
+    bytestream.readNALUnit( nalUnit, nalUnitSize, stats );
+    pushNALUnit( nalUnit, nalUnitSize );
+  }
+}
+
+void DecSession::flush()
+{
+  CHECK( !m_isCreated, "Decoder session not created" );
+
+  int poc;
+
+  if( !m_decLib.getFirstSliceInSequence() )
+  {
+    if( !m_loopFiltered )
+    {
+      m_decLib.executeLoopFilters();
+      m_decLib.finishPicture( poc, m_pcListPic );
+    }
+    if( m_pcListPic )
+    {
+      xWriteOutput();
+    }
+  }
+  else
+  {
+    m_decLib.setFirstSliceInPicture( true );
+  }
+  m_loopFiltered = false;
+
+  m_decLib.finishPendingPictures( poc, m_pcListPic );
+  xFlushOutput();
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+/** decodes the NAL unit like one iteration of the DecApp decoding loop, a NAL unit starting a new picture is
+    decoded again after the current picture is finished
+ */
+void DecSession::xDecodeNALUnit( const uint8_t* data, size_t size )
+{
+  bool bNewPicture;
+  do
+  {
+    int          poc;
+    InputNALUnit nalu;
+    nalu.getBitstream().getFifo().assign( data, data + size );
+    read( nalu );
+
+    bNewPicture = xIsNaluDecoded( nalu ) && m_decLib.decode( nalu, m_iSkipFrame, m_iPOCLastDisplay );
+
+    if( ( bNewPicture || nalu.m_nalUnitType == NAL_UNIT_EOS ) && !m_decLib.getFirstSliceInSequence() )
+    {
+      m_decLib.executeLoopFilters();
+      m_decLib.finishPicture( poc, m_pcListPic );
+
+      m_loopFiltered = ( nalu.m_nalUnitType == NAL_UNIT_EOS );
+      if( nalu.m_nalUnitType == NAL_UNIT_EOS )
+      {
+        m_decLib.setFirstSliceInSequence( true );
+      }
+    }
+    else if( ( bNewPicture || nalu.m_nalUnitType == NAL_UNIT_EOS ) && m_decLib.getFirstSliceInSequence() )
+    {
+      m_decLib.setFirstSliceInPicture( true );
+    }
+
+    if( !m_pcListPic )
+    {
+      continue;
+    }
+
+    if( bNewPicture )
+    {
+      xWriteOutput();
+    }
+    if( ( bNewPicture || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_CRA ) && m_decLib.getNoOutputPriorPicsFlag() )
+    {
+      m_decLib.checkNoOutputPriorPics( m_pcListPic );
+      m_decLib.setNoOutputPriorPicsFlag( false );
+    }
+    if( bNewPicture &&
+#if !JVET_M0101_HLS
+        (   nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_W_RADL
+         || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_N_LP
+         || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_BLA_N_LP
+         || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_BLA_W_RADL
+         || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_BLA_W_LP ) )
+#else
+        (   nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_W_RADL
+         || nalu.m_nalUnitType == NAL_UNIT_CODED_SLICE_IDR_N_LP ) )
+#endif
+    {
+      m_decLib.finishPendingPictures( poc, m_pcListPic );
+      xFlushOutput();
+    }
+    if( nalu.m_nalUnitType == NAL_UNIT_EOS )
+    {
+      m_decLib.finishPendingPictures( poc, m_pcListPic );
+      xWriteOutput();
+      m_decLib.setFirstSliceInPicture( false );
+    }
+    // additional bumping as defined in C.5.2.3
+#if JVET_N0067_NAL_Unit_Header
+    if( !bNewPicture && ( ( nalu.m_nalUnitType >= NAL_UNIT_CODED_SLICE_TRAIL && nalu.m_nalUnitType <= NAL_UNIT_RESERVED_VCL_15 )
+                       || ( nalu.m_nalUnitType >= NAL_UNIT_CODED_SLICE_IDR_W_RADL && nalu.m_nalUnitType <= NAL_UNIT_CODED_SLICE_GRA ) ) )
+#else
+#if !JVET_M0101_HLS
+    if( !bNewPicture && nalu.m_nalUnitType >= NAL_UNIT_CODED_SLICE_TRAIL_N && nalu.m_nalUnitType <= NAL_UNIT_RESERVED_VCL31 )
+#else
+    if( !bNewPicture && nalu.m_nalUnitType >= NAL_UNIT_CODED_SLICE_TRAIL && nalu.m_nalUnitType <= NAL_UNIT_RESERVED_VCL15 )
+#endif
+#endif
+    {
+      xWriteOutput();
+    }
+  }
+  while( bNewPicture );
+}
+
+bool DecSession::xIsNaluDecoded( const InputNALUnit& nalu ) const
+{
+  if( m_cfg.maxTemporalLayer >= 0 && nalu.m_temporalId > m_cfg.maxTemporalLayer )
+  {
+    return false;
+  }
+#if JVET_N0278_HLS
+  if( m_cfg.targetLayer >= 0 && nalu.m_nuhLayerId != m_cfg.targetLayer )
+  {
+    return false;
+  }
+#endif
+  return true;
+}
+
+void DecSession::xOutputPicture( Picture* pic )
+{
+  if( m_outputCallback )
+  {
+    m_outputCallback( *pic );
+  }
+
+  // update POC of display order
+  m_iPOCLastDisplay = pic->getPOC();
+
+  // erase non-referenced picture in the reference picture list after display
+  if( !pic->referenced && pic->reconstructed )
+  {
+    pic->reconstructed = false;
+  }
+  pic->neededForOutput = false;
+}
+
+/** outputs the pictures that have to leave the DPB, see DecApp::xWriteOutput
+ */
+void DecSession::xWriteOutput()
+{
+  if( m_pcListPic->empty() )
+  {
+    return;
+  }
+
+  const SPS*     activeSPS      = m_pcListPic->front()->cs->sps;
+  const uint32_t maxNrSublayers = activeSPS->getMaxTLayers();
+  const uint32_t maxTid         = ( m_cfg.maxTemporalLayer == -1 || m_cfg.maxTemporalLayer >= maxNrSublayers ) ? maxNrSublayers - 1 : m_cfg.maxTemporalLayer;
+  const uint32_t numReorderPicsHighestTid     = activeSPS->getNumReorderPics( maxTid );
+  const uint32_t maxDecPicBufferingHighestTid = activeSPS->getMaxDecPicBuffering( maxTid );
+
+  int numPicsNotYetDisplayed = 0;
+  int dpbFullness            = 0;
+
+  for( auto pic : *m_pcListPic )
+  {
+    if( pic->neededForOutput && pic->getPOC() > m_iPOCLastDisplay )
+    {
+      numPicsNotYetDisplayed++;
+      dpbFullness++;
+    }
+    else if( pic->referenced )
+    {
+      dpbFullness++;
+    }
+  }
+
+  for( auto pic : *m_pcListPic )
+  {
+    if( m_decLib.isLoopFilterPending( pic ) )
+    {
+      break; // the following pictures in output order have to wait for it
+    }
+    if( pic->neededForOutput && pic->getPOC() > m_iPOCLastDisplay &&
+      ( numPicsNotYetDisplayed > numReorderPicsHighestTid || dpbFullness > maxDecPicBufferingHighestTid ) )
+    {
+      numPicsNotYetDisplayed--;
+      if( !pic->referenced )
+      {
+        dpbFullness--;
+      }
+      xOutputPicture( pic );
+    }
+  }
+}
+
+/** outputs all remaining pictures and empties the DPB, see DecApp::xFlushOutput
+ */
+void DecSession::xFlushOutput()
+{
+  if( !m_pcListPic || m_pcListPic->empty() )
+  {
+    return;
+  }
+
+  for( auto pic : *m_pcListPic )
+  {
+    if( pic->neededForOutput )
+    {
+      xOutputPicture( pic );
+    }
+    pic->destroy();
+    delete pic;
+  }
+  m_pcListPic->clear();
+  m_iPOCLastDisplay = -MAX_INT;
+}
+
+//! \}
@@ -0,0 +1,117 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     DecSession.h
+    \brief    decoder session, decodes in-memory bitstreams and hands out the pictures in output order (header)
+*/
+
+#ifndef __DECSESSION__
+#define __DECSESSION__
+
+#include "DecLib.h"
+
+#include <functional>
+
+//! \ingroup DecoderLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// configuration of a decoder session
+struct DecSessionCfg
+{
+  int  numDecThreads;                   ///< number of threads used for decoding CTU rows and bricks in parallel
+  int  loopFilterPipelineDepth;         ///< number of pictures filtered concurrently to the decoding of the following ones
+  int  decodedPictureHashSEIEnabled;    ///< check the decoded picture hash SEI messages
+  int  maxTemporalLayer;                ///< highest temporal layer to be decoded, -1 for all
+#if JVET_N0278_HLS
+  int  targetLayer;                     ///< layer to be decoded, -1 for all
+#endif
+
+  DecSessionCfg()
+    : numDecThreads               ( 1 )
+    , loopFilterPipelineDepth     ( 0 )
+    , decodedPictureHashSEIEnabled( 0 )
+    , maxTemporalLayer            ( -1 )
+#if JVET_N0278_HLS
+    , targetLayer                 ( -1 )
+#endif
+  {}
+};
+
+/// decoder session, NAL units are pushed in and the decoded pictures are handed to a callback in output order
+/** Each session owns its decoder, so several sessions can be used in one process, also concurrently on different
+    threads. Only field-coded bitstreams are not paired into frames, every field is output as one picture. */
+class DecSession
+{
+public:
+  /// called for every picture in output order, the picture is only valid during the call
+  typedef std::function<void( const Picture& pic )> OutputCallback;
+
+  DecSession();
+  ~DecSession();
+
+  void  create            ( const DecSessionCfg& cfg, OutputCallback outputCallback );
+  void  destroy           ();
+
+  /// decode one NAL unit, without start code prefix and with emulation prevention bytes
+  void  pushNALUnit       ( const uint8_t* data, size_t size );
+  /// decode the NAL units of an Annex-B byte stream, the buffer has to end at a NAL unit boundary
+  void  pushByteStream    ( const uint8_t* data, size_t size );
+  /// end of the bitstream, finishes the last picture and outputs all remaining pictures
+  void  flush             ();
+
+  uint32_t getNumberOfChecksumErrorsDetected() const { return m_decLib.getNumberOfChecksumErrorsDetected(); }
+
+private:
+  void  xDecodeNALUnit    ( const uint8_t* data, size_t size );
+  bool  xIsNaluDecoded    ( const InputNALUnit& nalu ) const;
+  void  xOutputPicture    ( Picture* pic );
+  void  xWriteOutput      ();
+  void  xFlushOutput      ();
+
+  DecLib          m_decLib;
+  DecSessionCfg   m_cfg;
+  OutputCallback  m_outputCallback;
+  bool            m_isCreated;
+  PicList*        m_pcListPic;
+  int             m_iSkipFrame;
+  int             m_iPOCLastDisplay;
+  bool            m_loopFiltered;     ///< the last picture was finished by an end of sequence NAL unit
+};
+
+//! \}
+
+#endif // __DECSESSION__
@@ -49,11 +49,15 @@
 //////////////////////////////////////////////////////////////////////
 
 DecSlice::DecSlice()
+  : m_CABACDecoder( nullptr )
+  , m_pcCuDecoder ( nullptr )
+  , m_threadPool  ( nullptr )
 {
 }
 
 DecSlice::~DecSlice()
 {
+  destroy();
 }
 
 void DecSlice::create()
@@ -62,12 +66,19 @@ void DecSlice::create()
 
 void DecSlice::destroy()
 {
+  for( auto progress: m_substreamProgress )
+  {
+    delete progress;
+  }
+  m_substreamProgress.clear();
+  m_ctuRowSyncContextStates.clear();
 }
 
-void DecSlice::init( CABACDecoder* cabacDecoder, DecCu* pcCuDecoder )
+void DecSlice::init( CABACDecoder* cabacDecoder, DecCu* pcCuDecoder, ThreadPool* threadPool )
 {
   m_CABACDecoder    = cabacDecoder;
   m_pcCuDecoder     = pcCuDecoder;
+  m_threadPool      = threadPool;
 }
 
 void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int debugCTU )
@@ -138,6 +149,34 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
   const unsigned  widthInCtus             = cs.pcv->widthInCtus;
   const bool      wavefrontsEnabled       = cs.pps->getEntropyCodingSyncEnabledFlag();
 
+  const bool decodeCtuRowsParallel = xCanDecodeCtuRowsParallel( slice, numSubstreams, debugCTU );
+#if JVET_N0857_RECT_SLICES
+  const bool decodeBricksParallel  = xCanDecodeBricksParallel ( slice, numSubstreams, debugCTU );
+#else
+  const bool decodeBricksParallel  = false;
+#endif
+
+  if( decodeCtuRowsParallel || decodeBricksParallel )
+  {
+    if( decodeCtuRowsParallel )
+    {
+      xDecompressCtuRowsParallel( slice, ppcSubstreams );
+    }
+#if JVET_N0857_RECT_SLICES
+    else
+    {
+      xDecompressBricksParallel( slice, ppcSubstreams );
+    }
+#endif
+
+    for( auto substr: ppcSubstreams )
+    {
+      delete substr;
+    }
+    slice->stopProcessingTimer();
+    return;
+  }
+
   cabacReader.initBitstream( ppcSubstreams[0] );
   cabacReader.initCtxModels( *slice );
 
@@ -255,9 +294,14 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
       isLastCtuOfSliceSegment = true; // get out here
       break;
     }
-    isLastCtuOfSliceSegment = cabacReader.coding_tree_unit( cs, ctuArea, pic->m_prevQP, ctuRsAddr );
-
-    m_pcCuDecoder->decompressCtu( cs, ctuArea );
+    {
+      DEC_STAGE_TIMER( cs.picture->stageTimes, DEC_STAGE_CABAC );
+      isLastCtuOfSliceSegment = cabacReader.coding_tree_unit( cs, ctuArea, pic->m_prevQP, ctuRsAddr );
+    }
+    {
+      DEC_STAGE_TIMER( cs.picture->stageTimes, DEC_STAGE_RECON );
+      m_pcCuDecoder->decompressCtu( cs, ctuArea );
+    }
 
 #if JVET_N0150_ONE_CTU_DELAY_WPP
     if( ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
@@ -306,4 +350,441 @@ void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int deb
   slice->stopProcessingTimer();
 }
 
+bool DecSlice::xCanDecodeCtuRowsParallel( const Slice* slice, const unsigned numSubstreams, const int debugCTU ) const
+{
+#if ENABLE_TRACING || RExt__DECODER_DEBUG_BIT_STATISTICS
+  // the trace and statistics output relies on the CTU coding order
+  return false;
+#else
+  const PPS&            pps = *slice->getPPS();
+  const PreCalcValues&  pcv = *pps.pcv;
+#if JVET_N0857_TILES_BRICKS
+  const size_t       numTiles = slice->getPic()->brickMap->bricks.size();
+#else
+  const size_t       numTiles = slice->getPic()->tileMap->tiles.size();
+#endif
+  const unsigned  startCtuRow = slice->getSliceCurStartCtuTsAddr() / pcv.widthInCtus;
+
+  // each substream has to hold one CTU row, the substreams are processed in waves
+  return m_threadPool && numSubstreams > 1 && debugCTU < 0
+      && pps.getEntropyCodingSyncEnabledFlag() && numTiles == 1
+#if JVET_N0857_RECT_SLICES
+      && !pps.getRectSliceFlag()
+#endif
+      && !pps.getPpsRangeExtension().getChromaQpOffsetListEnabledFlag() // the CU chroma QP adjustment is stored in the coding structure
+      && startCtuRow + numSubstreams <= pcv.heightInCtus;
+#endif
+}
+
+void DecSlice::xDecompressCtuRowsParallel( Slice* slice, std::vector<InputBitstream*>& substreams )
+{
+  Picture*          pic = slice->getPic();
+  CodingStructure&  cs  = *pic->cs;
+
+  const unsigned numSubstreams = (unsigned) substreams.size();
+  const unsigned startCtuTsAddr = slice->getSliceCurStartCtuTsAddr();
+  const unsigned startCtuRow    = startCtuTsAddr / cs.pcv->widthInCtus;
+  const unsigned startCtuCol    = startCtuTsAddr % cs.pcv->widthInCtus;
+
+  // slice level state, which is otherwise set up while decoding the first CTU
+  if( slice->getSliceType() == B_SLICE )
+  {
+    resetGbiCodingOrder( true, cs );
+  }
+  if( !slice->isIntra() )
+  {
+    pic->mctsInfo.init( &cs, startCtuTsAddr );
+  }
+
+  while( m_substreamProgress.size() < numSubstreams )
+  {
+    m_substreamProgress.push_back( new ProgressCounter );
+  }
+  m_ctuRowSyncContextStates.resize( numSubstreams );
+  for( unsigned idx = 0; idx < numSubstreams; idx++ )
+  {
+    // the CTUs of the first row in front of the slice are decoded already
+    m_substreamProgress[idx]->reset( idx == 0 ? startCtuCol : 0 );
+  }
+
+  cs.startCtuRowParallelism( startCtuRow, numSubstreams );
+
+  for( unsigned idx = 0; idx < numSubstreams; idx++ )
+  {
+    InputBitstream* substream = substreams[idx];
+    m_threadPool->addTask( [this, slice, substream, idx, numSubstreams]( int threadIdx )
+    {
+      xDecompressCtuRow( slice, substream, idx, numSubstreams, threadIdx );
+    } );
+  }
+
+  try
+  {
+    m_threadPool->waitForTasks();
+  }
+  catch( ... )
+  {
+    cs.finishCtuParallelism();
+    throw;
+  }
+
+  cs.finishCtuParallelism();
+
+  pic->m_prevQP[0] = pic->m_prevQP[1] = slice->getSliceQp();
+}
+
+void DecSlice::xDecompressCtuRow( Slice* slice, InputBitstream* substream, const unsigned substreamIdx, const unsigned numSubstreams, const int threadIdx )
+{
+  Picture*          pic         = slice->getPic();
+  CodingStructure&  cs          = *pic->cs;
+  CABACReader&      cabacReader = *m_CABACDecoder[threadIdx].getCABACReader( 0 );
+  DecCu&            cuDecoder   = m_pcCuDecoder[threadIdx];
+
+  const unsigned  widthInCtus = cs.pcv->widthInCtus;
+  const unsigned  maxCUSize   = cs.sps->getMaxCUWidth();
+  const unsigned  startCtuTsAddr = slice->getSliceCurStartCtuTsAddr();
+  const unsigned  ctuYPosInCtus  = startCtuTsAddr / widthInCtus + substreamIdx;
+  const unsigned  startCtuXPos   = substreamIdx == 0 ? startCtuTsAddr % widthInCtus : 0;
+  const bool      isLastSubstream = substreamIdx + 1 == numSubstreams;
+
+  int prevQP[MAX_NUM_CHANNEL_TYPE] = { slice->getSliceQp(), slice->getSliceQp() };
+
+  try
+  {
+    cabacReader.initBitstream( substream );
+    cabacReader.initCtxModels( *slice );
+
+    bool isLastCtuOfSliceSegment = false;
+
+    for( unsigned ctuXPosInCtus = startCtuXPos; ctuXPosInCtus < widthInCtus; ctuXPosInCtus++ )
+    {
+      const unsigned  ctuRsAddr = ctuYPosInCtus * widthInCtus + ctuXPosInCtus;
+      Position pos( ctuXPosInCtus*maxCUSize, ctuYPosInCtus*maxCUSize );
+      UnitArea ctuArea( cs.area.chromaFormat, Area( pos.x, pos.y, maxCUSize, maxCUSize ) );
+
+      // wait until the CTU above is decoded
+      if( substreamIdx > 0 && !m_substreamProgress[substreamIdx - 1]->wait( ctuXPosInCtus + 1 ) )
+      {
+        // decoding of a preceding CTU row failed
+        for( unsigned idx = substreamIdx; idx < numSubstreams; idx++ )
+        {
+          m_substreamProgress[idx]->abort();
+        }
+        return;
+      }
+
+      if( ctuXPosInCtus == 0 )
+      {
+        // Synchronize cabac probabilities with the upper CTU if it's available and at the start of a line.
+#if JVET_N0857_TILES_BRICKS
+        const unsigned tileIdx = pic->brickMap->getBrickIdxRsMap( pos );
+#else
+        const unsigned tileIdx = pic->tileMap->getTileIdxMap( pos );
+#endif
+#if JVET_N0150_ONE_CTU_DELAY_WPP
+        if( substreamIdx > 0 && cs.getCURestricted( pos.offset( 0, -1 ), pos, slice->getIndependentSliceIdx(), tileIdx, CH_L ) )
+#else
+        if( substreamIdx > 0 && cs.getCURestricted( pos.offset( maxCUSize, -1 ), slice->getIndependentSliceIdx(), tileIdx, CH_L ) )
+#endif
+        {
+          cabacReader.getCtx() = m_ctuRowSyncContextStates[substreamIdx - 1];
+        }
+
+        if( slice->getSliceType() != I_SLICE || cs.sps->getIBCFlag() )
+        {
+          LutMotionCand& motionLut = cs.getMotionLut( pos );
+          motionLut.lut.resize( 0 );
+          motionLut.lutIbc.resize( 0 );
+#if !JVET_N0266_SMALL_BLOCKS
+          motionLut.lutShare.resize( 0 );
+#endif
+          motionLut.lutShareIbc.resize( 0 );
+        }
+      }
+
+      {
+        DEC_STAGE_TIMER( cs.picture->stageTimes, DEC_STAGE_CABAC );
+        isLastCtuOfSliceSegment = cabacReader.coding_tree_unit( cs, ctuArea, prevQP, ctuRsAddr );
+      }
+      {
+        DEC_STAGE_TIMER( cs.picture->stageTimes, DEC_STAGE_RECON );
+        cuDecoder.decompressCtu( cs, ctuArea );
+      }
+
+#if JVET_N0150_ONE_CTU_DELAY_WPP
+      if( ctuXPosInCtus == 0 )
+#else
+      if( ctuXPosInCtus == 1 )
+#endif
+      {
+        m_ctuRowSyncContextStates[substreamIdx] = cabacReader.getCtx();
+      }
+
+      if( isLastCtuOfSliceSegment )
+      {
+        CHECK( !isLastSubstream, "Slice segment ended before its last substream" );
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+        cabacReader.remaining_bytes( false );
+#endif
+        slice->setSliceCurEndCtuTsAddr( ctuRsAddr + 1 );
+      }
+      else if( ctuXPosInCtus + 1 == widthInCtus )
+      {
+        // The sub-stream should be terminated after this CTU (end of wavefront-CTU-row).
+        unsigned binVal = cabacReader.terminating_bit();
+        CHECK( !binVal, "Expecting a terminating bit" );
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+        cabacReader.remaining_bytes( true );
+#endif
+      }
+
+      m_substreamProgress[substreamIdx]->set( ctuXPosInCtus + 1 );
+
+      if( isLastCtuOfSliceSegment )
+      {
+        break;
+      }
+    }
+
+    CHECK( isLastSubstream && !isLastCtuOfSliceSegment, "Last CTU of slice segment not signalled as such" );
+  }
+  catch( ... )
+  {
+    // release the threads waiting for the following CTU rows
+    for( unsigned idx = substreamIdx; idx < numSubstreams; idx++ )
+    {
+      m_substreamProgress[idx]->abort();
+    }
+    throw;
+  }
+}
+
+#if JVET_N0857_RECT_SLICES
+bool DecSlice::xCanDecodeBricksParallel( const Slice* slice, const unsigned numSubstreams, const int debugCTU ) const
+{
+#if ENABLE_TRACING || RExt__DECODER_DEBUG_BIT_STATISTICS
+  // the trace and statistics output relies on the CTU coding order
+  return false;
+#else
+  const PPS& pps = *slice->getPPS();
+
+  // each substream has to hold one brick, wavefronts inside of the bricks are not combined with it
+  return m_threadPool && numSubstreams > 1 && debugCTU < 0
+      && !pps.getEntropyCodingSyncEnabledFlag()
+      && !slice->getSPS()->getIBCFlag()                                  // the IBC reference area is not limited to the brick
+      && !pps.getPpsRangeExtension().getChromaQpOffsetListEnabledFlag(); // the CU chroma QP adjustment is stored in the coding structure
+#endif
+}
+
+void DecSlice::xDecompressBricksParallel( Slice* slice, std::vector<InputBitstream*>& substreams )
+{
+  Picture*          pic      = slice->getPic();
+  CodingStructure&  cs       = *pic->cs;
+  const BrickMap&   brickMap = *pic->brickMap;
+
+  const unsigned numSubstreams  = (unsigned) substreams.size();
+  const unsigned widthInCtus    = cs.pcv->widthInCtus;
+  const unsigned startCtuTsAddr = slice->getSliceCurStartCtuTsAddr();
+  const unsigned endCtuTsAddr   = slice->getSliceCurEndCtuTsAddr();
+  const bool     rectSlice      = slice->getPPS()->getRectSliceFlag();
+
+  // collect the bricks of the slice in decoding order, each of them is coded in its own substream
+  const uint32_t startSliceRsAddr = brickMap.getCtuBsToRsAddrMap( startCtuTsAddr );
+  const uint32_t endSliceRsAddr   = brickMap.getCtuBsToRsAddrMap( endCtuTsAddr - 1 );
+  std::vector<int> ctuBrickLanes( cs.pcv->sizeInCtus, -1 );
+
+  m_sliceBricks.clear();
+  for( unsigned ctuTsAddr = startCtuTsAddr; ctuTsAddr < endCtuTsAddr; ctuTsAddr++ )
+  {
+    const unsigned ctuRsAddr = brickMap.getCtuBsToRsAddrMap( ctuTsAddr );
+    if( rectSlice &&
+      ( ctuRsAddr / widthInCtus < startSliceRsAddr / widthInCtus || ctuRsAddr / widthInCtus > endSliceRsAddr / widthInCtus ||
+        ctuRsAddr % widthInCtus < startSliceRsAddr % widthInCtus || ctuRsAddr % widthInCtus > endSliceRsAddr % widthInCtus ) )
+    {
+      continue;
+    }
+
+    const Brick* brick = &brickMap.bricks[brickMap.getBrickIdxRsMap( ctuRsAddr )];
+    if( m_sliceBricks.empty() || m_sliceBricks.back().brick != brick )
+    {
+      m_sliceBricks.push_back( SliceBrick{ brick, -1, -1, 0 } );
+    }
+    ctuBrickLanes[ctuRsAddr] = (int) m_sliceBricks.size() - 1;
+  }
+  CHECK( m_sliceBricks.size() != numSubstreams, "Each brick of the slice has to be coded in its own substream" );
+
+  // The bricks are decoded independently, except for two dependencies of the decoding process:
+  // the HMVP tables are only reset at the left picture boundary, so a brick starting in another
+  // column continues with the table of the preceding brick, and the QP of the first quantization
+  // group in a CTU at the left picture boundary is predicted from the CU above, even across bricks.
+  const bool usesMotionLut = slice->getSliceType() != I_SLICE;
+
+  for( int idx = 0; idx < (int) m_sliceBricks.size(); idx++ )
+  {
+    SliceBrick&    sliceBrick = m_sliceBricks[idx];
+    const unsigned firstCtu   = sliceBrick.brick->getFirstCtuRsAddr();
+
+    if( firstCtu % widthInCtus != 0 )
+    {
+      sliceBrick.lutPredecessor = usesMotionLut && idx > 0 ? idx - 1 : -1;
+    }
+    else if( firstCtu >= widthInCtus && ctuBrickLanes[firstCtu - widthInCtus] >= 0 )
+    {
+      const int    aboveIdx   = ctuBrickLanes[firstCtu - widthInCtus];
+      const Brick& aboveBrick = *m_sliceBricks[aboveIdx].brick;
+
+      sliceBrick.qpPredecessor     = aboveIdx;
+      sliceBrick.qpPredecessorCtus = ( aboveBrick.getHeightInCtus() - 1 ) * aboveBrick.getWidthInCtus() + 1;
+    }
+  }
+
+  // slice level state, which is otherwise set up while decoding the first CTU
+  if( slice->getSliceType() == B_SLICE )
+  {
+    resetGbiCodingOrder( true, cs );
+  }
+  if( !slice->isIntra() )
+  {
+    pic->mctsInfo.init( &cs, startSliceRsAddr );
+  }
+
+  while( m_substreamProgress.size() < numSubstreams )
+  {
+    m_substreamProgress.push_back( new ProgressCounter );
+  }
+  for( unsigned idx = 0; idx < numSubstreams; idx++ )
+  {
+    m_substreamProgress[idx]->reset();
+  }
+
+  cs.startBrickParallelism( ctuBrickLanes, numSubstreams );
+
+  for( unsigned idx = 0; idx < numSubstreams; idx++ )
+  {
+    InputBitstream* substream = substreams[idx];
+    m_threadPool->addTask( [this, slice, substream, idx]( int threadIdx )
+    {
+      xDecompressBrick( slice, substream, idx, threadIdx );
+    } );
+  }
+
+  try
+  {
+    m_threadPool->waitForTasks();
+  }
+  catch( ... )
+  {
+    cs.finishCtuParallelism();
+    throw;
+  }
+
+  cs.finishCtuParallelism();
+
+  pic->m_prevQP[0] = pic->m_prevQP[1] = slice->getSliceQp();
+}
+
+void DecSlice::xDecompressBrick( Slice* slice, InputBitstream* substream, const unsigned sliceBrickIdx, const int threadIdx )
+{
+  Picture*          pic         = slice->getPic();
+  CodingStructure&  cs          = *pic->cs;
+  CABACReader&      cabacReader = *m_CABACDecoder[threadIdx].getCABACReader( 0 );
+  DecCu&            cuDecoder   = m_pcCuDecoder[threadIdx];
+  const SliceBrick& sliceBrick  = m_sliceBricks[sliceBrickIdx];
+  const Brick&      brick       = *sliceBrick.brick;
+  ProgressCounter&  progress    = *m_substreamProgress[sliceBrickIdx];
+
+  const unsigned  widthInCtus     = cs.pcv->widthInCtus;
+  const unsigned  maxCUSize       = cs.sps->getMaxCUWidth();
+  const unsigned  brickXPosInCtus = brick.getFirstCtuRsAddr() % widthInCtus;
+  const unsigned  brickYPosInCtus = brick.getFirstCtuRsAddr() / widthInCtus;
+  const unsigned  numCtusInBrick  = brick.getWidthInCtus() * brick.getHeightInCtus();
+  const bool      isLastBrick     = sliceBrickIdx + 1 == m_sliceBricks.size();
+  const bool      usesMotionLut   = slice->getSliceType() != I_SLICE;
+
+  int prevQP[MAX_NUM_CHANNEL_TYPE] = { slice->getSliceQp(), slice->getSliceQp() };
+
+  try
+  {
+    // wait for the state of the preceding bricks the decoding process depends on
+    const Brick* lutBrick = sliceBrick.lutPredecessor >= 0 ? m_sliceBricks[sliceBrick.lutPredecessor].brick : nullptr;
+
+    if( ( sliceBrick.qpPredecessor >= 0 && !m_substreamProgress[sliceBrick.qpPredecessor]->wait( sliceBrick.qpPredecessorCtus ) ) ||
+        ( lutBrick && !m_substreamProgress[sliceBrick.lutPredecessor]->wait( lutBrick->getWidthInCtus() * lutBrick->getHeightInCtus() ) ) )
+    {
+      // decoding of a preceding brick failed
+      progress.abort();
+      return;
+    }
+    if( lutBrick )
+    {
+      const unsigned lutCtuRsAddr = lutBrick->getFirstCtuRsAddr();
+      cs.getMotionLut( Position( brickXPosInCtus * maxCUSize, brickYPosInCtus * maxCUSize ) ) =
+        cs.getMotionLut( Position( ( lutCtuRsAddr % widthInCtus ) * maxCUSize, ( lutCtuRsAddr / widthInCtus ) * maxCUSize ) );
+    }
+
+    cabacReader.initBitstream( substream );
+    cabacReader.initCtxModels( *slice );
+
+    bool isLastCtuOfSliceSegment = false;
+
+    for( unsigned ctuIdx = 0; ctuIdx < numCtusInBrick && !isLastCtuOfSliceSegment; ctuIdx++ )
+    {
+      const unsigned  ctuXPosInCtus = brickXPosInCtus + ctuIdx % brick.getWidthInCtus();
+      const unsigned  ctuYPosInCtus = brickYPosInCtus + ctuIdx / brick.getWidthInCtus();
+      const unsigned  ctuRsAddr     = ctuYPosInCtus * widthInCtus + ctuXPosInCtus;
+      Position pos( ctuXPosInCtus*maxCUSize, ctuYPosInCtus*maxCUSize );
+      UnitArea ctuArea( cs.area.chromaFormat, Area( pos.x, pos.y, maxCUSize, maxCUSize ) );
+
+      if( usesMotionLut && ctuXPosInCtus == 0 )
+      {
+        LutMotionCand& motionLut = cs.getMotionLut( pos );
+        motionLut.lut.resize( 0 );
+        motionLut.lutIbc.resize( 0 );
+#if !JVET_N0266_SMALL_BLOCKS
+        motionLut.lutShare.resize( 0 );
+#endif
+        motionLut.lutShareIbc.resize( 0 );
+      }
+
+      {
+        DEC_STAGE_TIMER( cs.picture->stageTimes, DEC_STAGE_CABAC );
+        isLastCtuOfSliceSegment = cabacReader.coding_tree_unit( cs, ctuArea, prevQP, ctuRsAddr );
+      }
+      {
+        DEC_STAGE_TIMER( cs.picture->stageTimes, DEC_STAGE_RECON );
+        cuDecoder.decompressCtu( cs, ctuArea );
+      }
+
+      if( isLastCtuOfSliceSegment )
+      {
+        CHECK( !isLastBrick || ctuIdx + 1 != numCtusInBrick, "Slice segment ended before its last brick" );
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+        cabacReader.remaining_bytes( false );
+#endif
+        slice->setSliceCurEndCtuTsAddr( pic->brickMap->getCtuRsToBsAddrMap( ctuRsAddr ) + 1 );
+      }
+      else if( ctuIdx + 1 == numCtusInBrick )
+      {
+        // The sub-stream should be terminated after this CTU (end of brick).
+        unsigned binVal = cabacReader.terminating_bit();
+        CHECK( !binVal, "Expecting a terminating bit" );
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+        cabacReader.remaining_bytes( true );
+#endif
+      }
+
+      progress.set( ctuIdx + 1 );
+    }
+
+    CHECK( isLastBrick && !isLastCtuOfSliceSegment, "Last CTU of slice segment not signalled as such" );
+  }
+  catch( ... )
+  {
+    // release the bricks waiting for this one
+    progress.abort();
+    throw;
+  }
+}
+#endif
+
 //! \}
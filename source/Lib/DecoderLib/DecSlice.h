@@ -44,6 +44,7 @@
 
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/BitStream.h"
+#include "CommonLib/ThreadPool.h"
 #include "DecCu.h"
 #include "CABACReader.h"
 
@@ -58,21 +59,47 @@
 class DecSlice
 {
 private:
-  // access channel
+  // access channel, one instance per thread of the thread pool
   CABACDecoder*   m_CABACDecoder;
   DecCu*          m_pcCuDecoder;
+  ThreadPool*     m_threadPool;
 
   Ctx             m_entropyCodingSyncContextState;      ///< context storage for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row
 
+  // wavefront and brick parallel decoding
+  std::vector<Ctx>              m_ctuRowSyncContextStates;  ///< synchronization contexts, one per substream (CTU row)
+  std::vector<ProgressCounter*> m_substreamProgress;        ///< number of decoded CTUs per substream (CTU row or brick)
+
+#if JVET_N0857_RECT_SLICES
+  struct SliceBrick
+  {
+    const Brick* brick;
+    int          lutPredecessor;     ///< brick of the slice whose final HMVP table is continued, -1 if none
+    int          qpPredecessor;      ///< brick of the slice holding the CTU above the first CTU, -1 if none
+    unsigned     qpPredecessorCtus;  ///< number of CTUs of that brick up to the CTU above
+  };
+  std::vector<SliceBrick>       m_sliceBricks;              ///< bricks of the current slice in decoding order
+#endif
+
 public:
   DecSlice();
   virtual ~DecSlice();
 
-  void  init              ( CABACDecoder* cabacDecoder, DecCu* pcMbDecoder );
+  void  init              ( CABACDecoder* cabacDecoder, DecCu* pcMbDecoder, ThreadPool* threadPool = nullptr );
   void  create            ();
   void  destroy           ();
 
   void  decompressSlice   ( Slice* slice, InputBitstream* bitstream, int debugCTU );
+
+private:
+  bool  xCanDecodeCtuRowsParallel( const Slice* slice, const unsigned numSubstreams, const int debugCTU ) const;
+  void  xDecompressCtuRowsParallel( Slice* slice, std::vector<InputBitstream*>& substreams );
+  void  xDecompressCtuRow         ( Slice* slice, InputBitstream* substream, const unsigned substreamIdx, const unsigned numSubstreams, const int threadIdx );
+#if JVET_N0857_RECT_SLICES
+  bool  xCanDecodeBricksParallel  ( const Slice* slice, const unsigned numSubstreams, const int debugCTU ) const;
+  void  xDecompressBricksParallel ( Slice* slice, std::vector<InputBitstream*>& substreams );
+  void  xDecompressBrick          ( Slice* slice, InputBitstream* substream, const unsigned sliceBrickIdx, const int threadIdx );
+#endif
 };
 
 //! \}
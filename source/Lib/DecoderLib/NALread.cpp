@@ -40,6 +40,7 @@
 #include <vector>
 #include <algorithm>
 #include <ostream>
+#include <cstring>
 
 #include "NALread.h"
 
@@ -59,30 +60,46 @@ using namespace std;
 static void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, InputBitstream *bitstream, bool isVclNalUnit)
 {
   uint32_t zeroCount = 0;
-  vector<uint8_t>::iterator it_read, it_write;
+  uint8_t* buf       = nalUnitBuf.data();
+  size_t   size      = nalUnitBuf.size();
+  size_t   read      = 0;
+  size_t   write     = 0;
 
-  uint32_t pos = 0;
   bitstream->clearEmulationPreventionByteLocation();
-  for (it_read = it_write = nalUnitBuf.begin(); it_read != nalUnitBuf.end(); it_read++, it_write++, pos++)
+  while (read < size)
   {
-    CHECK(zeroCount >= 2 && *it_read < 0x03, "Zero count is '2' and read value is small than '3'");
-    if (zeroCount == 2 && *it_read == 0x03)
+    if (zeroCount == 0)
     {
-      bitstream->pushEmulationPreventionByteLocation( pos );
-      pos++;
-      it_read++;
+      // move the bytes up to the next 0x0000 followed by a byte <= 0x03 at once
+      const size_t next = g_bitstreamOps.findEmulationPrevention(buf, read, size);
+      if (write != read)
+      {
+        memmove(buf + write, buf + read, next - read);
+      }
+      write += next - read;
+      read   = next;
+      if (read == size)
+      {
+        break;
+      }
+    }
+    CHECK(zeroCount >= 2 && buf[read] < 0x03, "Zero count is '2' and read value is small than '3'");
+    if (zeroCount == 2 && buf[read] == 0x03)
+    {
+      bitstream->pushEmulationPreventionByteLocation( uint32_t( read ) );
+      read++;
       zeroCount = 0;
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
       CodingStatistics::IncrementStatisticEP(STATS__EMULATION_PREVENTION_3_BYTES, 8, 0);
 #endif
-      if (it_read == nalUnitBuf.end())
+      if (read == size)
       {
         break;
       }
-      CHECK(*it_read > 0x03, "Read a value bigger than '3'");
+      CHECK(buf[read] > 0x03, "Read a value bigger than '3'");
     }
-    zeroCount = (*it_read == 0x00) ? zeroCount+1 : 0;
-    *it_write = *it_read;
+    zeroCount = (buf[read] == 0x00) ? zeroCount+1 : 0;
+    buf[write++] = buf[read++];
   }
   CHECK(zeroCount != 0, "Zero count not '0'");
 
@@ -91,9 +108,9 @@ static void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, InputBitstream *bi
     // Remove cabac_zero_word from payload if present
     int n = 0;
 
-    while (it_write[-1] == 0x00)
+    while (buf[write - 1] == 0x00)
     {
-      it_write--;
+      write--;
       n++;
     }
 
@@ -103,7 +120,7 @@ static void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, InputBitstream *bi
     }
   }
 
-  nalUnitBuf.resize(it_write - nalUnitBuf.begin());
+  nalUnitBuf.resize(write);
 }
 
 #if ENABLE_TRACING
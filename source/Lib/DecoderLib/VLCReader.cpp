@@ -127,23 +127,13 @@ void VLCReader::xReadUvlc( uint32_t& ruiVal)
 #endif
 {
   uint32_t uiVal = 0;
-  uint32_t uiCode = 0;
-  uint32_t uiLength;
-  m_pcBitstream->read( 1, uiCode );
+  uint32_t uiLength = m_pcBitstream->readExpGolombPrefix();
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   uint32_t totalLen=1;
 #endif
 
-  if( 0 == uiCode )
+  if( uiLength )
   {
-    uiLength = 0;
-
-    while( ! ( uiCode & 1 ))
-    {
-      m_pcBitstream->read( 1, uiCode );
-      uiLength++;
-    }
-
     m_pcBitstream->read( uiLength, uiVal );
 
     uiVal += (1 << uiLength)-1;
@@ -165,20 +155,12 @@ void VLCReader::xReadSvlc( int& riVal)
 #endif
 {
   uint32_t uiBits = 0;
-  m_pcBitstream->read( 1, uiBits );
+  uint32_t uiLength = m_pcBitstream->readExpGolombPrefix();
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   uint32_t totalLen=1;
 #endif
-  if( 0 == uiBits )
+  if( uiLength )
   {
-    uint32_t uiLength = 0;
-
-    while( ! ( uiBits & 1 ))
-    {
-      m_pcBitstream->read( 1, uiBits );
-      uiLength++;
-    }
-
     m_pcBitstream->read( uiLength, uiBits );
 
     uiBits += (1 << uiLength);
@@ -189,6 +171,7 @@ void VLCReader::xReadSvlc( int& riVal)
   }
   else
   {
+    uiBits = 1;
     riVal = 0;
   }
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
@@ -3671,7 +3654,7 @@ void HLSyntaxReader::alfFilter( AlfSliceParam& alfSliceParam, const bool isChrom
   READ_UVLC( code, isChroma ? "alf_chroma_min_eg_order_minus1" : "alf_luma_min_eg_order_minus1" );
 
   int kMin = code + 1;
-  static int kMinTab[MAX_NUM_ALF_COEFF];
+  int kMinTab[MAX_NUM_ALF_COEFF];
   const int numFilters = isChroma ? 1 : alfSliceParam.numLumaFilters;
   short* coeff = isChroma ? alfSliceParam.chromaCoeff : alfSliceParam.lumaCoeff;
 #if JVET_N0242_NON_LINEAR_ALF
@@ -44,7 +44,6 @@
 #else
 #define AlfCtx(c) SubCtx( Ctx::ctbAlfFlag, c )
 #endif
-std::vector<double> EncAdaptiveLoopFilter::m_lumaLevelToWeightPLUT;
 
 #if JVET_N0242_NON_LINEAR_ALF
 void AlfCovariance::getClipMax(const AlfFilterShape& alfShape, int *clip_max) const
@@ -1546,8 +1545,8 @@ double EncAdaptiveLoopFilter::mergeFiltersAndCost( AlfSliceParam& alfSliceParam,
 {
   int numFiltersBest = 0;
   int numFilters = MAX_NUM_ALF_CLASSES;
-  static bool codedVarBins[MAX_NUM_ALF_CLASSES];
-  static double errorForce0CoeffTab[MAX_NUM_ALF_CLASSES][2];
+  static thread_local bool codedVarBins[MAX_NUM_ALF_CLASSES];
+  static thread_local double errorForce0CoeffTab[MAX_NUM_ALF_CLASSES][2];
 
   double cost, cost0, dist, distForce0, costMin = MAX_DOUBLE;
   int predMode = 0, bestPredMode = 0, coeffBits, coeffBitsForce0;
@@ -1975,7 +1974,7 @@ int EncAdaptiveLoopFilter::lengthFilterClipps( AlfFilterShape& alfShape, const i
 #endif
 double EncAdaptiveLoopFilter::getDistForce0( AlfFilterShape& alfShape, const int numFilters, double errorTabForce0Coeff[MAX_NUM_ALF_CLASSES][2], bool* codedVarBins )
 {
-  static int bitsVarBin[MAX_NUM_ALF_CLASSES];
+  static thread_local int bitsVarBin[MAX_NUM_ALF_CLASSES];
 
   memset( m_bitsCoeffScan, 0, sizeof( m_bitsCoeffScan ) );
   for( int ind = 0; ind < numFilters; ++ind )
@@ -2305,9 +2304,9 @@ double EncAdaptiveLoopFilter::deriveCoeffQuant( int *filterCoeffQuant, double **
 #if JVET_N0242_NON_LINEAR_ALF
 const int numCoeff = shape.numCoeff;
 #else
-  static int filterCoeffQuantMod[MAX_NUM_ALF_LUMA_COEFF];
+  static thread_local int filterCoeffQuantMod[MAX_NUM_ALF_LUMA_COEFF];
 #endif
-  static double filterCoeff[MAX_NUM_ALF_LUMA_COEFF];
+  static thread_local double filterCoeff[MAX_NUM_ALF_LUMA_COEFF];
 
 #if JVET_N0242_NON_LINEAR_ALF
   cov.optimizeFilter( shape, filterClipp, filterCoeff, optimizeClip );
@@ -2536,14 +2535,14 @@ void EncAdaptiveLoopFilter::mergeClasses( AlfCovariance* cov, AlfCovariance* cov
 #endif
 {
 #if JVET_N0242_NON_LINEAR_ALF
-  static int tmpClip[MAX_NUM_ALF_LUMA_COEFF];
-  static int bestMergeClip[MAX_NUM_ALF_LUMA_COEFF];
-  static double err[MAX_NUM_ALF_CLASSES];
-  static double bestMergeErr;
+  static thread_local int tmpClip[MAX_NUM_ALF_LUMA_COEFF];
+  static thread_local int bestMergeClip[MAX_NUM_ALF_LUMA_COEFF];
+  static thread_local double err[MAX_NUM_ALF_CLASSES];
+  static thread_local double bestMergeErr;
 #endif
-  static bool availableClass[MAX_NUM_ALF_CLASSES];
-  static uint8_t indexList[MAX_NUM_ALF_CLASSES];
-  static uint8_t indexListTemp[MAX_NUM_ALF_CLASSES];
+  static thread_local bool availableClass[MAX_NUM_ALF_CLASSES];
+  static thread_local uint8_t indexList[MAX_NUM_ALF_CLASSES];
+  static thread_local uint8_t indexListTemp[MAX_NUM_ALF_CLASSES];
   int numRemaining = numClasses;
 
   memset( filterIndices, 0, sizeof( short ) * MAX_NUM_ALF_CLASSES * MAX_NUM_ALF_CLASSES );
@@ -2988,11 +2987,11 @@ void EncAdaptiveLoopFilter::getBlkStats(AlfCovariance* alfCovariace, const AlfFi
 
 {
 #if JVET_N0242_NON_LINEAR_ALF
-  static int ELocal[MAX_NUM_ALF_LUMA_COEFF][MaxAlfNumClippingValues];
+  static thread_local int ELocal[MAX_NUM_ALF_LUMA_COEFF][MaxAlfNumClippingValues];
 
   const int numBins = AlfNumClippingValues[channel];
 #else
-  static int ELocal[MAX_NUM_ALF_LUMA_COEFF];
+  static thread_local int ELocal[MAX_NUM_ALF_LUMA_COEFF];
 #endif
 
   int transposeIdx = 0;
@@ -3428,7 +3427,7 @@ void EncAdaptiveLoopFilter::calcCovariance(int *ELocal, const Pel *rec, const in
 #if !JVET_N0242_NON_LINEAR_ALF
 double EncAdaptiveLoopFilter::calculateError( AlfCovariance& cov )
 {
-  static double c[MAX_NUM_ALF_COEFF];
+  static thread_local double c[MAX_NUM_ALF_COEFF];
 
   gnsSolveByChol( cov.E, cov.y, c, cov.numCoeff );
 
@@ -3452,7 +3451,7 @@ double EncAdaptiveLoopFilter::calculateError( AlfCovariance& cov )
 //Find filter coeff related
 int EncAdaptiveLoopFilter::gnsCholeskyDec( double **inpMatr, double outMatr[MAX_NUM_ALF_COEFF][MAX_NUM_ALF_COEFF], int numEq )
 {
-  static double invDiag[MAX_NUM_ALF_COEFF];  /* Vector of the inverse of diagonal entries of outMatr */
+  static thread_local double invDiag[MAX_NUM_ALF_COEFF];  /* Vector of the inverse of diagonal entries of outMatr */
 
   for( int i = 0; i < numEq; i++ )
   {
@@ -3526,8 +3525,8 @@ void EncAdaptiveLoopFilter::gnsBacksubstitution( double R[MAX_NUM_ALF_COEFF][MAX
 
 int EncAdaptiveLoopFilter::gnsSolveByChol( double **LHS, double *rhs, double *x, int numEq )
 {
-  static double aux[MAX_NUM_ALF_COEFF];     /* Auxiliary vector */
-  static double U[MAX_NUM_ALF_COEFF][MAX_NUM_ALF_COEFF];    /* Upper triangular Cholesky factor of LHS */
+  static thread_local double aux[MAX_NUM_ALF_COEFF];     /* Auxiliary vector */
+  static thread_local double U[MAX_NUM_ALF_COEFF][MAX_NUM_ALF_COEFF];    /* Upper triangular Cholesky factor of LHS */
   int res = 1;  // Signal that Cholesky factorization is successfully performed
 
                 /* The equation to be solved is LHSx = rhs */
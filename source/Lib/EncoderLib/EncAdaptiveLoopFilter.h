@@ -317,7 +317,7 @@ public:
   static constexpr int   m_MAX_EXP_GOLOMB = 16;
   int m_alfWSSD;
   inline void           setAlfWSSD(int alfWSSD) { m_alfWSSD = alfWSSD; }
-  static std::vector<double>  m_lumaLevelToWeightPLUT;
+  std::vector<double>  m_lumaLevelToWeightPLUT;
   inline std::vector<double>& getLumaLevelWeightTable() { return m_lumaLevelToWeightPLUT; }
 
 private:
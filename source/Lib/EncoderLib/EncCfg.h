@@ -759,6 +759,7 @@ protected:
   int         m_numWppThreads;
   int         m_numWppExtraLines;
   bool        m_ensureWppBitEqual;
+  int         m_numFrameThreads;
 #endif
 
   bool        m_alf;                                          ///< Adaptive Loop Filter
@@ -1837,6 +1838,8 @@ public:
   int          getNumWppExtraLines()                           const { return m_numWppExtraLines; }
   void         setEnsureWppBitEqual( bool b)                         { m_ensureWppBitEqual = b; }
   bool         getEnsureWppBitEqual()                          const { return m_ensureWppBitEqual; }
+  void         setNumFrameThreads( int n )                           { m_numFrameThreads = n; }
+  int          getNumFrameThreads()                            const { return m_numFrameThreads; }
 #endif
   void        setUseALF( bool b ) { m_alf = b; }
   bool        getUseALF()                                      const { return m_alf; }
@@ -52,10 +52,6 @@
 #include <stdio.h>
 #include <cmath>
 #include <algorithm>
-#if ENABLE_WPP_PARALLELISM
-#include <mutex>
-extern std::recursive_mutex g_cache_mutex;
-#endif
 
 
 
@@ -269,7 +265,11 @@ void EncCu::init( EncLib* pcEncLib, const SPS& sps PARL_PARAM( const int tId ) )
   m_CABACEstimator->setEncCu(this);
   m_CtxCache           = pcEncLib->getCtxCache( PARL_PARAM0( tId ) );
   m_pcRateCtrl         = pcEncLib->getRateCtrl();
+#if ENABLE_WPP_PARALLELISM
+  m_pcSliceEncoder     = pcEncLib->getSliceEncoder( tId / pcEncLib->getNumPicCuEncStacks() );
+#else
   m_pcSliceEncoder     = pcEncLib->getSliceEncoder();
+#endif
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   m_pcEncLib           = pcEncLib;
   m_dataId             = tId;
@@ -632,7 +632,7 @@ void EncCu::xCompressCU( CodingStructure *&tempCS, CodingStructure *&bestCS, Par
     {
       for (int jId = 1; jId < NUM_RESERVERD_SPLIT_JOBS; jId++)
       {
-        auto slsSbt = dynamic_cast<SaveLoadEncInfoSbt *>(m_pcEncLib->getCuEncoder(jId)->m_modeCtrl);
+        auto slsSbt = dynamic_cast<SaveLoadEncInfoSbt *>(m_pcEncLib->getCuEncoder(tempCS->picture->scheduler.getSplitDataId(jId))->m_modeCtrl);
         slsSbt->resetSaveloadSbt(maxSLSize);
       }
     }
@@ -928,8 +928,6 @@ void EncCu::updateLambda (Slice* slice, const int dQP, const bool updateRdCostLa
 #endif
 
 #if ENABLE_SPLIT_PARALLELISM
-//#undef DEBUG_PARALLEL_TIMINGS
-//#define DEBUG_PARALLEL_TIMINGS 1
 void EncCu::xCompressCUParallel( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner )
 {
   const unsigned wIdx = gp_sizeIdxInfo->idxFrom( partitioner.currArea().lwidth() );
@@ -945,22 +943,20 @@ void EncCu::xCompressCUParallel( CodingStructure *&tempCS, CodingStructure *&bes
   const UnitArea currArea = CS::getArea( *tempCS, partitioner.currArea(), partitioner.chType );
 #if ENABLE_WPP_PARALLELISM
   const int      wppTId   = picture->scheduler.getWppThreadId();
-#endif
-  const bool doParallel   = !m_pcEncCfg->getForceSingleSplitThread();
-#if _MSC_VER && ENABLE_WPP_PARALLELISM
-#pragma omp parallel for schedule(dynamic,1) num_threads(NUM_SPLIT_THREADS_IF_MSVC) if(doParallel)
+  ThreadPool*    splitThreadPool = m_pcEncLib->getSplitThreadPool( wppTId );
 #else
-  omp_set_num_threads( m_pcEncCfg->getNumSplitThreads() );
-
-#pragma omp parallel for schedule(dynamic,1) if(doParallel)
+  ThreadPool*    splitThreadPool = m_pcEncLib->getSplitThreadPool( 0 );
 #endif
-  for( int jId = 1; jId <= numJobs; jId++ )
+
+  // every job evaluates a group of split candidates on its own encoder stack, which is reused by all parallel CUs
+  auto evalJob = [&]( const int splitTId, const int jobIdx )
   {
-    // thread start
+    const int jId = jobIdx + 1;
+
 #if ENABLE_WPP_PARALLELISM
     picture->scheduler.setWppThreadId( wppTId );
 #endif
-    picture->scheduler.setSplitThreadId();
+    picture->scheduler.setSplitThreadId( splitTId );
     picture->scheduler.setSplitJobId( jId );
 
     Partitioner* jobPartitioner = PartitionerFactory::get( *tempCS->slice );
@@ -988,7 +984,19 @@ void EncCu::xCompressCUParallel( CodingStructure *&tempCS, CodingStructure *&bes
     delete jobPartitioner;
 
     picture->scheduler.setSplitJobId( 0 );
-    // thread stop
+  };
+
+  if( splitThreadPool )
+  {
+    // the idle threads take over the next job, the calling thread works as split thread 0
+    splitThreadPool->runJobs( numJobs, evalJob );
+  }
+  else
+  {
+    for( int jobIdx = 0; jobIdx < numJobs; jobIdx++ )
+    {
+      evalJob( 0, jobIdx );
+    }
   }
   picture->scheduler.setSplitThreadId( 0 );
 
@@ -121,7 +121,8 @@ EncGOP::EncGOP()
 
 EncGOP::~EncGOP()
 {
-  if( !m_pcCfg->getDecodeBitstream(0).empty() || !m_pcCfg->getDecodeBitstream(1).empty() )
+  // the configuration is only set if the encoder was initialized
+  if( m_pcCfg && ( !m_pcCfg->getDecodeBitstream(0).empty() || !m_pcCfg->getDecodeBitstream(1).empty() ) )
   {
     // reset potential decoder resources
     tryDecodePicture( NULL, 0, std::string("") );
@@ -1404,8 +1405,6 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
 {
   // TODO: Split this function up.
 
-  Picture*        pcPic = NULL;
-  Slice*      pcSlice;
   OutputBitstream  *pcBitstreamRedirect;
   pcBitstreamRedirect = new OutputBitstream;
   AccessUnit::iterator  itLocationToPushSliceHeaderNALU; // used to store location where NALU containing slice header is to be inserted
@@ -1433,8 +1432,31 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     m_pcCfg->setEncodedFlag(iGOPid, false);
   }
 
-  for ( int iGOPid=0; iGOPid < m_iGopSize; iGOPid++ )
+  // encodes the picture of the GOP entry iGOPid, with frame threads as the picture picIdx of a group of independent ones
+  auto compressPicture = [&]( int& iGOPid
+#if ENABLE_WPP_PARALLELISM
+                            , FramePicTurns* turns, const int picIdx
+#endif
+                            )
   {
+    Picture*        pcPic = NULL;
+    Slice*      pcSlice;
+#if ENABLE_WPP_PARALLELISM
+    // the concurrently encoded pictures use the slice encoders and encoder stacks following the ones of the GOP encoder
+    const int       frameSliceEncId = turns ? picIdx + 1 : 0;
+    EncSlice*       pcSliceEncoder  = m_pcEncLib->getSliceEncoder( frameSliceEncId );
+    const int       cuEncStackId    = frameSliceEncId * m_pcEncLib->getNumPicCuEncStacks();
+
+    if( turns && !turns->waitSetUp( picIdx ) )
+    {
+      return;
+    }
+#else
+    EncSlice*       pcSliceEncoder  = m_pcSliceEncoder;
+    const int       cuEncStackId    = 0;
+#endif
+    EncReshape*     pcReshaper      = m_pcEncLib->getReshaper( PARL_PARAM0( cuEncStackId ) );
+
     if (m_pcCfg->getEfficientFieldIRAPEnabled())
     {
       iGOPid=effFieldIRAPMap.adjustGOPid(iGOPid);
@@ -1479,7 +1501,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       {
         iGOPid=effFieldIRAPMap.restoreGOPid(iGOPid);
       }
-      continue;
+      return;
     }
 
     if( getNalUnitType(pocCurr, m_iLastIDR, isField) == NAL_UNIT_CODED_SLICE_IDR_W_RADL || getNalUnitType(pocCurr, m_iLastIDR, isField) == NAL_UNIT_CODED_SLICE_IDR_N_LP )
@@ -1491,6 +1513,12 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     AccessUnit accessUnit;
     xGetBuffer( rcListPic, rcListPicYuvRecOut,
                 iNumPicRcvd, iTimeOffset, pcPic, pocCurr, isField );
+#if ENABLE_WPP_PARALLELISM
+    if( turns )
+    {
+      pcPic->scheduler.setWppThreadId( cuEncStackId );
+    }
+#endif
 
     // th this is a hot fix for the choma qp control
     if( m_pcEncLib->getWCGChromaQPControl().isEnabled() && m_pcEncLib->getSwitchPOC() != -1 )
@@ -1512,15 +1540,19 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
 #elif ENABLE_WPP_PARALLELISM
     pcPic->scheduler.init( pcPic->cs->pcv->heightInCtus, pcPic->cs->pcv->widthInCtus, m_pcCfg->getNumWppThreads(), m_pcCfg->getNumWppExtraLines(), 1                             );
 #endif
+#if ENABLE_WPP_PARALLELISM
+    pcPic->createTempBuffers( pcPic->cs->pps->pcv->maxCUWidth, m_pcEncLib->getWppThreadPool() != nullptr );
+#else
     pcPic->createTempBuffers( pcPic->cs->pps->pcv->maxCUWidth );
+#endif
     pcPic->cs->createCoeffs();
 
     //  Slice data initialization
     pcPic->clearSliceBuffer();
     pcPic->allocateNewSlice();
-    m_pcSliceEncoder->setSliceSegmentIdx(0);
+    pcSliceEncoder->setSliceSegmentIdx(0);
 
-    m_pcSliceEncoder->initEncSlice(pcPic, iPOCLast, pocCurr, iGOPid, pcSlice, isField
+    pcSliceEncoder->initEncSlice(pcPic, iPOCLast, pocCurr, iGOPid, pcSlice, isField
       , isEncodeLtRef
     );
 
@@ -1962,7 +1994,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     }
     else
     {
-      pcSlice->setEncCABACTableIdx( m_pcSliceEncoder->getEncCABACTableIdx() );
+      pcSlice->setEncCABACTableIdx( pcSliceEncoder->getEncCABACTableIdx() );
     }
 
     if (pcSlice->getSliceType() == B_SLICE)
@@ -2039,7 +2071,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     // set adaptive search range for non-intra-slices
     if (m_pcCfg->getUseASR() && !pcSlice->isIRAP())
     {
-      m_pcSliceEncoder->setSearchRange(pcSlice);
+      pcSliceEncoder->setSearchRange(pcSlice);
     }
 
     bool bGPBcheck=false;
@@ -2210,7 +2242,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       }
       else if ( frameLevel == 0 )   // intra case, but use the model
       {
-        m_pcSliceEncoder->calCostSliceI(pcPic); // TODO: This only analyses the first slice segment - what about the others?
+        pcSliceEncoder->calCostSliceI(pcPic); // TODO: This only analyses the first slice segment - what about the others?
 
         if ( m_pcCfg->getIntraPeriod() != 1 )   // do not refine allocated bits for all intra case
         {
@@ -2266,7 +2298,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
       sliceQP = Clip3( -pcSlice->getSPS()->getQpBDOffset(CHANNEL_TYPE_LUMA), MAX_QP, sliceQP );
       m_pcRateCtrl->getRCPic()->setPicEstQP( sliceQP );
 
-      m_pcSliceEncoder->resetQP( pcPic, sliceQP, lambda );
+      pcSliceEncoder->resetQP( pcPic, sliceQP, lambda );
     }
 
     uint32_t uiNumSliceSegments = 1;
@@ -2339,7 +2371,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
 #if JVET_N0054_JOINT_CHROMA
       pcSlice->setSliceChromaQpDelta(JOINT_CbCr,   m_pcCfg->getChromaCbCrQpOffsetDualTree());
 #endif
-      m_pcSliceEncoder->setUpLambda(pcSlice, pcSlice->getLambdas()[0], pcSlice->getSliceQp());
+      pcSliceEncoder->setUpLambda(pcSlice, pcSlice->getLambdas()[0], pcSlice->getSliceQp());
     }
     if (pcSlice->getSPS()->getUseReshaper())
     {
@@ -2468,6 +2500,18 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     {
       m_pcReshaper->setCTUFlag(false);
     }
+#if ENABLE_WPP_PARALLELISM
+    if( turns )
+    {
+      // the luma mapping is set up in coding order, the picture is compressed and finished with a copy of it
+      pcReshaper->copyState( *m_pcReshaper );
+      turns->finishSetUp( picIdx );
+      if( !turns->waitCompress() )
+      {
+        return;
+      }
+    }
+#endif
 
     if( encPic )
     // now compress (trial encode) the various slice segments (slices, and dependent slices)
@@ -2482,8 +2526,8 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
 #endif
       for(uint32_t nextCtuTsAddr = 0; nextCtuTsAddr < numberOfCtusInFrame; )
       {
-        m_pcSliceEncoder->precompressSlice( pcPic );
-        m_pcSliceEncoder->compressSlice   ( pcPic, false, false );
+        pcSliceEncoder->precompressSlice( pcPic );
+        pcSliceEncoder->compressSlice   ( pcPic, false, false );
 
         const uint32_t curSliceEnd = pcSlice->getSliceCurEndCtuTsAddr();
 #if JVET_N0857_RECT_SLICES
@@ -2493,7 +2537,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
         {
           uint32_t independentSliceIdx = pcSlice->getIndependentSliceIdx();
           pcPic->allocateNewSlice();
-          m_pcSliceEncoder->setSliceSegmentIdx      (uiNumSliceSegments);
+          pcSliceEncoder->setSliceSegmentIdx      (uiNumSliceSegments);
           // prepare for next slice
           pcSlice = pcPic->slices[uiNumSliceSegments];
           CHECK(!(pcSlice->getPPS() != 0), "Unspecified error");
@@ -2526,13 +2570,23 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
         }
         nextCtuTsAddr = curSliceEnd;
       }
+    }
+
+#if ENABLE_WPP_PARALLELISM
+    if( turns && !turns->waitFinish( picIdx ) )
+    {
+      return;
+    }
+#endif
 
+    if( encPic )
+    {
       duData.clear();
 
       CodingStructure& cs = *pcPic->cs;
       pcSlice = pcPic->slices[0];
 
-      if (pcSlice->getSPS()->getUseReshaper() && m_pcReshaper->getSliceReshaperInfo().getUseSliceReshaper())
+      if (pcSlice->getSPS()->getUseReshaper() && pcReshaper->getSliceReshaperInfo().getUseSliceReshaper())
       {
 #if JVET_N0805_APS_LMCS
         pcSlice->setLmcsEnabledFlag(true);
@@ -2549,9 +2603,9 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
           }
         }
 #endif
-          CHECK((m_pcReshaper->getRecReshaped() == false), "Rec picture is not reshaped!");
-          pcPic->getRecoBuf(COMPONENT_Y).rspSignal(m_pcReshaper->getInvLUT());
-          m_pcReshaper->setRecReshaped(false);
+          CHECK((pcReshaper->getRecReshaped() == false), "Rec picture is not reshaped!");
+          pcPic->getRecoBuf(COMPONENT_Y).rspSignal(pcReshaper->getInvLUT());
+          pcReshaper->setRecReshaped(false);
 
           pcPic->getOrigBuf().copyFrom(pcPic->getTrueOrigBuf());
       }
@@ -2617,7 +2671,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
         m_pcALF->initCABACEstimator(m_pcEncLib->getCABACEncoder(), m_pcEncLib->getCtxCache(), pcSlice, m_pcEncLib->getApsMap());
         m_pcALF->ALFProcess(cs, pcSlice->getLambdas()
 #if ENABLE_QPA
-          , (m_pcCfg->getUsePerceptQPA() && !m_pcCfg->getUseRateCtrl() && pcSlice->getPPS()->getUseDQP() ? m_pcEncLib->getRdCost(PARL_PARAM0(0))->getChromaWeight() : 0.0)
+          , (m_pcCfg->getUsePerceptQPA() && !m_pcCfg->getUseRateCtrl() && pcSlice->getPPS()->getUseDQP() ? m_pcEncLib->getRdCost( PARL_PARAM0( cuEncStackId ) )->getChromaWeight() : 0.0)
 #endif
         );
 
@@ -2818,7 +2872,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
         {
           pcSlice->checkColRefIdx(sliceSegmentIdxCount, pcPic);
         }
-        m_pcSliceEncoder->setSliceSegmentIdx(sliceSegmentIdxCount);
+        pcSliceEncoder->setSliceSegmentIdx(sliceSegmentIdxCount);
 
 #if JVET_M0128
         pcSlice->setRPL0(pcPic->slices[0]->getRPL0());
@@ -2870,7 +2924,7 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
         pcSlice->clearSubstreamSizes(  );
         {
           uint32_t numBinsCoded = 0;
-          m_pcSliceEncoder->encodeSlice(pcPic, &(substreamsOut[0]), numBinsCoded);
+          pcSliceEncoder->encodeSlice(pcPic, &(substreamsOut[0]), numBinsCoded);
           binCountsInNalUnits+=numBinsCoded;
         }
         {
@@ -3040,6 +3094,52 @@ void EncGOP::compressGOP( int iPOCLast, int iNumPicRcvd, PicList& rcListPic,
     pcPic->destroyTempBuffers();
     pcPic->cs->destroyCoeffs();
     pcPic->cs->releaseIntermediateData();
+#if ENABLE_WPP_PARALLELISM
+    if( turns )
+    {
+      pcPic->scheduler.setWppThreadId( 0 );
+      turns->finishPic( picIdx );
+    }
+#endif
+  };
+
+#if ENABLE_WPP_PARALLELISM
+  ThreadPool* frameThreadPool = m_pcEncLib->getFrameThreadPool();
+#endif
+  for ( int iGOPid=0; iGOPid < m_iGopSize; iGOPid++ )
+  {
+#if ENABLE_WPP_PARALLELISM
+    const int numFramePics = frameThreadPool ? xGetNumFramePics( iGOPid, iPOCLast, iNumPicRcvd ) : 1;
+
+    if( numFramePics > 1 )
+    {
+      FramePicTurns turns( numFramePics );
+      const int     firstGOPid = iGOPid;
+
+      frameThreadPool->runJobs( numFramePics, [&]( int, int picIdx )
+      {
+        int picGOPid = firstGOPid + picIdx;
+
+        try
+        {
+          compressPicture( picGOPid, &turns, picIdx );
+        }
+        catch( ... )
+        {
+          // release the pictures waiting for their turn
+          turns.abort();
+          throw;
+        }
+      } );
+
+      iGOPid += numFramePics - 1;
+      continue;
+    }
+
+    compressPicture( iGOPid, nullptr, 0 );
+#else
+    compressPicture( iGOPid );
+#endif
   } // iGOPid-loop
 
   delete pcBitstreamRedirect;
@@ -3235,6 +3335,65 @@ void EncGOP::xGetBuffer( PicList&                  rcListPic,
   return;
 }
 
+#if ENABLE_WPP_PARALLELISM
+/** returns the number of pictures starting with the GOP entry iGOPid, which can be encoded concurrently by the frame threads:
+ *  consecutive non-IRAP pictures of the same temporal layer, none of them referring to one of the others
+ */
+int EncGOP::xGetNumFramePics( int iGOPid, int iPOCLast, int iNumPicRcvd )
+{
+#if ENABLE_TRACING
+  return 1;  // the trace follows the coding order
+#else
+#if JVET_M0128
+  if( iPOCLast == 0 || !m_pcCfg->getDecodeBitstream( 0 ).empty() || !m_pcCfg->getDecodeBitstream( 1 ).empty() )
+  {
+    return 1;
+  }
+
+  const int        temporalId = m_pcCfg->getGOPEntry( iGOPid ).m_temporalId;
+  std::vector<int> groupPOCs;
+
+  for( int gopId = iGOPid; gopId < m_iGopSize && (int) groupPOCs.size() < m_pcCfg->getNumFrameThreads(); gopId++ )
+  {
+    const GOPEntry& gopEntry = m_pcCfg->getGOPEntry( gopId );
+    const int       pocCurr  = iPOCLast - iNumPicRcvd + gopEntry.m_POC;
+    const NalUnitType nalType = getNalUnitType( pocCurr, m_iLastIDR, false );
+
+    if( pocCurr >= m_pcCfg->getFramesToBeEncoded() || gopEntry.m_temporalId != temporalId
+      || nalType == NAL_UNIT_CODED_SLICE_IDR_W_RADL || nalType == NAL_UNIT_CODED_SLICE_IDR_N_LP || nalType == NAL_UNIT_CODED_SLICE_CRA )
+    {
+      break;
+    }
+
+    const int rplIdx      = m_pcEncLib->getReferencePictureListIdx( pocCurr, gopId );
+    bool      refersGroup = false;
+
+    for( int l = 0; l < 2; l++ )
+    {
+      const RPLEntry& rplEntry = m_pcCfg->getRPLEntry( l, rplIdx );
+
+      for( int i = 0; i < rplEntry.m_numRefPics; i++ )
+      {
+        refersGroup |= std::find( groupPOCs.begin(), groupPOCs.end(), pocCurr - rplEntry.m_deltaRefPics[i] ) != groupPOCs.end();
+      }
+    }
+
+    if( refersGroup )
+    {
+      break;
+    }
+
+    groupPOCs.push_back( pocCurr );
+  }
+
+  return std::max<int>( 1, (int) groupPOCs.size() );
+#else
+  return 1;
+#endif
+#endif
+}
+#endif
+
 #if ENABLE_QPA
 
 #ifndef BETA
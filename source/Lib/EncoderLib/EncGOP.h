@@ -89,6 +89,27 @@ class EncGOP
     int accumNalsDU;
   };
 
+#if ENABLE_WPP_PARALLELISM
+  /// turns of the pictures encoded concurrently by the frame threads: the set-up and the finishing of the
+  /// pictures (loop filters, entropy coding, statistics) keep the coding order, only the slices are compressed concurrently
+  class FramePicTurns
+  {
+  public:
+    FramePicTurns( const int numPics ) : m_numPics( numPics ) {}
+
+    bool waitSetUp   ( const int picIdx ) const { return m_progress.wait( picIdx ); }
+    void finishSetUp ( const int picIdx )       { m_progress.set( picIdx + 1 ); }
+    bool waitCompress()                   const { return m_progress.wait( m_numPics ); }
+    bool waitFinish  ( const int picIdx ) const { return m_progress.wait( m_numPics + picIdx ); }
+    void finishPic   ( const int picIdx )       { m_progress.set( m_numPics + picIdx + 1 ); }
+    void abort       ()                         { m_progress.abort(); }
+
+  private:
+    const int       m_numPics;
+    ProgressCounter m_progress;
+  };
+#endif
+
 private:
 
   Analyze                 m_gcAnalyzeAll;
@@ -231,6 +252,9 @@ protected:
   );
   void  xGetBuffer        ( PicList& rcListPic, std::list<PelUnitBuf*>& rcListPicYuvRecOut,
                             int iNumPicRcvd, int iTimeOffset, Picture*& rpcPic, int pocCurr, bool isField );
+#if ENABLE_WPP_PARALLELISM
+  int   xGetNumFramePics  ( int iGOPid, int iPOCLast, int iNumPicRcvd );
+#endif
 
   void  xCalculateAddPSNRs(const bool isField, const bool isFieldTopFieldFirst, const int iGOPid, Picture* pcPic, const AccessUnit&accessUnit, PicList &rcListPic, int64_t dEncTime, const InputColourSpaceConversion snr_conversion, const bool printFrameMSE, double* PSNR_Y
     , bool isEncodeLtRef
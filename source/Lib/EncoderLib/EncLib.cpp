@@ -44,13 +44,16 @@
 #include "CommonLib/Picture.h"
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/ChromaFormat.h"
-#if ENABLE_SPLIT_PARALLELISM
-#include <omp.h>
-#endif
+
+#include <mutex>
 
 //! \ingroup EncoderLib
 //! \{
 
+// the ROM tables are shared by all encoders of the process, they are created by the first and destroyed by the last one
+static std::mutex s_romMutex;
+static int        s_numRomUsers = 0;
+
 // ====================================================================================================================
 // Constructor / destructor / create / destroy
 // ====================================================================================================================
@@ -66,6 +69,10 @@ EncLib::EncLib()
   , m_apsMap( MAX_NUM_APS )
 #endif
   , m_AUWriterIf( nullptr )
+#if ENABLE_WPP_PARALLELISM
+  , m_wppThreadPool( nullptr )
+  , m_frameThreadPool( nullptr )
+#endif
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
   , m_cacheModel()
 #endif
@@ -95,12 +102,20 @@ EncLib::~EncLib()
 void EncLib::create ()
 {
   // initialize global variables
-  initROM();
+  {
+    std::unique_lock<std::mutex> lock( s_romMutex );
+    if( s_numRomUsers++ == 0 )
+    {
+      initROM();
+    }
+  }
   TComHash::initBlockSizeToIndex();
   m_iPOCLast = m_compositeRefEnabled ? -2 : -1;
   // create processing unit classes
   m_cGOPEncoder.        create( );
+#if !ENABLE_WPP_PARALLELISM
   m_cSliceEncoder.      create( getSourceWidth(), getSourceHeight(), m_chromaFormatIDC, m_maxCUWidth, m_maxCUHeight, m_maxTotalCUDepth );
+#endif
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
 #if ENABLE_SPLIT_PARALLELISM
   m_numCuEncStacks  = m_numSplitThreads == 1 ? 1 : NUM_RESERVERD_SPLIT_JOBS;
@@ -109,6 +124,43 @@ void EncLib::create ()
 #endif
 #if ENABLE_WPP_PARALLELISM
   m_numCuEncStacks *= ( m_numWppThreads + m_numWppExtraLines );
+
+  if( m_numWppThreads > 1 )
+  {
+    // each thread encodes whole CTU rows using the encoder stack of its thread index
+    m_wppThreadPool = new ThreadPool;
+    m_wppThreadPool->create( m_numWppThreads + m_numWppExtraLines );
+  }
+#endif
+  m_numPicCuEncStacks = m_numCuEncStacks;
+#if ENABLE_WPP_PARALLELISM
+
+  if( m_numFrameThreads > 1 )
+  {
+    // each frame thread encodes a picture with its own slice encoder and encoder stacks, the first ones remain with the GOP encoder
+    m_numCuEncStacks *= m_numFrameThreads + 1;
+
+    // the thread calling the GOP encoder encodes one of the pictures itself
+    m_frameThreadPool = new ThreadPool;
+    m_frameThreadPool->create( m_numFrameThreads - 1 );
+  }
+#endif
+#if ENABLE_SPLIT_PARALLELISM
+
+  if( m_numSplitThreads > 1 && !m_forceSingleSplitThread )
+  {
+    // the thread encoding a CTU takes part in the split evaluation, the pool provides the other split threads
+#if ENABLE_WPP_PARALLELISM
+    m_splitThreadPools.resize( m_numWppThreads + m_numWppExtraLines );
+#else
+    m_splitThreadPools.resize( 1 );
+#endif
+    for( auto &splitThreadPool : m_splitThreadPools )
+    {
+      splitThreadPool = new ThreadPool;
+      splitThreadPool->create( m_numSplitThreads - 1 );
+    }
+  }
 #endif
 
   m_cCuEncoder      = new EncCu              [m_numCuEncStacks];
@@ -121,9 +173,23 @@ void EncLib::create ()
 
   for( int jId = 0; jId < m_numCuEncStacks; jId++ )
   {
+#if WCG_EXT
+    m_cRdCost[jId].            setLumaLevelWeights( &m_lumaLevelWeights );
+#endif
     m_cCuEncoder[jId].         create( this );
   }
+#if ENABLE_WPP_PARALLELISM
+
+  m_cSliceEncoder   = new EncSlice           [m_numCuEncStacks / m_numPicCuEncStacks];
+  for( int sId = 0; sId < m_numCuEncStacks / m_numPicCuEncStacks; sId++ )
+  {
+    m_cSliceEncoder[sId].      create( getSourceWidth(), getSourceHeight(), m_chromaFormatIDC, m_maxCUWidth, m_maxCUHeight, m_maxTotalCUDepth );
+  }
+#endif
 #else
+#if WCG_EXT
+  m_cRdCost.            setLumaLevelWeights( &m_lumaLevelWeights );
+#endif
   m_cCuEncoder.         create( this );
 #endif
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
@@ -177,9 +243,39 @@ void EncLib::create ()
 
 void EncLib::destroy ()
 {
+#if ENABLE_WPP_PARALLELISM
+  if( m_wppThreadPool )
+  {
+    m_wppThreadPool->destroy();
+    delete m_wppThreadPool;
+    m_wppThreadPool = nullptr;
+  }
+  if( m_frameThreadPool )
+  {
+    m_frameThreadPool->destroy();
+    delete m_frameThreadPool;
+    m_frameThreadPool = nullptr;
+  }
+#endif
+#if ENABLE_SPLIT_PARALLELISM
+  for( auto &splitThreadPool : m_splitThreadPools )
+  {
+    splitThreadPool->destroy();
+    delete splitThreadPool;
+  }
+  m_splitThreadPools.clear();
+#endif
   // destroy processing unit classes
   m_cGOPEncoder.        destroy();
+#if ENABLE_WPP_PARALLELISM
+  for( int sId = 0; sId < m_numCuEncStacks / m_numPicCuEncStacks; sId++ )
+  {
+    m_cSliceEncoder[sId].destroy();
+  }
+  delete[] m_cSliceEncoder;
+#else
   m_cSliceEncoder.      destroy();
+#endif
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   for( int jId = 0; jId < m_numCuEncStacks; jId++ )
   {
@@ -229,7 +325,13 @@ void EncLib::destroy ()
 
 
   // destroy ROM
-  destroyROM();
+  {
+    std::unique_lock<std::mutex> lock( s_romMutex );
+    if( --s_numRomUsers == 0 )
+    {
+      destroyROM();
+    }
+  }
   return;
 }
 
@@ -257,14 +359,6 @@ void EncLib::init( bool isFieldCoding, AUWriterIf* auWriterIf )
   sps0.setDecodingParameterSetId(m_dps.getDecodingParameterSetId());
     
 #endif
-#if ENABLE_SPLIT_PARALLELISM
-  if( omp_get_dynamic() )
-  {
-    omp_set_dynamic( false );
-  }
-  omp_set_nested( true );
-#endif
-
   if (getUseCompositeRef())
   {
     sps0.setLongTermRefsPresent(true);
@@ -317,7 +411,14 @@ void EncLib::init( bool isFieldCoding, AUWriterIf* auWriterIf )
 
   // initialize processing unit classes
   m_cGOPEncoder.  init( this );
-  m_cSliceEncoder.init( this, sps0 );
+#if ENABLE_WPP_PARALLELISM
+  for( int sId = 0; sId < m_numCuEncStacks / m_numPicCuEncStacks; sId++ )
+  {
+    m_cSliceEncoder[sId].init( this, sps0, sId * m_numPicCuEncStacks );
+  }
+#else
+  m_cSliceEncoder.init( this, sps0 PARL_PARAM( 0 ) );
+#endif
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   for( int jId = 0; jId < m_numCuEncStacks; jId++ )
   {
@@ -878,6 +979,17 @@ void EncLib::xGetNewPicBuffer ( std::list<PelUnitBuf*>& rcListPicYuvRecOut, Pict
   if (rpcPic==0)
   {
     rpcPic = new Picture;
+#if ENABLE_WPP_PARALLELISM
+    if( m_frameThreadPool )
+    {
+      m_picUnitCaches.emplace_back();
+      rpcPic->unitCache = &m_picUnitCaches.back();
+    }
+    else
+#endif
+    {
+      rpcPic->unitCache = &m_unitCache;
+    }
 
     rpcPic->create( sps.getChromaFormatIdc(), Size( sps.getPicWidthInLumaSamples(), sps.getPicHeightInLumaSamples()), sps.getMaxCUWidth(), sps.getMaxCUWidth()+16, false );
     if ( getUseAdaptiveQP() )
@@ -1709,16 +1821,10 @@ void EncLib::getActiveRefPicListNumForPOC(const SPS *sps, int POCCurr, int GOPid
   *activeL1 = rpl1->getNumberOfActivePictures();
 }
 
-void EncLib::selectReferencePictureList(Slice* slice, int POCCurr, int GOPid, int ltPoc)
+// index of the reference picture list candidates of the SPS, the same one is used for both lists
+int EncLib::getReferencePictureListIdx(int POCCurr, int GOPid) const
 {
-  bool isEncodeLtRef = (POCCurr == ltPoc);
-  if (m_compositeRefEnabled && isEncodeLtRef)
-  {
-    POCCurr++;
-  }
-
-  slice->setRPL0idx(GOPid);
-  slice->setRPL1idx(GOPid);
+  int rplIdx = GOPid;
 
   int fullListNum = m_iGOPSize;
   int partialListNum = getRPLCandidateSize(0) - m_iGOPSize;
@@ -1727,13 +1833,11 @@ void EncLib::selectReferencePictureList(Slice* slice, int POCCurr, int GOPid, in
   {
     if (POCCurr < 10)
     {
-      slice->setRPL0idx(POCCurr + m_iGOPSize - 1);
-      slice->setRPL1idx(POCCurr + m_iGOPSize - 1);
+      rplIdx = POCCurr + m_iGOPSize - 1;
     }
     else
     {
-      slice->setRPL0idx((POCCurr%m_iGOPSize == 0) ? m_iGOPSize - 1 : POCCurr%m_iGOPSize - 1);
-      slice->setRPL1idx((POCCurr%m_iGOPSize == 0) ? m_iGOPSize - 1 : POCCurr%m_iGOPSize - 1);
+      rplIdx = (POCCurr%m_iGOPSize == 0) ? m_iGOPSize - 1 : POCCurr%m_iGOPSize - 1;
     }
     extraNum = fullListNum + partialListNum;
   }
@@ -1746,13 +1850,27 @@ void EncLib::selectReferencePictureList(Slice* slice, int POCCurr, int GOPid, in
         POCIndex = m_uiIntraPeriod;
       if (POCIndex == m_RPLList0[extraNum].m_POC)
       {
-        slice->setRPL0idx(extraNum);
-        slice->setRPL1idx(extraNum);
+        rplIdx = extraNum;
         extraNum++;
       }
     }
   }
 
+  return rplIdx;
+}
+
+void EncLib::selectReferencePictureList(Slice* slice, int POCCurr, int GOPid, int ltPoc)
+{
+  bool isEncodeLtRef = (POCCurr == ltPoc);
+  if (m_compositeRefEnabled && isEncodeLtRef)
+  {
+    POCCurr++;
+  }
+
+  const int rplIdx = getReferencePictureListIdx(POCCurr, GOPid);
+  slice->setRPL0idx(rplIdx);
+  slice->setRPL1idx(rplIdx);
+
   const ReferencePictureList *rpl0 = (slice->getSPS()->getRPLList0()->getReferencePictureList(slice->getRPL0idx()));
   const ReferencePictureList *rpl1 = (slice->getSPS()->getRPLList1()->getReferencePictureList(slice->getRPL1idx()));
   slice->setRPL0(rpl0);
@@ -42,6 +42,7 @@
 #include "CommonLib/TrQuant.h"
 #include "CommonLib/LoopFilter.h"
 #include "CommonLib/NAL.h"
+#include "CommonLib/ThreadPool.h"
 
 #include "Utilities/VideoIOYuv.h"
 
@@ -107,7 +108,11 @@ private:
 
   // processing unit
   EncGOP                    m_cGOPEncoder;                        ///< GOP encoder
+#if ENABLE_WPP_PARALLELISM
+  EncSlice                 *m_cSliceEncoder;                      ///< slice encoder of the GOP encoder, followed by the ones of the frame threads
+#else
   EncSlice                  m_cSliceEncoder;                      ///< slice encoder
+#endif
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   EncCu                    *m_cCuEncoder;                         ///< CU encoder
 #else
@@ -124,14 +129,27 @@ private:
 #else
   RdCost                    m_cRdCost;                            ///< RD cost computation class
   CtxCache                  m_CtxCache;                           ///< buffer for temporarily stored context models
+#endif
+#if WCG_EXT
+  LumaLevelWeights          m_lumaLevelWeights;                   ///< luma level distortion weights of the RD cost instances, separate per encoder instance
 #endif
   // quality control
   RateCtrl                  m_cRateCtrl;                          ///< Rate control class
 
   AUWriterIf*               m_AUWriterIf;
+  XUCache                   m_unitCache;                          ///< coding units of the pictures in m_cListPic, separate per encoder instance
 
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   int                       m_numCuEncStacks;
+  int                       m_numPicCuEncStacks;                  ///< encoder stacks used for one picture, i.e. by its WPP and split threads
+#endif
+#if ENABLE_WPP_PARALLELISM
+  ThreadPool*               m_wppThreadPool;                      ///< encodes the CTU rows concurrently, only created with more than one WPP thread
+  ThreadPool*               m_frameThreadPool;                    ///< encodes independent pictures concurrently, only created with more than one frame thread
+  std::list<XUCache>        m_picUnitCaches;                      ///< unit caches of the pictures, which must not share one when encoded concurrently
+#endif
+#if ENABLE_SPLIT_PARALLELISM
+  std::vector<ThreadPool*>  m_splitThreadPools;                   ///< helper threads evaluating split candidates, one pool per WPP thread
 #endif
 
 #if JVET_J0090_MEMORY_BANDWITH_MEASURE
@@ -210,7 +228,11 @@ public:
   EncSampleAdaptiveOffset* getSAO               ()              { return  &m_cEncSAO;              }
   EncAdaptiveLoopFilter*  getALF                ()              { return  &m_cEncALF;              }
   EncGOP*                 getGOPEncoder         ()              { return  &m_cGOPEncoder;          }
+#if ENABLE_WPP_PARALLELISM
+  EncSlice*               getSliceEncoder       ( int sId = 0 ) { return  &m_cSliceEncoder[sId];   }
+#else
   EncSlice*               getSliceEncoder       ()              { return  &m_cSliceEncoder;        }
+#endif
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   EncCu*                  getCuEncoder          ( int jId = 0 ) { return  &m_cCuEncoder[jId];      }
 #else
@@ -229,11 +251,19 @@ public:
   CtxCache*               getCtxCache           ()              { return  &m_CtxCache;             }
 #endif
   RateCtrl*               getRateCtrl           ()              { return  &m_cRateCtrl;            }
+#if ENABLE_WPP_PARALLELISM
+  ThreadPool*             getWppThreadPool      ()              { return   m_wppThreadPool;        }
+  ThreadPool*             getFrameThreadPool    ()              { return   m_frameThreadPool;      }
+#endif
+#if ENABLE_SPLIT_PARALLELISM
+  ThreadPool*             getSplitThreadPool    ( int wppTId )  { return   m_splitThreadPools.empty() ? nullptr : m_splitThreadPools[wppTId]; }
+#endif
 
 
 #if JVET_M0128
   void                    getActiveRefPicListNumForPOC(const SPS *sps, int POCCurr, int GOPid, uint32_t *activeL0, uint32_t *activeL1);
   void                    selectReferencePictureList(Slice* slice, int POCCurr, int GOPid, int ltPoc);
+  int                     getReferencePictureListIdx(int POCCurr, int GOPid) const;
 #else
   void selectReferencePictureSet(Slice* slice, int POCCurr, int GOPid
     , int ltPoc
@@ -253,6 +283,7 @@ public:
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
   void                   setNumCuEncStacks( int n )             { m_numCuEncStacks = n; }
   int                    getNumCuEncStacks()              const { return m_numCuEncStacks; }
+  int                    getNumPicCuEncStacks()           const { return m_numPicCuEncStacks; }
 #endif
 
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
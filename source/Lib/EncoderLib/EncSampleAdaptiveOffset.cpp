@@ -1170,6 +1170,91 @@ void EncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const int c
   int* skipLinesR = m_skipLinesR[compIdx];
   int* skipLinesB = m_skipLinesB[compIdx];
 
+#if JVET_N0438_LOOP_FILTER_DISABLED_ACROSS_VIR_BOUND
+  if( !isCtuCrossedByVirtualBoundaries )
+#endif
+  {
+    // the edge class is derived directly from both neighbours, the sign line buffers below are only needed for skipping samples at virtual boundaries
+    for( int typeIdx = 0; typeIdx < NUM_SAO_NEW_TYPES; typeIdx++ )
+    {
+      SAOStatData& statsData = statsDataTypes[typeIdx];
+      statsData.reset();
+
+      const int skipR = skipLinesR[typeIdx];
+      const int skipB = skipLinesB[typeIdx];
+
+      switch( typeIdx )
+      {
+      case SAO_TYPE_EO_0:
+        endY   = isBelowAvail ? ( height - skipB ) : height;
+        startX = !isCalculatePreDeblockSamples ? ( isLeftAvail  ? 0 : 1 ) : ( isRightAvail ? ( width - skipR ) : ( width - 1 ) );
+        endX   = !isCalculatePreDeblockSamples ? ( isRightAvail ? ( width - skipR ) : ( width - 1 ) ) : ( isRightAvail ? width : ( width - 1 ) );
+        m_calcEdgeStats( srcBlk, orgBlk, srcStride, orgStride, startX, endX, endY, -1, 1, statsData.diff, statsData.count );
+        if( isCalculatePreDeblockSamples && isBelowAvail )
+        {
+          startY = std::max( endY, 0 );
+          m_calcEdgeStats( srcBlk + startY * srcStride, orgBlk + startY * orgStride, srcStride, orgStride, isLeftAvail ? 0 : 1, isRightAvail ? width : ( width - 1 ), skipB, -1, 1, statsData.diff, statsData.count );
+        }
+        break;
+      case SAO_TYPE_EO_90:
+        startX = !isCalculatePreDeblockSamples ? 0 : ( isRightAvail ? ( width - skipR ) : width );
+        endX   = !isCalculatePreDeblockSamples ? ( isRightAvail ? ( width - skipR ) : width ) : width;
+        startY = isAboveAvail ? 0 : 1;
+        endY   = isBelowAvail ? ( height - skipB ) : ( height - 1 );
+        m_calcEdgeStats( srcBlk + startY * srcStride, orgBlk + startY * orgStride, srcStride, orgStride, startX, endX, endY - startY, -srcStride, srcStride, statsData.diff, statsData.count );
+        if( isCalculatePreDeblockSamples && isBelowAvail )
+        {
+          startY = std::max( endY, startY );
+          m_calcEdgeStats( srcBlk + startY * srcStride, orgBlk + startY * orgStride, srcStride, orgStride, 0, width, skipB, -srcStride, srcStride, statsData.diff, statsData.count );
+        }
+        break;
+      case SAO_TYPE_EO_135:
+      case SAO_TYPE_EO_45:
+        {
+          const bool is135   = typeIdx == SAO_TYPE_EO_135;
+          const int  nbAbove = is135 ? ( -srcStride - 1 ) : ( -srcStride + 1 );
+          const int  nbBelow = is135 ? (  srcStride + 1 ) : (  srcStride - 1 );
+
+          startX = !isCalculatePreDeblockSamples ? ( isLeftAvail  ? 0 : 1 ) : ( isRightAvail ? ( width - skipR ) : ( width - 1 ) );
+          endX   = !isCalculatePreDeblockSamples ? ( isRightAvail ? ( width - skipR ) : ( width - 1 ) ) : ( isRightAvail ? width : ( width - 1 ) );
+          endY   = isBelowAvail ? ( height - skipB ) : ( height - 1 );
+          if( is135 )
+          {
+            firstLineStartX = !isCalculatePreDeblockSamples ? ( isAboveLeftAvail ? 0    : 1 ) : startX;
+            firstLineEndX   = !isCalculatePreDeblockSamples ? ( isAboveAvail     ? endX : 1 ) : endX;
+          }
+          else
+          {
+            firstLineStartX = !isCalculatePreDeblockSamples ? ( isAboveAvail ? startX : endX ) : startX;
+            firstLineEndX   = !isCalculatePreDeblockSamples ? ( ( !isRightAvail && isAboveRightAvail ) ? width : endX ) : endX;
+          }
+          m_calcEdgeStats( srcBlk, orgBlk, srcStride, orgStride, firstLineStartX, firstLineEndX, 1, nbAbove, nbBelow, statsData.diff, statsData.count );
+          m_calcEdgeStats( srcBlk + srcStride, orgBlk + orgStride, srcStride, orgStride, startX, endX, endY - 1, nbAbove, nbBelow, statsData.diff, statsData.count );
+          if( isCalculatePreDeblockSamples && isBelowAvail )
+          {
+            startY = std::max( endY, 1 );
+            m_calcEdgeStats( srcBlk + startY * srcStride, orgBlk + startY * orgStride, srcStride, orgStride, isLeftAvail ? 0 : 1, isRightAvail ? width : ( width - 1 ), skipB, nbAbove, nbBelow, statsData.diff, statsData.count );
+          }
+        }
+        break;
+      case SAO_TYPE_BO:
+        startX = !isCalculatePreDeblockSamples ? 0 : ( isRightAvail ? ( width - skipR ) : width );
+        endX   = !isCalculatePreDeblockSamples ? ( isRightAvail ? ( width - skipR ) : width ) : width;
+        endY   = isBelowAvail ? ( height - skipB ) : height;
+        m_calcBandStats( srcBlk, orgBlk, srcStride, orgStride, startX, endX, endY, channelBitDepth - NUM_SAO_BO_CLASSES_LOG2, statsData.diff, statsData.count );
+        if( isCalculatePreDeblockSamples && isBelowAvail )
+        {
+          startY = std::max( endY, 0 );
+          m_calcBandStats( srcBlk + startY * srcStride, orgBlk + startY * orgStride, srcStride, orgStride, 0, width, skipB, channelBitDepth - NUM_SAO_BO_CLASSES_LOG2, statsData.diff, statsData.count );
+        }
+        break;
+      default:
+        THROW( "Not a supported SAO type" );
+      }
+    }
+    return;
+  }
+
   for(int typeIdx=0; typeIdx< NUM_SAO_NEW_TYPES; typeIdx++)
   {
     SAOStatData& statsData= statsDataTypes[typeIdx];
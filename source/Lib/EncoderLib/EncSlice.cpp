@@ -44,10 +44,6 @@
 #include "CommonLib/dtrace_blockstatistics.h"
 #endif
 
-#if ENABLE_WPP_PARALLELISM
-#include <mutex>
-extern recursive_mutex g_cache_mutex;
-#endif
 
 #include <math.h>
 
@@ -83,19 +79,20 @@ void EncSlice::destroy()
   m_viRdPicQp.clear();
 }
 
-void EncSlice::init( EncLib* pcEncLib, const SPS& sps )
+void EncSlice::init( EncLib* pcEncLib, const SPS& sps PARL_PARAM( const int jId ) )
 {
   m_pcCfg             = pcEncLib;
   m_pcLib             = pcEncLib;
   m_pcListPic         = pcEncLib->getListPic();
 
   m_pcGOPEncoder      = pcEncLib->getGOPEncoder();
-  m_pcCuEncoder       = pcEncLib->getCuEncoder();
-  m_pcInterSearch     = pcEncLib->getInterSearch();
-  m_CABACWriter       = pcEncLib->getCABACEncoder()->getCABACWriter   (&sps);
-  m_CABACEstimator    = pcEncLib->getCABACEncoder()->getCABACEstimator(&sps);
-  m_pcTrQuant         = pcEncLib->getTrQuant();
-  m_pcRdCost          = pcEncLib->getRdCost();
+  m_pcCuEncoder       = pcEncLib->getCuEncoder   ( PARL_PARAM0( jId ) );
+  m_pcInterSearch     = pcEncLib->getInterSearch ( PARL_PARAM0( jId ) );
+  m_CABACWriter       = pcEncLib->getCABACEncoder( PARL_PARAM0( jId ) )->getCABACWriter   (&sps);
+  m_CABACEstimator    = pcEncLib->getCABACEncoder( PARL_PARAM0( jId ) )->getCABACEstimator(&sps);
+  m_pcTrQuant         = pcEncLib->getTrQuant     ( PARL_PARAM0( jId ) );
+  m_pcRdCost          = pcEncLib->getRdCost      ( PARL_PARAM0( jId ) );
+  m_pcReshaper        = pcEncLib->getReshaper    ( PARL_PARAM0( jId ) );
 
   // create lambda and QP arrays
   m_vdRdPicLambda.resize(m_pcCfg->getDeltaQpRD() * 2 + 1 );
@@ -1221,7 +1218,7 @@ void EncSlice::setSearchRange( Slice* pcSlice )
       int newSearchRange = Clip3(m_pcCfg->getMinSearchWindow(), iMaxSR, (iMaxSR*ADAPT_SR_SCALE*abs(iCurrPOC - iRefPOC)+iOffset)/iGOPSize);
       m_pcInterSearch->setAdaptiveSearchRange(iDir, iRefIdx, newSearchRange);
 #if ENABLE_WPP_PARALLELISM
-      for( int jId = 1; jId < m_pcLib->getNumCuEncStacks(); jId++ )
+      for( int jId = 1; jId < m_pcLib->getNumPicCuEncStacks(); jId++ )
       {
         m_pcLib->getInterSearch( jId )->setAdaptiveSearchRange( iDir, iRefIdx, newSearchRange );
       }
@@ -1375,7 +1372,7 @@ void EncSlice::compressSlice( Picture* pcPic, const bool bCompressEntireSlice, c
   m_CABACEstimator->initCtxModels( *pcSlice );
 
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
-  for( int jId = 1; jId < m_pcLib->getNumCuEncStacks(); jId++ )
+  for( int jId = 1; jId < m_pcLib->getNumPicCuEncStacks(); jId++ )
   {
     CABACWriter* cw = m_pcLib->getCABACEncoder( jId )->getCABACEstimator( pcSlice->getSPS() );
     cw->initCtxModels( *pcSlice );
@@ -1437,7 +1434,7 @@ void EncSlice::compressSlice( Picture* pcPic, const bool bCompressEntireSlice, c
     {
       m_CABACEstimator->initCtxModels (*pcSlice);
 #if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
-      for (int jId = 1; jId < m_pcLib->getNumCuEncStacks(); jId++)
+      for (int jId = 1; jId < m_pcLib->getNumPicCuEncStacks(); jId++)
       {
         CABACWriter* cw = m_pcLib->getCABACEncoder (jId)->getCABACEstimator (pcSlice->getSPS());
         cw->initCtxModels (*pcSlice);
@@ -1452,30 +1449,6 @@ void EncSlice::compressSlice( Picture* pcPic, const bool bCompressEntireSlice, c
   }
 #endif // ENABLE_QPA
 
-#if ENABLE_WPP_PARALLELISM
-  bool bUseThreads = m_pcCfg->getNumWppThreads() > 1;
-  if( bUseThreads )
-  {
-    CHECK( startCtuTsAddr != 0 || boundingCtuTsAddr != pcPic->cs->pcv->sizeInCtus, "not intended" );
-
-    pcPic->cs->allocateVectorsAtPicLevel();
-
-    omp_set_num_threads( m_pcCfg->getNumWppThreads() + m_pcCfg->getNumWppExtraLines() );
-
-    #pragma omp parallel for schedule(static,1) if(bUseThreads)
-    for( int ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ctuTsAddr += widthInCtus )
-    {
-      // wpp thread start
-      pcPic->scheduler.setWppThreadId();
-#if ENABLE_SPLIT_PARALLELISM
-      pcPic->scheduler.setSplitThreadId( 0 );
-#endif
-      encodeCtus( pcPic, bCompressEntireSlice, bFastDeltaQP, ctuTsAddr, ctuTsAddr + widthInCtus, m_pcLib );
-      // wpp thread stop
-    }
-  }
-  else
-#endif
 #if K0149_BLOCK_STATISTICS
   const SPS *sps = pcSlice->getSPS();
   CHECK(sps == 0, "No SPS present");
@@ -1535,6 +1508,183 @@ void EncSlice::checkDisFracMmvd( Picture* pcPic, uint32_t startCtuTsAddr, uint32
 }
 
 void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, const bool bFastDeltaQP, uint32_t startCtuTsAddr, uint32_t boundingCtuTsAddr, EncLib* pEncLib )
+{
+  CodingStructure&  cs            = *pcPic->cs;
+  Slice* pcSlice                  = cs.slice;
+#if ENABLE_WPP_PARALLELISM
+  const bool bCtuRowsParallel     = xCanEncodeCtuRowsParallel( pcPic, startCtuTsAddr, boundingCtuTsAddr );
+#endif
+
+  if ( pcSlice->getSPS()->getFpelMmvdEnabledFlag() ||
+      (pcSlice->getSPS()->getIBCFlag() && m_pcCuEncoder->getEncCfg()->getIBCHashSearch()))
+  {
+#if JVET_N0329_IBC_SEARCH_IMP
+    m_pcCuEncoder->getIbcHashMap().rebuildPicHashMap(cs.picture->getTrueOrigBuf());
+#if ENABLE_WPP_PARALLELISM
+    if( bCtuRowsParallel )
+    {
+      // the CU encoders of the concurrently encoded CTU rows search their own hash maps
+      for( int tId = 1; tId < pEncLib->getNumWppThreads() + pEncLib->getNumWppExtraLines(); tId++ )
+      {
+        pEncLib->getCuEncoder( pcPic->scheduler.getWppDataId( tId ) )->getIbcHashMap().rebuildPicHashMap( cs.picture->getTrueOrigBuf() );
+      }
+    }
+#endif
+    if (m_pcCfg->getIntraPeriod() != -1)
+    {
+      int hashBlkHitPerc = m_pcCuEncoder->getIbcHashMap().calHashBlkMatchPerc(cs.area.Y());
+      cs.slice->setDisableSATDForRD(hashBlkHitPerc > 59);
+    }
+#else
+    if (pcSlice->getSPS()->getUseReshaper() && m_pcReshaper->getCTUFlag() && pcSlice->getSPS()->getIBCFlag())
+      cs.picture->getOrigBuf(COMPONENT_Y).rspSignal(m_pcReshaper->getFwdLUT());
+    m_pcCuEncoder->getIbcHashMap().rebuildPicHashMap( cs.picture->getOrigBuf() );
+#if ENABLE_WPP_PARALLELISM
+    if( bCtuRowsParallel )
+    {
+      for( int tId = 1; tId < pEncLib->getNumWppThreads() + pEncLib->getNumWppExtraLines(); tId++ )
+      {
+        pEncLib->getCuEncoder( pcPic->scheduler.getWppDataId( tId ) )->getIbcHashMap().rebuildPicHashMap( cs.picture->getOrigBuf() );
+      }
+    }
+#endif
+    if (pcSlice->getSPS()->getUseReshaper() && m_pcReshaper->getCTUFlag() && pcSlice->getSPS()->getIBCFlag())
+      cs.picture->getOrigBuf().copyFrom(cs.picture->getTrueOrigBuf());
+#endif
+  }
+  checkDisFracMmvd( pcPic, startCtuTsAddr, boundingCtuTsAddr );
+
+  // slice level state of the CU encoder
+  if( pcSlice->getSliceType() == B_SLICE )
+  {
+    resetGbiCodingOrder( false, cs );
+    m_pcInterSearch->initWeightIdxBits();
+  }
+  if( pcSlice->getSPS()->getUseReshaper() )
+  {
+    m_pcCuEncoder->setDecCuReshaperInEncCU( m_pcReshaper, pcSlice->getSPS()->getChromaFormatIdc() );
+#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
+    for( int jId = 1; jId < pEncLib->getNumPicCuEncStacks(); jId++ )
+    {
+      pEncLib->getCuEncoder( jId )->setDecCuReshaperInEncCU( pEncLib->getReshaper( jId ), pcSlice->getSPS()->getChromaFormatIdc() );
+    }
+#endif
+  }
+
+#if ENABLE_WPP_PARALLELISM
+  if( bCtuRowsParallel )
+  {
+    xEncodeCtuRowsParallel( pcPic, bCompressEntireSlice, bFastDeltaQP, pEncLib );
+    return;
+  }
+
+#endif
+  xEncodeCtus( pcPic, bCompressEntireSlice, bFastDeltaQP, startCtuTsAddr, boundingCtuTsAddr, pEncLib );
+}
+
+#if ENABLE_WPP_PARALLELISM
+bool EncSlice::xCanEncodeCtuRowsParallel( const Picture* pcPic, const uint32_t startCtuTsAddr, const uint32_t boundingCtuTsAddr ) const
+{
+#if ENABLE_TRACING
+  // the trace and block statistics output relies on the CTU coding order
+  return false;
+#else
+  const Slice&          slice = *pcPic->cs->slice;
+  const PPS&            pps   = *slice.getPPS();
+  const PreCalcValues&  pcv   = *pps.pcv;
+#if JVET_N0857_TILES_BRICKS
+  const size_t       numTiles = pcPic->brickMap->bricks.size();
+#else
+  const size_t       numTiles = pcPic->tileMap->tiles.size();
+#endif
+  const bool         debugCTU = m_pcCfg->getSwitchPOC() == pcPic->poc && m_pcCfg->getDebugCTU() >= 0;
+
+  // the CTU rows of a slice covering the whole picture are encoded in waves
+  return m_pcLib->getWppThreadPool() && !debugCTU && pcv.heightInCtus > 1
+      && startCtuTsAddr == 0 && boundingCtuTsAddr == pcv.sizeInCtus && numTiles == 1
+      && slice.getSliceMode() != FIXED_NUMBER_OF_BYTES                // the slice end depends on the bits of all preceding CTUs
+      && !m_pcCfg->getUseRateCtrl()                                    // the rate control is updated CTU by CTU
+#if ENABLE_QPA
+      && !( m_pcCfg->getUsePerceptQPA() && pps.getUseDQP() )           // the sub-CTU QPs are stored once per picture
+#endif
+      && !m_pcCfg->getMCTSEncConstraint()                              // the MCTS info is stored once per picture
+      && !m_pcCfg->getUseEncDbOpt();                                   // the deblocking cost uses the loop filter of the encoder
+#endif
+}
+
+void EncSlice::xEncodeCtuRowsParallel( Picture* pcPic, const bool bCompressEntireSlice, const bool bFastDeltaQP, EncLib* pEncLib )
+{
+  CodingStructure&      cs          = *pcPic->cs;
+  const PreCalcValues&  pcv         = *cs.pcv;
+  const int             numThreads  = pEncLib->getNumWppThreads() + pEncLib->getNumWppExtraLines();
+
+  // the encoder stacks of the other threads start with the slice level state of the first one
+  for( int tId = 1; tId < numThreads; tId++ )
+  {
+    const int dataId = pcPic->scheduler.getWppDataId( tId );
+
+    pEncLib->getRdCost     ( dataId )->copyState( *m_pcRdCost );
+    pEncLib->getTrQuant    ( dataId )->copyState( *m_pcTrQuant );
+    pEncLib->getInterSearch( dataId )->copyState( *m_pcInterSearch );
+    pEncLib->getReshaper   ( dataId )->copyState( *m_pcReshaper );
+    pEncLib->getCuEncoder  ( dataId )->getModeCtrl()->setFastDeltaQp( bFastDeltaQP );
+    if( cs.slice->getSliceType() == B_SLICE )
+    {
+      pEncLib->getInterSearch( dataId )->initWeightIdxBits();
+    }
+  }
+
+  // the CTU progress of the rows is reset for every pass of the slice QP search
+#if ENABLE_SPLIT_PARALLELISM
+  pcPic->scheduler.init( pcv.heightInCtus, pcv.widthInCtus, pEncLib->getNumWppThreads(), pEncLib->getNumWppExtraLines(), pEncLib->getNumSplitThreads() );
+#else
+  pcPic->scheduler.init( pcv.heightInCtus, pcv.widthInCtus, pEncLib->getNumWppThreads(), pEncLib->getNumWppExtraLines(), 1 );
+#endif
+
+  cs.startCtuRowParallelism( 0, pcv.heightInCtus );
+
+  ThreadPool* threadPool = pEncLib->getWppThreadPool();
+  for( uint32_t ctuRow = 0; ctuRow < pcv.heightInCtus; ctuRow++ )
+  {
+    threadPool->addTask( [this, pcPic, bCompressEntireSlice, bFastDeltaQP, pEncLib, ctuRow]( int threadIdx )
+    {
+      const uint32_t widthInCtus = pcPic->cs->pcv->widthInCtus;
+
+      pcPic->scheduler.setWppThreadId( threadIdx );
+#if ENABLE_SPLIT_PARALLELISM
+      pcPic->scheduler.setSplitThreadId( 0 );
+#endif
+      try
+      {
+        xEncodeCtus( pcPic, bCompressEntireSlice, bFastDeltaQP, ctuRow * widthInCtus, ( ctuRow + 1 ) * widthInCtus, pEncLib );
+      }
+      catch( ... )
+      {
+        // release the rows waiting for this one
+        pcPic->scheduler.abort();
+        throw;
+      }
+    } );
+  }
+
+  try
+  {
+    threadPool->waitForTasks();
+  }
+  catch( ... )
+  {
+    cs.finishCtuParallelism();
+    throw;
+  }
+
+  cs.finishCtuParallelism();
+
+  m_uiPicTotalBits = cs.fracBits >> SCALE_BITS;
+  m_uiPicDist      = cs.dist;
+}
+#endif
+
+void EncSlice::xEncodeCtus( Picture* pcPic, const bool bCompressEntireSlice, const bool bFastDeltaQP, uint32_t startCtuTsAddr, uint32_t boundingCtuTsAddr, EncLib* pEncLib )
 {
   CodingStructure&  cs            = *pcPic->cs;
   Slice* pcSlice                  = cs.slice;
@@ -1560,8 +1710,9 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
   EncCfg*         pCfg            = pEncLib;
   RateCtrl*       pRateCtrl       = pEncLib->getRateCtrl();
 #if ENABLE_WPP_PARALLELISM
-  // first version dont use ctx from above
-  pCABACWriter->initCtxModels( *pcSlice );
+  const bool      bCtuRowsParallel = cs.isCtuParallel();
+  const bool      bWppBitEqual     = pEncLib->getNumWppThreads() > 1 || pEncLib->getEnsureWppBitEqual();
+  InterSearch*    pInterSearch     = pEncLib->getInterSearch( dataId );
 #endif
 #if RDOQ_CHROMA_LAMBDA
   pTrQuant    ->setLambdas( pcSlice->getLambdas() );
@@ -1575,26 +1726,6 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
   prevQP[0] = prevQP[1] = pcSlice->getSliceQp();
   currQP[0] = currQP[1] = pcSlice->getSliceQp();
 
-    prevQP[0] = prevQP[1] = pcSlice->getSliceQp();
-  if ( pcSlice->getSPS()->getFpelMmvdEnabledFlag() ||
-      (pcSlice->getSPS()->getIBCFlag() && m_pcCuEncoder->getEncCfg()->getIBCHashSearch()))
-  {
-#if JVET_N0329_IBC_SEARCH_IMP
-    m_pcCuEncoder->getIbcHashMap().rebuildPicHashMap(cs.picture->getTrueOrigBuf());
-    if (m_pcCfg->getIntraPeriod() != -1)
-    {
-      int hashBlkHitPerc = m_pcCuEncoder->getIbcHashMap().calHashBlkMatchPerc(cs.area.Y());
-      cs.slice->setDisableSATDForRD(hashBlkHitPerc > 59);
-    }
-#else
-    if (pcSlice->getSPS()->getUseReshaper() && m_pcLib->getReshaper()->getCTUFlag() && pcSlice->getSPS()->getIBCFlag())
-      cs.picture->getOrigBuf(COMPONENT_Y).rspSignal(m_pcLib->getReshaper()->getFwdLUT());
-    m_pcCuEncoder->getIbcHashMap().rebuildPicHashMap( cs.picture->getOrigBuf() );
-    if (pcSlice->getSPS()->getUseReshaper() && m_pcLib->getReshaper()->getCTUFlag() && pcSlice->getSPS()->getIBCFlag())
-      cs.picture->getOrigBuf().copyFrom(cs.picture->getTrueOrigBuf());
-#endif
-  }
-  checkDisFracMmvd( pcPic, startCtuTsAddr, boundingCtuTsAddr );
   // for every CTU in the slice segment (may terminate sooner if there is a byte limit on the slice-segment)
 #if JVET_N0857_RECT_SLICES
   uint32_t startSliceRsRow = tileMap.getCtuBsToRsAddrMap(startCtuTsAddr) / widthInCtus;
@@ -1633,16 +1764,21 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     if( pCfg->getSwitchPOC() != pcPic->poc || -1 == pCfg->getDebugCTU() )
     if ((cs.slice->getSliceType() != I_SLICE || cs.sps->getIBCFlag()) && ctuXPosInCtus == 0)
     {
-      cs.motionLut.lut.resize(0);
-      cs.motionLut.lutIbc.resize(0);
+      LutMotionCand& motionLut = cs.getMotionLut( pos );
+      motionLut.lut.resize(0);
+      motionLut.lutIbc.resize(0);
 #if !JVET_N0266_SMALL_BLOCKS
-      cs.motionLut.lutShare.resize(0);
+      motionLut.lutShare.resize(0);
 #endif
-      cs.motionLut.lutShareIbc.resize(0);
+      motionLut.lutShareIbc.resize(0);
     }
 
 #if ENABLE_WPP_PARALLELISM
-    pcPic->scheduler.wait( ctuXPosInCtus, ctuYPosInCtus );
+    if( bCtuRowsParallel && !pcPic->scheduler.wait( ctuXPosInCtus, ctuYPosInCtus ) )
+    {
+      // encoding of a preceding CTU row failed
+      return;
+    }
 #endif
 
     if (ctuRsAddr == firstCtuRsAddrOfTile)
@@ -1675,11 +1811,24 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     }
 
 #if ENABLE_WPP_PARALLELISM
-    if( ctuXPosInCtus == 0 && ctuYPosInCtus > 0 && widthInCtus > 1 && ( pEncLib->getNumWppThreads() > 1 || pEncLib->getEnsureWppBitEqual() ) )
+    if( ctuXPosInCtus == 0 && bWppBitEqual )
     {
-      pCABACWriter->getCtx() = pEncLib->m_entropyCodingSyncContextStateVec[ctuYPosInCtus-1];  // last line
-    }
+      // the CTU row starts from the state of the row above, independent of the encoder stack it is encoded with
+#if JVET_N0150_ONE_CTU_DELAY_WPP
+      if( ctuYPosInCtus > 0 )
 #else
+      if( ctuYPosInCtus > 0 && widthInCtus > 1 )
+#endif
+      {
+        pCABACWriter->getCtx() = pEncLib->m_entropyCodingSyncContextStateVec[ctuYPosInCtus-1];  // last line
+      }
+      prevQP[0] = prevQP[1] = pcSlice->getSliceQp();
+      pInterSearch->resetAffineMVList();
+      if( pCfg->getIBCMode() )
+      {
+        pInterSearch->resetIbcSearch();
+      }
+    }
 #endif
 
 #if RDOQ_CHROMA_LAMBDA && ENABLE_QPA && !ENABLE_QPA_SUB_CTU
@@ -1753,34 +1902,13 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     }
 #endif
 
-    bool updateGbiCodingOrder = cs.slice->getSliceType() == B_SLICE && ctuTsAddr == startCtuTsAddr;
-    if( updateGbiCodingOrder )
-    {
-      resetGbiCodingOrder(false, cs);
-      m_pcInterSearch->initWeightIdxBits();
-    }
-    if (pcSlice->getSPS()->getUseReshaper())
-    {
-      m_pcCuEncoder->setDecCuReshaperInEncCU(m_pcLib->getReshaper(), pcSlice->getSPS()->getChromaFormatIdc());
-
-#if ENABLE_SPLIT_PARALLELISM || ENABLE_WPP_PARALLELISM
-      for (int jId = 1; jId < m_pcLib->getNumCuEncStacks(); jId++)
-      {
-        m_pcLib->getCuEncoder(jId)->setDecCuReshaperInEncCU(m_pcLib->getReshaper(jId), pcSlice->getSPS()->getChromaFormatIdc());
-      }
-#endif
-    }
     if( !cs.slice->isIntra() && pCfg->getMCTSEncConstraint() )
     {
       pcPic->mctsInfo.init( &cs, ctuRsAddr );
     }
 
   if (pCfg->getSwitchPOC() != pcPic->poc || ctuRsAddr >= pCfg->getDebugCTU())
-#if ENABLE_WPP_PARALLELISM
-    pEncLib->getCuEncoder( dataId )->compressCtu( cs, ctuArea, ctuRsAddr, prevQP, currQP );
-#else
-    m_pcCuEncoder->compressCtu( cs, ctuArea, ctuRsAddr, prevQP, currQP );
-#endif
+    pEncLib->getCuEncoder( PARL_PARAM0( dataId ) )->compressCtu( cs, ctuArea, ctuRsAddr, prevQP, currQP );
 
 #if K0149_BLOCK_STATISTICS
     getAndStoreBlockStatistics(cs, ctuArea);
@@ -1804,13 +1932,12 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
       break;
     }
 
-#if ENABLE_WPP_PARALLELISM || ENABLE_SPLIT_PARALLELISM
-#pragma omp critical
-#endif
-    pcSlice->setSliceBits( ( uint32_t ) ( pcSlice->getSliceBits() + numberOfWrittenBits ) );
-#if ENABLE_WPP_PARALLELISM || ENABLE_SPLIT_PARALLELISM
-#pragma omp critical
+    {
+#if ENABLE_WPP_PARALLELISM
+      std::unique_lock<std::mutex> lock( m_sliceBitsMutex );
 #endif
+      pcSlice->setSliceBits( ( uint32_t ) ( pcSlice->getSliceBits() + numberOfWrittenBits ) );
+    }
 
     // Store probabilities of second CTU in line into buffer - used only if wavefront-parallel-processing is enabled.
 #if JVET_N0150_ONE_CTU_DELAY_WPP
@@ -1822,22 +1949,20 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
       pEncLib->m_entropyCodingSyncContextState = pCABACWriter->getCtx();
     }
 #if ENABLE_WPP_PARALLELISM
-    if( ctuXPosInCtus == 1 && ( pEncLib->getNumWppThreads() > 1 || pEncLib->getEnsureWppBitEqual() ) )
+#if JVET_N0150_ONE_CTU_DELAY_WPP
+    if( ctuXPosInCtus == 0 && bWppBitEqual )
+#else
+    if( ctuXPosInCtus == 1 && bWppBitEqual )
+#endif
     {
       pEncLib->m_entropyCodingSyncContextStateVec[ctuYPosInCtus] = pCABACWriter->getCtx();
     }
 #endif
 
-#if !ENABLE_WPP_PARALLELISM
     int actualBits = int(cs.fracBits >> SCALE_BITS);
     actualBits    -= (int)m_uiPicTotalBits;
-#endif
     if ( pCfg->getUseRateCtrl() )
     {
-#if ENABLE_WPP_PARALLELISM
-      int actualBits      = int( cs.fracBits >> SCALE_BITS );
-      actualBits         -= (int)m_uiPicTotalBits;
-#endif
       int actualQP        = g_RCInvalidQPValue;
       double actualLambda = pRdCost->getLambda();
       int numberOfEffectivePixels    = 0;
@@ -1883,20 +2008,17 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     }
 #endif
 
-#if !ENABLE_WPP_PARALLELISM
-    m_uiPicTotalBits += actualBits;
-    m_uiPicDist       = cs.dist;
-#endif
 #if ENABLE_WPP_PARALLELISM
-    pcPic->scheduler.setReady( ctuXPosInCtus, ctuYPosInCtus );
+    if( bCtuRowsParallel )
+    {
+      // the picture totals are taken after all CTU rows are finished
+      pcPic->scheduler.setReady( ctuXPosInCtus, ctuYPosInCtus );
+      continue;
+    }
 #endif
+    m_uiPicTotalBits += actualBits;
+    m_uiPicDist       = cs.dist;
   }
-
-  // this is wpp exclusive section
-
-//  m_uiPicTotalBits += actualBits;
-//  m_uiPicDist       = cs.dist;
-
 }
 
 void EncSlice::encodeSlice   ( Picture* pcPic, OutputBitstream* pcSubstreams, uint32_t &numBinsCoded )
@@ -2023,7 +2145,7 @@ void EncSlice::encodeSlice   ( Picture* pcPic, OutputBitstream* pcSubstreams, ui
 #if JVET_N0857_TILES_BRICKS
 #if JVET_N0857_RECT_SLICES
     bool isLastCTUinBrick = tileMap.getBrickIdxBsMap(ctuTsAddr) != tileMap.getBrickIdxBsMap(ctuTsAddr + 1);
-    bool isLastCTUinWPP = wavefrontsEnabled && ((ctuRsAddr + 1 % widthInCtus) == tileXPosInCtus);
+    bool isLastCTUinWPP = wavefrontsEnabled && ( ctuXPosInCtus + 1 == tileXPosInCtus + currentTile.getWidthInCtus() );
     bool isMoreCTUsinSlice = ctuRsAddr != tileMap.getCtuBsToRsAddrMap(boundingCtuTsAddr - 1);
     if (isLastCTUinBrick || isLastCTUinWPP || !isMoreCTUsinSlice)         // this the the last CTU of either tile/brick/WPP/slice
 #else
@@ -79,6 +79,7 @@ private:
   // coding tools
   CABACWriter*            m_CABACWriter;
   TrQuant*                m_pcTrQuant;                          ///< transform & quantization
+  EncReshape*             m_pcReshaper;                         ///< luma mapping of the encoder stack
 
   // RD optimization
   RdCost*                 m_pcRdCost;                           ///< RD cost computation
@@ -95,6 +96,9 @@ private:
 #if SHARP_LUMA_DELTA_QP
   int                     m_gopID;
 #endif
+#if ENABLE_WPP_PARALLELISM
+  std::mutex              m_sliceBitsMutex;                     ///< guards the slice bits of concurrently encoded CTU rows
+#endif
 
 #if SHARP_LUMA_DELTA_QP
 public:
@@ -117,7 +121,7 @@ public:
 
   void    create              ( int iWidth, int iHeight, ChromaFormat chromaFormat, uint32_t iMaxCUWidth, uint32_t iMaxCUHeight, uint8_t uhTotalDepth );
   void    destroy             ();
-  void    init                ( EncLib* pcEncLib, const SPS& sps );
+  void    init                ( EncLib* pcEncLib, const SPS& sps PARL_PARAM( const int jId ) );
 
   /// preparation of slice encoding (reference marking, QP and lambda)
   void    initEncSlice        ( Picture*  pcPic, const int pocLast, const int pocCurr,
@@ -133,9 +137,6 @@ public:
   void    calCostSliceI       ( Picture* pcPic );
 
   void    encodeSlice         ( Picture* pcPic, OutputBitstream* pcSubstreams, uint32_t &numBinsCoded );
-#if ENABLE_WPP_PARALLELISM
-  static
-#endif
   void    encodeCtus          ( Picture* pcPic, const bool bCompressEntireSlice, const bool bFastDeltaQP, uint32_t startCtuTsAddr, uint32_t boundingCtuTsAddr, EncLib* pcEncLib );
   void    checkDisFracMmvd    ( Picture* pcPic, uint32_t startCtuTsAddr, uint32_t boundingCtuTsAddr );
 
@@ -151,6 +152,12 @@ public:
   void    setEncCABACTableIdx (SliceType b)         { m_encCABACTableIdx = b; }
 private:
   double  xGetQPValueAccordingToLambda ( double lambda );
+
+  void    xEncodeCtus         ( Picture* pcPic, const bool bCompressEntireSlice, const bool bFastDeltaQP, uint32_t startCtuTsAddr, uint32_t boundingCtuTsAddr, EncLib* pcEncLib );
+#if ENABLE_WPP_PARALLELISM
+  bool    xCanEncodeCtuRowsParallel( const Picture* pcPic, const uint32_t startCtuTsAddr, const uint32_t boundingCtuTsAddr ) const;
+  void    xEncodeCtuRowsParallel   ( Picture* pcPic, const bool bCompressEntireSlice, const bool bFastDeltaQP, EncLib* pcEncLib );
+#endif
 };
 
 //! \}
@@ -438,6 +438,13 @@ static bool verifyPlane(Pel* dst,
 }
 
 
+/// true if Pel words are stored little-endian, i.e. in the byte order of 16 bit YUV files
+static inline bool isLittleEndianHost()
+{
+  const uint16_t one = 1;
+  return *reinterpret_cast<const uint8_t*>(&one) == 1;
+}
+
 /**
  * Write an image plane (width444*height444 pixels) from src into output stream fd.
  *
@@ -608,15 +615,29 @@ static bool writePlane(ostream& fd, const Pel* src,
   }
   else
   {
-    const uint32_t mask_y_file = (1 << csy_file) - 1;
-    const uint32_t mask_y_src  = (1 << csy_src ) - 1;
+    const uint32_t mask_y_file     = (1 << csy_file) - 1;
+    const uint32_t mask_y_src      = (1 << csy_src ) - 1;
+    const bool     writeNativePels = sizeof(Pel) == 2 && isLittleEndianHost();
 
     for (uint32_t y444 = 0; y444 < height444; y444++)
     {
       if ((y444 & mask_y_file) == 0)
       {
         // write a new line
-        if (csx_file < csx_src)
+        const uint8_t *line = buf;
+        if (csx_file == csx_src && is16bit && writeNativePels)
+        {
+          // the source line already is in file format, write it without conversion
+          line = reinterpret_cast<const uint8_t*>(pSrcBuf);
+        }
+        else if (csx_file == csx_src && !is16bit)
+        {
+          for (uint32_t x = 0; x < width_file; x++)
+          {
+            buf[x] = (uint8_t)(pSrcBuf[x]);
+          }
+        }
+        else if (csx_file < csx_src)
         {
           // eg file is 444, source is 422.
           const uint32_t sx = csx_src - csx_file;
@@ -657,7 +678,7 @@ static bool writePlane(ostream& fd, const Pel* src,
           }
         }
 
-        fd.write (reinterpret_cast<const char*>(buf), stride_file);
+        fd.write (reinterpret_cast<const char*>(line), stride_file);
         if (fd.eof() || fd.fail())
         {
           return false;
@@ -0,0 +1,228 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     VideoIOYuvAsyncWriter.cpp
+    \brief    asynchronous YUV file writer
+*/
+
+#include "VideoIOYuvAsyncWriter.h"
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+VideoIOYuvAsyncWriter::VideoIOYuvAsyncWriter()
+  : m_file      ( nullptr )
+  , m_head      ( 0 )
+  , m_numQueued ( 0 )
+  , m_stop      ( false )
+  , m_failed    ( false )
+{
+}
+
+VideoIOYuvAsyncWriter::~VideoIOYuvAsyncWriter()
+{
+  destroy();
+}
+
+void VideoIOYuvAsyncWriter::create( VideoIOYuv* file, const int queueDepth )
+{
+  CHECK( m_file != nullptr, "Asynchronous YUV writer already created" );
+  CHECK( queueDepth < 0, "Invalid output queue depth" );
+
+  m_file      = file;
+  m_head      = 0;
+  m_numQueued = 0;
+  m_stop      = false;
+  m_failed    = false;
+  m_jobs.resize( queueDepth );
+
+  if( queueDepth > 0 )
+  {
+    m_thread = std::thread( &VideoIOYuvAsyncWriter::xWriterLoop, this );
+  }
+}
+
+void VideoIOYuvAsyncWriter::destroy()
+{
+  if( m_thread.joinable() )
+  {
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_stop = true;
+    }
+    m_queuedCond.notify_one();
+    m_thread.join();
+  }
+
+  for( auto &job : m_jobs )
+  {
+    job.top.destroy();
+    job.bottom.destroy();
+  }
+  m_jobs.clear();
+  m_file = nullptr;
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+void VideoIOYuvAsyncWriter::write( const CPelUnitBuf& pic, const InputColourSpaceConversion ipCSC, const bool bPackedYUVOutputMode,
+                                   int confLeft, int confRight, int confTop, int confBottom, ChromaFormat format, const bool bClipToRec709 )
+{
+  if( m_jobs.empty() )
+  {
+    m_failed |= !m_file->write( pic, ipCSC, bPackedYUVOutputMode, confLeft, confRight, confTop, confBottom, format, bClipToRec709 );
+    return;
+  }
+
+  OutputJob &job = xAcquireJob();
+
+  xCopyPicture( job.top, pic );
+  job.isField             = false;
+  job.ipCSC               = ipCSC;
+  job.packedYUVOutputMode = bPackedYUVOutputMode;
+  job.confLeft            = confLeft;
+  job.confRight           = confRight;
+  job.confTop             = confTop;
+  job.confBottom          = confBottom;
+  job.format              = format;
+  job.isTff               = false;
+  job.clipToRec709        = bClipToRec709;
+
+  xSubmitJob();
+}
+
+void VideoIOYuvAsyncWriter::write( const CPelUnitBuf& picTop, const CPelUnitBuf& picBot, const InputColourSpaceConversion ipCSC, const bool bPackedYUVOutputMode,
+                                   int confLeft, int confRight, int confTop, int confBottom, ChromaFormat format, const bool isTff, const bool bClipToRec709 )
+{
+  if( m_jobs.empty() )
+  {
+    m_failed |= !m_file->write( picTop, picBot, ipCSC, bPackedYUVOutputMode, confLeft, confRight, confTop, confBottom, format, isTff, bClipToRec709 );
+    return;
+  }
+
+  OutputJob &job = xAcquireJob();
+
+  xCopyPicture( job.top,    picTop );
+  xCopyPicture( job.bottom, picBot );
+  job.isField             = true;
+  job.ipCSC               = ipCSC;
+  job.packedYUVOutputMode = bPackedYUVOutputMode;
+  job.confLeft            = confLeft;
+  job.confRight           = confRight;
+  job.confTop             = confTop;
+  job.confBottom          = confBottom;
+  job.format              = format;
+  job.isTff               = isTff;
+  job.clipToRec709        = bClipToRec709;
+
+  xSubmitJob();
+}
+
+bool VideoIOYuvAsyncWriter::flush()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_freeCond.wait( lock, [this] { return m_numQueued == 0; } );
+  return !m_failed;
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+/** waits until the writer thread has released the oldest buffer if all buffers are queued
+    \returns the buffer following the queued ones, it is owned by the caller until xSubmitJob() is called
+ */
+VideoIOYuvAsyncWriter::OutputJob& VideoIOYuvAsyncWriter::xAcquireJob()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_freeCond.wait( lock, [this] { return m_numQueued < m_jobs.size(); } );
+  return m_jobs[( m_head + m_numQueued ) % m_jobs.size()];
+}
+
+void VideoIOYuvAsyncWriter::xSubmitJob()
+{
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_numQueued++;
+  }
+  m_queuedCond.notify_one();
+}
+
+bool VideoIOYuvAsyncWriter::xWriteJob( OutputJob& job )
+{
+  if( job.isField )
+  {
+    return m_file->write( job.top, job.bottom, job.ipCSC, job.packedYUVOutputMode,
+                          job.confLeft, job.confRight, job.confTop, job.confBottom, job.format, job.isTff, job.clipToRec709 );
+  }
+  return m_file->write( job.top, job.ipCSC, job.packedYUVOutputMode,
+                        job.confLeft, job.confRight, job.confTop, job.confBottom, job.format, job.clipToRec709 );
+}
+
+void VideoIOYuvAsyncWriter::xWriterLoop()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+
+  while( true )
+  {
+    m_queuedCond.wait( lock, [this] { return m_numQueued > 0 || m_stop; } );
+    if( m_numQueued == 0 )
+    {
+      return; // stopped and all queued pictures are written
+    }
+
+    // the head buffer is not touched by the producer while it is queued
+    OutputJob &job = m_jobs[m_head];
+    lock.unlock();
+    const bool ok = xWriteJob( job );
+    lock.lock();
+
+    m_failed   |= !ok;
+    m_head      = ( m_head + 1 ) % m_jobs.size();
+    m_numQueued--;
+    m_freeCond.notify_one();
+  }
+}
+
+void VideoIOYuvAsyncWriter::xCopyPicture( PelStorage& dst, const CPelUnitBuf& src )
+{
+  if( dst.bufs.empty() || dst.chromaFormat != src.chromaFormat || dst.Y().width != src.Y().width || dst.Y().height != src.Y().height )
+  {
+    dst.destroy();
+    dst.create( src.chromaFormat, Area( Position(), src.Y() ) );
+  }
+  dst.copyFrom( src );
+}
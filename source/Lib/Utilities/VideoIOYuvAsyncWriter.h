@@ -0,0 +1,115 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2019, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     VideoIOYuvAsyncWriter.h
+    \brief    asynchronous YUV file writer (header)
+*/
+
+#ifndef __VIDEOIOYUVASYNCWRITER__
+#define __VIDEOIOYUVASYNCWRITER__
+
+#include "VideoIOYuv.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// writes output pictures to a VideoIOYuv file on a background thread
+/** Pictures are copied into a bounded ring of writer owned buffers, so the caller can release the source
+    picture as soon as write() returns. write() only blocks when all buffers are still queued for writing.
+    With a queue depth of 0 the pictures are written synchronously by the calling thread. */
+class VideoIOYuvAsyncWriter
+{
+public:
+  VideoIOYuvAsyncWriter();
+  ~VideoIOYuvAsyncWriter();
+
+  void  create ( VideoIOYuv* file, const int queueDepth );
+  void  destroy();                                          ///< writes all queued pictures and stops the writer thread
+
+  /// queue one YUV frame for writing, see VideoIOYuv::write
+  void  write  ( const CPelUnitBuf& pic,
+                 const InputColourSpaceConversion ipCSC,
+                 const bool bPackedYUVOutputMode,
+                 int confLeft = 0, int confRight = 0, int confTop = 0, int confBottom = 0, ChromaFormat format = NUM_CHROMA_FORMAT, const bool bClipToRec709 = false );
+
+  /// queue one YUV frame composed of two fields for writing, see VideoIOYuv::write
+  void  write  ( const CPelUnitBuf& picTop, const CPelUnitBuf& picBot,
+                 const InputColourSpaceConversion ipCSC,
+                 const bool bPackedYUVOutputMode,
+                 int confLeft = 0, int confRight = 0, int confTop = 0, int confBottom = 0, ChromaFormat format = NUM_CHROMA_FORMAT, const bool isTff = false, const bool bClipToRec709 = false );
+
+  /// blocks until all queued pictures are written, returns false if writing any picture failed
+  bool  flush  ();
+
+private:
+  struct OutputJob
+  {
+    PelStorage                 top;
+    PelStorage                 bottom;
+    bool                       isField;
+    InputColourSpaceConversion ipCSC;
+    bool                       packedYUVOutputMode;
+    int                        confLeft;
+    int                        confRight;
+    int                        confTop;
+    int                        confBottom;
+    ChromaFormat               format;
+    bool                       isTff;
+    bool                       clipToRec709;
+  };
+
+  OutputJob& xAcquireJob  ();
+  void       xSubmitJob   ();
+  bool       xWriteJob    ( OutputJob& job );
+  void       xWriterLoop  ();
+  static void xCopyPicture( PelStorage& dst, const CPelUnitBuf& src );
+
+  VideoIOYuv*                 m_file;
+  std::vector<OutputJob>      m_jobs;                       ///< ring of output buffers
+  size_t                      m_head;                       ///< next job to be written
+  size_t                      m_numQueued;
+  bool                        m_stop;
+  bool                        m_failed;
+  std::mutex                  m_mutex;
+  std::condition_variable     m_queuedCond;                 ///< signals the writer thread
+  std::condition_variable     m_freeCond;                   ///< signals a free buffer or an empty queue
+  std::thread                 m_thread;
+};
+
+#endif // __VIDEOIOYUVASYNCWRITER__